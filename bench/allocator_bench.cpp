@@ -0,0 +1,177 @@
+#include "benchmark/benchmark.h"
+
+#include "sds/allocator/region_allocator.h"
+#include "sds/allocator/stack_allocator.h"
+#include "sds/allocator/thread_cache_allocator.h"
+#include "sds/array/dynamic_array.h"
+#include "sds/s_list.h"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+/** \file allocator_bench.cpp
+ * \brief sds::thread_cache_allocate against glibc malloc under multi-threaded churn, containers
+ * on sds::Thread_Cache_Allocator against std::allocator, per call scratch buffers on
+ * sds::Stack_Allocator, and random access to a large table in huge page regions.
+ */
+
+namespace
+{
+struct Malloc {
+    static void* allocate(size_t bytes) { return std::malloc(bytes); }
+    static void deallocate(void* p, size_t) { std::free(p); }
+};
+
+struct Thread_Cache {
+    static void* allocate(size_t bytes) { return sds::thread_cache_allocate(bytes); }
+    static void deallocate(void* p, size_t bytes) { sds::thread_cache_deallocate(p, bytes); }
+};
+
+/* Sizes between 16 and 1024 bytes, skewed small like typical container nodes and strings. */
+struct Size_Source {
+    sds::u32 state;
+
+    size_t next() noexcept
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state % 4 == 0 ? 16 + state % 1009 : 16 + state % 113;
+    }
+};
+
+constexpr size_t live_per_thread = 256;
+constexpr size_t shared_slot_count = 4096;
+} // namespace
+
+/* Each thread frees its own blocks, oldest first. */
+template <typename Alloc>
+static void BM_alloc_churn_local(benchmark::State& state)
+{
+    Size_Source sizes{static_cast<sds::u32>(state.thread_index() + 1)};
+    void* live[live_per_thread] = {};
+    size_t live_bytes[live_per_thread] = {};
+    size_t i = 0;
+    for (auto _ : state) {
+        if (live[i]) { Alloc::deallocate(live[i], live_bytes[i]); }
+        live_bytes[i] = sizes.next();
+        live[i] = Alloc::allocate(live_bytes[i]);
+        benchmark::DoNotOptimize(live[i]);
+        i = (i + 1) % live_per_thread;
+    }
+    for (size_t j = 0; j < live_per_thread; ++j) {
+        if (live[j]) { Alloc::deallocate(live[j], live_bytes[j]); }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK_TEMPLATE(BM_alloc_churn_local, Malloc)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_alloc_churn_local, Thread_Cache)->ThreadRange(1, 16)->UseRealTime();
+
+/* Blocks are swapped through slots shared by all threads, so most are freed by a thread other
+ * than the one that allocated them, like work items passed between a producer and consumers.
+ * Blocks carry their size so any thread can free them. */
+template <typename Alloc>
+static void BM_alloc_churn_remote(benchmark::State& state)
+{
+    static std::atomic<void*> slots[shared_slot_count];
+    Size_Source sizes{static_cast<sds::u32>(state.thread_index() + 1)};
+    for (auto _ : state) {
+        size_t const bytes = sizes.next();
+        void* const p = Alloc::allocate(bytes);
+        std::memcpy(p, &bytes, sizeof(bytes));
+        if (void* const old = slots[sizes.state % shared_slot_count].exchange(p)) {
+            size_t old_bytes = 0;
+            std::memcpy(&old_bytes, old, sizeof(old_bytes));
+            Alloc::deallocate(old, old_bytes);
+        }
+    }
+    // All threads have left the loop
+    if (state.thread_index() == 0) {
+        for (std::atomic<void*>& slot : slots) {
+            if (void* const p = slot.exchange(nullptr)) {
+                size_t bytes = 0;
+                std::memcpy(&bytes, p, sizeof(bytes));
+                Alloc::deallocate(p, bytes);
+            }
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK_TEMPLATE(BM_alloc_churn_remote, Malloc)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_alloc_churn_remote, Thread_Cache)->ThreadRange(1, 16)->UseRealTime();
+
+template <typename Alloc>
+static void BM_alloc_dynamic_array_push_back(benchmark::State& state)
+{
+    for (auto _ : state) {
+        sds::Dynamic_Array<int, Alloc> v;
+        for (int i = 0; i < 256; ++i) { v.push_back(i); }
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * 256);
+}
+BENCHMARK_TEMPLATE(BM_alloc_dynamic_array_push_back, std::allocator<int>)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_alloc_dynamic_array_push_back, sds::Thread_Cache_Allocator<int>)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+template <typename Alloc>
+static void BM_alloc_s_list_push_back(benchmark::State& state)
+{
+    for (auto _ : state) {
+        sds::S_List<int, Alloc> l;
+        for (int i = 0; i < 256; ++i) { l.push_back(i); }
+        benchmark::DoNotOptimize(&l);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * 256);
+}
+BENCHMARK_TEMPLATE(BM_alloc_s_list_push_back, std::allocator<int>)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_alloc_s_list_push_back, sds::Thread_Cache_Allocator<int>)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+/* A scratch buffer that lives for one call, as in a function building a temporary index. */
+template <typename Alloc>
+static void BM_alloc_scratch_buffer(benchmark::State& state)
+{
+    for (auto _ : state) {
+        sds::Stack_Scope const scratch;
+        sds::Dynamic_Array<int, Alloc> v;
+        v.reserve(256);
+        for (int i = 0; i < 256; ++i) { v.push_back(i); }
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK_TEMPLATE(BM_alloc_scratch_buffer, std::allocator<int>);
+BENCHMARK_TEMPLATE(BM_alloc_scratch_buffer, sds::Thread_Cache_Allocator<int>);
+BENCHMARK_TEMPLATE(BM_alloc_scratch_buffer, sds::Stack_Allocator<int>);
+
+/* Random loads from a 256 MiB table. With 4 KiB pages nearly every load misses the TLB; a
+ * region on transparent huge pages needs 512 times fewer TLB entries. */
+template <typename Alloc>
+static void BM_alloc_large_table_gather(benchmark::State& state)
+{
+    constexpr size_t count = (size_t{256} << 20) / sizeof(sds::u64);
+    sds::Dynamic_Array<sds::u64, Alloc> table;
+    table.resize(count, 1);
+    sds::u64 x = 0x9e3779b97f4a7c15;
+    for (auto _ : state) {
+        sds::u64 sum = 0;
+        for (int i = 0; i < 1024; ++i) {
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            sum += table[x % count];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * 1024);
+}
+BENCHMARK_TEMPLATE(BM_alloc_large_table_gather, std::allocator<sds::u64>);
+BENCHMARK_TEMPLATE(BM_alloc_large_table_gather, sds::Region_Allocator<sds::u64>);
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "benchmark/benchmark.h"
+
+#include "sds/perf_counters.h"
+
+/** \file bench_counters.h
+ * \brief Hardware counters per iteration as Google Benchmark user counters, see
+ * sds/perf_counters.h.
+ *
+ * Construct a Bench_Counters right before the timed loop, after any setup, so only the loop is
+ * counted. Counters that can't be read on the host are left out of the report, so without a PMU
+ * the output is unchanged.
+ *
+ *   for (auto _ : state) { ... }
+ *
+ * becomes
+ *
+ *   Bench_Counters const counters(state);
+ *   for (auto _ : state) { ... }
+ */
+
+class Bench_Counters {
+public:
+    explicit Bench_Counters(benchmark::State& state) noexcept : m_state(state)
+    {
+        perf_counters().start();
+    }
+
+    ~Bench_Counters()
+    {
+        sds::Perf_Counter_Values const v = perf_counters().stop();
+        for (sds::u32 i = 0; i < sds::perf_counter_count; ++i) {
+            sds::Perf_Counter const c = static_cast<sds::Perf_Counter>(i);
+            if (v.has(c)) {
+                m_state.counters[sds::to_string(c)] =
+                    benchmark::Counter(v[c], benchmark::Counter::kAvgIterations);
+            }
+        }
+    }
+
+    Bench_Counters(Bench_Counters const&) = delete;
+    Bench_Counters& operator=(Bench_Counters const&) = delete;
+
+private:
+    benchmark::State& m_state;
+
+    /* Opened once; benchmarks run on the main thread */
+    static sds::Perf_Counters& perf_counters() noexcept
+    {
+        static sds::Perf_Counters s_counters;
+        return s_counters;
+    }
+};
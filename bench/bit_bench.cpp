@@ -0,0 +1,156 @@
+#include "benchmark/benchmark.h"
+
+#include "sds/bit.h"
+#include "sds/bitarray.h"
+#include <bitset>
+#include <random>
+#include <vector>
+
+/** \file bit_bench.cpp
+ * \brief sds::bit_count against the compiler builtin and a portable loop, sds::Bitarray against
+ * std::bitset.
+ */
+
+namespace
+{
+std::vector<sds::u64> random_words(size_t n)
+{
+    std::mt19937_64 rng(42);
+    std::vector<sds::u64> words(n);
+    for (sds::u64& w : words) { w = rng(); }
+    return words;
+}
+
+int kernighan_bit_count(sds::u64 x)
+{
+    int count = 0;
+    for (; x != 0; x &= x - 1) { ++count; }
+    return count;
+}
+
+void word_counts(benchmark::internal::Benchmark* b)
+{
+    for (int n : {1, 16, 256, 4096}) { b->Arg(n); }
+}
+} // namespace
+
+static void BM_sds_bit_count(benchmark::State& state)
+{
+    std::vector<sds::u64> const words = random_words(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        sds::s64 count = 0;
+        for (sds::u64 w : words) { count += sds::bit_count(w); }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_sds_bit_count)->Apply(word_counts);
+
+static void BM_sds_bit_count_bulk(benchmark::State& state)
+{
+    std::vector<sds::u64> const words = random_words(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            sds::bit_count(words.data(), static_cast<sds::sz>(words.size())));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_sds_bit_count_bulk)->Apply(word_counts);
+
+static void BM_builtin_popcount(benchmark::State& state)
+{
+    std::vector<sds::u64> const words = random_words(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        sds::s64 count = 0;
+        for (sds::u64 w : words) { count += __builtin_popcountll(w); }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_builtin_popcount)->Apply(word_counts);
+
+static void BM_loop_bit_count(benchmark::State& state)
+{
+    std::vector<sds::u64> const words = random_words(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        sds::s64 count = 0;
+        for (sds::u64 w : words) { count += kernighan_bit_count(w); }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_loop_bit_count)->Apply(word_counts);
+
+namespace
+{
+constexpr sds::sz bitset_bits = 4096;
+
+struct Sds_Bits {
+    sds::Bitarray<bitset_bits> bits;
+
+    void set(int i) { bits.set(i); }
+    bool test(int i) const { return bits.test(i); }
+    int count() const { return bits.count(); }
+    bool any() const { return bits.any(); }
+};
+
+struct Std_Bits {
+    std::bitset<bitset_bits> bits;
+
+    void set(int i) { bits.set(static_cast<size_t>(i)); }
+    bool test(int i) const { return bits.test(static_cast<size_t>(i)); }
+    int count() const { return static_cast<int>(bits.count()); }
+    bool any() const { return bits.any(); }
+};
+
+template <typename Bits>
+void set_half_random(Bits& b)
+{
+    std::mt19937 rng(7);
+    for (int i = 0; i < bitset_bits / 2; ++i) {
+        b.set(static_cast<int>(rng() % static_cast<unsigned>(bitset_bits)));
+    }
+}
+} // namespace
+
+template <typename Bits>
+static void BM_bitset_set_test(benchmark::State& state)
+{
+    Bits b;
+    int hits = 0;
+    for (auto _ : state) {
+        for (int i = 0; i < bitset_bits; i += 3) { b.set(i); }
+        for (int i = 0; i < bitset_bits; ++i) { hits += b.test(i); }
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * bitset_bits);
+}
+BENCHMARK_TEMPLATE(BM_bitset_set_test, Sds_Bits);
+BENCHMARK_TEMPLATE(BM_bitset_set_test, Std_Bits);
+
+template <typename Bits>
+static void BM_bitset_count(benchmark::State& state)
+{
+    Bits b;
+    set_half_random(b);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(&b);
+        benchmark::DoNotOptimize(b.count());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * bitset_bits);
+}
+BENCHMARK_TEMPLATE(BM_bitset_count, Sds_Bits);
+BENCHMARK_TEMPLATE(BM_bitset_count, Std_Bits);
+
+template <typename Bits>
+static void BM_bitset_any_empty(benchmark::State& state)
+{
+    Bits const b{};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(&b);
+        benchmark::DoNotOptimize(b.any());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * bitset_bits);
+}
+BENCHMARK_TEMPLATE(BM_bitset_any_empty, Sds_Bits);
+BENCHMARK_TEMPLATE(BM_bitset_any_empty, Std_Bits);
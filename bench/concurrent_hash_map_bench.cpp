@@ -0,0 +1,108 @@
+#include "benchmark/benchmark.h"
+
+#include "sds/concurrent_hash_map.h"
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+/** \file concurrent_hash_map_bench.cpp
+ * \brief Thread scaling of sds::Concurrent_Hash_Map against a single locked std::unordered_map.
+ *
+ * Each thread runs a mix of lookups and writes over a shared, prefilled map. The argument is the
+ * percentage of operations that are writes.
+ */
+
+namespace
+{
+constexpr sds::u64 num_keys = 1 << 16; // pow2 so keys can be masked
+
+/* Per-thread key stream. */
+struct Xorshift {
+    sds::u64 state;
+
+    sds::u64 next() noexcept
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+template <typename Lock>
+struct Sds_Map {
+    sds::Concurrent_Hash_Map<sds::u64, sds::u64, sds::Hash<sds::u64>, std::equal_to<sds::u64>,
+                             Lock>
+        map;
+
+    bool find(sds::u64 k) const { return map.find(k).has_value(); }
+    void assign(sds::u64 k, sds::u64 v) { map.insert_or_assign(k, v); }
+};
+
+/* The usual baseline: one lock around the whole map. */
+template <typename Mutex>
+struct Std_Map {
+    mutable Mutex mutex;
+    std::unordered_map<sds::u64, sds::u64, sds::Hash<sds::u64>> map;
+
+    bool find(sds::u64 k) const
+    {
+        if constexpr (std::is_same_v<Mutex, std::shared_mutex>) {
+            std::shared_lock<Mutex> guard(mutex);
+            return map.find(k) != map.end();
+        } else {
+            std::lock_guard<Mutex> guard(mutex);
+            return map.find(k) != map.end();
+        }
+    }
+    void assign(sds::u64 k, sds::u64 v)
+    {
+        std::lock_guard<Mutex> guard(mutex);
+        map.insert_or_assign(k, v);
+    }
+};
+
+template <typename Map>
+Map& shared_map()
+{
+    // Function static so every benchmark thread sees the one map, built once
+    static Map* m = [] {
+        Map* p = new Map();
+        for (sds::u64 k = 0; k < num_keys; ++k) { p->assign(k, k); }
+        return p;
+    }();
+    return *m;
+}
+} // namespace
+
+template <typename Map>
+static void BM_concurrent_map_mixed(benchmark::State& state)
+{
+    Map& m = shared_map<Map>();
+    sds::u64 const write_percent = static_cast<sds::u64>(state.range(0));
+    Xorshift rng{0x9E3779B97F4A7C15ULL * static_cast<sds::u64>(state.thread_index() + 1)};
+
+    for (auto _ : state) {
+        sds::u64 const r = rng.next();
+        sds::u64 const k = r & (num_keys - 1);
+        if ((r >> 32) % 100 < write_percent) {
+            m.assign(k, r);
+        } else {
+            benchmark::DoNotOptimize(m.find(k));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+#define SDS_CONCURRENT_MAP_BENCH(map)                                                              \
+    BENCHMARK_TEMPLATE(BM_concurrent_map_mixed, map)                                               \
+        ->Arg(0)                                                                                   \
+        ->Arg(10)                                                                                  \
+        ->Arg(50)                                                                                  \
+        ->ThreadRange(1, 64)                                                                       \
+        ->UseRealTime()
+
+SDS_CONCURRENT_MAP_BENCH(Sds_Map<sds::Spin_Lock>);
+SDS_CONCURRENT_MAP_BENCH(Sds_Map<sds::Readers_Writer_Spin_Lock>);
+SDS_CONCURRENT_MAP_BENCH(Std_Map<std::mutex>);
+SDS_CONCURRENT_MAP_BENCH(Std_Map<std::shared_mutex>);
@@ -0,0 +1,186 @@
+#include "benchmark/benchmark.h"
+
+#include "bench_counters.h"
+
+#include "sds/array/array.h"
+#include "sds/array/dynamic_array.h"
+#include "sds/s_list.h"
+#include <array>
+#include <forward_list>
+#include <list>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/** \file containers_bench.cpp
+ * \brief Basic containers against their std counterparts: sds::S_List against std::forward_list
+ * and std::list, sds::Dynamic_Array against std::vector, sds::Array against std::array.
+ */
+
+namespace
+{
+void element_counts(benchmark::internal::Benchmark* b)
+{
+    for (int n : {16, 256, 4096, 65536}) { b->Arg(n); }
+}
+
+void set_items_processed(benchmark::State& state)
+{
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+/* std::forward_list has no push_back; keep an iterator to the last node instead. */
+struct Forward_List_Appender {
+    std::forward_list<int> list;
+    std::forward_list<int>::iterator last = list.before_begin();
+
+    void push_back(int v) { last = list.insert_after(last, v); }
+};
+
+template <typename List>
+List make_list(int n)
+{
+    if constexpr (std::is_same_v<List, std::forward_list<int>>) {
+        Forward_List_Appender out;
+        for (int i = 0; i < n; ++i) { out.push_back(i); }
+        return std::move(out.list);
+    } else {
+        List list;
+        for (int i = 0; i < n; ++i) { list.push_back(i); }
+        return list;
+    }
+}
+
+template <typename List>
+int sum(List const& list)
+{
+    int s = 0;
+    for (int v : list) { s += v; }
+    return s;
+}
+} // namespace
+
+template <typename List>
+static void BM_list_push_back(benchmark::State& state)
+{
+    int const n = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        List list;
+        for (int i = 0; i < n; ++i) { list.push_back(i); }
+        benchmark::DoNotOptimize(&list);
+    }
+    set_items_processed(state);
+}
+BENCHMARK_TEMPLATE(BM_list_push_back, sds::S_List<int>)->Apply(element_counts);
+BENCHMARK_TEMPLATE(BM_list_push_back, Forward_List_Appender)->Apply(element_counts);
+BENCHMARK_TEMPLATE(BM_list_push_back, std::list<int>)->Apply(element_counts);
+
+template <typename List>
+static void BM_list_iterate(benchmark::State& state)
+{
+    List const list = make_list<List>(static_cast<int>(state.range(0)));
+    Bench_Counters const counters(state);
+    for (auto _ : state) { benchmark::DoNotOptimize(sum(list)); }
+    set_items_processed(state);
+}
+BENCHMARK_TEMPLATE(BM_list_iterate, sds::S_List<int>)->Apply(element_counts);
+BENCHMARK_TEMPLATE(BM_list_iterate, std::forward_list<int>)->Apply(element_counts);
+BENCHMARK_TEMPLATE(BM_list_iterate, std::list<int>)->Apply(element_counts);
+
+template <typename Vec>
+static void BM_vector_push_back(benchmark::State& state)
+{
+    int const n = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        Vec v;
+        for (int i = 0; i < n; ++i) { v.push_back(i); }
+        benchmark::DoNotOptimize(v.data());
+    }
+    set_items_processed(state);
+}
+BENCHMARK_TEMPLATE(BM_vector_push_back, sds::Dynamic_Array<int>)->Apply(element_counts);
+BENCHMARK_TEMPLATE(BM_vector_push_back, std::vector<int>)->Apply(element_counts);
+
+template <typename Vec>
+static void BM_vector_reserved_push_back(benchmark::State& state)
+{
+    int const n = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        Vec v;
+        v.reserve(static_cast<size_t>(n));
+        for (int i = 0; i < n; ++i) { v.push_back(i); }
+        benchmark::DoNotOptimize(v.data());
+    }
+    set_items_processed(state);
+}
+BENCHMARK_TEMPLATE(BM_vector_reserved_push_back, sds::Dynamic_Array<int>)->Apply(element_counts);
+BENCHMARK_TEMPLATE(BM_vector_reserved_push_back, std::vector<int>)->Apply(element_counts);
+
+template <typename Vec>
+static void BM_vector_iterate(benchmark::State& state)
+{
+    Vec const v = make_list<Vec>(static_cast<int>(state.range(0)));
+    Bench_Counters const counters(state);
+    for (auto _ : state) { benchmark::DoNotOptimize(sum(v)); }
+    set_items_processed(state);
+}
+BENCHMARK_TEMPLATE(BM_vector_iterate, sds::Dynamic_Array<int>)->Apply(element_counts);
+BENCHMARK_TEMPLATE(BM_vector_iterate, std::vector<int>)->Apply(element_counts);
+
+template <typename Vec>
+static void BM_vector_insert_front(benchmark::State& state)
+{
+    int const n = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        Vec v;
+        for (int i = 0; i < n; ++i) { v.insert(v.begin(), i); }
+        benchmark::DoNotOptimize(v.data());
+    }
+    set_items_processed(state);
+}
+BENCHMARK_TEMPLATE(BM_vector_insert_front, sds::Dynamic_Array<int>)->Arg(16)->Arg(256)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_vector_insert_front, std::vector<int>)->Arg(16)->Arg(256)->Arg(4096);
+
+namespace
+{
+constexpr sds::sz array_size = 1024;
+
+struct Sds_Array {
+    sds::Array<int, array_size> a;
+};
+
+struct Std_Array {
+    std::array<int, array_size> a;
+};
+} // namespace
+
+template <typename Wrapper>
+static void BM_array_fill(benchmark::State& state)
+{
+    Wrapper w;
+    int v = 0;
+    for (auto _ : state) {
+        w.a.fill(v++);
+        benchmark::DoNotOptimize(w.a.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * array_size);
+}
+BENCHMARK_TEMPLATE(BM_array_fill, Sds_Array);
+BENCHMARK_TEMPLATE(BM_array_fill, Std_Array);
+
+template <typename Wrapper>
+static void BM_array_iterate(benchmark::State& state)
+{
+    Wrapper w;
+    std::iota(w.a.begin(), w.a.end(), 0);
+    Bench_Counters const counters(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(w.a.data());
+        benchmark::DoNotOptimize(sum(w.a));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * array_size);
+}
+BENCHMARK_TEMPLATE(BM_array_iterate, Sds_Array);
+BENCHMARK_TEMPLATE(BM_array_iterate, Std_Array);
@@ -0,0 +1,119 @@
+#include "benchmark/benchmark.h"
+
+#include "bench_counters.h"
+
+#include "sds/flat_hash_map.h"
+#include "sds/string.h"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/** \file flat_hash_map_bench.cpp
+ * \brief sds::Flat_Hash_Map against std::unordered_map for integer and string keys.
+ */
+
+namespace
+{
+using Int_Key = sds::u64;
+using Str_Key = sds::String;
+
+template <typename K>
+K make_key(sds::u64 x);
+
+template <>
+Int_Key make_key<Int_Key>(sds::u64 x)
+{
+    return x;
+}
+
+template <>
+Str_Key make_key<Str_Key>(sds::u64 x)
+{
+    // Identifier-like keys: short enough for the inline buffer
+    return Str_Key(("key_" + std::to_string(x)).c_str());
+}
+
+template <typename K>
+std::vector<K> make_keys(size_t n, sds::u64 seed)
+{
+    std::mt19937_64 rng(seed);
+    std::vector<K> keys;
+    keys.reserve(n);
+    for (size_t i = 0; i < n; ++i) { keys.push_back(make_key<K>(rng())); }
+    return keys;
+}
+
+template <typename K>
+using Sds_Map = sds::Flat_Hash_Map<K, sds::u64>;
+
+// Same hash for both maps, so only the table layout is compared
+template <typename K>
+using Std_Map = std::unordered_map<K, sds::u64, sds::Hash<K>>;
+
+template <typename Map>
+Map make_map(std::vector<typename Map::key_type> const& keys)
+{
+    Map m;
+    for (size_t i = 0; i < keys.size(); ++i) { m.emplace(keys[i], i); }
+    return m;
+}
+} // namespace
+
+template <typename Map>
+static void BM_map_insert(benchmark::State& state)
+{
+    using K = typename Map::key_type;
+    std::vector<K> const keys = make_keys<K>(static_cast<size_t>(state.range(0)), 1);
+    for (auto _ : state) {
+        Map m;
+        for (size_t i = 0; i < keys.size(); ++i) { m.emplace(keys[i], i); }
+        benchmark::DoNotOptimize(m);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+template <typename Map>
+static void BM_map_find_hit(benchmark::State& state)
+{
+    using K = typename Map::key_type;
+    std::vector<K> keys = make_keys<K>(static_cast<size_t>(state.range(0)), 1);
+    Map const m = make_map<Map>(keys);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937_64(2));
+
+    size_t i = 0;
+    Bench_Counters const counters(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(m.find(keys[i]));
+        i = i + 1 == keys.size() ? 0 : i + 1;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+template <typename Map>
+static void BM_map_find_miss(benchmark::State& state)
+{
+    using K = typename Map::key_type;
+    Map const m = make_map<Map>(make_keys<K>(static_cast<size_t>(state.range(0)), 1));
+    std::vector<K> const missing = make_keys<K>(static_cast<size_t>(state.range(0)), 3);
+
+    size_t i = 0;
+    Bench_Counters const counters(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(m.find(missing[i]));
+        i = i + 1 == missing.size() ? 0 : i + 1;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+#define SDS_MAP_BENCH(bm, map)                                                                    \
+    BENCHMARK_TEMPLATE(bm, map<Int_Key>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);           \
+    BENCHMARK_TEMPLATE(bm, map<Str_Key>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20)
+
+SDS_MAP_BENCH(BM_map_insert, Sds_Map);
+SDS_MAP_BENCH(BM_map_insert, Std_Map);
+SDS_MAP_BENCH(BM_map_find_hit, Sds_Map);
+SDS_MAP_BENCH(BM_map_find_hit, Std_Map);
+SDS_MAP_BENCH(BM_map_find_miss, Sds_Map);
+SDS_MAP_BENCH(BM_map_find_miss, Std_Map);
@@ -0,0 +1,79 @@
+#include "benchmark/benchmark.h"
+
+#include "bench_counters.h"
+
+#include "sds/flat_map.h"
+#include <map>
+#include <random>
+#include <vector>
+
+/** \file flat_map_bench.cpp
+ * \brief sds::Flat_Map lookups against std::map.
+ */
+
+namespace
+{
+using Key = sds::u32;
+
+std::vector<Key> make_keys(size_t n)
+{
+    std::mt19937 rng(1);
+    std::vector<Key> keys(n);
+    for (Key& k : keys) { k = static_cast<Key>(rng()); }
+    return keys;
+}
+
+constexpr size_t num_probes = 4096; // power of 2
+
+/* Lookups in random order, half of them hits. */
+std::vector<Key> make_probes(std::vector<Key> const& keys)
+{
+    std::mt19937 rng(2);
+    std::vector<Key> probes(num_probes);
+    for (Key& k : probes) { k = rng() % 2 ? keys[rng() % keys.size()] : static_cast<Key>(rng()); }
+    return probes;
+}
+
+template <sds::Flat_Search search>
+using Flat = sds::Flat_Map<Key, Key, std::less<Key>, search>;
+using Flat_Binary = Flat<sds::Flat_Search::binary>;
+using Flat_Eytzinger = Flat<sds::Flat_Search::eytzinger>;
+using Std_Map = std::map<Key, Key>;
+} // namespace
+
+template <typename Map>
+static void BM_sorted_map_find(benchmark::State& state)
+{
+    std::vector<Key> const keys = make_keys(static_cast<size_t>(state.range(0)));
+    std::vector<Key> const probes = make_probes(keys);
+    std::vector<std::pair<Key, Key>> pairs;
+    for (Key k : keys) { pairs.emplace_back(k, k); }
+    Map const m(pairs.begin(), pairs.end());
+
+    size_t i = 0;
+    Bench_Counters const counters(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(m.find(probes[i]));
+        i = (i + 1) & (num_probes - 1);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK_TEMPLATE(BM_sorted_map_find, Flat_Binary)->RangeMultiplier(8)->Range(16, 1 << 20);
+BENCHMARK_TEMPLATE(BM_sorted_map_find, Flat_Eytzinger)->RangeMultiplier(8)->Range(16, 1 << 20);
+BENCHMARK_TEMPLATE(BM_sorted_map_find, Std_Map)->RangeMultiplier(8)->Range(16, 1 << 20);
+
+template <typename Map>
+static void BM_sorted_map_build(benchmark::State& state)
+{
+    std::vector<Key> const keys = make_keys(static_cast<size_t>(state.range(0)));
+    std::vector<std::pair<Key, Key>> pairs;
+    for (Key k : keys) { pairs.emplace_back(k, k); }
+
+    for (auto _ : state) {
+        Map m(pairs.begin(), pairs.end());
+        benchmark::DoNotOptimize(m);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_sorted_map_build, Flat_Binary)->RangeMultiplier(8)->Range(16, 1 << 20);
+BENCHMARK_TEMPLATE(BM_sorted_map_build, Std_Map)->RangeMultiplier(8)->Range(16, 1 << 20);
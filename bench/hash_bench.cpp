@@ -0,0 +1,66 @@
+#include "benchmark/benchmark.h"
+
+#include "sds/hash.h"
+#include <functional>
+#include <random>
+#include <string_view>
+#include <vector>
+
+/** \file hash_bench.cpp
+ * \brief sds::hash_bytes against std::hash across key lengths.
+ */
+
+namespace
+{
+std::vector<char> make_bytes(size_t n)
+{
+    std::mt19937_64 rng(1);
+    std::vector<char> v(n);
+    for (char& c : v) { c = static_cast<char>(rng()); }
+    return v;
+}
+} // namespace
+
+static void BM_hash_bytes(benchmark::State& state)
+{
+    std::vector<char> const bytes = make_bytes(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bytes.data());
+        benchmark::DoNotOptimize(sds::hash_bytes(bytes.data(), bytes.size()));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_hash_bytes)->RangeMultiplier(4)->Range(4, 1 << 20);
+
+static void BM_std_hash_string_view(benchmark::State& state)
+{
+    std::vector<char> const bytes = make_bytes(static_cast<size_t>(state.range(0)));
+    std::hash<std::string_view> const hasher;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bytes.data());
+        benchmark::DoNotOptimize(hasher(std::string_view(bytes.data(), bytes.size())));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_std_hash_string_view)->RangeMultiplier(4)->Range(4, 1 << 20);
+
+static void BM_hash_u64(benchmark::State& state)
+{
+    sds::u64 x = 0;
+    for (auto _ : state) {
+        x = sds::hash_u64(x);
+        benchmark::DoNotOptimize(x);
+    }
+}
+BENCHMARK(BM_hash_u64);
+
+static void BM_std_hash_u64(benchmark::State& state)
+{
+    std::hash<sds::u64> const hasher;
+    sds::u64 x = 0;
+    for (auto _ : state) {
+        x = hasher(x) + 1;
+        benchmark::DoNotOptimize(x);
+    }
+}
+BENCHMARK(BM_std_hash_u64);
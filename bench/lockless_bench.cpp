@@ -0,0 +1,175 @@
+#include "benchmark/benchmark.h"
+
+#include "sds/cache_aligned.h"
+#include "sds/lockless.h"
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <type_traits>
+
+/** \file lockless_bench.cpp
+ * \brief sds spin locks against std::mutex and std::shared_mutex, uncontended and under
+ * contention on a short critical section, and the cost of false sharing between per-thread
+ * counters and locks that sit on one cache line.
+ */
+
+namespace
+{
+/* Common aquire()/release() face over the sds and std lock spellings. */
+template <typename Lock>
+struct Exclusive {
+    static constexpr bool writes = true;
+    Lock lock{};
+
+    void aquire() { lock.aquire(); }
+    void release() { lock.release(); }
+};
+
+template <>
+struct Exclusive<sds::Reentrant_Spin_Lock32> {
+    static constexpr bool writes = true;
+    sds::Reentrant_Spin_Lock32 lock{};
+
+    void aquire() { lock.acquire(); }
+    void release() { lock.release(); }
+};
+
+template <>
+struct Exclusive<std::mutex> {
+    static constexpr bool writes = true;
+    std::mutex lock{};
+
+    void aquire() { lock.lock(); }
+    void release() { lock.unlock(); }
+};
+
+template <>
+struct Exclusive<std::shared_mutex> {
+    static constexpr bool writes = true;
+    std::shared_mutex lock{};
+
+    void aquire() { lock.lock(); }
+    void release() { lock.unlock(); }
+};
+
+template <typename Lock>
+struct Shared {
+    static constexpr bool writes = false;
+    Lock lock{};
+
+    void aquire() { lock.aquire_shared(); }
+    void release() { lock.release_shared(); }
+};
+
+template <>
+struct Shared<std::shared_mutex> {
+    static constexpr bool writes = false;
+    std::shared_mutex lock{};
+
+    void aquire() { lock.lock_shared(); }
+    void release() { lock.unlock_shared(); }
+};
+
+/* Shared by all threads of a run. Writers bump the counter, readers only load it. Padded so
+ * the counter and lock don't share a line with anything else. */
+template <typename Guard>
+struct alignas(sds::hardware_destructive_interference_size) Contended {
+    Guard guard{};
+    alignas(sds::hardware_destructive_interference_size) long counter = 0;
+};
+
+constexpr int max_threads = 16;
+
+template <typename Slot>
+std::atomic<sds::u64>& counter_of(Slot& s) noexcept
+{
+    if constexpr (std::is_same_v<Slot, std::atomic<sds::u64>>) {
+        return s;
+    } else {
+        return *s;
+    }
+}
+} // namespace
+
+template <typename Guard>
+static void BM_lock_uncontended(benchmark::State& state)
+{
+    Guard g;
+    long counter = 0;
+    for (auto _ : state) {
+        g.aquire();
+        ++counter;
+        benchmark::DoNotOptimize(counter);
+        g.release();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK_TEMPLATE(BM_lock_uncontended, Exclusive<sds::Spin_Lock>);
+BENCHMARK_TEMPLATE(BM_lock_uncontended, Exclusive<sds::Reentrant_Spin_Lock32>);
+BENCHMARK_TEMPLATE(BM_lock_uncontended, Exclusive<sds::Readers_Writer_Spin_Lock>);
+BENCHMARK_TEMPLATE(BM_lock_uncontended, Exclusive<std::mutex>);
+BENCHMARK_TEMPLATE(BM_lock_uncontended, Exclusive<std::shared_mutex>);
+BENCHMARK_TEMPLATE(BM_lock_uncontended, Shared<sds::Readers_Writer_Spin_Lock>);
+BENCHMARK_TEMPLATE(BM_lock_uncontended, Shared<std::shared_mutex>);
+
+template <typename Guard>
+static void BM_lock_contended(benchmark::State& state)
+{
+    static Contended<Guard> shared;
+    for (auto _ : state) {
+        shared.guard.aquire();
+        if constexpr (Guard::writes) { ++shared.counter; }
+        benchmark::DoNotOptimize(shared.counter);
+        shared.guard.release();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK_TEMPLATE(BM_lock_contended, Exclusive<sds::Spin_Lock>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_lock_contended, Exclusive<sds::Readers_Writer_Spin_Lock>)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_lock_contended, Exclusive<std::mutex>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_lock_contended, Shared<sds::Readers_Writer_Spin_Lock>)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_lock_contended, Shared<std::shared_mutex>)->ThreadRange(1, 16)->UseRealTime();
+
+/* Each thread only touches its own slot. Unpadded slots share lines, so the threads still
+ * contend for them. */
+template <typename Slot>
+static void BM_false_sharing_counters(benchmark::State& state)
+{
+    static Slot slots[max_threads];
+    std::atomic<sds::u64>& counter = counter_of(slots[state.thread_index()]);
+    for (auto _ : state) { counter.fetch_add(1, std::memory_order_relaxed); }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK_TEMPLATE(BM_false_sharing_counters, std::atomic<sds::u64>)
+    ->ThreadRange(1, max_threads)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_false_sharing_counters, sds::Cache_Aligned<std::atomic<sds::u64>>)
+    ->ThreadRange(1, max_threads)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_false_sharing_counters, sds::Padded<std::atomic<sds::u64>>)
+    ->ThreadRange(1, max_threads)
+    ->UseRealTime();
+
+template <typename Lock>
+static void BM_false_sharing_locks(benchmark::State& state)
+{
+    static Lock locks[max_threads];
+    Lock& lock = locks[state.thread_index()];
+    long counter = 0;
+    for (auto _ : state) {
+        sds::Scoped_Lock<sds::Spin_Lock> guard(lock);
+        ++counter;
+        benchmark::DoNotOptimize(counter);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK_TEMPLATE(BM_false_sharing_locks, sds::Spin_Lock)
+    ->ThreadRange(1, max_threads)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_false_sharing_locks, sds::Cache_Aligned_Lock<sds::Spin_Lock>)
+    ->ThreadRange(1, max_threads)
+    ->UseRealTime();
@@ -0,0 +1,41 @@
+#include "benchmark/benchmark.h"
+
+#include "sds/profile.h"
+#include <chrono>
+
+/** \file profile_bench.cpp
+ * \brief Cost of recording an sds::Profile_Scope zone against taking two steady clock readings.
+ */
+
+static void BM_profile_scope(benchmark::State& state)
+{
+    for (auto _ : state) {
+        sds::Profile_Scope const zone("zone");
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_profile_scope);
+BENCHMARK(BM_profile_scope)->Threads(4)->UseRealTime();
+
+static void BM_steady_clock_pair(benchmark::State& state)
+{
+    for (auto _ : state) {
+        auto const begin = std::chrono::steady_clock::now();
+        benchmark::ClobberMemory();
+        benchmark::DoNotOptimize(std::chrono::steady_clock::now() - begin);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_steady_clock_pair);
+
+static void BM_read_tsc_pair(benchmark::State& state)
+{
+    for (auto _ : state) {
+        sds::u64 const begin = sds::read_tsc();
+        benchmark::ClobberMemory();
+        benchmark::DoNotOptimize(sds::read_tsc() - begin);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_read_tsc_pair);
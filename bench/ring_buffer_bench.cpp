@@ -0,0 +1,91 @@
+#include "benchmark/benchmark.h"
+
+#include "sds/array/ring_buffer.h"
+#include <deque>
+#include <vector>
+
+/** \file ring_buffer_bench.cpp
+ * \brief Rolling window of recent samples: sds::Ring_Buffer against shifting a std::vector and
+ * std::deque.
+ */
+
+namespace
+{
+constexpr sds::sz window = 256;
+
+struct Sds_Window {
+    sds::Ring_Buffer<float, window> samples;
+
+    void push(float v) { samples.push_back(v); }
+    float oldest() const { return samples.front(); }
+};
+
+struct Vector_Window {
+    std::vector<float> samples = std::vector<float>(window, 0.0f);
+
+    void push(float v)
+    {
+        samples.erase(samples.begin());
+        samples.push_back(v);
+    }
+    float oldest() const { return samples.front(); }
+};
+
+struct Deque_Window {
+    std::deque<float> samples = std::deque<float>(window, 0.0f);
+
+    void push(float v)
+    {
+        samples.pop_front();
+        samples.push_back(v);
+    }
+    float oldest() const { return samples.front(); }
+};
+} // namespace
+
+template <typename Window>
+static void BM_rolling_window_push(benchmark::State& state)
+{
+    Window w;
+    float v = 0.0f;
+    for (auto _ : state) {
+        w.push(v);
+        v += 1.0f;
+        benchmark::DoNotOptimize(w.oldest());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK_TEMPLATE(BM_rolling_window_push, Sds_Window);
+BENCHMARK_TEMPLATE(BM_rolling_window_push, Vector_Window);
+BENCHMARK_TEMPLATE(BM_rolling_window_push, Deque_Window);
+
+/* Copy the window out in order, as when handing it to a filter. */
+static void BM_ring_buffer_copy_out(benchmark::State& state)
+{
+    sds::Ring_Buffer<float, window> r;
+    for (sds::sz i = 0; i < window + window / 3; ++i) { r.push_back(static_cast<float>(i)); }
+    float out[window];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(r.copy_to(out));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * window *
+                            static_cast<int64_t>(sizeof(float)));
+}
+BENCHMARK(BM_ring_buffer_copy_out);
+
+static void BM_ring_buffer_iterate_copy(benchmark::State& state)
+{
+    sds::Ring_Buffer<float, window> r;
+    for (sds::sz i = 0; i < window + window / 3; ++i) { r.push_back(static_cast<float>(i)); }
+    float out[window];
+    for (auto _ : state) {
+        float* o = out;
+        for (float const v : r) { *o++ = v; }
+        benchmark::DoNotOptimize(out);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * window *
+                            static_cast<int64_t>(sizeof(float)));
+}
+BENCHMARK(BM_ring_buffer_iterate_copy);
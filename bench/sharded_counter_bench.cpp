@@ -0,0 +1,82 @@
+#include "benchmark/benchmark.h"
+
+#include "sds/sharded_counter.h"
+#include <atomic>
+
+/** \file sharded_counter_bench.cpp
+ * \brief sds::Sharded_Counter against one shared std::atomic incremented from every thread, the
+ * cost of reading the sharded types, and histogram updates.
+ */
+
+namespace
+{
+struct Shared_Atomic {
+    std::atomic<sds::s64> value{0};
+
+    void add() noexcept { value.fetch_add(1, std::memory_order_relaxed); }
+};
+
+template <sds::Shard_Policy Policy>
+struct Sharded {
+    sds::Sharded_Counter counter{Policy};
+
+    void add() noexcept { counter.add(); }
+};
+} // namespace
+
+template <typename Counter>
+static void BM_counter_increment(benchmark::State& state)
+{
+    static Counter counter;
+    for (auto _ : state) { counter.add(); }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK_TEMPLATE(BM_counter_increment, Shared_Atomic)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_counter_increment, Sharded<sds::Shard_Policy::thread>)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_counter_increment, Sharded<sds::Shard_Policy::cpu>)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+static void BM_counter_read(benchmark::State& state)
+{
+    sds::Sharded_Counter counter;
+    counter.add();
+    for (auto _ : state) { benchmark::DoNotOptimize(counter.value()); }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_counter_read);
+
+static void BM_max_record(benchmark::State& state)
+{
+    static sds::Sharded_Max max;
+    sds::s64 v = 0;
+    for (auto _ : state) { max.record(++v); }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_max_record)->ThreadRange(1, 16)->UseRealTime();
+
+static void BM_histogram_record(benchmark::State& state)
+{
+    static sds::Sharded_Histogram histogram;
+    sds::u64 v = 1;
+    for (auto _ : state) {
+        v = v * 6364136223846793005ULL + 1442695040888963407ULL;
+        histogram.record(v >> 44);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_histogram_record)->ThreadRange(1, 16)->UseRealTime();
+
+static void BM_histogram_snapshot(benchmark::State& state)
+{
+    sds::Sharded_Histogram histogram;
+    histogram.record(100);
+    for (auto _ : state) {
+        sds::Histogram_Snapshot const s = histogram.snapshot();
+        benchmark::DoNotOptimize(s.percentile(0.99));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_histogram_snapshot);
@@ -0,0 +1,103 @@
+#include "benchmark/benchmark.h"
+
+#include "bench_counters.h"
+
+#include "sds/flat_hash_map.h"
+#include "sds/slot_map.h"
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+/** \file slot_map_bench.cpp
+ * \brief sds::Slot_Map handles against integer ids in a hash map, for objects that are created
+ * and destroyed at high rates.
+ */
+
+namespace
+{
+struct Object {
+    float position[3];
+    sds::u32 flags;
+};
+
+constexpr size_t num_lookups = 4096; // pow2 so the probe index can be masked
+
+/* Ids handed out by a counter, the usual alternative to a slot map. */
+template <typename Map>
+struct Id_Map {
+    Map map;
+    sds::u64 next_id = 0;
+
+    sds::u64 insert(Object const& o)
+    {
+        map.emplace(next_id, o);
+        return next_id++;
+    }
+    void erase(sds::u64 id) { map.erase(id); }
+    Object* find(sds::u64 id)
+    {
+        auto const it = map.find(id);
+        return it == map.end() ? nullptr : &it->second;
+    }
+};
+
+struct Sds_Slot_Map {
+    sds::Slot_Map<Object> map;
+
+    sds::Slot_Handle insert(Object const& o) { return map.insert(o); }
+    void erase(sds::Slot_Handle h) { map.erase(h); }
+    Object* find(sds::Slot_Handle h) { return map.find(h); }
+};
+
+using Std_Id_Map = Id_Map<std::unordered_map<sds::u64, Object, sds::Hash<sds::u64>>>;
+using Flat_Id_Map = Id_Map<sds::Flat_Hash_Map<sds::u64, Object>>;
+
+template <typename Container>
+auto fill(Container& c, size_t n)
+{
+    std::vector<decltype(c.insert(Object{}))> ids;
+    ids.reserve(n);
+    for (size_t i = 0; i < n; ++i) { ids.push_back(c.insert(Object{{0, 0, 0}, 0})); }
+    return ids;
+}
+} // namespace
+
+/* Destroy a random live object and create a new one, at a steady population. */
+template <typename Container>
+static void BM_object_churn(benchmark::State& state)
+{
+    Container c;
+    auto ids = fill(c, static_cast<size_t>(state.range(0)));
+    std::mt19937_64 rng(1);
+    size_t const mask = ids.size() - 1;
+    for (auto _ : state) {
+        size_t const i = rng() & mask;
+        c.erase(ids[i]);
+        ids[i] = c.insert(Object{{1, 2, 3}, 4});
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK_TEMPLATE(BM_object_churn, Sds_Slot_Map)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_object_churn, Flat_Id_Map)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_object_churn, Std_Id_Map)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
+
+template <typename Container>
+static void BM_object_lookup(benchmark::State& state)
+{
+    Container c;
+    auto const ids = fill(c, static_cast<size_t>(state.range(0)));
+    std::mt19937_64 rng(2);
+    std::vector<typename decltype(ids)::value_type> probes;
+    for (size_t i = 0; i < num_lookups; ++i) { probes.push_back(ids[rng() % ids.size()]); }
+
+    size_t i = 0;
+    Bench_Counters const counters(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(c.find(probes[i])->flags);
+        i = (i + 1) & (num_lookups - 1);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK_TEMPLATE(BM_object_lookup, Sds_Slot_Map)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_object_lookup, Flat_Id_Map)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_object_lookup, Std_Id_Map)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
@@ -0,0 +1,111 @@
+#include "benchmark/benchmark.h"
+
+#include "sds/array/soa_array.h"
+#include <vector>
+
+/** \file soa_array_bench.cpp
+ * \brief Scanning one or two fields of many records: sds::Soa_Array against an array of structs.
+ */
+
+namespace
+{
+struct Particle {
+    float x, y, z;
+    float vx, vy, vz;
+    sds::u32 id;
+    sds::u32 flags;
+};
+
+using Particle_Soa =
+    sds::Soa_Array<float, float, float, float, float, float, sds::u32, sds::u32>;
+
+std::vector<Particle> make_aos(size_t n)
+{
+    std::vector<Particle> v(n);
+    for (size_t i = 0; i < n; ++i) {
+        float const f = static_cast<float>(i & 1023);
+        v[i] = {f, f, f, 1.0f, 1.0f, 1.0f, static_cast<sds::u32>(i), 0};
+    }
+    return v;
+}
+
+Particle_Soa make_soa(size_t n)
+{
+    Particle_Soa s;
+    s.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        float const f = static_cast<float>(i & 1023);
+        s.push_back(f, f, f, 1.0f, 1.0f, 1.0f, static_cast<sds::u32>(i), sds::u32{0});
+    }
+    return s;
+}
+
+void set_bytes(benchmark::State& state, size_t bytes_per_record)
+{
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0) *
+                            static_cast<int64_t>(bytes_per_record));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+} // namespace
+
+/* Sum one field. Bytes processed counts the useful bytes only. Integer, so it vectorizes. */
+static void BM_scan_one_field_aos(benchmark::State& state)
+{
+    std::vector<Particle> const v = make_aos(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        sds::u64 sum = 0;
+        for (Particle const& p : v) { sum += p.id; }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_bytes(state, sizeof(sds::u32));
+}
+BENCHMARK(BM_scan_one_field_aos)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
+
+static void BM_scan_one_field_soa(benchmark::State& state)
+{
+    Particle_Soa const s = make_soa(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        sds::u64 sum = 0;
+        for (sds::u32 const id : s.column<6>()) { sum += id; }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_bytes(state, sizeof(sds::u32));
+}
+BENCHMARK(BM_scan_one_field_soa)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
+
+/* x += vx over every record. */
+static void BM_update_two_fields_aos(benchmark::State& state)
+{
+    std::vector<Particle> v = make_aos(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        for (Particle& p : v) { p.x += p.vx; }
+        benchmark::ClobberMemory();
+    }
+    set_bytes(state, 2 * sizeof(float));
+}
+BENCHMARK(BM_update_two_fields_aos)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
+
+static void BM_update_two_fields_soa(benchmark::State& state)
+{
+    Particle_Soa s = make_soa(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        sds::Span<float> const x = s.column<0>();
+        sds::Span<float const> const vx = s.column<3>();
+        for (size_t i = 0; i < x.size(); ++i) { x.data()[i] += vx.data()[i]; }
+        benchmark::ClobberMemory();
+    }
+    set_bytes(state, 2 * sizeof(float));
+}
+BENCHMARK(BM_update_two_fields_soa)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
+
+/* Same update through row proxies, to show their overhead against column spans. */
+static void BM_update_two_fields_soa_rows(benchmark::State& state)
+{
+    Particle_Soa s = make_soa(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        for (auto row : s) { std::get<0>(row) += std::get<3>(row); }
+        benchmark::ClobberMemory();
+    }
+    set_bytes(state, 2 * sizeof(float));
+}
+BENCHMARK(BM_update_two_fields_soa_rows)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
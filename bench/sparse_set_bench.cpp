@@ -0,0 +1,134 @@
+#include "benchmark/benchmark.h"
+
+#include "bench_counters.h"
+
+#include "sds/bit.h"
+#include "sds/sparse_set.h"
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+/** \file sparse_set_bench.cpp
+ * \brief sds::Sparse_Set membership, iteration and intersection against std::unordered_set and a
+ * plain bitmap over the same id space.
+ */
+
+namespace
+{
+constexpr sds::u32 id_space = 1 << 22;
+constexpr size_t num_probes = 4096; // pow2 so the probe index can be masked
+
+std::vector<sds::u32> make_ids(size_t n, sds::u64 seed)
+{
+    std::mt19937_64 rng(seed);
+    std::vector<sds::u32> ids(n);
+    for (sds::u32& id : ids) { id = static_cast<sds::u32>(rng() & (id_space - 1)); }
+    return ids;
+}
+
+struct Sds_Set {
+    sds::Sparse_Set<> set;
+
+    void insert(sds::u32 id) { set.insert(id); }
+    bool contains(sds::u32 id) const { return set.contains(id); }
+    template <typename F>
+    void for_each(F&& f) const
+    {
+        for (sds::u32 const id : set) { f(id); }
+    }
+};
+
+struct Std_Set {
+    std::unordered_set<sds::u32> set;
+
+    void insert(sds::u32 id) { set.insert(id); }
+    bool contains(sds::u32 id) const { return set.count(id) != 0; }
+    template <typename F>
+    void for_each(F&& f) const
+    {
+        for (sds::u32 const id : set) { f(id); }
+    }
+};
+
+/* One bit per id. Iteration scans every word of the id space. */
+struct Bitmap_Set {
+    std::vector<sds::u64> words = std::vector<sds::u64>(id_space / 64, 0);
+
+    void insert(sds::u32 id) { words[id / 64] |= sds::u64{1} << (id % 64); }
+    bool contains(sds::u32 id) const { return (words[id / 64] >> (id % 64)) & 1; }
+    template <typename F>
+    void for_each(F&& f) const
+    {
+        for (size_t w = 0; w < words.size(); ++w) {
+            for (sds::u64 bits = words[w]; bits != 0; bits &= bits - 1) {
+                f(static_cast<sds::u32>(w * 64 + static_cast<size_t>(
+                                                     sds::count_trailing_zeros(bits))));
+            }
+        }
+    }
+};
+
+template <typename Set>
+Set make_set(size_t n, sds::u64 seed)
+{
+    Set s;
+    for (sds::u32 const id : make_ids(n, seed)) { s.insert(id); }
+    return s;
+}
+} // namespace
+
+template <typename Set>
+static void BM_id_set_contains(benchmark::State& state)
+{
+    Set const s = make_set<Set>(static_cast<size_t>(state.range(0)), 1);
+    std::vector<sds::u32> const probes = make_ids(num_probes, 2);
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(s.contains(probes[i]));
+        i = (i + 1) & (num_probes - 1);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK_TEMPLATE(BM_id_set_contains, Sds_Set)->RangeMultiplier(64)->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(BM_id_set_contains, Std_Set)->RangeMultiplier(64)->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(BM_id_set_contains, Bitmap_Set)->RangeMultiplier(64)->Range(1 << 8, 1 << 20);
+
+template <typename Set>
+static void BM_id_set_iterate(benchmark::State& state)
+{
+    Set const s = make_set<Set>(static_cast<size_t>(state.range(0)), 1);
+    Bench_Counters const counters(state);
+    for (auto _ : state) {
+        sds::u64 sum = 0;
+        s.for_each([&sum](sds::u32 id) { sum += id; });
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_id_set_iterate, Sds_Set)->RangeMultiplier(64)->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(BM_id_set_iterate, Std_Set)->RangeMultiplier(64)->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(BM_id_set_iterate, Bitmap_Set)->RangeMultiplier(64)->Range(1 << 8, 1 << 20);
+
+/* A small set intersected with a large one, as when filtering by a rare component. */
+static void BM_sparse_set_intersection(benchmark::State& state)
+{
+    sds::Sparse_Set<> const large = make_set<Sds_Set>(1 << 20, 1).set;
+    sds::Sparse_Set<> const small = make_set<Sds_Set>(static_cast<size_t>(state.range(0)), 3).set;
+    for (auto _ : state) {
+        size_t count = 0;
+        for_each_intersection(large, small, [&count](sds::u32) { ++count; });
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_sparse_set_intersection)->RangeMultiplier(16)->Range(1 << 6, 1 << 14);
+
+/* Same, building the result set. Each result id can touch a fresh sparse page. */
+static void BM_sparse_set_intersection_build(benchmark::State& state)
+{
+    sds::Sparse_Set<> const large = make_set<Sds_Set>(1 << 20, 1).set;
+    sds::Sparse_Set<> const small = make_set<Sds_Set>(static_cast<size_t>(state.range(0)), 3).set;
+    for (auto _ : state) { benchmark::DoNotOptimize(intersection(large, small).size()); }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_sparse_set_intersection_build)->RangeMultiplier(16)->Range(1 << 6, 1 << 14);
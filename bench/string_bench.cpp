@@ -0,0 +1,250 @@
+#include "benchmark/benchmark.h"
+
+#include "sds/string.h"
+#include <cstring>
+#include <string>
+#include <string_view>
+
+/** \file string_bench.cpp
+ * \brief String kernels against their libc counterparts, sds::String against std::string.
+ */
+
+namespace
+{
+void string_lengths(benchmark::internal::Benchmark* b)
+{
+    for (int len : {8, 16, 32, 64, 256, 1024, 4096}) { b->Arg(len); }
+}
+
+std::string make_key(benchmark::State const& state)
+{
+    return std::string(static_cast<size_t>(state.range(0)), 'k');
+}
+
+void set_bytes_processed(benchmark::State& state)
+{
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+} // namespace
+
+static void BM_sds_str_size(benchmark::State& state)
+{
+    std::string const key = make_key(state);
+    char const* p = key.c_str();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(p);
+        benchmark::DoNotOptimize(sds::str_size(p));
+    }
+    set_bytes_processed(state);
+}
+BENCHMARK(BM_sds_str_size)->Apply(string_lengths);
+
+static void BM_byte_loop_str_size(benchmark::State& state)
+{
+    // Reference: the previous one byte per iteration implementation
+    std::string const key = make_key(state);
+    char const* p = key.c_str();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(p);
+        char const* q = p;
+        while (*q != '\0') {
+            benchmark::DoNotOptimize(q);
+            ++q;
+        }
+        benchmark::DoNotOptimize(q - p);
+    }
+    set_bytes_processed(state);
+}
+BENCHMARK(BM_byte_loop_str_size)->Apply(string_lengths);
+
+static void BM_libc_strlen(benchmark::State& state)
+{
+    std::string const key = make_key(state);
+    char const* p = key.c_str();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(p);
+        benchmark::DoNotOptimize(std::strlen(p));
+    }
+    set_bytes_processed(state);
+}
+BENCHMARK(BM_libc_strlen)->Apply(string_lengths);
+
+static void BM_sds_ascii_cmp(benchmark::State& state)
+{
+    std::string const a = make_key(state);
+    std::string const b = make_key(state);
+    char const* pa = a.c_str();
+    char const* pb = b.c_str();
+    auto const len = static_cast<sds::s32>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pa);
+        benchmark::DoNotOptimize(sds::ascii_cmp(pa, pb, len));
+    }
+    set_bytes_processed(state);
+}
+BENCHMARK(BM_sds_ascii_cmp)->Apply(string_lengths);
+
+static void BM_libc_strncmp(benchmark::State& state)
+{
+    std::string const a = make_key(state);
+    std::string const b = make_key(state);
+    char const* pa = a.c_str();
+    char const* pb = b.c_str();
+    auto const len = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pa);
+        benchmark::DoNotOptimize(std::strncmp(pa, pb, len) == 0);
+    }
+    set_bytes_processed(state);
+}
+BENCHMARK(BM_libc_strncmp)->Apply(string_lengths);
+
+namespace
+{
+void key_lengths(benchmark::internal::Benchmark* b)
+{
+    for (int len : {8, 15, 16, 23, 32, 64}) { b->Arg(len); }
+}
+} // namespace
+
+template <typename String>
+static void BM_construct_key(benchmark::State& state)
+{
+    std::string const key = make_key(state);
+    char const* p = key.c_str();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(p);
+        String s(p);
+        benchmark::DoNotOptimize(s.data());
+    }
+}
+BENCHMARK_TEMPLATE(BM_construct_key, sds::String)->Apply(key_lengths);
+BENCHMARK_TEMPLATE(BM_construct_key, std::string)->Apply(key_lengths);
+
+template <typename String>
+static void BM_copy_key(benchmark::State& state)
+{
+    String const key(make_key(state).c_str());
+    for (auto _ : state) {
+        String s(key);
+        benchmark::DoNotOptimize(s.data());
+    }
+}
+BENCHMARK_TEMPLATE(BM_copy_key, sds::String)->Apply(key_lengths);
+BENCHMARK_TEMPLATE(BM_copy_key, std::string)->Apply(key_lengths);
+
+template <typename String>
+static void BM_append_key(benchmark::State& state)
+{
+    auto const len = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        String s;
+        for (int i = 0; i < len; ++i) { s += static_cast<char>('a' + (i & 15)); }
+        benchmark::DoNotOptimize(s.data());
+    }
+}
+BENCHMARK_TEMPLATE(BM_append_key, sds::String)->Apply(key_lengths);
+BENCHMARK_TEMPLATE(BM_append_key, std::string)->Apply(key_lengths);
+
+namespace
+{
+void search_lengths(benchmark::internal::Benchmark* b)
+{
+    for (int len : {16, 64, 256, 4096, 1 << 20}) { b->Arg(len); }
+}
+} // namespace
+
+// Search for a match at the very end of the buffer
+
+static void BM_sds_find_char(benchmark::State& state)
+{
+    std::string hay = make_key(state);
+    hay.back() = '!';
+    sds::String_View const v(hay.data(), hay.size());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(v.data());
+        benchmark::DoNotOptimize(v.find('!'));
+    }
+    set_bytes_processed(state);
+}
+BENCHMARK(BM_sds_find_char)->Apply(search_lengths);
+
+static void BM_libc_memchr(benchmark::State& state)
+{
+    std::string hay = make_key(state);
+    hay.back() = '!';
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(hay.data());
+        benchmark::DoNotOptimize(std::memchr(hay.data(), '!', hay.size()));
+    }
+    set_bytes_processed(state);
+}
+BENCHMARK(BM_libc_memchr)->Apply(search_lengths);
+
+static void BM_sds_find_first_of(benchmark::State& state)
+{
+    std::string hay = make_key(state);
+    hay.back() = '\n';
+    sds::String_View const v(hay.data(), hay.size());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(v.data());
+        benchmark::DoNotOptimize(v.find_first_of(" \t\r\n,;"));
+    }
+    set_bytes_processed(state);
+}
+BENCHMARK(BM_sds_find_first_of)->Apply(search_lengths);
+
+static void BM_std_find_first_of(benchmark::State& state)
+{
+    std::string hay = make_key(state);
+    hay.back() = '\n';
+    std::string_view const v(hay);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(v.data());
+        benchmark::DoNotOptimize(v.find_first_of(" \t\r\n,;"));
+    }
+    set_bytes_processed(state);
+}
+BENCHMARK(BM_std_find_first_of)->Apply(search_lengths);
+
+static void BM_sds_find_substr(benchmark::State& state)
+{
+    std::string hay = make_key(state);
+    hay.replace(hay.size() - 4, 4, "kkey");
+    sds::String_View const v(hay.data(), hay.size());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(v.data());
+        benchmark::DoNotOptimize(v.find("key"));
+    }
+    set_bytes_processed(state);
+}
+BENCHMARK(BM_sds_find_substr)->Apply(search_lengths);
+
+static void BM_std_find_substr(benchmark::State& state)
+{
+    std::string hay = make_key(state);
+    hay.replace(hay.size() - 4, 4, "kkey");
+    std::string_view const v(hay);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(v.data());
+        benchmark::DoNotOptimize(v.find("key"));
+    }
+    set_bytes_processed(state);
+}
+BENCHMARK(BM_std_find_substr)->Apply(search_lengths);
+
+static void BM_sds_split_lines(benchmark::State& state)
+{
+    // 1 MB of 80 character lines
+    std::string text;
+    while (text.size() < (1 << 20)) { text.append(79, 'x').push_back('\n'); }
+    sds::String_View const v(text.data(), text.size());
+    for (auto _ : state) {
+        size_t total = 0;
+        for (sds::String_View line : v.split('\n')) { total += line.size(); }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            static_cast<int64_t>(text.size()));
+}
+BENCHMARK(BM_sds_split_lines);
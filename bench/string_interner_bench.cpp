@@ -0,0 +1,77 @@
+#include "benchmark/benchmark.h"
+
+#include "sds/string.h"
+#include "sds/string_interner.h"
+#include <string>
+#include <vector>
+
+/** \file string_interner_bench.cpp
+ * \brief Interned handle comparison against string comparison.
+ */
+
+namespace
+{
+constexpr int num_identifiers = 4096;
+
+std::vector<std::string> make_identifiers()
+{
+    std::vector<std::string> ids;
+    ids.reserve(num_identifiers);
+    for (int i = 0; i < num_identifiers; ++i) {
+        ids.push_back("namespace::component_identifier_" + std::to_string(i));
+    }
+    return ids;
+}
+} // namespace
+
+static void BM_ascii_cmp_identifiers(benchmark::State& state)
+{
+    std::vector<std::string> const ids = make_identifiers();
+    std::vector<std::string> const probes = make_identifiers();
+    size_t i = 0;
+    for (auto _ : state) {
+        // Equal identifiers: the whole string has to be compared
+        bool const eq = sds::ascii_cmp(ids[i].c_str(), probes[i].c_str());
+        benchmark::DoNotOptimize(eq);
+        i = (i + 1) % num_identifiers;
+    }
+}
+BENCHMARK(BM_ascii_cmp_identifiers);
+
+static void BM_interned_identifiers(benchmark::State& state)
+{
+    std::vector<std::string> const ids = make_identifiers();
+    sds::String_Interner pool;
+    std::vector<sds::Interned_String> a;
+    std::vector<sds::Interned_String> b;
+    for (std::string const& s : ids) {
+        a.push_back(pool.intern(sds::String_View(s.data(), s.size())));
+        b.push_back(pool.intern(sds::String_View(s.data(), s.size())));
+    }
+
+    size_t i = 0;
+    for (auto _ : state) {
+        bool const eq = a[i] == b[i];
+        benchmark::DoNotOptimize(eq);
+        i = (i + 1) % num_identifiers;
+    }
+}
+BENCHMARK(BM_interned_identifiers);
+
+static void BM_intern_existing(benchmark::State& state)
+{
+    static sds::String_Interner pool;
+    std::vector<std::string> const ids = make_identifiers();
+    for (std::string const& s : ids) {
+        benchmark::DoNotOptimize(pool.intern(sds::String_View(s.data(), s.size())));
+    }
+
+    size_t i = static_cast<size_t>(state.thread_index()) * 97;
+    for (auto _ : state) {
+        std::string const& s = ids[i % num_identifiers];
+        benchmark::DoNotOptimize(pool.intern(sds::String_View(s.data(), s.size())));
+        ++i;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_intern_existing)->ThreadRange(1, 16)->UseRealTime();
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "sds/details/common.h"
+
+#include "sds/cache_aligned.h"
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace sds
+{
+/**
+ * \brief Stateless allocator that aligns every allocation to \a Alignment bytes.
+ *
+ * For containers whose elements are streamed with SIMD loads or should not share a cache line
+ * with unrelated data. The alignment used is the larger of \a Alignment and `alignof(T)`.
+ *
+ * \tparam T Element type.
+ * \tparam Alignment Minimum alignment in bytes. Power of 2. A cache line by default.
+ */
+template <typename T, size_t Alignment = hardware_destructive_interference_size>
+class Aligned_Allocator {
+    SDS_STATIC_ASSERT(Alignment != 0 && (Alignment & (Alignment - 1)) == 0);
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using is_always_equal = std::true_type;
+
+    static constexpr size_t alignment = Alignment > alignof(T) ? Alignment : alignof(T);
+
+    template <typename U>
+    struct rebind {
+        using other = Aligned_Allocator<U, Alignment>;
+    };
+
+    constexpr Aligned_Allocator() noexcept = default;
+    template <typename U>
+    constexpr Aligned_Allocator(Aligned_Allocator<U, Alignment> const&) noexcept
+    {}
+
+    [[nodiscard]] T* allocate(size_t n)
+    {
+        if (n > static_cast<size_t>(-1) / sizeof(T)) { throw std::bad_array_new_length(); }
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignment)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept
+    {
+        ::operator delete(p, n * sizeof(T), std::align_val_t(alignment));
+    }
+
+    template <typename U>
+    friend constexpr bool operator==(Aligned_Allocator const&,
+                                     Aligned_Allocator<U, Alignment> const&) noexcept
+    {
+        return true;
+    }
+    template <typename U>
+    friend constexpr bool operator!=(Aligned_Allocator const&,
+                                     Aligned_Allocator<U, Alignment> const&) noexcept
+    {
+        return false;
+    }
+};
+} // namespace sds
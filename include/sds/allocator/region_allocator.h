@@ -0,0 +1,214 @@
+#pragma once
+
+/**
+ * \file region_allocator.h
+ * \brief Page mapped memory regions for large buffers, backed by huge pages and placed on a chosen
+ * NUMA node.
+ *
+ * A buffer of several GB in 4 KiB pages needs far more TLB entries than the CPU has, so random
+ * access pays a page walk on most loads. 2 MiB pages cut that by 512 times. On multi-socket hosts
+ * the pages should also sit on the node of the threads that use them.
+ *
+ * Usage:
+ *   sds::Region_Options options;
+ *   options.numa_node = 1;
+ *   sds::Dynamic_Array<u64, sds::Region_Allocator<u64>> table{sds::Region_Allocator<u64>(options)};
+ *   table.resize(u64{1} << 30);
+ *
+ *   auto bits = sds::make_region_unique<sds::Bitarray<(1 << 30)>>(options);
+ *
+ * Everything degrades: explicit huge pages fall back to transparent ones, transparent ones to
+ * normal pages, and the NUMA placement is skipped where the kernel refuses it. Outside Linux
+ * regions are plain aligned allocations.
+ */
+
+#include "sds/details/common.h"
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace sds
+{
+enum class Page_Size : u32 {
+    normal = 0,
+    /* madvise(MADV_HUGEPAGE). The kernel backs the region with huge pages as it can, which
+     * requires transparent huge pages in "madvise" or "always" mode. */
+    transparent_huge,
+    /* mmap(MAP_HUGETLB) from the pages reserved in /proc/sys/vm/nr_hugepages. Guaranteed huge
+     * pages, but only as many as the administrator reserved. */
+    huge,
+};
+
+char const* to_string(Page_Size p) noexcept;
+
+/**
+ * \brief Granularity of regions that ask for huge pages.
+ */
+inline constexpr size_t huge_page_size = 2 * 1024 * 1024;
+
+struct Region_Options {
+    Page_Size pages = Page_Size::transparent_huge;
+    /* NUMA node to place the pages on, or -1 for the thread's default policy. The node is
+     * preferred, so pages go to other nodes once it is full. */
+    s32 numa_node = -1;
+    /* Region_Allocator sends smaller allocations to ::operator new, where rounding up to whole
+     * pages would waste memory. */
+    size_t min_bytes = huge_page_size / 2;
+
+    [[nodiscard]] friend bool operator==(Region_Options const& a, Region_Options const& b) noexcept
+    {
+        return a.pages == b.pages && a.numa_node == b.numa_node && a.min_bytes == b.min_bytes;
+    }
+    [[nodiscard]] friend bool operator!=(Region_Options const& a, Region_Options const& b) noexcept
+    {
+        return !(a == b);
+    }
+};
+
+/**
+ * \brief What a region actually got.
+ */
+struct Region_Info {
+    Page_Size pages = Page_Size::normal;
+    bool numa_bound = false;
+};
+
+/**
+ * \brief Map a region of at least \a bytes. Page aligned, and huge page aligned when huge pages
+ * are asked for. The memory is zero.
+ *
+ * \param info Receives what the region got.
+ * \throw std::bad_alloc
+ */
+[[nodiscard]] void* region_allocate(size_t bytes, Region_Options const& options = {},
+                                    Region_Info* info = nullptr);
+
+/**
+ * \brief Unmap a region from \a region_allocate.
+ *
+ * \param bytes Size passed to \a region_allocate.
+ * \param options Options passed to \a region_allocate.
+ */
+void region_deallocate(void* p, size_t bytes, Region_Options const& options = {}) noexcept;
+
+/**
+ * \brief Number of NUMA nodes of the host, 1 if unknown.
+ */
+[[nodiscard]] s32 numa_node_count() noexcept;
+
+/**
+ * \brief NUMA node of the page holding \a p, or -1 if unknown. The page must have been touched.
+ */
+[[nodiscard]] s32 numa_node_of(void const* p) noexcept;
+
+/**
+ * \brief Allocator that maps allocations of at least \a Region_Options::min_bytes as regions.
+ *
+ * Allocators compare equal when their options are equal.
+ *
+ * \tparam T Element type.
+ */
+template <typename T>
+class Region_Allocator {
+    template <typename U>
+    friend class Region_Allocator;
+
+    static constexpr bool over_aligned = alignof(T) > alignof(std::max_align_t);
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using is_always_equal = std::false_type;
+
+    template <typename U>
+    struct rebind {
+        using other = Region_Allocator<U>;
+    };
+
+    Region_Allocator() noexcept = default;
+    explicit Region_Allocator(Region_Options const& options) noexcept : m_options(options) {}
+    template <typename U>
+    Region_Allocator(Region_Allocator<U> const& o) noexcept : m_options(o.m_options)
+    {}
+
+    [[nodiscard]] T* allocate(size_t n)
+    {
+        if (n > static_cast<size_t>(-1) / sizeof(T)) { throw std::bad_array_new_length(); }
+        size_t const bytes = n * sizeof(T);
+        if (bytes >= m_options.min_bytes) {
+            return static_cast<T*>(sds::region_allocate(bytes, m_options));
+        }
+        if constexpr (over_aligned) {
+            return static_cast<T*>(::operator new(bytes, std::align_val_t(alignof(T))));
+        } else {
+            return static_cast<T*>(::operator new(bytes));
+        }
+    }
+
+    void deallocate(T* p, size_t n) noexcept
+    {
+        size_t const bytes = n * sizeof(T);
+        if (bytes >= m_options.min_bytes) {
+            sds::region_deallocate(p, bytes, m_options);
+        } else if constexpr (over_aligned) {
+            ::operator delete(p, bytes, std::align_val_t(alignof(T)));
+        } else {
+            ::operator delete(p, bytes);
+        }
+    }
+
+    [[nodiscard]] Region_Options const& options() const noexcept { return m_options; }
+
+    template <typename U>
+    friend bool operator==(Region_Allocator const& a, Region_Allocator<U> const& b) noexcept
+    {
+        return a.options() == b.options();
+    }
+    template <typename U>
+    friend bool operator!=(Region_Allocator const& a, Region_Allocator<U> const& b) noexcept
+    {
+        return !(a == b);
+    }
+
+private:
+    Region_Options m_options{};
+};
+
+/**
+ * \brief Deleter of objects made by \a make_region_unique.
+ */
+template <typename T>
+struct Region_Deleter {
+    Region_Options options{};
+
+    void operator()(T* p) const noexcept
+    {
+        p->~T();
+        sds::region_deallocate(p, sizeof(T), options);
+    }
+};
+
+template <typename T>
+using Region_Ptr = std::unique_ptr<T, Region_Deleter<T>>;
+
+/**
+ * \brief Construct a \a T in a region of its own. For large fixed size objects, ex. a
+ * \a Bitarray of billions of bits.
+ */
+template <typename T, typename... Args>
+[[nodiscard]] Region_Ptr<T> make_region_unique(Region_Options const& options, Args&&... args)
+{
+    SDS_STATIC_ASSERT(alignof(T) <= 4096);
+    void* const p = sds::region_allocate(sizeof(T), options);
+    try {
+        return Region_Ptr<T>(new (p) T(std::forward<Args>(args)...), Region_Deleter<T>{options});
+    } catch (...) {
+        sds::region_deallocate(p, sizeof(T), options);
+        throw;
+    }
+}
+} // namespace sds
@@ -0,0 +1,309 @@
+#pragma once
+
+/**
+ * \file stack_allocator.h
+ * \brief LIFO arena for scratch memory that lives for one function call.
+ *
+ * Allocating bumps a pointer past the alignment padding. Nothing is freed individually; a
+ * \a Stack_Scope releases everything allocated since it was opened. Each thread has a default
+ * arena, so scratch memory needs no plumbing:
+ *
+ *   void build_mesh(Span<Vertex const> in)
+ *   {
+ *       sds::Stack_Scope const scratch;
+ *       sds::Dynamic_Array<u32, sds::Stack_Allocator<u32>> indices;
+ *       indices.reserve(in.size());
+ *       ...
+ *   } // indices and everything else allocated in the scope is released
+ *
+ * An arena with canaries follows each allocation with a canary that is checked when the
+ * allocation is released, and overwrites released memory, so overruns and use after release fail
+ * fast. A broken canary aborts, whether or not the library was built with NDEBUG. Arenas have
+ * canaries by default when the library is built without NDEBUG.
+ */
+
+#include "sds/details/common.h"
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+namespace sds
+{
+/**
+ * \brief Position in a \a Stack_Arena to rewind to.
+ */
+struct Stack_Marker {
+    void* block = nullptr;
+    char* top = nullptr;
+    void* last = nullptr; // most recent allocation, when canaries are on
+};
+
+/**
+ * \brief Arena that hands out memory in LIFO order from a chain of blocks.
+ *
+ * Grows by another block when the current one is full. Blocks are kept after a rewind and reused,
+ * so a warmed up arena no longer allocates. Not thread safe; see \a thread_stack_arena.
+ */
+class Stack_Arena {
+public:
+    static constexpr size_t default_block_size = 64 * 1024;
+
+    /**
+     * \param block_size Size of the blocks the arena grows by. Larger allocations get a block of
+     * their own size.
+     * \param canaries Guard allocations with canaries.
+     */
+    explicit Stack_Arena(size_t block_size = default_block_size,
+                         bool canaries = canaries_by_default()) noexcept
+        : m_block_size(block_size), m_canaries(canaries)
+    {}
+    ~Stack_Arena();
+
+    Stack_Arena(Stack_Arena const&) = delete;
+    Stack_Arena& operator=(Stack_Arena const&) = delete;
+
+    /**
+     * \brief Whether arenas get canaries when not told otherwise. True unless the library was built
+     * with NDEBUG.
+     *
+     * NOTE(sdsmith): Decided where the library is built rather than in each translation unit, so
+     * code built with and without NDEBUG agrees on how a shared arena is laid out.
+     */
+    [[nodiscard]] static bool canaries_by_default() noexcept;
+
+    /**
+     * \param alignment Power of 2.
+     * \throw std::bad_alloc When a new block can't be allocated.
+     */
+    [[nodiscard]] void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t))
+    {
+        SDS_ASSERT(alignment != 0 && (alignment & (alignment - 1)) == 0);
+        for (;;) {
+            if (void* const p = try_allocate(bytes, alignment)) { return p; }
+            grow(bytes + alignment + overhead());
+        }
+    }
+
+    /**
+     * \brief Release \a p if it is the most recent allocation. Otherwise it is released by the
+     * next rewind past it.
+     */
+    void deallocate(void* p, size_t bytes) noexcept
+    {
+        // The top allocation is in an earlier block when the current one is empty. Leave it to
+        // a rewind.
+        if (!p || m_top == m_block->begin()) { return; }
+        if (m_canaries) {
+            if (p != m_last) { return; }
+            Canary_Header const h = *header_of(p); // the fill overwrites it
+            SDS_ASSERT(h.bytes == bytes && "deallocate size differs from allocate size");
+            check_canaries(h.prev);
+            fill_released(h.prev_top, m_top);
+            m_top = h.prev_top;
+            m_last = h.prev;
+            return;
+        }
+        char* const c = static_cast<char*>(p);
+        if (c + bytes == m_top) { m_top = c; }
+    }
+
+    [[nodiscard]] Stack_Marker mark() const noexcept { return {m_block, m_top, m_last}; }
+
+    /**
+     * \brief Release everything allocated since \a m was taken.
+     */
+    void rewind(Stack_Marker const& m) noexcept
+    {
+        // Marked before the first allocation: back to the start of the first block
+        Block* const target = m.block ? static_cast<Block*>(m.block) : first_block();
+        if (!target) { return; }
+        char* const top = m.block ? m.top : target->begin();
+        if (m_canaries) {
+            check_canaries(m.last);
+            for (Block* b = target;; b = b->next) {
+                fill_released(b == target ? top : b->begin(), b == m_block ? m_top : b->end());
+                if (b == m_block) { break; }
+            }
+        }
+        m_block = target;
+        m_top = top;
+        m_end = target->end();
+        m_last = m.last;
+    }
+
+    /**
+     * \brief Bytes in blocks before the current position, including alignment padding and
+     * unused block ends.
+     */
+    [[nodiscard]] size_t used() const noexcept;
+    /**
+     * \brief Bytes in blocks held by the arena.
+     */
+    [[nodiscard]] size_t reserved() const noexcept;
+
+    [[nodiscard]] bool canaries() const noexcept { return m_canaries; }
+
+private:
+    struct alignas(std::max_align_t) Block {
+        Block* prev = nullptr;
+        Block* next = nullptr; // kept after a rewind for reuse
+        size_t size = 0;       // bytes after the header
+
+        char* begin() noexcept { return reinterpret_cast<char*>(this) + sizeof(Block); }
+        char* end() noexcept { return begin() + size; }
+    };
+
+    struct Canary_Header {
+        void* prev = nullptr; // allocation before this one
+        char* prev_top = nullptr;
+        size_t bytes = 0;
+    };
+    static constexpr unsigned char canary[8] = {0xca, 0x4a, 0x21, 0xe5, 0xca, 0x4a, 0x21, 0xe5};
+    static constexpr int released_fill = 0xdd;
+
+    static Canary_Header* header_of(void* p) noexcept
+    {
+        return reinterpret_cast<Canary_Header*>(static_cast<char*>(p) - sizeof(Canary_Header));
+    }
+
+    /* Check the canaries of the allocations after \a last. */
+    void check_canaries(void* last) const noexcept;
+
+    static void fill_released(char* from, char* to) noexcept
+    {
+        std::memset(from, released_fill, static_cast<size_t>(to - from));
+    }
+
+    size_t overhead() const noexcept
+    {
+        return m_canaries ? sizeof(Canary_Header) + sizeof(canary) : 0;
+    }
+
+    size_t m_block_size = default_block_size;
+    bool m_canaries = false;
+    Block* m_block = nullptr;
+    char* m_top = nullptr;
+    char* m_end = nullptr;
+    void* m_last = nullptr; // only used with canaries
+
+    static char* align_up(char* p, size_t alignment) noexcept
+    {
+        uintptr_t const a = reinterpret_cast<uintptr_t>(p);
+        return p + ((alignment - (a & (alignment - 1))) & (alignment - 1));
+    }
+
+    void* try_allocate(size_t bytes, size_t alignment) noexcept
+    {
+        if (!m_top) { return nullptr; }
+        if (m_canaries) {
+            if (alignment < alignof(Canary_Header)) { alignment = alignof(Canary_Header); }
+            char* const p = align_up(m_top + sizeof(Canary_Header), alignment);
+            if (p > m_end || static_cast<size_t>(m_end - p) < sizeof(canary) ||
+                static_cast<size_t>(m_end - p) - sizeof(canary) < bytes) {
+                return nullptr;
+            }
+            Canary_Header* const h = header_of(p);
+            h->prev = m_last;
+            h->prev_top = m_top;
+            h->bytes = bytes;
+            std::memcpy(p + bytes, canary, sizeof(canary));
+            m_last = p;
+            m_top = p + bytes + sizeof(canary);
+            return p;
+        }
+        char* const p = align_up(m_top, alignment);
+        if (p > m_end || static_cast<size_t>(m_end - p) < bytes) { return nullptr; }
+        m_top = p + bytes;
+        return p;
+    }
+
+    /* Move to a block with room for \a min_bytes. */
+    void grow(size_t min_bytes);
+    [[nodiscard]] Block* first_block() const noexcept;
+};
+
+/**
+ * \brief Arena of the calling thread. Created on first use, released when the thread exits.
+ */
+[[nodiscard]] Stack_Arena& thread_stack_arena() noexcept;
+
+/**
+ * \brief Rewinds an arena to where it was at construction.
+ *
+ * Containers using the arena must be destroyed before the scope, ie. declared after it.
+ */
+class Stack_Scope {
+    Stack_Arena& m_arena;
+    Stack_Marker m_marker;
+
+public:
+    explicit Stack_Scope(Stack_Arena& arena = thread_stack_arena()) noexcept
+        : m_arena(arena), m_marker(arena.mark())
+    {}
+    ~Stack_Scope() { m_arena.rewind(m_marker); }
+
+    Stack_Scope(Stack_Scope const&) = delete;
+    Stack_Scope& operator=(Stack_Scope const&) = delete;
+
+    [[nodiscard]] Stack_Arena& arena() const noexcept { return m_arena; }
+};
+
+/**
+ * \brief Allocator over a \a Stack_Arena, the calling thread's by default.
+ *
+ * Memory is only reclaimed when it was the last allocation or when a \a Stack_Scope ends, so
+ * reserve containers up front instead of letting them grow.
+ *
+ * \tparam T Element type.
+ */
+template <typename T>
+class Stack_Allocator {
+    template <typename U>
+    friend class Stack_Allocator;
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using is_always_equal = std::false_type;
+
+    template <typename U>
+    struct rebind {
+        using other = Stack_Allocator<U>;
+    };
+
+    Stack_Allocator() noexcept : m_arena(&thread_stack_arena()) {}
+    explicit Stack_Allocator(Stack_Arena& arena) noexcept : m_arena(&arena) {}
+    Stack_Allocator(Stack_Allocator const&) = default;
+    Stack_Allocator& operator=(Stack_Allocator const&) = default;
+    template <typename U>
+    Stack_Allocator(Stack_Allocator<U> const& o) noexcept : m_arena(o.m_arena)
+    {}
+
+    [[nodiscard]] T* allocate(size_t n)
+    {
+        if (n > static_cast<size_t>(-1) / sizeof(T)) { throw std::bad_array_new_length(); }
+        return static_cast<T*>(m_arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept { m_arena->deallocate(p, n * sizeof(T)); }
+
+    [[nodiscard]] Stack_Arena& arena() const noexcept { return *m_arena; }
+
+    template <typename U>
+    friend bool operator==(Stack_Allocator const& a, Stack_Allocator<U> const& b) noexcept
+    {
+        return &a.arena() == &b.arena();
+    }
+    template <typename U>
+    friend bool operator!=(Stack_Allocator const& a, Stack_Allocator<U> const& b) noexcept
+    {
+        return !(a == b);
+    }
+
+private:
+    Stack_Arena* m_arena = nullptr;
+};
+} // namespace sds
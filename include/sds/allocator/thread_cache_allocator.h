@@ -0,0 +1,114 @@
+#pragma once
+
+#include "sds/details/common.h"
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace sds
+{
+/**
+ * \brief Largest allocation served from the thread caches. Larger ones go to `::operator new`.
+ */
+inline constexpr size_t thread_cache_max_size = 16 * 1024;
+
+/**
+ * \brief Allocate \a bytes from the calling thread's cache. Aligned to `alignof(std::max_align_t)`.
+ *
+ * Each thread owns a heap of slabs, each slab split into blocks of one size class. Allocating
+ * pops a block off the current slab of the size class without locks or atomics. Slabs are carved
+ * from segments shared by all threads; a thread only takes the shared lock when it needs a new
+ * slab.
+ *
+ * \throw std::bad_alloc
+ */
+[[nodiscard]] void* thread_cache_allocate(size_t bytes);
+
+/**
+ * \brief Release memory from \a thread_cache_allocate. Any thread can release it.
+ *
+ * A block freed by the thread that owns its slab goes back on the slab's free list. A block freed
+ * by another thread is pushed onto the slab's lock-free remote queue, which the owner collects
+ * once the slab runs out of free blocks. Slabs whose blocks are all free return to the shared
+ * pool for any thread to reuse.
+ *
+ * The heap of a thread that exits is kept with its slabs and handed to the next new thread.
+ *
+ * \param bytes Size passed to \a thread_cache_allocate.
+ */
+void thread_cache_deallocate(void* p, size_t bytes) noexcept;
+
+struct Thread_Cache_Stats {
+    /* Memory taken from the system for slabs. Never returned. */
+    size_t reserved_bytes = 0;
+    /* Part of reserved_bytes in slabs that no thread holds. */
+    size_t pooled_bytes = 0;
+};
+
+[[nodiscard]] Thread_Cache_Stats thread_cache_stats() noexcept;
+
+/**
+ * \brief Stateless allocator over \a thread_cache_allocate, for containers allocated and freed
+ * from many threads.
+ *
+ *   sds::Dynamic_Array<int, sds::Thread_Cache_Allocator<int>> v;
+ *   sds::S_List<Job, sds::Thread_Cache_Allocator<Job>> jobs;
+ *
+ * Over-aligned types go to the aligned `::operator new`.
+ *
+ * \tparam T Element type.
+ */
+template <typename T>
+class Thread_Cache_Allocator {
+    static constexpr bool over_aligned = alignof(T) > alignof(std::max_align_t);
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal = std::true_type;
+
+    template <typename U>
+    struct rebind {
+        using other = Thread_Cache_Allocator<U>;
+    };
+
+    constexpr Thread_Cache_Allocator() noexcept = default;
+    template <typename U>
+    constexpr Thread_Cache_Allocator(Thread_Cache_Allocator<U> const&) noexcept
+    {}
+
+    [[nodiscard]] T* allocate(size_t n)
+    {
+        if (n > static_cast<size_t>(-1) / sizeof(T)) { throw std::bad_array_new_length(); }
+        if constexpr (over_aligned) {
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+        } else {
+            return static_cast<T*>(sds::thread_cache_allocate(n * sizeof(T)));
+        }
+    }
+
+    void deallocate(T* p, size_t n) noexcept
+    {
+        if constexpr (over_aligned) {
+            ::operator delete(p, n * sizeof(T), std::align_val_t(alignof(T)));
+        } else {
+            sds::thread_cache_deallocate(p, n * sizeof(T));
+        }
+    }
+
+    template <typename U>
+    friend constexpr bool operator==(Thread_Cache_Allocator const&,
+                                     Thread_Cache_Allocator<U> const&) noexcept
+    {
+        return true;
+    }
+    template <typename U>
+    friend constexpr bool operator!=(Thread_Cache_Allocator const&,
+                                     Thread_Cache_Allocator<U> const&) noexcept
+    {
+        return false;
+    }
+};
+} // namespace sds
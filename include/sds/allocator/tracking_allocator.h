@@ -0,0 +1,213 @@
+#pragma once
+
+#include "sds/details/common.h"
+
+#include "sds/cache_aligned.h"
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace sds
+{
+/**
+ * \brief Number of buckets in \a Memory_Stats::size_histogram.
+ */
+inline constexpr s32 memory_histogram_buckets = 32;
+
+/**
+ * \brief Snapshot of a \a Memory_Tag.
+ */
+struct Memory_Stats {
+    s64 live_bytes = 0;
+    /* High-water mark of live_bytes. See Memory_Tag for its precision. */
+    s64 peak_bytes = 0;
+    u64 allocations = 0;
+    u64 deallocations = 0;
+    /* Allocations by size. Bucket i counts sizes in [2^i, 2^(i+1)), the last bucket everything
+     * larger. Zero byte allocations go in bucket 0. */
+    u64 size_histogram[memory_histogram_buckets] = {};
+};
+
+/**
+ * \brief Named memory account that \a Tracking_Allocator reports to.
+ *
+ * Counters are split over cache line sized shards picked per thread, so threads allocating
+ * through the same tag rarely share a line. \a stats() sums the shards.
+ *
+ * To track the peak without a shared counter on every call, each shard folds its live byte delta
+ * into a shared total once it exceeds \a peak_batch_bytes in either direction, and the peak is the
+ * high-water mark of that total. The peak can therefore be understated by up to
+ * `shard_count * peak_batch_bytes`.
+ *
+ * Live bytes are eventually consistent. They are exact once allocations through the tag stop, but a
+ * read racing with them can miss the delta of a shard that is being folded at that moment.
+ *
+ * Tags register themselves on construction so dashboards can enumerate them with
+ * \a for_each_memory_tag. They must outlive all allocators and memory that refer to them.
+ */
+class Memory_Tag {
+public:
+    static constexpr s32 shard_count = 16;
+    static constexpr s64 peak_batch_bytes = 64 * 1024;
+
+    /**
+     * \param name Name in reports. Must outlive the tag, ie. a string literal.
+     */
+    explicit Memory_Tag(char const* name);
+    ~Memory_Tag();
+
+    Memory_Tag(Memory_Tag const&) = delete;
+    Memory_Tag& operator=(Memory_Tag const&) = delete;
+
+    [[nodiscard]] char const* name() const noexcept { return m_name; }
+
+    void record_allocate(size_t bytes) noexcept;
+    void record_deallocate(size_t bytes) noexcept;
+
+    [[nodiscard]] Memory_Stats stats() const noexcept;
+
+    /**
+     * \brief Tag of default constructed tracking allocators.
+     */
+    [[nodiscard]] static Memory_Tag& untagged() noexcept;
+
+private:
+    struct alignas(hardware_destructive_interference_size) Shard {
+        std::atomic<s64> pending_bytes{0}; // not yet folded into m_live_bytes
+        std::atomic<u64> allocations{0};
+        std::atomic<u64> deallocations{0};
+        std::atomic<u64> size_histogram[memory_histogram_buckets] = {};
+    };
+
+    char const* m_name = nullptr;
+    Memory_Tag* m_next = nullptr; // registry list
+    Shard m_shards[shard_count];
+    alignas(hardware_destructive_interference_size) std::atomic<s64> m_live_bytes{0};
+    std::atomic<s64> m_peak_bytes{0};
+
+    Shard& local_shard() noexcept;
+    void fold(Shard& shard, s64 pending) noexcept;
+
+    friend struct Memory_Tag_Registry;
+};
+
+namespace details
+{
+using Memory_Tag_Visitor = void (*)(Memory_Tag const& tag, void* ctx);
+void for_each_memory_tag(Memory_Tag_Visitor visit, void* ctx);
+} // namespace details
+
+/**
+ * \brief Call `f(Memory_Tag const&)` for each live tag. Tags can't register or unregister during
+ * the call.
+ */
+template <typename F>
+void for_each_memory_tag(F&& f)
+{
+    auto visit = [](Memory_Tag const& tag, void* ctx) {
+        (*static_cast<std::remove_reference_t<F>*>(ctx))(tag);
+    };
+    details::for_each_memory_tag(visit, const_cast<void*>(static_cast<void const*>(&f)));
+}
+
+/**
+ * \brief Allocator adapter that accounts every allocation to a \a Memory_Tag, then forwards to
+ * \a Allocator.
+ *
+ * Plugs into any container's allocator parameter:
+ *
+ *   sds::Memory_Tag g_mesh_memory("meshes");
+ *   sds::Dynamic_Array<float, sds::Tracking_Allocator<float>> v(
+ *       sds::Tracking_Allocator<float>(g_mesh_memory));
+ *
+ * Allocators with different tags compare unequal, so memory is always released to the tag that
+ * allocated it. Propagation traits follow \a Allocator.
+ *
+ * \tparam T Element type.
+ * \tparam Allocator Underlying allocator of T.
+ */
+template <typename T, typename Allocator = std::allocator<T>>
+class Tracking_Allocator {
+    using base_traits = std::allocator_traits<Allocator>;
+
+    template <typename U, typename A>
+    friend class Tracking_Allocator;
+
+public:
+    using value_type = T;
+    using size_type = typename base_traits::size_type;
+    using difference_type = typename base_traits::difference_type;
+    using propagate_on_container_copy_assignment =
+        typename base_traits::propagate_on_container_copy_assignment;
+    using propagate_on_container_move_assignment =
+        typename base_traits::propagate_on_container_move_assignment;
+    using propagate_on_container_swap = typename base_traits::propagate_on_container_swap;
+    using is_always_equal = std::false_type;
+
+    template <typename U>
+    struct rebind {
+        using other = Tracking_Allocator<U, typename base_traits::template rebind_alloc<U>>;
+    };
+
+    Tracking_Allocator() noexcept(noexcept(Allocator())) : m_tag(&Memory_Tag::untagged()) {}
+    explicit Tracking_Allocator(Memory_Tag& tag, Allocator const& base = Allocator()) noexcept
+        : m_base(base), m_tag(&tag)
+    {}
+    Tracking_Allocator(Tracking_Allocator const&) = default;
+    Tracking_Allocator& operator=(Tracking_Allocator const&) = default;
+    template <typename U, typename A>
+    Tracking_Allocator(Tracking_Allocator<U, A> const& o) noexcept
+        : m_base(o.m_base), m_tag(o.m_tag)
+    {}
+
+    [[nodiscard]] T* allocate(size_type n)
+    {
+        T* const p = base_traits::allocate(m_base, n);
+        m_tag->record_allocate(n * sizeof(T));
+        return p;
+    }
+
+    void deallocate(T* p, size_type n) noexcept
+    {
+        m_tag->record_deallocate(n * sizeof(T));
+        base_traits::deallocate(m_base, p, n);
+    }
+
+    template <typename U, typename... Args>
+    void construct(U* p, Args&&... args)
+    {
+        base_traits::construct(m_base, p, std::forward<Args>(args)...);
+    }
+
+    template <typename U>
+    void destroy(U* p) noexcept
+    {
+        base_traits::destroy(m_base, p);
+    }
+
+    Tracking_Allocator select_on_container_copy_construction() const
+    {
+        return Tracking_Allocator(*m_tag,
+                                  base_traits::select_on_container_copy_construction(m_base));
+    }
+
+    [[nodiscard]] Memory_Tag& tag() const noexcept { return *m_tag; }
+    [[nodiscard]] Allocator const& base() const noexcept { return m_base; }
+
+    template <typename U, typename A>
+    friend bool operator==(Tracking_Allocator const& a, Tracking_Allocator<U, A> const& b) noexcept
+    {
+        return &a.tag() == &b.tag() && a.base() == b.base();
+    }
+    template <typename U, typename A>
+    friend bool operator!=(Tracking_Allocator const& a, Tracking_Allocator<U, A> const& b) noexcept
+    {
+        return !(a == b);
+    }
+
+private:
+    Allocator m_base{};
+    Memory_Tag* m_tag = nullptr;
+};
+} // namespace sds
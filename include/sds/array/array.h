@@ -94,13 +94,19 @@ public:
     [[nodiscard]] constexpr const_iterator end() const noexcept { return &m_arr[N]; }
     [[nodiscard]] constexpr const_iterator cend() const noexcept { return &m_arr[N]; }
 
-    [[nodiscard]] constexpr reverse_iterator rbegin() noexcept { return {&m_arr[N]}; }
-    [[nodiscard]] constexpr const_reverse_iterator rbegin() const noexcept { return {&m_arr[N]}; }
-    [[nodiscard]] constexpr const_reverse_iterator crbegin() const noexcept { return {&m_arr[N]}; }
+    [[nodiscard]] constexpr reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    [[nodiscard]] constexpr const_reverse_iterator rbegin() const noexcept { return crbegin(); }
+    [[nodiscard]] constexpr const_reverse_iterator crbegin() const noexcept
+    {
+        return const_reverse_iterator(cend());
+    }
 
-    [[nodiscard]] constexpr reverse_iterator rend() noexcept { return {&m_arr[0]}; }
-    [[nodiscard]] constexpr const_reverse_iterator rend() const noexcept { return {&m_arr[0]}; }
-    [[nodiscard]] constexpr const_reverse_iterator crend() const noexcept { return {&m_arr[0]}; }
+    [[nodiscard]] constexpr reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    [[nodiscard]] constexpr const_reverse_iterator rend() const noexcept { return crend(); }
+    [[nodiscard]] constexpr const_reverse_iterator crend() const noexcept
+    {
+        return const_reverse_iterator(cbegin());
+    }
 
     Array<T, N> operator=(Array<T, N> const&) = delete;
     Array<T, N> operator=(Array<T, N>&&) = delete;
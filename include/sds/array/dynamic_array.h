@@ -1,9 +1,18 @@
 #pragma once
 
+#include "sds/details/common.h"
+#include "sds/allocator/aligned_allocator.h"
+#include "sds/move.h"
+#include "sds/swap.h"
+#include <algorithm>
 #include <initializer_list>
 #include <iterator>
 #include <memory>
+#include <ostream>
 #include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
 
 
 namespace sds
@@ -17,6 +26,15 @@ namespace sds
 */
 
 
+/**
+ * \brief Contiguous growable array. Interface is compatible with \a std::vector.
+ *
+ * Grows by 1.5x. Elements are moved on reallocation when their move constructor can't throw,
+ * otherwise copied.
+ *
+ * \tparam T Element type.
+ * \tparam Allocator Allocator of T.
+ */
 template<typename T, typename Allocator = std::allocator<T>>
 class Dynamic_Array {
 public:
@@ -37,16 +55,24 @@ public:
         //using iterator_category = std::contiguous_iterator_tag;
         using iterator_category = std::random_access_iterator_tag;
         using difference_type = ptrdiff_t;
-        using value_type = ValueT;
-        using pointer = value_type*;
-        using reference = value_type&;
+        using value_type = std::remove_const_t<ValueT>;
+        using pointer = ValueT*;
+        using reference = ValueT&;
 
+        constexpr Iterator() = default;
         constexpr Iterator(pointer p) : m_p(p) {}
-        constexpr const_reference operator*() const { return *m_p; }
+
+        /* iterator to const_iterator */
+        template<typename OtherT,
+                 typename = std::enable_if_t<std::is_same<OtherT const, ValueT>::value &&
+                                             !std::is_same<OtherT, ValueT>::value>>
+        constexpr Iterator(Iterator<OtherT> const& o) : m_p(o.operator->()) {}
+
+        constexpr reference operator*() const { return *m_p; }
         constexpr pointer operator->() const { return m_p; }
         constexpr Iterator& operator++() { m_p++; return *this; }
         constexpr Iterator operator++(int) { Iterator it = *this; ++(*this); return it; }
-        constexpr Iterator operator--() { m_p--; return *this; }
+        constexpr Iterator& operator--() { m_p--; return *this; }
         constexpr Iterator operator--(int) { Iterator it = *this; --(*this); return it; }
 
         constexpr Iterator& operator+=(difference_type n) { m_p += n; return *this; }
@@ -54,16 +80,15 @@ public:
         constexpr friend Iterator operator+(difference_type n, Iterator const& a) { return a + n; }
 
         constexpr Iterator& operator-=(difference_type n) { m_p -= n; return *this; }
-        constexpr friend Iterator operator-(Iterator const& a, difference_type n) { return Iterator(a.m_p + n); }
-        constexpr friend Iterator operator-(difference_type n, Iterator const& b) { return b - n; }
-        constexpr friend difference_type operator-(Iterator const& a, Iterator const& b) { return b.m_p - a.m_p; }
-        constexpr reference operator[](difference_type n) const { return *(*this + n); }
+        constexpr friend Iterator operator-(Iterator const& a, difference_type n) { return Iterator(a.m_p - n); }
+        constexpr friend difference_type operator-(Iterator const& a, Iterator const& b) { return a.m_p - b.m_p; }
+        constexpr reference operator[](difference_type n) const { return m_p[n]; }
 
         // TODO(sdsmith): comparing pointers is _yikes_
         constexpr friend bool operator<(Iterator const& a, Iterator const& b) { return a.m_p < b.m_p; }
-        constexpr friend bool operator>=(Iterator const& a, Iterator const& b) { return a.m_p > b.m_p; }
+        constexpr friend bool operator>=(Iterator const& a, Iterator const& b) { return a.m_p >= b.m_p; }
         constexpr friend bool operator<=(Iterator const& a, Iterator const& b) { return a.m_p <= b.m_p; }
-        constexpr friend bool operator>(Iterator const& a, Iterator const& b) { return a.m_p >= b.m_p; }
+        constexpr friend bool operator>(Iterator const& a, Iterator const& b) { return a.m_p > b.m_p; }
         constexpr friend bool operator==(Iterator const& a, Iterator const& b) { return a.m_p == b.m_p; }
         constexpr friend bool operator!=(Iterator const& a, Iterator const& b) { return !(a == b); }
 
@@ -76,108 +101,147 @@ public:
     using reverse_iterator = std::reverse_iterator<iterator>;
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
-    Dynamic_Array() {}
-    Dynamic_Array(std::initializer_list<T> l);
-    Dynamic_Array(Dynamic_Array const& o);
-    Dynamic_Array(Dynamic_Array&& o);
-    ~Dynamic_Array();
-
-    Dynamic_Array& operator=(Dynamic_Array const& o) noexcept(false); /*{
-        clear();
-
-        if (capacity() < o.size()) {
-            reallocate(o.size());
-        }
-        std::copy(o.begin(), o.end(), begin());
-        }*/
+private:
+    using alloc_traits = std::allocator_traits<Allocator>;
+
+    // Empty base optimization: stateless allocators take no space
+    struct Storage : Allocator {
+        pointer data = nullptr;
+        size_type size = 0;
+        size_type capacity = 0;
+
+        Storage() = default;
+        explicit Storage(Allocator const& alloc) noexcept : Allocator(alloc) {}
+        explicit Storage(Allocator&& alloc) noexcept : Allocator(sds::move(alloc)) {}
+        Storage(Storage const&) = delete;
+        Storage& operator=(Storage const&) = delete;
+    };
 
-    Dynamic_Array& operator=(Dynamic_Array&& o) {
-        deallocate();
+    Storage m_storage;
 
-        m_data = std::move(o.m_data);
-        m_size = o.m_size;
-        m_capacity = o.m_capacity;
-    }
+public:
+    Dynamic_Array() noexcept(noexcept(Allocator())) : m_storage() {}
+    explicit Dynamic_Array(Allocator const& alloc) noexcept : m_storage(alloc) {}
+    explicit Dynamic_Array(size_type count, Allocator const& alloc = Allocator());
+    Dynamic_Array(size_type count, T const& value, Allocator const& alloc = Allocator());
+    template<typename InputIt,
+             typename = std::enable_if_t<!std::is_integral<InputIt>::value>>
+    Dynamic_Array(InputIt first, InputIt last, Allocator const& alloc = Allocator());
+    Dynamic_Array(std::initializer_list<T> l, Allocator const& alloc = Allocator());
+    Dynamic_Array(Dynamic_Array const& o);
+    Dynamic_Array(Dynamic_Array const& o, Allocator const& alloc);
+    Dynamic_Array(Dynamic_Array&& o) noexcept;
+    ~Dynamic_Array();
 
-    iterator begin() const { return iterator(m_data); }
-    iterator end() const { return iterator(m_data + m_size); }
-    const_iterator cbegin() const { return const_iterator(m_data); }
-    const_iterator cend() const { return const_iterator(m_data + m_size); }
+    Dynamic_Array& operator=(Dynamic_Array const& o) noexcept(false);
+    Dynamic_Array& operator=(Dynamic_Array&& o) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value ||
+        alloc_traits::is_always_equal::value);
+    Dynamic_Array& operator=(std::initializer_list<T> l);
+
+    void assign(size_type count, T const& value);
+    template<typename InputIt,
+             typename = std::enable_if_t<!std::is_integral<InputIt>::value>>
+    void assign(InputIt first, InputIt last);
+    void assign(std::initializer_list<T> l) { assign(l.begin(), l.end()); }
+
+    allocator_type get_allocator() const noexcept { return alloc(); }
+
+    iterator begin() noexcept { return iterator(m_storage.data); }
+    iterator end() noexcept { return iterator(m_storage.data + m_storage.size); }
+    const_iterator begin() const noexcept { return cbegin(); }
+    const_iterator end() const noexcept { return cend(); }
+    const_iterator cbegin() const noexcept { return const_iterator(m_storage.data); }
+    const_iterator cend() const noexcept { return const_iterator(m_storage.data + m_storage.size); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
 
     reference front() {
         SDS_ASSERT(!empty());
-        return *m_data;
+        return *m_storage.data;
     }
 
     const_reference front() const {
         SDS_ASSERT(!empty());
-        return *m_data;
+        return *m_storage.data;
     }
 
     reference back() {
         SDS_ASSERT(!empty());
-        return m_data[m_size - 1];
+        return m_storage.data[m_storage.size - 1];
     }
 
     const_reference back() const {
         SDS_ASSERT(!empty());
-        return m_data[m_size - 1];
+        return m_storage.data[m_storage.size - 1];
     }
 
-    reference data() { return m_data; }
-    const_reference data() const { return m_data; }
+    pointer data() noexcept { return m_storage.data; }
+    const_pointer data() const noexcept { return m_storage.data; }
 
-    constexpr void push_back(T const& v);
-    constexpr void push_back(T&& v);
+    void push_back(T const& v) { emplace_back(v); }
+    void push_back(T&& v) { emplace_back(sds::move(v)); }
     template<typename... Args>
-    constexpr reference emplace_back(Args&&... args);
-
-    constexpr iterator insert(const_iterator pos, T const& value);
-    constexpr iterator insert(const_iterator pos, T&& value);
-    template<typename InputIt>
-    constexpr iterator insert(const_iterator pos, InputIt first, InputIt last);
-    constexpr iterator insert(const_iterator pos, std::initializer_list<T> l);
+    reference emplace_back(Args&&... args);
+    void pop_back();
+
+    iterator insert(const_iterator pos, T const& value) { return emplace(pos, value); }
+    iterator insert(const_iterator pos, T&& value) { return emplace(pos, sds::move(value)); }
+    iterator insert(const_iterator pos, size_type count, T const& value);
+    template<typename InputIt,
+             typename = std::enable_if_t<!std::is_integral<InputIt>::value>>
+    iterator insert(const_iterator pos, InputIt first, InputIt last);
+    iterator insert(const_iterator pos, std::initializer_list<T> l)
+    {
+        return insert(pos, l.begin(), l.end());
+    }
+    template<typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args);
 
-    constexpr void clear();
-    constexpr iterator erase(const_iterator pos);
-    constexpr iterator erase(const_iterator first, const_iterator last);
+    void clear() noexcept;
+    iterator erase(const_iterator pos);
+    iterator erase(const_iterator first, const_iterator last);
 
-    constexpr reference at(size_type index) noexcept(false) {
+    reference at(size_type index) noexcept(false) {
         range_check(index);
         return (*this)[index];
     }
-    constexpr const_reference at(size_type index) const noexcept(false) {
+    const_reference at(size_type index) const noexcept(false) {
         range_check(index);
         return (*this)[index];
     }
 
-    constexpr reference operator[](size_type index) noexcept {
-        SDS_ASSERT(!empty());
-        return m_data[index];
+    reference operator[](size_type index) noexcept {
+        SDS_ASSERT(index < size());
+        return m_storage.data[index];
     }
-    constexpr const_reference operator[](size_type index) const noexcept {
-        SDS_ASSERT(!empty());
-        return m_data[index];
+    const_reference operator[](size_type index) const noexcept {
+        SDS_ASSERT(index < size());
+        return m_storage.data[index];
     }
 
-    constexpr bool empty() const noexcept { return size() != 0; }
-    constexpr size_type size() const noexcept { return m_size; }
-    constexpr size_type max_size() const noexcept { return m_max_size; }
-    constexpr size_type capacity() const noexcept { return m_capacity; }
+    bool empty() const noexcept { return size() == 0; }
+    size_type size() const noexcept { return m_storage.size; }
+    size_type max_size() const noexcept { return alloc_traits::max_size(alloc()); }
+    size_type capacity() const noexcept { return m_storage.capacity; }
 
-    constexpr void reserve(size_t);
-    // TODO(sdsmith): shrink_to_fit
+    void reserve(size_type new_cap);
+    void shrink_to_fit();
+    void resize(size_type count);
+    void resize(size_type count, T const& value);
 
-    constexpr void swap(Dynamic_Array& o);
+    void swap(Dynamic_Array& o) noexcept;
 
-    friend bool operator==(Dynamic_Array<T> const& a, Dynamic_Array<T> const& b) {
+    friend bool operator==(Dynamic_Array const& a, Dynamic_Array const& b) {
         return a.size() == b.size() && std::equal(a.cbegin(), a.cend(), b.cbegin(), b.cend());
     }
-    friend bool operator!=(Dynamic_Array<T> const& a, Dynamic_Array<T> const& b) {
+    friend bool operator!=(Dynamic_Array const& a, Dynamic_Array const& b) {
         return !(a == b);
     }
 
-    friend std::ostream& operator<<(std::ostream& os, Dynamic_Array<T> const& a) {
+    friend std::ostream& operator<<(std::ostream& os, Dynamic_Array const& a) {
         os << "[";
         for (const_reference e : a) {
             os << e << ", ";
@@ -186,20 +250,503 @@ public:
     }
 
 private:
-    size_type m_capacity = 0;
-    size_type m_size = 0;
-    size_type m_max_size = 0;
-    pointer m_data = nullptr;
+    Allocator& alloc() noexcept { return m_storage; }
+    Allocator const& alloc() const noexcept { return m_storage; }
 
-    constexpr void range_check(size_type index) const noexcept(false) {
+    void range_check(size_type index) const noexcept(false) {
         if (index >= size()) {
             throw std::out_of_range("invalid container index: " + std::to_string(index)); // TODO(sdsmith): clearer message?
         }
     }
 
-    void deallocate();
-    void allocate(size_type n); // TODO(sdsmith): needed?
+    /* Capacity to grow to so \a required elements fit. */
+    size_type grown_capacity(size_type required) const noexcept;
+
+    /* Destroy the elements and free the buffer. Leaves the members dangling. */
+    void deallocate() noexcept;
+
+    /* Move the elements to a buffer of \a n. */
     void reallocate(size_type n);
+
+    /* Move \a count elements to uninitialized \a dst, or copy them if the move can throw and
+     * there is a copy. Leaves \a dst uninitialized if it throws. */
+    void relocate(pointer src, size_type count, pointer dst);
+
+    /* Insert \a count elements at \a index. construct(p, i, n) constructs new elements [i, i + n)
+     * in uninitialized memory at p, assign(p, i, n) assigns them over live elements. Returns a
+     * pointer to the first inserted element. */
+    template<typename Construct, typename Assign>
+    pointer insert_n(size_type index, size_type count, Construct construct, Assign assign);
+
+    void destroy_range(pointer first, pointer last) noexcept;
+
+    void steal(Dynamic_Array& o) noexcept;
 };
 
+/**
+ * \brief \a Dynamic_Array whose buffer starts on an \a Alignment boundary, a cache line by
+ * default. For buffers streamed with SIMD loads or split between threads by cache line.
+ *
+ * Over-aligned element types, ex. \a Cache_Aligned, need no special allocator: every element
+ * starts on its own boundary with std::allocator too.
+ */
+template<typename T, size_t Alignment = hardware_destructive_interference_size>
+using Aligned_Dynamic_Array = Dynamic_Array<T, Aligned_Allocator<T, Alignment>>;
+
+template<typename T, typename Allocator>
+Dynamic_Array<T, Allocator>::Dynamic_Array(size_type count, Allocator const& alloc)
+    : m_storage(alloc)
+{
+    resize(count);
+}
+
+template<typename T, typename Allocator>
+Dynamic_Array<T, Allocator>::Dynamic_Array(size_type count, T const& value,
+                                           Allocator const& alloc)
+    : m_storage(alloc)
+{
+    resize(count, value);
+}
+
+template<typename T, typename Allocator>
+template<typename InputIt, typename>
+Dynamic_Array<T, Allocator>::Dynamic_Array(InputIt first, InputIt last, Allocator const& alloc)
+    : m_storage(alloc)
+{
+    assign(first, last);
+}
+
+template<typename T, typename Allocator>
+Dynamic_Array<T, Allocator>::Dynamic_Array(std::initializer_list<T> l, Allocator const& alloc)
+    : m_storage(alloc)
+{
+    assign(l.begin(), l.end());
+}
+
+template<typename T, typename Allocator>
+Dynamic_Array<T, Allocator>::Dynamic_Array(Dynamic_Array const& o)
+    : m_storage(alloc_traits::select_on_container_copy_construction(o.alloc()))
+{
+    assign(o.begin(), o.end());
+}
+
+template<typename T, typename Allocator>
+Dynamic_Array<T, Allocator>::Dynamic_Array(Dynamic_Array const& o, Allocator const& alloc)
+    : m_storage(alloc)
+{
+    assign(o.begin(), o.end());
+}
+
+template<typename T, typename Allocator>
+Dynamic_Array<T, Allocator>::Dynamic_Array(Dynamic_Array&& o) noexcept
+    : m_storage(sds::move(o.alloc()))
+{
+    steal(o);
+}
+
+template<typename T, typename Allocator>
+Dynamic_Array<T, Allocator>::~Dynamic_Array()
+{
+    deallocate();
+}
+
+template<typename T, typename Allocator>
+Dynamic_Array<T, Allocator>&
+Dynamic_Array<T, Allocator>::operator=(Dynamic_Array const& o) noexcept(false)
+{
+    if SDS_UNLIKELY(this == &o) { return *this; }
+
+    if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+        if (!alloc_traits::is_always_equal::value && alloc() != o.alloc()) {
+            deallocate();
+            m_storage.data = nullptr;
+            m_storage.size = 0;
+            m_storage.capacity = 0;
+        }
+        alloc() = o.alloc();
+    }
+    assign(o.begin(), o.end());
+    return *this;
+}
+
+template<typename T, typename Allocator>
+Dynamic_Array<T, Allocator>& Dynamic_Array<T, Allocator>::operator=(Dynamic_Array&& o) noexcept(
+    alloc_traits::propagate_on_container_move_assignment::value ||
+    alloc_traits::is_always_equal::value)
+{
+    if SDS_UNLIKELY(this == &o) { return *this; }
+
+    if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+        deallocate();
+        alloc() = sds::move(o.alloc());
+        steal(o);
+    } else {
+        if (alloc_traits::is_always_equal::value || alloc() == o.alloc()) {
+            deallocate();
+            steal(o);
+        } else {
+            // Memory from another allocator can't be adopted
+            assign(std::make_move_iterator(o.begin()), std::make_move_iterator(o.end()));
+            o.clear();
+        }
+    }
+    return *this;
+}
+
+template<typename T, typename Allocator>
+Dynamic_Array<T, Allocator>& Dynamic_Array<T, Allocator>::operator=(std::initializer_list<T> l)
+{
+    assign(l.begin(), l.end());
+    return *this;
+}
+
+template<typename T, typename Allocator>
+void Dynamic_Array<T, Allocator>::assign(size_type count, T const& value)
+{
+    clear();
+    resize(count, value);
+}
+
+template<typename T, typename Allocator>
+template<typename InputIt, typename>
+void Dynamic_Array<T, Allocator>::assign(InputIt first, InputIt last)
+{
+    clear();
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value) {
+        reserve(static_cast<size_type>(std::distance(first, last)));
+    }
+    for (; first != last; ++first) { emplace_back(*first); }
+}
+
+template<typename T, typename Allocator>
+template<typename... Args>
+typename Dynamic_Array<T, Allocator>::reference
+Dynamic_Array<T, Allocator>::emplace_back(Args&&... args)
+{
+    if SDS_UNLIKELY(m_storage.size == m_storage.capacity) {
+        // The arguments may refer to an element, so construct before moving the old elements
+        size_type const n = grown_capacity(m_storage.size + 1);
+        pointer const p = alloc_traits::allocate(alloc(), n);
+        try {
+            alloc_traits::construct(alloc(), p + m_storage.size, std::forward<Args>(args)...);
+        } catch (...) {
+            alloc_traits::deallocate(alloc(), p, n);
+            throw;
+        }
+        try {
+            relocate(m_storage.data, m_storage.size, p);
+        } catch (...) {
+            alloc_traits::destroy(alloc(), p + m_storage.size);
+            alloc_traits::deallocate(alloc(), p, n);
+            throw;
+        }
+        size_type const size = m_storage.size;
+        deallocate();
+        m_storage.data = p;
+        m_storage.size = size + 1;
+        m_storage.capacity = n;
+        return p[size];
+    }
+
+    pointer const p = m_storage.data + m_storage.size;
+    alloc_traits::construct(alloc(), p, std::forward<Args>(args)...);
+    ++m_storage.size;
+    return *p;
+}
+
+template<typename T, typename Allocator>
+void Dynamic_Array<T, Allocator>::pop_back()
+{
+    SDS_ASSERT(!empty());
+    --m_storage.size;
+    alloc_traits::destroy(alloc(), m_storage.data + m_storage.size);
+}
+
+template<typename T, typename Allocator>
+typename Dynamic_Array<T, Allocator>::iterator
+Dynamic_Array<T, Allocator>::insert(const_iterator pos, size_type count, T const& value)
+{
+    size_type const index = static_cast<size_type>(pos - cbegin());
+    if (count == 0) { return begin() + static_cast<difference_type>(index); }
+
+    // The value may be an element that moves
+    T const copy(value);
+    return iterator(insert_n(
+        index, count,
+        [&copy](pointer p, size_type, size_type n) { std::uninitialized_fill_n(p, n, copy); },
+        [&copy](pointer p, size_type, size_type n) { std::fill_n(p, n, copy); }));
+}
+
+template<typename T, typename Allocator>
+template<typename InputIt, typename>
+typename Dynamic_Array<T, Allocator>::iterator
+Dynamic_Array<T, Allocator>::insert(const_iterator pos, InputIt first, InputIt last)
+{
+    size_type const index = static_cast<size_type>(pos - cbegin());
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value) {
+        size_type const count = static_cast<size_type>(std::distance(first, last));
+        if (count == 0) { return begin() + static_cast<difference_type>(index); }
+
+        auto const from = [first](size_type i) {
+            return std::next(first, static_cast<difference_type>(i));
+        };
+        return iterator(insert_n(
+            index, count,
+            [&from](pointer p, size_type i, size_type n) {
+                std::uninitialized_copy_n(from(i), n, p);
+            },
+            [&from](pointer p, size_type i, size_type n) { std::copy_n(from(i), n, p); }));
+    } else {
+        // Single pass: append, then rotate into place
+        size_type const old_size = size();
+        for (; first != last; ++first) { emplace_back(*first); }
+        std::rotate(begin() + static_cast<difference_type>(index),
+                    begin() + static_cast<difference_type>(old_size), end());
+        return begin() + static_cast<difference_type>(index);
+    }
+}
+
+template<typename T, typename Allocator>
+template<typename... Args>
+typename Dynamic_Array<T, Allocator>::iterator
+Dynamic_Array<T, Allocator>::emplace(const_iterator pos, Args&&... args)
+{
+    size_type const index = static_cast<size_type>(pos - cbegin());
+    if (index == size()) {
+        emplace_back(std::forward<Args>(args)...);
+        return end() - 1;
+    }
+
+    // The arguments may refer to an element that moves
+    T value(std::forward<Args>(args)...);
+    return iterator(insert_n(
+        index, 1,
+        [this, &value](pointer p, size_type, size_type) {
+            alloc_traits::construct(alloc(), p, sds::move(value));
+        },
+        [&value](pointer p, size_type, size_type) { *p = sds::move(value); }));
+}
+
+template<typename T, typename Allocator>
+void Dynamic_Array<T, Allocator>::clear() noexcept
+{
+    destroy_range(m_storage.data, m_storage.data + m_storage.size);
+    m_storage.size = 0;
+}
+
+template<typename T, typename Allocator>
+typename Dynamic_Array<T, Allocator>::iterator
+Dynamic_Array<T, Allocator>::erase(const_iterator pos)
+{
+    SDS_ASSERT(pos >= cbegin() && pos < cend());
+    return erase(pos, pos + 1);
+}
+
+template<typename T, typename Allocator>
+typename Dynamic_Array<T, Allocator>::iterator
+Dynamic_Array<T, Allocator>::erase(const_iterator first, const_iterator last)
+{
+    SDS_ASSERT(first >= cbegin() && first <= last && last <= cend());
+    pointer const p = m_storage.data + (first - cbegin());
+    size_type const count = static_cast<size_type>(last - first);
+    if (count > 0) {
+        pointer const new_end = std::move(p + count, m_storage.data + m_storage.size, p);
+        destroy_range(new_end, m_storage.data + m_storage.size);
+        m_storage.size -= count;
+    }
+    return iterator(p);
+}
+
+template<typename T, typename Allocator>
+void Dynamic_Array<T, Allocator>::reserve(size_type new_cap)
+{
+    if (new_cap > capacity()) { reallocate(new_cap); }
+}
+
+template<typename T, typename Allocator>
+void Dynamic_Array<T, Allocator>::shrink_to_fit()
+{
+    if (size() == capacity()) { return; }
+
+    if (empty()) {
+        deallocate();
+        m_storage.data = nullptr;
+        m_storage.capacity = 0;
+    } else {
+        reallocate(size());
+    }
+}
+
+template<typename T, typename Allocator>
+void Dynamic_Array<T, Allocator>::resize(size_type count)
+{
+    if (count <= size()) {
+        destroy_range(m_storage.data + count, m_storage.data + m_storage.size);
+        m_storage.size = count;
+        return;
+    }
+
+    if (count > capacity()) { reallocate(grown_capacity(count)); }
+    std::uninitialized_value_construct_n(m_storage.data + m_storage.size, count - size());
+    m_storage.size = count;
+}
+
+template<typename T, typename Allocator>
+void Dynamic_Array<T, Allocator>::resize(size_type count, T const& value)
+{
+    if (count <= size()) {
+        destroy_range(m_storage.data + count, m_storage.data + m_storage.size);
+        m_storage.size = count;
+        return;
+    }
+
+    // The value may be an element that moves
+    T const copy(value);
+    if (count > capacity()) { reallocate(grown_capacity(count)); }
+    std::uninitialized_fill_n(m_storage.data + m_storage.size, count - size(), copy);
+    m_storage.size = count;
+}
+
+template<typename T, typename Allocator>
+void Dynamic_Array<T, Allocator>::swap(Dynamic_Array& o) noexcept
+{
+    if constexpr (alloc_traits::propagate_on_container_swap::value) {
+        sds::swap(alloc(), o.alloc());
+    } else {
+        SDS_ASSERT(alloc_traits::is_always_equal::value || alloc() == o.alloc());
+    }
+
+    sds::swap(m_storage.data, o.m_storage.data);
+    sds::swap(m_storage.size, o.m_storage.size);
+    sds::swap(m_storage.capacity, o.m_storage.capacity);
+}
+
+template<typename T, typename Allocator>
+typename Dynamic_Array<T, Allocator>::size_type
+Dynamic_Array<T, Allocator>::grown_capacity(size_type required) const noexcept
+{
+    size_type const grown = capacity() + capacity() / 2;
+    return grown > required ? grown : required;
+}
+
+template<typename T, typename Allocator>
+void Dynamic_Array<T, Allocator>::deallocate() noexcept
+{
+    if (!m_storage.data) { return; }
+
+    destroy_range(m_storage.data, m_storage.data + m_storage.size);
+    alloc_traits::deallocate(alloc(), m_storage.data, m_storage.capacity);
+}
+
+template<typename T, typename Allocator>
+void Dynamic_Array<T, Allocator>::reallocate(size_type n)
+{
+    SDS_ASSERT(n >= size());
+    pointer const p = alloc_traits::allocate(alloc(), n);
+    try {
+        relocate(m_storage.data, m_storage.size, p);
+    } catch (...) {
+        alloc_traits::deallocate(alloc(), p, n);
+        throw;
+    }
+
+    size_type const size = m_storage.size;
+    deallocate();
+    m_storage.data = p;
+    m_storage.size = size;
+    m_storage.capacity = n;
+}
+
+template<typename T, typename Allocator>
+void Dynamic_Array<T, Allocator>::relocate(pointer src, size_type count, pointer dst)
+{
+    if constexpr (std::is_nothrow_move_constructible<T>::value ||
+                  !std::is_copy_constructible<T>::value) {
+        std::uninitialized_move_n(src, count, dst);
+    } else {
+        std::uninitialized_copy_n(src, count, dst);
+    }
+}
+
+template<typename T, typename Allocator>
+template<typename Construct, typename Assign>
+typename Dynamic_Array<T, Allocator>::pointer
+Dynamic_Array<T, Allocator>::insert_n(size_type index, size_type count, Construct construct,
+                                      Assign assign)
+{
+    SDS_ASSERT(index <= size() && count > 0);
+    size_type const old_size = size();
+    if (old_size + count > capacity()) {
+        // Build the new buffer around the new elements and only adopt it once complete, so a
+        // throw leaves the array as it was
+        size_type const n = grown_capacity(old_size + count);
+        pointer const p = alloc_traits::allocate(alloc(), n);
+        try {
+            construct(p + index, 0, count);
+        } catch (...) {
+            alloc_traits::deallocate(alloc(), p, n);
+            throw;
+        }
+        try {
+            relocate(m_storage.data, index, p);
+            try {
+                relocate(m_storage.data + index, old_size - index, p + index + count);
+            } catch (...) {
+                destroy_range(p, p + index);
+                throw;
+            }
+        } catch (...) {
+            destroy_range(p + index, p + index + count);
+            alloc_traits::deallocate(alloc(), p, n);
+            throw;
+        }
+        deallocate();
+        m_storage.data = p;
+        m_storage.size = old_size + count;
+        m_storage.capacity = n;
+        return p + index;
+    }
+
+    // Only live elements are ever assigned over, and the size grows as the end is constructed.
+    // A throw leaves every element counted by the size alive.
+    pointer const pos = m_storage.data + index;
+    pointer const end = m_storage.data + old_size;
+    size_type const tail = old_size - index;
+    if (tail > count) {
+        std::uninitialized_move(end - count, end, end);
+        m_storage.size += count;
+        std::move_backward(pos, end - count, end);
+        assign(pos, 0, count);
+    } else {
+        // New elements that land past the end are constructed there directly
+        if (count > tail) { construct(end, tail, count - tail); }
+        m_storage.size += count - tail;
+        std::uninitialized_move(pos, end, pos + count);
+        m_storage.size += tail;
+        if (tail > 0) { assign(pos, 0, tail); }
+    }
+    return pos;
+}
+
+template<typename T, typename Allocator>
+void Dynamic_Array<T, Allocator>::destroy_range(pointer first, pointer last) noexcept
+{
+    if constexpr (!std::is_trivially_destructible<T>::value) {
+        for (; first != last; ++first) { alloc_traits::destroy(alloc(), first); }
+    }
+}
+
+template<typename T, typename Allocator>
+void Dynamic_Array<T, Allocator>::steal(Dynamic_Array& o) noexcept
+{
+    m_storage.data = o.m_storage.data;
+    m_storage.size = o.m_storage.size;
+    m_storage.capacity = o.m_storage.capacity;
+    o.m_storage.data = nullptr;
+    o.m_storage.size = 0;
+    o.m_storage.capacity = 0;
+}
+
 } // namespace sds
@@ -0,0 +1,360 @@
+#pragma once
+
+#include "sds/array/array.h"
+#include "sds/bit.h"
+#include "sds/details/common.h"
+#include "sds/iterator.h"
+#include "sds/move.h"
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace sds
+{
+/**
+ * \brief Fixed capacity circular buffer built ontop of \a sds::Array.
+ *
+ * Holds the last \a N elements pushed. Pushing to a full buffer overwrites the oldest element,
+ * so appends are O(1) and never allocate. Indices are masked, so \a N must be a power of 2.
+ *
+ * All \a N elements of the storage are always constructed. Elements that fall out of the buffer
+ * are left as-is until overwritten.
+ *
+ * Elements are stored in at most two contiguous segments, see \a segments and \a copy_to.
+ *
+ * \tparam T Element type. Must be default constructible, and assignable to be pushed.
+ * \tparam N Capacity. Power of 2.
+ */
+template <typename T, sz N>
+class Ring_Buffer {
+    SDS_STATIC_ASSERT(N > 0 && sds::is_pow2(static_cast<u64>(N)));
+
+public:
+    using value_type = T;
+    using size_type = sz;
+    using difference_type = ptrdiff;
+    using reference = value_type&;
+    using const_reference = value_type const&;
+    using pointer = value_type*;
+    using const_pointer = value_type const*;
+
+    /**
+     * \brief Contiguous run of elements.
+     */
+    template <typename ValueT>
+    struct Segment {
+        ValueT* data = nullptr;
+        size_type size = 0;
+
+        [[nodiscard]] constexpr ValueT* begin() const noexcept { return data; }
+        [[nodiscard]] constexpr ValueT* end() const noexcept { return data + size; }
+        [[nodiscard]] constexpr bool empty() const noexcept { return size == 0; }
+    };
+
+    /**
+     * \brief Logical order of the elements: \a first holds the oldest, \a second the rest.
+     */
+    template <typename ValueT>
+    struct Segments {
+        Segment<ValueT> first;
+        Segment<ValueT> second;
+    };
+
+    template <typename ValueT>
+    class Iterator {
+    public:
+        using iterator_category = sds::random_access_iterator_tag;
+        using difference_type = ptrdiff;
+        using value_type = std::remove_const_t<ValueT>;
+        using pointer = ValueT*;
+        using reference = ValueT&;
+
+        constexpr Iterator() noexcept = default;
+
+        /* iterator to const_iterator */
+        template <typename OtherT,
+                  typename = std::enable_if_t<std::is_same<OtherT const, ValueT>::value &&
+                                              !std::is_same<OtherT, ValueT>::value>>
+        constexpr Iterator(Iterator<OtherT> const& o) noexcept : m_data(o.m_data), m_pos(o.m_pos)
+        {}
+
+        constexpr reference operator*() const noexcept { return m_data[m_pos & s_mask]; }
+        constexpr pointer operator->() const noexcept { return &m_data[m_pos & s_mask]; }
+        constexpr reference operator[](difference_type n) const noexcept
+        {
+            return m_data[(m_pos + static_cast<size_type>(n)) & s_mask];
+        }
+
+        constexpr Iterator& operator++() noexcept { ++m_pos; return *this; }
+        constexpr Iterator operator++(int) noexcept { Iterator it = *this; ++m_pos; return it; }
+        constexpr Iterator& operator--() noexcept { --m_pos; return *this; }
+        constexpr Iterator operator--(int) noexcept { Iterator it = *this; --m_pos; return it; }
+
+        constexpr Iterator& operator+=(difference_type n) noexcept
+        {
+            m_pos += static_cast<size_type>(n);
+            return *this;
+        }
+        constexpr Iterator& operator-=(difference_type n) noexcept
+        {
+            m_pos -= static_cast<size_type>(n);
+            return *this;
+        }
+        constexpr friend Iterator operator+(Iterator a, difference_type n) noexcept
+        {
+            return a += n;
+        }
+        constexpr friend Iterator operator+(difference_type n, Iterator a) noexcept
+        {
+            return a += n;
+        }
+        constexpr friend Iterator operator-(Iterator a, difference_type n) noexcept
+        {
+            return a -= n;
+        }
+        constexpr friend difference_type operator-(Iterator const& a, Iterator const& b) noexcept
+        {
+            return static_cast<difference_type>(a.m_pos) - static_cast<difference_type>(b.m_pos);
+        }
+
+        constexpr friend bool operator==(Iterator const& a, Iterator const& b) noexcept
+        {
+            return a.m_pos == b.m_pos;
+        }
+        constexpr friend bool operator!=(Iterator const& a, Iterator const& b) noexcept
+        {
+            return a.m_pos != b.m_pos;
+        }
+        constexpr friend bool operator<(Iterator const& a, Iterator const& b) noexcept
+        {
+            return a.m_pos < b.m_pos;
+        }
+        constexpr friend bool operator>(Iterator const& a, Iterator const& b) noexcept
+        {
+            return a.m_pos > b.m_pos;
+        }
+        constexpr friend bool operator<=(Iterator const& a, Iterator const& b) noexcept
+        {
+            return a.m_pos <= b.m_pos;
+        }
+        constexpr friend bool operator>=(Iterator const& a, Iterator const& b) noexcept
+        {
+            return a.m_pos >= b.m_pos;
+        }
+
+    private:
+        friend class Ring_Buffer;
+        template <typename>
+        friend class Iterator;
+
+        ValueT* m_data = nullptr;
+        // Storage index before masking. Not wrapped so begin and end differ when full.
+        size_type m_pos = 0;
+
+        constexpr Iterator(ValueT* data, size_type pos) noexcept : m_data(data), m_pos(pos) {}
+    };
+
+    using iterator = Iterator<T>;
+    using const_iterator = Iterator<T const>;
+    using reverse_iterator = sds::Reverse_Iterator<iterator>;
+    using const_reverse_iterator = sds::Reverse_Iterator<const_iterator>;
+    using segments_type = Segments<T>;
+    using const_segments_type = Segments<T const>;
+
+    Ring_Buffer() = default;
+    Ring_Buffer(Ring_Buffer const& o) noexcept(std::is_nothrow_copy_assignable_v<T>);
+    Ring_Buffer& operator=(Ring_Buffer const& o) noexcept(std::is_nothrow_copy_assignable_v<T>);
+
+    /**
+     * \brief Append \a v. When full, the oldest element is overwritten.
+     */
+    constexpr reference push_back(T const& v) noexcept(std::is_nothrow_copy_assignable_v<T>)
+    {
+        return slot_for_push() = v;
+    }
+    constexpr reference push_back(T&& v) noexcept(std::is_nothrow_move_assignable_v<T>)
+    {
+        return slot_for_push() = sds::move(v);
+    }
+    /**
+     * \brief Append a \a T built from \a args. Not constructed in place: the slot always holds an
+     * element, so the new one is move assigned over it and \a T must be move assignable.
+     */
+    template <typename... Args>
+    constexpr reference assign_back(Args&&... args)
+    {
+        return slot_for_push() = T(std::forward<Args>(args)...);
+    }
+
+    /**
+     * \brief Drop the oldest element.
+     */
+    constexpr void pop_front() noexcept
+    {
+        SDS_ASSERT(!empty());
+        m_head = (m_head + 1) & s_mask;
+        --m_size;
+    }
+    /**
+     * \brief Drop the newest element.
+     */
+    constexpr void pop_back() noexcept
+    {
+        SDS_ASSERT(!empty());
+        --m_size;
+    }
+
+    constexpr void clear() noexcept
+    {
+        m_head = 0;
+        m_size = 0;
+    }
+
+    /**
+     * \brief Element \a pos from the oldest.
+     */
+    [[nodiscard]] constexpr reference operator[](size_type pos) noexcept
+    {
+        SDS_ASSERT(pos >= 0 && pos < m_size);
+        return m_buf[(m_head + pos) & s_mask];
+    }
+    [[nodiscard]] constexpr const_reference operator[](size_type pos) const noexcept
+    {
+        SDS_ASSERT(pos >= 0 && pos < m_size);
+        return m_buf[(m_head + pos) & s_mask];
+    }
+    [[nodiscard]] constexpr reference at(size_type pos)
+    {
+        if (pos < 0 || pos >= m_size) { throw std::out_of_range("Ring_Buffer::at"); }
+        return (*this)[pos];
+    }
+    [[nodiscard]] constexpr const_reference at(size_type pos) const
+    {
+        if (pos < 0 || pos >= m_size) { throw std::out_of_range("Ring_Buffer::at"); }
+        return (*this)[pos];
+    }
+
+    [[nodiscard]] constexpr reference front() noexcept { return (*this)[0]; }
+    [[nodiscard]] constexpr const_reference front() const noexcept { return (*this)[0]; }
+    [[nodiscard]] constexpr reference back() noexcept { return (*this)[m_size - 1]; }
+    [[nodiscard]] constexpr const_reference back() const noexcept { return (*this)[m_size - 1]; }
+
+    [[nodiscard]] constexpr bool empty() const noexcept { return m_size == 0; }
+    [[nodiscard]] constexpr bool full() const noexcept { return m_size == N; }
+    [[nodiscard]] constexpr size_type size() const noexcept { return m_size; }
+    [[nodiscard]] constexpr size_type max_size() const noexcept { return N; }
+    [[nodiscard]] constexpr size_type capacity() const noexcept { return N; }
+
+    /**
+     * \brief The elements as at most two contiguous runs, oldest first.
+     */
+    [[nodiscard]] constexpr segments_type segments() noexcept
+    {
+        return make_segments<T>(m_buf.data());
+    }
+    [[nodiscard]] constexpr const_segments_type segments() const noexcept
+    {
+        return make_segments<T const>(m_buf.data());
+    }
+
+    /**
+     * \brief Copy the elements, oldest first, to \a out. Room for \a size elements is required.
+     * \return One past the last element written.
+     */
+    template <typename OutputIt>
+    OutputIt copy_to(OutputIt out) const
+    {
+        const_segments_type const s = segments();
+        out = std::copy(s.first.begin(), s.first.end(), out);
+        return std::copy(s.second.begin(), s.second.end(), out);
+    }
+
+    [[nodiscard]] constexpr iterator begin() noexcept { return {m_buf.data(), m_head}; }
+    [[nodiscard]] constexpr const_iterator begin() const noexcept { return cbegin(); }
+    [[nodiscard]] constexpr const_iterator cbegin() const noexcept
+    {
+        return {m_buf.data(), m_head};
+    }
+
+    [[nodiscard]] constexpr iterator end() noexcept { return {m_buf.data(), m_head + m_size}; }
+    [[nodiscard]] constexpr const_iterator end() const noexcept { return cend(); }
+    [[nodiscard]] constexpr const_iterator cend() const noexcept
+    {
+        return {m_buf.data(), m_head + m_size};
+    }
+
+    [[nodiscard]] constexpr reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    [[nodiscard]] constexpr const_reverse_iterator rbegin() const noexcept { return crbegin(); }
+    [[nodiscard]] constexpr const_reverse_iterator crbegin() const noexcept
+    {
+        return const_reverse_iterator(cend());
+    }
+
+    [[nodiscard]] constexpr reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    [[nodiscard]] constexpr const_reverse_iterator rend() const noexcept { return crend(); }
+    [[nodiscard]] constexpr const_reverse_iterator crend() const noexcept
+    {
+        return const_reverse_iterator(cbegin());
+    }
+
+private:
+    static constexpr size_type s_mask = N - 1;
+
+    Array<T, N> m_buf{};
+    size_type m_head = 0; // storage index of the oldest element
+    size_type m_size = 0;
+
+    /* Slot the next element goes in. Advances past the oldest element when full. */
+    constexpr reference slot_for_push() noexcept
+    {
+        size_type const i = (m_head + m_size) & s_mask;
+        if (m_size == N) {
+            m_head = (m_head + 1) & s_mask;
+        } else {
+            ++m_size;
+        }
+        return m_buf[i];
+    }
+
+    template <typename ValueT>
+    constexpr Segments<ValueT> make_segments(ValueT* data) const noexcept
+    {
+        size_type const first = std::min(m_size, N - m_head);
+        return {{data + m_head, first}, {data, m_size - first}};
+    }
+};
+
+template <typename T, sz N>
+Ring_Buffer<T, N>::Ring_Buffer(Ring_Buffer const& o) noexcept(
+    std::is_nothrow_copy_assignable_v<T>)
+    : m_buf(), m_head(0), m_size(o.m_size)
+{
+    // NOTE(sdsmith): sds::Array is not copyable. Copy the live elements only, unwrapped.
+    o.copy_to(m_buf.data());
+}
+
+template <typename T, sz N>
+Ring_Buffer<T, N>& Ring_Buffer<T, N>::operator=(Ring_Buffer const& o) noexcept(
+    std::is_nothrow_copy_assignable_v<T>)
+{
+    if (this != &o) {
+        o.copy_to(m_buf.data());
+        m_head = 0;
+        m_size = o.m_size;
+    }
+    return *this;
+}
+
+template <typename T, sz N>
+bool operator==(Ring_Buffer<T, N> const& a, Ring_Buffer<T, N> const& b)
+{
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+}
+
+template <typename T, sz N>
+bool operator!=(Ring_Buffer<T, N> const& a, Ring_Buffer<T, N> const& b)
+{
+    return !(a == b);
+}
+} // namespace sds
@@ -0,0 +1,457 @@
+#pragma once
+
+#include "sds/allocator/aligned_allocator.h"
+#include "sds/array/dynamic_array.h"
+#include "sds/details/common.h"
+#include "sds/iterator.h"
+#include "sds/move.h"
+#include "sds/span.h"
+#include "sds/type_traits.h"
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+namespace sds
+{
+/**
+ * \brief Structure-of-arrays container. Each field of a row is stored in its own array.
+ *
+ * A loop over one field only touches that field's memory, instead of striding over whole
+ * records. Each column is a cache line aligned \a Dynamic_Array, so \a column spans can be
+ * handed straight to SIMD loops.
+ *
+ * Rows are accessed through proxies: `operator[]` and the row iterators give a `std::tuple` of
+ * references, one per field, which works with structured bindings:
+ *
+ *     Soa_Array<float, float, u32> particles;
+ *     particles.push_back(1.0f, 2.0f, 7);
+ *     for (auto [x, y, id] : particles) { x += y; }
+ *     for (float& x : particles.column<0>()) { x *= 2.0f; }
+ *
+ * All modifiers change every column together, so the columns always have the same size.
+ * Columns can be named by index, or by type when the type appears once in \a Fields.
+ *
+ * \tparam Fields Field types, in column order.
+ */
+template <typename... Fields>
+class Soa_Array {
+    SDS_STATIC_ASSERT(sizeof...(Fields) > 0);
+
+public:
+    static constexpr size_t column_count = sizeof...(Fields);
+    static constexpr size_t column_alignment = hardware_destructive_interference_size;
+
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using value_type = std::tuple<Fields...>;
+    using reference = std::tuple<Fields&...>;
+    using const_reference = std::tuple<Fields const&...>;
+
+    template <size_t I>
+    using field_type = type_at_t<I, Fields...>;
+    template <typename T>
+    using column_type = Dynamic_Array<T, Aligned_Allocator<T, column_alignment>>;
+
+    /**
+     * \brief Random access iterator over rows. Dereferences to a row proxy.
+     */
+    template <bool is_const>
+    class Iterator {
+    public:
+        using iterator_category = sds::random_access_iterator_tag;
+        using difference_type = ptrdiff_t;
+        using value_type = Soa_Array::value_type;
+        using pointer = void;
+        using reference = std::conditional_t<is_const, Soa_Array::const_reference,
+                                             Soa_Array::reference>;
+
+        constexpr Iterator() noexcept = default;
+
+        /* iterator to const_iterator */
+        template <bool other_const, typename = std::enable_if_t<is_const && !other_const>>
+        constexpr Iterator(Iterator<other_const> const& o) noexcept
+            : m_soa(o.m_soa), m_index(o.m_index)
+        {}
+
+        reference operator*() const noexcept { return (*m_soa)[m_index]; }
+        reference operator[](difference_type n) const noexcept
+        {
+            return (*m_soa)[m_index + static_cast<size_type>(n)];
+        }
+
+        constexpr Iterator& operator++() noexcept { ++m_index; return *this; }
+        constexpr Iterator operator++(int) noexcept { Iterator it = *this; ++m_index; return it; }
+        constexpr Iterator& operator--() noexcept { --m_index; return *this; }
+        constexpr Iterator operator--(int) noexcept { Iterator it = *this; --m_index; return it; }
+
+        constexpr Iterator& operator+=(difference_type n) noexcept
+        {
+            m_index += static_cast<size_type>(n);
+            return *this;
+        }
+        constexpr Iterator& operator-=(difference_type n) noexcept
+        {
+            m_index -= static_cast<size_type>(n);
+            return *this;
+        }
+        constexpr friend Iterator operator+(Iterator a, difference_type n) noexcept
+        {
+            return a += n;
+        }
+        constexpr friend Iterator operator+(difference_type n, Iterator a) noexcept
+        {
+            return a += n;
+        }
+        constexpr friend Iterator operator-(Iterator a, difference_type n) noexcept
+        {
+            return a -= n;
+        }
+        constexpr friend difference_type operator-(Iterator const& a, Iterator const& b) noexcept
+        {
+            return static_cast<difference_type>(a.m_index - b.m_index);
+        }
+
+        constexpr friend bool operator==(Iterator const& a, Iterator const& b) noexcept
+        {
+            return a.m_index == b.m_index;
+        }
+        constexpr friend bool operator!=(Iterator const& a, Iterator const& b) noexcept
+        {
+            return a.m_index != b.m_index;
+        }
+        constexpr friend bool operator<(Iterator const& a, Iterator const& b) noexcept
+        {
+            return a.m_index < b.m_index;
+        }
+        constexpr friend bool operator>(Iterator const& a, Iterator const& b) noexcept
+        {
+            return a.m_index > b.m_index;
+        }
+        constexpr friend bool operator<=(Iterator const& a, Iterator const& b) noexcept
+        {
+            return a.m_index <= b.m_index;
+        }
+        constexpr friend bool operator>=(Iterator const& a, Iterator const& b) noexcept
+        {
+            return a.m_index >= b.m_index;
+        }
+
+    private:
+        friend class Soa_Array;
+        template <bool>
+        friend class Iterator;
+
+        using soa_pointer = std::conditional_t<is_const, Soa_Array const*, Soa_Array*>;
+
+        soa_pointer m_soa = nullptr;
+        size_type m_index = 0;
+
+        constexpr Iterator(soa_pointer soa, size_type index) noexcept
+            : m_soa(soa), m_index(index)
+        {}
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    Soa_Array() = default;
+
+    [[nodiscard]] size_type size() const noexcept { return std::get<0>(m_columns).size(); }
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+    /**
+     * \brief Rows that fit before any column reallocates.
+     */
+    [[nodiscard]] size_type capacity() const noexcept;
+
+    void reserve(size_type n);
+    void shrink_to_fit();
+    void clear() noexcept;
+    /**
+     * \brief Add or drop rows at the end. New rows are value-initialized.
+     */
+    void resize(size_type n);
+
+    /**
+     * \brief Append a row. Takes one value per field.
+     */
+    template <typename... Args,
+              typename = std::enable_if_t<sizeof...(Args) == sizeof...(Fields)>>
+    void push_back(Args&&... values)
+    {
+        push_back_impl(indices(), std::forward<Args>(values)...);
+    }
+    void push_back(value_type const& row);
+
+    /**
+     * \brief Append \a count rows copied from one array per field.
+     *
+     * Usage: `soa.append(n, xs, ys, ids);`
+     */
+    void append(size_type count, Fields const*... columns);
+
+    void pop_back() noexcept;
+
+    /**
+     * \brief Remove row \a index, shifting later rows down.
+     */
+    void erase(size_type index) { erase(index, index + 1); }
+    /**
+     * \brief Remove rows [\a first, \a last), shifting later rows down.
+     */
+    void erase(size_type first, size_type last);
+    /**
+     * \brief Remove row \a index by moving the last row into its place. O(1), changes order.
+     */
+    void swap_remove(size_type index);
+
+    [[nodiscard]] reference operator[](size_type i) noexcept
+    {
+        return row(i, std::index_sequence_for<Fields...>());
+    }
+    [[nodiscard]] const_reference operator[](size_type i) const noexcept
+    {
+        return row(i, std::index_sequence_for<Fields...>());
+    }
+    [[nodiscard]] reference at(size_type i)
+    {
+        range_check(i);
+        return (*this)[i];
+    }
+    [[nodiscard]] const_reference at(size_type i) const
+    {
+        range_check(i);
+        return (*this)[i];
+    }
+
+    /**
+     * \brief View of column \a I. Its size is fixed, so the columns stay in sync.
+     */
+    template <size_t I>
+    [[nodiscard]] Span<field_type<I>> column() noexcept
+    {
+        auto& c = std::get<I>(m_columns);
+        return {c.data(), c.size()};
+    }
+    template <size_t I>
+    [[nodiscard]] Span<field_type<I> const> column() const noexcept
+    {
+        auto const& c = std::get<I>(m_columns);
+        return {c.data(), c.size()};
+    }
+    /**
+     * \brief View of the column of type \a T. \a T must appear once in \a Fields.
+     */
+    template <typename T>
+    [[nodiscard]] Span<T> column() noexcept
+    {
+        SDS_STATIC_ASSERT((type_count_v<T, Fields...> == 1));
+        return column<type_index_v<T, Fields...>>();
+    }
+    template <typename T>
+    [[nodiscard]] Span<T const> column() const noexcept
+    {
+        SDS_STATIC_ASSERT((type_count_v<T, Fields...> == 1));
+        return column<type_index_v<T, Fields...>>();
+    }
+
+    [[nodiscard]] iterator begin() noexcept { return {this, 0}; }
+    [[nodiscard]] iterator end() noexcept { return {this, size()}; }
+    [[nodiscard]] const_iterator begin() const noexcept { return cbegin(); }
+    [[nodiscard]] const_iterator end() const noexcept { return cend(); }
+    [[nodiscard]] const_iterator cbegin() const noexcept { return {this, 0}; }
+    [[nodiscard]] const_iterator cend() const noexcept { return {this, size()}; }
+
+    void swap(Soa_Array& o) noexcept { m_columns.swap(o.m_columns); }
+
+    friend bool operator==(Soa_Array const& a, Soa_Array const& b)
+    {
+        return a.m_columns == b.m_columns;
+    }
+    friend bool operator!=(Soa_Array const& a, Soa_Array const& b) { return !(a == b); }
+
+private:
+    using indices = std::index_sequence_for<Fields...>;
+
+    std::tuple<column_type<Fields>...> m_columns{};
+
+    template <size_t... Is>
+    reference row(size_type i, std::index_sequence<Is...>) noexcept
+    {
+        SDS_ASSERT(i < size());
+        return reference(std::get<Is>(m_columns)[i]...);
+    }
+    template <size_t... Is>
+    const_reference row(size_type i, std::index_sequence<Is...>) const noexcept
+    {
+        SDS_ASSERT(i < size());
+        return const_reference(std::get<Is>(m_columns)[i]...);
+    }
+
+    /* Apply \a f to every column. */
+    template <typename F, size_t... Is>
+    void for_each_column(F&& f, std::index_sequence<Is...>)
+    {
+        (f(std::get<Is>(m_columns)), ...);
+    }
+    template <typename F, size_t... Is>
+    void for_each_column(F&& f, std::index_sequence<Is...>) const
+    {
+        (f(std::get<Is>(m_columns)), ...);
+    }
+    template <typename F>
+    void for_each_column(F&& f)
+    {
+        for_each_column(std::forward<F>(f), indices());
+    }
+    template <typename F>
+    void for_each_column(F&& f) const
+    {
+        for_each_column(std::forward<F>(f), indices());
+    }
+
+    template <size_t... Is, typename... Args>
+    void push_back_impl(std::index_sequence<Is...>, Args&&... values);
+    template <size_t... Is>
+    void append_impl(std::index_sequence<Is...>, size_type count, Fields const*... columns);
+
+    /* Room for \a extra more rows, growing every column to the same capacity. */
+    void grow_for(size_type extra);
+    /* Drop rows past \a n. Restores sync after a column failed part way through a modifier. */
+    void truncate(size_type n) noexcept;
+
+    void range_check(size_type i) const
+    {
+        if (i >= size()) { throw std::out_of_range("Soa_Array::at"); }
+    }
+};
+
+template <typename... Fields>
+auto Soa_Array<Fields...>::capacity() const noexcept -> size_type
+{
+    size_type cap = std::get<0>(m_columns).capacity();
+    for_each_column([&cap](auto const& c) {
+        if (c.capacity() < cap) { cap = c.capacity(); }
+    });
+    return cap;
+}
+
+template <typename... Fields>
+void Soa_Array<Fields...>::reserve(size_type n)
+{
+    for_each_column([n](auto& c) { c.reserve(n); });
+}
+
+template <typename... Fields>
+void Soa_Array<Fields...>::shrink_to_fit()
+{
+    for_each_column([](auto& c) { c.shrink_to_fit(); });
+}
+
+template <typename... Fields>
+void Soa_Array<Fields...>::clear() noexcept
+{
+    for_each_column([](auto& c) { c.clear(); });
+}
+
+template <typename... Fields>
+void Soa_Array<Fields...>::resize(size_type n)
+{
+    size_type const old_size = size();
+    if (n > old_size) { grow_for(n - old_size); }
+    try {
+        for_each_column([n](auto& c) { c.resize(n); });
+    } catch (...) {
+        truncate(old_size);
+        throw;
+    }
+}
+
+template <typename... Fields>
+void Soa_Array<Fields...>::push_back(value_type const& row)
+{
+    std::apply([this](auto const&... values) { push_back_impl(indices(), values...); }, row);
+}
+
+template <typename... Fields>
+template <size_t... Is, typename... Args>
+void Soa_Array<Fields...>::push_back_impl(std::index_sequence<Is...>, Args&&... values)
+{
+    size_type const old_size = size();
+    grow_for(1);
+    try {
+        (std::get<Is>(m_columns).emplace_back(std::forward<Args>(values)), ...);
+    } catch (...) {
+        truncate(old_size);
+        throw;
+    }
+}
+
+template <typename... Fields>
+void Soa_Array<Fields...>::append(size_type count, Fields const*... columns)
+{
+    append_impl(indices(), count, columns...);
+}
+
+template <typename... Fields>
+template <size_t... Is>
+void Soa_Array<Fields...>::append_impl(std::index_sequence<Is...>, size_type count,
+                                       Fields const*... columns)
+{
+    size_type const old_size = size();
+    grow_for(count);
+    try {
+        (std::get<Is>(m_columns).insert(std::get<Is>(m_columns).cend(), columns, columns + count),
+         ...);
+    } catch (...) {
+        truncate(old_size);
+        throw;
+    }
+}
+
+template <typename... Fields>
+void Soa_Array<Fields...>::pop_back() noexcept
+{
+    SDS_ASSERT(!empty());
+    for_each_column([](auto& c) { c.pop_back(); });
+}
+
+template <typename... Fields>
+void Soa_Array<Fields...>::erase(size_type first, size_type last)
+{
+    SDS_ASSERT(first <= last && last <= size());
+    auto const f = static_cast<difference_type>(first);
+    auto const l = static_cast<difference_type>(last);
+    for_each_column([f, l](auto& c) { c.erase(c.cbegin() + f, c.cbegin() + l); });
+}
+
+template <typename... Fields>
+void Soa_Array<Fields...>::swap_remove(size_type index)
+{
+    SDS_ASSERT(index < size());
+    size_type const last = size() - 1;
+    for_each_column([index, last](auto& c) {
+        if (index != last) { c[index] = sds::move(c[last]); }
+        c.pop_back();
+    });
+}
+
+template <typename... Fields>
+void Soa_Array<Fields...>::grow_for(size_type extra)
+{
+    size_type const required = size() + extra;
+    size_type const cap = capacity();
+    if (required <= cap) { return; }
+
+    // Same policy as Dynamic_Array, but decided once so every column reallocates together
+    size_type const grown = cap + cap / 2;
+    reserve(grown > required ? grown : required);
+}
+
+template <typename... Fields>
+void Soa_Array<Fields...>::truncate(size_type n) noexcept
+{
+    for_each_column([n](auto& c) {
+        while (c.size() > n) { c.pop_back(); }
+    });
+}
+} // namespace sds
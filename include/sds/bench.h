@@ -0,0 +1,228 @@
+#pragma once
+
+/**
+ * \file bench.h
+ * \brief Small self-contained benchmark harness with baseline comparison.
+ *
+ * Meant for code that can't pull in a benchmark framework, ex. performance self-tests shipped in a
+ * service, and for gating library upgrades on a stored baseline. Set \a Bench_Config::perf_counters
+ * to also get hardware counter readings per iteration, which tell why a result changed.
+ *
+ * Usage:
+ *   sds::Bench_Results results;
+ *   results.add(sds::run_bench("sum", [&] { sds::do_not_optimize(sum(v)); }));
+ *
+ *   sds::Bench_Results baseline;
+ *   if (baseline.load("baseline.txt")) {
+ *       s32 const regressions = sds::print_report(stdout, results, &baseline);
+ *   }
+ *   results.save("baseline.txt");
+ */
+
+#include "sds/details/common.h"
+
+#include "sds/perf_counters.h"
+#include "sds/string_view.h"
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace sds
+{
+/**
+ * \brief Prevent the compiler from discarding \a v or the computation that produced it.
+ */
+template <typename T>
+inline void do_not_optimize(T const& v) noexcept
+{
+#if SDS_COMPILER_GCC || SDS_COMPILER_CLANG
+    __asm__ volatile("" : : "r,m"(v) : "memory");
+#else
+    static_cast<void>(*static_cast<char const volatile*>(static_cast<void const*>(&v)));
+#endif
+}
+
+/**
+ * \brief Force pending writes to memory as far as the compiler is concerned.
+ */
+inline void clobber_memory() noexcept
+{
+#if SDS_COMPILER_GCC || SDS_COMPILER_CLANG
+    __asm__ volatile("" : : : "memory");
+#else
+    std::atomic_signal_fence(std::memory_order_acq_rel);
+#endif
+}
+
+enum class Bench_Clock : u32 {
+    steady = 0, // std::chrono::steady_clock
+    tsc,        // sds::read_tsc, converted with sds::tsc_ticks_per_ns
+};
+
+struct Bench_Config {
+    Bench_Clock clock = Bench_Clock::steady;
+    /* Time spent running the function before sampling, to settle caches, branch predictors and
+     * clock frequency. Calibration runs count towards it. */
+    double warmup_ms = 50.0;
+    /* Iterations per sample are doubled until a sample takes at least this long, so clock
+     * resolution and call overhead are negligible. */
+    double min_sample_ms = 1.0;
+    s32 sample_count = 31;
+    u64 max_iterations = u64{1} << 32;
+    /* Also read hardware counters around each sample, see \a Perf_Counters. Counters that aren't
+     * permitted are skipped. */
+    bool perf_counters = false;
+};
+
+/**
+ * \brief Summary of samples, in nanoseconds per iteration.
+ */
+struct Bench_Stats {
+    double median = 0.0;
+    /* Median absolute deviation from the median. Multiply by 1.4826 to estimate the standard
+     * deviation of normally distributed samples. */
+    double mad = 0.0;
+    double mean = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+    double p10 = 0.0;
+    double p90 = 0.0;
+    double p99 = 0.0;
+};
+
+/**
+ * \brief Value below which \a p of the sorted samples fall, interpolated. \a p is in [0, 1].
+ */
+[[nodiscard]] double percentile(double const* sorted, size_t count, double p) noexcept;
+
+/**
+ * \brief Summarize samples. Sorts them in place.
+ */
+[[nodiscard]] Bench_Stats bench_stats(double* samples, size_t count);
+
+struct Bench_Result {
+    std::string name{};
+    u64 iterations = 0; // per sample
+    std::vector<double> samples{}; // sorted, nanoseconds per iteration
+    Bench_Stats stats{};
+    /* Counter readings per iteration over all samples, when requested by Bench_Config. Not saved
+     * with the results. */
+    Perf_Counter_Values counters{};
+};
+
+namespace details
+{
+using Bench_Sample_Fn = u64 (*)(void* ctx, u64 iterations, Bench_Clock clock);
+
+/* Clock reading in clock ticks. */
+[[nodiscard]] u64 bench_now(Bench_Clock clock) noexcept;
+
+Bench_Result run_bench(String_View name, Bench_Config const& config, Bench_Sample_Fn sample,
+                       void* ctx);
+} // namespace details
+
+/**
+ * \brief Time \a f, called with no arguments, and summarize per call timings.
+ *
+ * Warms up and calibrates the iteration count, then takes \a config.sample_count samples of that
+ * many calls each. Use \a sds::do_not_optimize on results so the work isn't optimized out.
+ */
+template <typename F>
+Bench_Result run_bench(String_View name, F&& f, Bench_Config const& config = {})
+{
+    // Only the timed loop is instantiated per F, the rest of the harness is shared
+    auto sample = [](void* ctx, u64 iterations, Bench_Clock clock) -> u64 {
+        F& fn = *static_cast<std::remove_reference_t<F>*>(ctx);
+        u64 const t0 = details::bench_now(clock);
+        for (u64 i = 0; i < iterations; ++i) { fn(); }
+        return details::bench_now(clock) - t0;
+    };
+    return details::run_bench(name, config, sample,
+                              const_cast<void*>(static_cast<void const*>(&f)));
+}
+
+enum class Bench_Verdict : u32 {
+    unchanged = 0,
+    improved,
+    regressed,
+    missing, // no baseline to compare against
+};
+
+char const* to_string(Bench_Verdict v) noexcept;
+
+struct Bench_Compare_Config {
+    /* Significance level of the rank test. */
+    double alpha = 0.001;
+    /* Smallest relative change of the median worth reporting. Keeps tiny but significant shifts
+     * from failing a gate. */
+    double min_effect = 0.05;
+};
+
+struct Bench_Comparison {
+    Bench_Verdict verdict = Bench_Verdict::missing;
+    /* Current median over baseline median. Above 1 is slower. */
+    double ratio = 1.0;
+    /* Two-sided p-value of the Mann-Whitney U test that both sample sets come from the same
+     * distribution. */
+    double p_value = 1.0;
+};
+
+/**
+ * \brief Compare the samples of two runs of the same benchmark.
+ *
+ * A change is reported when the rank test is significant at \a config.alpha and the medians differ
+ * by at least \a config.min_effect. The rank test makes no normality assumption, which timings
+ * rarely satisfy.
+ */
+[[nodiscard]] Bench_Comparison compare(Bench_Result const& baseline, Bench_Result const& current,
+                                       Bench_Compare_Config const& config = {});
+
+/**
+ * \brief Named benchmark results that can be saved as a baseline and loaded back.
+ *
+ * The file is line based text: a version line, then per result its name, iteration count and
+ * samples separated by tabs. Names must not contain tabs or line breaks.
+ */
+class Bench_Results {
+public:
+    /**
+     * \brief Add \a r, replacing a result with the same name.
+     */
+    Bench_Result const& add(Bench_Result r);
+
+    /**
+     * \return Result named \a name or nullptr.
+     */
+    [[nodiscard]] Bench_Result const* find(std::string_view name) const noexcept;
+
+    [[nodiscard]] size_t size() const noexcept { return m_results.size(); }
+    [[nodiscard]] bool empty() const noexcept { return m_results.empty(); }
+    [[nodiscard]] auto begin() const noexcept { return m_results.cbegin(); }
+    [[nodiscard]] auto end() const noexcept { return m_results.cend(); }
+
+    /**
+     * \return False if the file couldn't be written.
+     */
+    bool save(char const* path) const;
+    /**
+     * \brief Replace the contents with the results in \a path.
+     * \return False if the file couldn't be read or is malformed. The contents are unchanged.
+     */
+    bool load(char const* path);
+
+private:
+    std::vector<Bench_Result> m_results{};
+};
+
+/**
+ * \brief Print one line per result. With a baseline, also print how each result compares to it.
+ * Results with counter readings get a second line with the readings per iteration.
+ * \return Number of regressions.
+ */
+s32 print_report(std::FILE* out, Bench_Results const& current,
+                 Bench_Results const* baseline = nullptr,
+                 Bench_Compare_Config const& config = {});
+} // namespace sds
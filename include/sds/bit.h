@@ -1,9 +1,29 @@
 #pragma once
 
 #include "sds/details/common.h"
-//#include <intrin0.h>
 #include <climits>
 
+#if SDS_USE_COMPILER_BUILTINS
+#    if SDS_COMPILER_MSC
+#        include <intrin.h>
+#    elif defined(__BMI2__)
+#        include <immintrin.h>
+#    endif
+#endif
+
+/*
+ * NOTE(sdsmith): The bit operations below are header inline so they can fold into callers' loops.
+ * With builtins enabled they lower to a single instruction when the target supports it (ex.
+ * `-mpopcnt`, `-mlzcnt`, `-mbmi2`), and fall back to portable code in constant expressions.
+ */
+
+/* BMI2 pdep/pext are only used when the compile target guarantees them. */
+#if SDS_USE_COMPILER_BUILTINS && (defined(__BMI2__) || (SDS_COMPILER_MSC && defined(__AVX2__)))
+#    define SDS_I_BIT_USE_BMI2 1
+#else
+#    define SDS_I_BIT_USE_BMI2 0
+#endif
+
 namespace sds
 {
 /**
@@ -101,6 +121,403 @@ constexpr u32 bitmask() noexcept
     }
 }
 
-[[nodiscard]] s32 bit_count(u32 x) noexcept;
-[[nodiscard]] s32 bit_count(u64 x) noexcept;
+namespace details
+{
+/*
+ * Portable implementations. Used in constant expressions and when compiler builtins are disabled.
+ */
+
+constexpr s32 soft_bit_count(u64 x) noexcept
+{
+    // SWAR popcount
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<s32>((x * 0x0101010101010101ULL) >> 56);
+}
+
+constexpr s32 soft_count_leading_zeros(u64 x, s32 width) noexcept
+{
+    s32 n = 0;
+    for (s32 i = width - 1; i >= 0 && ((x >> i) & 1) == 0; --i) { ++n; }
+    return n;
+}
+
+constexpr s32 soft_count_trailing_zeros(u64 x, s32 width) noexcept
+{
+    s32 n = 0;
+    while (n < width && ((x >> n) & 1) == 0) { ++n; }
+    return n;
+}
+
+constexpr u64 soft_pdep(u64 src, u64 mask) noexcept
+{
+    u64 dst = 0;
+    for (u64 bit = 1; mask != 0; bit <<= 1) {
+        if (src & bit) { dst |= mask & (~mask + 1); }
+        mask &= mask - 1;
+    }
+    return dst;
+}
+
+constexpr u64 soft_pext(u64 src, u64 mask) noexcept
+{
+    u64 dst = 0;
+    for (u64 bit = 1; mask != 0; bit <<= 1) {
+        if (src & mask & (~mask + 1)) { dst |= bit; }
+        mask &= mask - 1;
+    }
+    return dst;
+}
+} // namespace details
+
+/**
+ * \brief Number of set bits.
+ */
+[[nodiscard]] constexpr s32 bit_count(u32 x) noexcept
+{
+#if SDS_USE_COMPILER_BUILTINS
+#    if SDS_COMPILER_MSC
+    if (SDS_IS_CONSTANT_EVALUATED()) { return details::soft_bit_count(x); }
+    return static_cast<s32>(__popcnt(x));
+#    else
+    return __builtin_popcount(x);
+#    endif
+#else
+    return details::soft_bit_count(x);
+#endif
+}
+
+/**
+ * \brief Number of set bits.
+ */
+[[nodiscard]] constexpr s32 bit_count(u64 x) noexcept
+{
+#if SDS_USE_COMPILER_BUILTINS
+#    if SDS_COMPILER_MSC && SDS_ARCH_AMD64
+    if (SDS_IS_CONSTANT_EVALUATED()) { return details::soft_bit_count(x); }
+    return static_cast<s32>(__popcnt64(x));
+#    elif SDS_COMPILER_MSC
+    if (SDS_IS_CONSTANT_EVALUATED()) { return details::soft_bit_count(x); }
+    return static_cast<s32>(__popcnt(static_cast<u32>(x)) + __popcnt(static_cast<u32>(x >> 32)));
+#    else
+    return __builtin_popcountll(x);
+#    endif
+#else
+    return details::soft_bit_count(x);
+#endif
+}
+
+/**
+ * \brief Number of consecutive 0 bits starting from the most significant bit.
+ *
+ * \return Bit width of the type if \a x is 0.
+ */
+[[nodiscard]] constexpr s32 count_leading_zeros(u32 x) noexcept
+{
+    if (x == 0) { return bit_size<u32>(); }
+#if SDS_USE_COMPILER_BUILTINS
+#    if SDS_COMPILER_MSC
+    if (SDS_IS_CONSTANT_EVALUATED()) { return details::soft_count_leading_zeros(x, 32); }
+    unsigned long index = 0;
+    _BitScanReverse(&index, x);
+    return 31 - static_cast<s32>(index);
+#    else
+    return __builtin_clz(x);
+#    endif
+#else
+    return details::soft_count_leading_zeros(x, 32);
+#endif
+}
+
+/**
+ * \brief Number of consecutive 0 bits starting from the most significant bit.
+ *
+ * \return Bit width of the type if \a x is 0.
+ */
+[[nodiscard]] constexpr s32 count_leading_zeros(u64 x) noexcept
+{
+    if (x == 0) { return bit_size<u64>(); }
+#if SDS_USE_COMPILER_BUILTINS
+#    if SDS_COMPILER_MSC && SDS_ARCH_AMD64
+    if (SDS_IS_CONSTANT_EVALUATED()) { return details::soft_count_leading_zeros(x, 64); }
+    unsigned long index = 0;
+    _BitScanReverse64(&index, x);
+    return 63 - static_cast<s32>(index);
+#    elif SDS_COMPILER_MSC
+    u32 const hi = static_cast<u32>(x >> 32);
+    return hi != 0 ? count_leading_zeros(hi) : 32 + count_leading_zeros(static_cast<u32>(x));
+#    else
+    return __builtin_clzll(x);
+#    endif
+#else
+    return details::soft_count_leading_zeros(x, 64);
+#endif
+}
+
+/**
+ * \brief Number of consecutive 0 bits starting from the least significant bit.
+ *
+ * \return Bit width of the type if \a x is 0.
+ */
+[[nodiscard]] constexpr s32 count_trailing_zeros(u32 x) noexcept
+{
+    if (x == 0) { return bit_size<u32>(); }
+#if SDS_USE_COMPILER_BUILTINS
+#    if SDS_COMPILER_MSC
+    if (SDS_IS_CONSTANT_EVALUATED()) { return details::soft_count_trailing_zeros(x, 32); }
+    unsigned long index = 0;
+    _BitScanForward(&index, x);
+    return static_cast<s32>(index);
+#    else
+    return __builtin_ctz(x);
+#    endif
+#else
+    return details::soft_count_trailing_zeros(x, 32);
+#endif
+}
+
+/**
+ * \brief Number of consecutive 0 bits starting from the least significant bit.
+ *
+ * \return Bit width of the type if \a x is 0.
+ */
+[[nodiscard]] constexpr s32 count_trailing_zeros(u64 x) noexcept
+{
+    if (x == 0) { return bit_size<u64>(); }
+#if SDS_USE_COMPILER_BUILTINS
+#    if SDS_COMPILER_MSC && SDS_ARCH_AMD64
+    if (SDS_IS_CONSTANT_EVALUATED()) { return details::soft_count_trailing_zeros(x, 64); }
+    unsigned long index = 0;
+    _BitScanForward64(&index, x);
+    return static_cast<s32>(index);
+#    elif SDS_COMPILER_MSC
+    u32 const lo = static_cast<u32>(x);
+    return lo != 0 ? count_trailing_zeros(lo)
+                   : 32 + count_trailing_zeros(static_cast<u32>(x >> 32));
+#    else
+    return __builtin_ctzll(x);
+#    endif
+#else
+    return details::soft_count_trailing_zeros(x, 64);
+#endif
+}
+
+/**
+ * \brief Rotate bits left by \a s. Negative \a s rotates right.
+ *
+ * NOTE(sdsmith): Written so that compilers recognize the idiom and emit a single rotate.
+ */
+[[nodiscard]] constexpr u32 rotl(u32 x, s32 s) noexcept
+{
+    u32 const r = static_cast<u32>(s) & 31U;
+    return (x << r) | (x >> ((32U - r) & 31U));
+}
+
+/**
+ * \brief Rotate bits left by \a s. Negative \a s rotates right.
+ */
+[[nodiscard]] constexpr u64 rotl(u64 x, s32 s) noexcept
+{
+    u32 const r = static_cast<u32>(s) & 63U;
+    return (x << r) | (x >> ((64U - r) & 63U));
+}
+
+/**
+ * \brief Rotate bits right by \a s. Negative \a s rotates left.
+ */
+[[nodiscard]] constexpr u32 rotr(u32 x, s32 s) noexcept
+{
+    u32 const r = static_cast<u32>(s) & 31U;
+    return (x >> r) | (x << ((32U - r) & 31U));
+}
+
+/**
+ * \brief Rotate bits right by \a s. Negative \a s rotates left.
+ */
+[[nodiscard]] constexpr u64 rotr(u64 x, s32 s) noexcept
+{
+    u32 const r = static_cast<u32>(s) & 63U;
+    return (x >> r) | (x << ((64U - r) & 63U));
+}
+
+/**
+ * \brief Reverse the byte order.
+ */
+[[nodiscard]] constexpr u16 byte_swap(u16 x) noexcept
+{
+#if SDS_USE_COMPILER_BUILTINS && (SDS_COMPILER_GCC || SDS_COMPILER_CLANG)
+    return __builtin_bswap16(x);
+#else
+    return static_cast<u16>((x << 8) | (x >> 8));
+#endif
+}
+
+/**
+ * \brief Reverse the byte order.
+ */
+[[nodiscard]] constexpr u32 byte_swap(u32 x) noexcept
+{
+#if SDS_USE_COMPILER_BUILTINS && (SDS_COMPILER_GCC || SDS_COMPILER_CLANG)
+    return __builtin_bswap32(x);
+#else
+#    if SDS_USE_COMPILER_BUILTINS && SDS_COMPILER_MSC
+    if (!SDS_IS_CONSTANT_EVALUATED()) { return _byteswap_ulong(x); }
+#    endif
+    return ((x & 0x000000FFU) << 24) | ((x & 0x0000FF00U) << 8) | ((x & 0x00FF0000U) >> 8) |
+           ((x & 0xFF000000U) >> 24);
+#endif
+}
+
+/**
+ * \brief Reverse the byte order.
+ */
+[[nodiscard]] constexpr u64 byte_swap(u64 x) noexcept
+{
+#if SDS_USE_COMPILER_BUILTINS && (SDS_COMPILER_GCC || SDS_COMPILER_CLANG)
+    return __builtin_bswap64(x);
+#else
+#    if SDS_USE_COMPILER_BUILTINS && SDS_COMPILER_MSC
+    if (!SDS_IS_CONSTANT_EVALUATED()) { return _byteswap_uint64(x); }
+#    endif
+    return (static_cast<u64>(byte_swap(static_cast<u32>(x))) << 32) |
+           byte_swap(static_cast<u32>(x >> 32));
+#endif
+}
+
+/**
+ * \brief Floor of log base 2. Index of the most significant set bit.
+ *
+ * \param x Must be non-zero.
+ */
+[[nodiscard]] constexpr s32 log2(u32 x) noexcept
+{
+    SDS_ASSERT(x != 0);
+    return 31 - count_leading_zeros(x);
+}
+
+/**
+ * \brief Floor of log base 2. Index of the most significant set bit.
+ *
+ * \param x Must be non-zero.
+ */
+[[nodiscard]] constexpr s32 log2(u64 x) noexcept
+{
+    SDS_ASSERT(x != 0);
+    return 63 - count_leading_zeros(x);
+}
+
+/**
+ * \brief Largest power of 2 not greater than \a x. 0 if \a x is 0.
+ */
+[[nodiscard]] constexpr u32 bit_floor(u32 x) noexcept
+{
+    return x == 0 ? 0 : (1U << log2(x));
+}
+
+/**
+ * \brief Largest power of 2 not greater than \a x. 0 if \a x is 0.
+ */
+[[nodiscard]] constexpr u64 bit_floor(u64 x) noexcept
+{
+    return x == 0 ? 0 : (1ULL << log2(x));
+}
+
+/**
+ * \brief Smallest power of 2 not less than \a x.
+ *
+ * \param x Result must be representable in the type.
+ */
+[[nodiscard]] constexpr u32 bit_ceil(u32 x) noexcept
+{
+    if (x <= 1) { return 1; }
+    SDS_ASSERT(x <= (1U << 31));
+    return 1U << (32 - count_leading_zeros(x - 1));
+}
+
+/**
+ * \brief Smallest power of 2 not less than \a x.
+ *
+ * \param x Result must be representable in the type.
+ */
+[[nodiscard]] constexpr u64 bit_ceil(u64 x) noexcept
+{
+    if (x <= 1) { return 1; }
+    SDS_ASSERT(x <= (1ULL << 63));
+    return 1ULL << (64 - count_leading_zeros(x - 1));
+}
+
+/**
+ * \brief True if \a x is a power of 2.
+ */
+[[nodiscard]] constexpr bool is_pow2(u64 x) noexcept { return x != 0 && (x & (x - 1)) == 0; }
+
+/**
+ * \brief Parallel bit deposit. Scatter the low bits of \a src to the set bit positions of \a mask.
+ *
+ * Ex: `pdep(0b101, 0b11010) == 0b10010`
+ */
+[[nodiscard]] constexpr u32 pdep(u32 src, u32 mask) noexcept
+{
+#if SDS_I_BIT_USE_BMI2
+    if (!SDS_IS_CONSTANT_EVALUATED()) { return _pdep_u32(src, mask); }
+#endif
+    return static_cast<u32>(details::soft_pdep(src, mask));
+}
+
+/**
+ * \brief Parallel bit deposit. Scatter the low bits of \a src to the set bit positions of \a mask.
+ */
+[[nodiscard]] constexpr u64 pdep(u64 src, u64 mask) noexcept
+{
+#if SDS_I_BIT_USE_BMI2 && SDS_ARCH_AMD64
+    if (!SDS_IS_CONSTANT_EVALUATED()) { return _pdep_u64(src, mask); }
+#endif
+    return details::soft_pdep(src, mask);
+}
+
+/**
+ * \brief Parallel bit extract. Gather the bits of \a src at the set bit positions of \a mask into
+ * the low bits of the result.
+ *
+ * Ex: `pext(0b10110, 0b11010) == 0b101`
+ */
+[[nodiscard]] constexpr u32 pext(u32 src, u32 mask) noexcept
+{
+#if SDS_I_BIT_USE_BMI2
+    if (!SDS_IS_CONSTANT_EVALUATED()) { return _pext_u32(src, mask); }
+#endif
+    return static_cast<u32>(details::soft_pext(src, mask));
+}
+
+/**
+ * \brief Parallel bit extract. Gather the bits of \a src at the set bit positions of \a mask into
+ * the low bits of the result.
+ */
+[[nodiscard]] constexpr u64 pext(u64 src, u64 mask) noexcept
+{
+#if SDS_I_BIT_USE_BMI2 && SDS_ARCH_AMD64
+    if (!SDS_IS_CONSTANT_EVALUATED()) { return _pext_u64(src, mask); }
+#endif
+    return details::soft_pext(src, mask);
+}
+/**
+ * \brief Number of set bits in a range of words.
+ *
+ * Picks the widest kernel the executing CPU supports: AVX-512 VPOPCNTDQ, AVX2 Harley-Seal or
+ * POPCNT. Prefer this over a loop of single word \a bit_count calls for large bitmaps.
+ *
+ * \param words Start of the range.
+ * \param count Number of words.
+ */
+[[nodiscard]] s64 bit_count(u64 const* words, sz count) noexcept;
+
+/**
+ * \brief Number of set bits in a range of words.
+ *
+ * \see bit_count(u64 const*, sz)
+ */
+[[nodiscard]] s64 bit_count(u32 const* words, sz count) noexcept;
 }; // namespace sds
+
+#undef SDS_I_BIT_USE_BMI2
@@ -22,6 +22,8 @@ template <sz N>
 class Bitarray {
     static constexpr s32 s_num_trailing_bits = N % sds::bit_size<u32>();
     static constexpr s32 s_arr_els = sds::bits_fit_in_num_elements<u32>(N);
+    /* Below this many words an inline loop beats the call into the bulk popcount kernel. */
+    static constexpr s32 s_bulk_count_min_els = 64;
     sds::Array<u32, s_arr_els> m_arr{0};
 
     void fill(bool v) noexcept;
@@ -171,14 +173,14 @@ bool Bitarray<N>::none() const noexcept
 template <sz N>
 std::optional<sz> Bitarray<N>::first_unset() const noexcept
 {
-    // TODO(sdsmith): @perf: find first set optimization
-
-    s32 i = 0;
-    while (i < N) {
-        s32 el_idx = i / sds::bit_size<u32>();
-        s32 shift = i % sds::bit_size<u32>();
-        if ((m_arr[el_idx] & (1 << shift)) == 0) { return i; }
-        ++i;
+    for (s32 el_idx = 0; el_idx < s_arr_els; ++el_idx) {
+        u32 const unset = ~m_arr[el_idx];
+        if (unset != 0) {
+            // Unused trailing bits are 0, so they show up as unset here
+            sz const i = el_idx * sds::bit_size<u32>() + sds::count_trailing_zeros(unset);
+            if (i < N) { return i; }
+            return {};
+        }
     }
     return {};
 }
@@ -204,9 +206,13 @@ bool Bitarray<N>::test(s32 pos) const noexcept
 template <sz N>
 s32 Bitarray<N>::count() const noexcept
 {
-    s32 count = 0;
-    for (u32 e : m_arr) { count += sds::bit_count(e); }
-    return count;
+    if constexpr (s_arr_els >= s_bulk_count_min_els) {
+        return static_cast<s32>(sds::bit_count(m_arr.data(), s_arr_els));
+    } else {
+        s32 count = 0;
+        for (u32 e : m_arr) { count += sds::bit_count(e); }
+        return count;
+    }
 }
 
 template <sz N>
@@ -304,11 +310,11 @@ sds::String Bitarray<N>::to_string() const noexcept
     //   [31..0][63..32][95..64] and so on.
     // This isn't ideal for display, and it is currently not swizzled for the user.
 
-    sz const size = m_arr.size();
-
+    // Size once, then write the characters directly
     sds::String s;
-    s.reserve(size * sds::bit_size<decltype(m_arr)::value_type>());
-    for (sz i = 0; i < size; ++i) { s += ((*this)[i] ? '1' : '0'); }
+    s.resize(static_cast<sds::String::size_type>(N));
+    char* const p = s.data();
+    for (sz i = 0; i < N; ++i) { p[i] = ((*this)[i] ? '1' : '0'); }
 
     return s;
 }
@@ -0,0 +1,94 @@
+#pragma once
+
+/**
+ * \file cache_aligned.h
+ * \brief Wrappers that keep a value on cache lines of its own.
+ *
+ * Two threads writing to different variables on the same cache line still bounce that line
+ * between their cores. An array of per-thread counters or of locks is the usual victim:
+ *
+ *   sds::Cache_Aligned<std::atomic<u64>> counters[16];
+ *   counters[sds::thread_index() % 16]->fetch_add(1, std::memory_order_relaxed);
+ *
+ * \a Cache_Aligned starts the value on a line boundary and rounds its size up to whole lines. It
+ * relies on the storage honouring its alignment, which `new`, std::allocator and \a Dynamic_Array
+ * do since C++17. \a Padded puts a full line of padding on both sides instead, for storage that
+ * only guarantees `alignof(T)`.
+ */
+
+#include "sds/details/common.h"
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace sds
+{
+/**
+ * \brief Minimum offset between two objects to avoid false sharing.
+ *
+ * NOTE(sdsmith): Not std::hardware_destructive_interference_size, which varies with the compiler
+ * flags and so can't be used in an ABI. 64 bytes on every supported architecture.
+ */
+inline constexpr size_t hardware_destructive_interference_size = 64;
+
+/**
+ * \brief Maximum size of contiguous memory that is guaranteed to share a cache line.
+ */
+inline constexpr size_t hardware_constructive_interference_size = 64;
+
+/**
+ * \brief Small index of the calling thread, for picking one of several per-thread shards.
+ *
+ * Threads are numbered in the order they first ask, so the first n threads get distinct indices
+ * modulo n.
+ */
+[[nodiscard]] inline u32 thread_index() noexcept
+{
+    static std::atomic<u32> s_next_thread{0};
+    thread_local u32 const t_index = s_next_thread.fetch_add(1, std::memory_order_relaxed);
+    return t_index;
+}
+
+/**
+ * \brief \a T aligned to, and padded to a multiple of, the cache line size.
+ */
+template <typename T>
+struct alignas(hardware_destructive_interference_size) Cache_Aligned {
+    T value{};
+
+    Cache_Aligned() = default;
+    template <typename... Args>
+    explicit Cache_Aligned(std::in_place_t, Args&&... args) : value(std::forward<Args>(args)...)
+    {}
+
+    [[nodiscard]] T& operator*() noexcept { return value; }
+    [[nodiscard]] T const& operator*() const noexcept { return value; }
+    [[nodiscard]] T* operator->() noexcept { return &value; }
+    [[nodiscard]] T const* operator->() const noexcept { return &value; }
+};
+
+/**
+ * \brief \a T with a cache line of padding before and after it, so it shares no line with its
+ * neighbours whatever the alignment of its storage.
+ *
+ * Takes up to two lines more than \a Cache_Aligned. Prefer that where over-aligned storage is
+ * available.
+ */
+template <typename T>
+struct Padded {
+    char front_padding[hardware_destructive_interference_size] = {};
+    T value{};
+    char back_padding[hardware_destructive_interference_size] = {};
+
+    Padded() = default;
+    template <typename... Args>
+    explicit Padded(std::in_place_t, Args&&... args) : value(std::forward<Args>(args)...)
+    {}
+
+    [[nodiscard]] T& operator*() noexcept { return value; }
+    [[nodiscard]] T const& operator*() const noexcept { return value; }
+    [[nodiscard]] T* operator->() noexcept { return &value; }
+    [[nodiscard]] T const* operator->() const noexcept { return &value; }
+};
+} // namespace sds
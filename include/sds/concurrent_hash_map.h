@@ -0,0 +1,315 @@
+#pragma once
+
+#include "sds/details/common.h"
+#include "sds/flat_hash_map.h"
+#include "sds/lockless.h"
+#include <memory>
+#include <optional>
+
+namespace sds
+{
+/**
+ * \brief Thread-safe hash map with lock striping.
+ *
+ * Entries are split across shards picked by the high bits of the hash. Each shard is a
+ * Flat_Hash_Map guarded by its own lock on its own cache line, so threads working on different
+ * keys rarely contend. With \a Lock = Readers_Writer_Spin_Lock lookups take the lock shared and
+ * readers of the same shard run in parallel.
+ *
+ * Entries move when a shard rehashes, so there are no references into the map: lookups return a
+ * copy or run a callback while the shard is locked. Callbacks must not use the map.
+ *
+ * Whole-map queries (size, for_each) lock one shard at a time and are not a snapshot.
+ */
+template <typename Key, typename Value, typename Hasher = Hash<Key>,
+          typename Key_Equal = std::equal_to<Key>, typename Lock = Spin_Lock,
+          typename Allocator = std::allocator<std::pair<Key const, Value>>>
+class Concurrent_Hash_Map {
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key const, Value>;
+    using size_type = size_t;
+    using hasher = Hasher;
+    using key_equal = Key_Equal;
+    using lock_type = Lock;
+    using allocator_type = Allocator;
+    using map_type = Flat_Hash_Map<Key, Value, Hasher, Key_Equal, Allocator>;
+
+    static constexpr size_type default_shard_count = 64;
+
+    Concurrent_Hash_Map() : Concurrent_Hash_Map(default_shard_count) {}
+    /**
+     * \brief Map with at least \a shard_count shards, rounded up to a power of 2.
+     */
+    explicit Concurrent_Hash_Map(size_type shard_count, Hasher const& hash = Hasher(),
+                                 Key_Equal const& eq = Key_Equal(),
+                                 Allocator const& alloc = Allocator());
+
+    Concurrent_Hash_Map(Concurrent_Hash_Map const&) = delete;
+    Concurrent_Hash_Map& operator=(Concurrent_Hash_Map const&) = delete;
+
+    [[nodiscard]] size_type shard_count() const noexcept { return size_type(1) << m_shard_bits; }
+    [[nodiscard]] hasher hash_function() const { return m_hash; }
+    [[nodiscard]] key_equal key_eq() const { return m_shards[0].map.key_eq(); }
+
+    /**
+     * \brief Copy of the value for \a key, if present.
+     */
+    [[nodiscard]] std::optional<Value> find(Key const& key) const;
+    [[nodiscard]] bool contains(Key const& key) const;
+
+    /**
+     * \brief Call `f(value const&)` with the shard locked if \a key is present.
+     * \return True if \a key was found.
+     */
+    template <typename F>
+    bool visit(Key const& key, F&& f) const;
+
+    /**
+     * \brief Call `f(value&)` with the shard locked for writing if \a key is present.
+     * \return True if \a key was found.
+     */
+    template <typename F>
+    bool update(Key const& key, F&& f);
+
+    /**
+     * \return True if inserted, false if an existing value was assigned.
+     */
+    template <typename M>
+    bool insert_or_assign(Key const& key, M&& obj);
+    template <typename M>
+    bool insert_or_assign(Key&& key, M&& obj);
+
+    /**
+     * \return True if inserted, false if \a key was already present.
+     */
+    template <typename... Args>
+    bool try_emplace(Key const& key, Args&&... args);
+
+    /**
+     * \brief Value for \a key, inserting `make()` first if it is absent.
+     *
+     * \a make runs at most once per missing key, with the shard locked.
+     */
+    template <typename F>
+    Value compute_if_absent(Key const& key, F&& make);
+
+    /**
+     * \return Number of entries removed.
+     */
+    size_type erase(Key const& key);
+
+    [[nodiscard]] size_type size() const;
+    [[nodiscard]] bool empty() const { return size() == 0; }
+    void clear();
+
+    /**
+     * \brief Reserve room for \a n entries spread evenly over the shards.
+     */
+    void reserve(size_type n);
+
+    /**
+     * \brief Call `f(value_type const&)` on every entry, one locked shard at a time.
+     */
+    template <typename F>
+    void for_each(F&& f) const;
+
+private:
+    // NOTE(sdsmith): Own cache line so one shard's lock traffic does not slow its neighbours.
+    struct alignas(hardware_destructive_interference_size) Shard {
+        mutable Lock lock{};
+        map_type map{};
+    };
+
+    using read_lock = Scoped_Shared_Lock<Lock>;
+    using write_lock = Scoped_Lock<Lock>;
+
+    std::unique_ptr<Shard[]> m_shards;
+    Hasher m_hash;
+    s32 m_shard_bits;
+
+    size_type shard_index(Key const& key) const noexcept
+    {
+        if (m_shard_bits == 0) { return 0; }
+        u64 const h = static_cast<u64>(m_hash(key));
+        return static_cast<size_type>(h >> (64 - m_shard_bits));
+    }
+    Shard& shard(Key const& key) noexcept { return m_shards[shard_index(key)]; }
+    Shard const& shard(Key const& key) const noexcept { return m_shards[shard_index(key)]; }
+};
+
+template <typename Key, typename Value, typename Hasher, typename Key_Equal, typename Lock,
+          typename Allocator>
+Concurrent_Hash_Map<Key, Value, Hasher, Key_Equal, Lock, Allocator>::Concurrent_Hash_Map(
+    size_type shard_count, Hasher const& hash, Key_Equal const& eq, Allocator const& alloc)
+    : m_shards(), m_hash(hash), m_shard_bits(0)
+{
+    while ((size_type(1) << m_shard_bits) < shard_count) { ++m_shard_bits; }
+    SDS_ASSERT(m_shard_bits < 64);
+
+    m_shards = std::make_unique<Shard[]>(this->shard_count());
+    for (size_type i = 0; i < this->shard_count(); ++i) {
+        m_shards[i].map = map_type(0, hash, eq, alloc);
+    }
+}
+
+template <typename Key, typename Value, typename Hasher, typename Key_Equal, typename Lock,
+          typename Allocator>
+std::optional<Value>
+Concurrent_Hash_Map<Key, Value, Hasher, Key_Equal, Lock, Allocator>::find(Key const& key) const
+{
+    Shard const& s = shard(key);
+    read_lock guard(s.lock);
+    auto const it = s.map.find(key);
+    if (it == s.map.end()) { return std::nullopt; }
+    return it->second;
+}
+
+template <typename Key, typename Value, typename Hasher, typename Key_Equal, typename Lock,
+          typename Allocator>
+bool Concurrent_Hash_Map<Key, Value, Hasher, Key_Equal, Lock, Allocator>::contains(
+    Key const& key) const
+{
+    Shard const& s = shard(key);
+    read_lock guard(s.lock);
+    return s.map.contains(key);
+}
+
+template <typename Key, typename Value, typename Hasher, typename Key_Equal, typename Lock,
+          typename Allocator>
+template <typename F>
+bool Concurrent_Hash_Map<Key, Value, Hasher, Key_Equal, Lock, Allocator>::visit(Key const& key,
+                                                                                F&& f) const
+{
+    Shard const& s = shard(key);
+    read_lock guard(s.lock);
+    auto const it = s.map.find(key);
+    if (it == s.map.end()) { return false; }
+    f(it->second);
+    return true;
+}
+
+template <typename Key, typename Value, typename Hasher, typename Key_Equal, typename Lock,
+          typename Allocator>
+template <typename F>
+bool Concurrent_Hash_Map<Key, Value, Hasher, Key_Equal, Lock, Allocator>::update(Key const& key,
+                                                                                 F&& f)
+{
+    Shard& s = shard(key);
+    write_lock guard(s.lock);
+    auto const it = s.map.find(key);
+    if (it == s.map.end()) { return false; }
+    f(it->second);
+    return true;
+}
+
+template <typename Key, typename Value, typename Hasher, typename Key_Equal, typename Lock,
+          typename Allocator>
+template <typename M>
+bool Concurrent_Hash_Map<Key, Value, Hasher, Key_Equal, Lock, Allocator>::insert_or_assign(
+    Key const& key, M&& obj)
+{
+    Shard& s = shard(key);
+    write_lock guard(s.lock);
+    return s.map.insert_or_assign(key, std::forward<M>(obj)).second;
+}
+
+template <typename Key, typename Value, typename Hasher, typename Key_Equal, typename Lock,
+          typename Allocator>
+template <typename M>
+bool Concurrent_Hash_Map<Key, Value, Hasher, Key_Equal, Lock, Allocator>::insert_or_assign(
+    Key&& key, M&& obj)
+{
+    Shard& s = shard(key);
+    write_lock guard(s.lock);
+    return s.map.insert_or_assign(sds::move(key), std::forward<M>(obj)).second;
+}
+
+template <typename Key, typename Value, typename Hasher, typename Key_Equal, typename Lock,
+          typename Allocator>
+template <typename... Args>
+bool Concurrent_Hash_Map<Key, Value, Hasher, Key_Equal, Lock, Allocator>::try_emplace(
+    Key const& key, Args&&... args)
+{
+    Shard& s = shard(key);
+    write_lock guard(s.lock);
+    return s.map.try_emplace(key, std::forward<Args>(args)...).second;
+}
+
+template <typename Key, typename Value, typename Hasher, typename Key_Equal, typename Lock,
+          typename Allocator>
+template <typename F>
+Value Concurrent_Hash_Map<Key, Value, Hasher, Key_Equal, Lock, Allocator>::compute_if_absent(
+    Key const& key, F&& make)
+{
+    Shard& s = shard(key);
+
+    // Most calls find the key, so try under the read lock before taking the write lock
+    if constexpr (details::Has_Shared_Aquire<Lock>::value) {
+        read_lock guard(s.lock);
+        auto const it = s.map.find(key);
+        if (it != s.map.end()) { return it->second; }
+    }
+
+    write_lock guard(s.lock);
+    auto it = s.map.find(key);
+    if (it == s.map.end()) { it = s.map.try_emplace(key, make()).first; }
+    return it->second;
+}
+
+template <typename Key, typename Value, typename Hasher, typename Key_Equal, typename Lock,
+          typename Allocator>
+auto Concurrent_Hash_Map<Key, Value, Hasher, Key_Equal, Lock, Allocator>::erase(Key const& key)
+    -> size_type
+{
+    Shard& s = shard(key);
+    write_lock guard(s.lock);
+    return s.map.erase(key);
+}
+
+template <typename Key, typename Value, typename Hasher, typename Key_Equal, typename Lock,
+          typename Allocator>
+auto Concurrent_Hash_Map<Key, Value, Hasher, Key_Equal, Lock, Allocator>::size() const
+    -> size_type
+{
+    size_type n = 0;
+    for (size_type i = 0; i < shard_count(); ++i) {
+        read_lock guard(m_shards[i].lock);
+        n += m_shards[i].map.size();
+    }
+    return n;
+}
+
+template <typename Key, typename Value, typename Hasher, typename Key_Equal, typename Lock,
+          typename Allocator>
+void Concurrent_Hash_Map<Key, Value, Hasher, Key_Equal, Lock, Allocator>::clear()
+{
+    for (size_type i = 0; i < shard_count(); ++i) {
+        write_lock guard(m_shards[i].lock);
+        m_shards[i].map.clear();
+    }
+}
+
+template <typename Key, typename Value, typename Hasher, typename Key_Equal, typename Lock,
+          typename Allocator>
+void Concurrent_Hash_Map<Key, Value, Hasher, Key_Equal, Lock, Allocator>::reserve(size_type n)
+{
+    size_type const per_shard = (n + shard_count() - 1) >> m_shard_bits;
+    for (size_type i = 0; i < shard_count(); ++i) {
+        write_lock guard(m_shards[i].lock);
+        m_shards[i].map.reserve(per_shard);
+    }
+}
+
+template <typename Key, typename Value, typename Hasher, typename Key_Equal, typename Lock,
+          typename Allocator>
+template <typename F>
+void Concurrent_Hash_Map<Key, Value, Hasher, Key_Equal, Lock, Allocator>::for_each(F&& f) const
+{
+    for (size_type i = 0; i < shard_count(); ++i) {
+        read_lock guard(m_shards[i].lock);
+        for (value_type const& v : m_shards[i].map) { f(v); }
+    }
+}
+} // namespace sds
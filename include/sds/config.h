@@ -51,6 +51,19 @@
 #    define SDS_USE_STD_ITERATOR_CATEGORIES 0
 #endif
 
+/**
+ * \def SDS_USE_PROFILER
+ * \brief Record \a SDS_PROFILE_SCOPE zones. See \a sds/profile.h.
+ *
+ * Off by default, in which case the zone macros compile to nothing.
+ */
+#ifndef SDS_USE_PROFILER
+#    define SDS_USE_PROFILER 0
+#else
+#    undef SDS_USE_PROFILER
+#    define SDS_USE_PROFILER 1
+#endif
+
 /**
  * \def SDS_ASSERT
  * \brief Assert used by the library. Defaults to using cassert. Define \a
@@ -0,0 +1,157 @@
+#pragma once
+
+/**
+ * \file cpu.h
+ * \brief Runtime CPU feature detection and dispatch.
+ *
+ * One binary can run on hosts with and without a given instruction set extension. Kernels are
+ * compiled per extension with \a SDS_TARGET and the best variant is picked once at runtime through
+ * a \a Cpu_Dispatch.
+ */
+
+#include "sds/details/common.h"
+
+#include "sds/intrinsics.h"
+#include <atomic>
+
+namespace sds
+{
+/**
+ * \brief Instruction set extensions that can be queried at runtime.
+ */
+enum class Cpu_Feature : u32 {
+    sse2 = 0,
+    sse3,
+    ssse3,
+    sse41,
+    sse42,
+    popcnt,
+    lzcnt,
+    bmi1,
+    bmi2,
+    fma,
+    avx,
+    avx2,
+    avx512f,
+    avx512dq,
+    avx512cd,
+    avx512bw,
+    avx512vl,
+    avx512vbmi,
+    avx512vpopcntdq,
+
+    count
+};
+
+/**
+ * \brief Name of the feature, ex. "avx2".
+ */
+char const* to_string(Cpu_Feature f) noexcept;
+
+/**
+ * \brief Set of CPU features.
+ */
+class Cpu_Features {
+    u64 m_bits = 0;
+
+    SDS_STATIC_ASSERT(static_cast<u32>(Cpu_Feature::count) <= 64);
+
+    static constexpr u64 bit(Cpu_Feature f) noexcept { return 1ULL << static_cast<u32>(f); }
+
+public:
+    constexpr Cpu_Features() = default;
+
+    /**
+     * \brief Query the executing CPU and OS.
+     *
+     * AVX and AVX-512 features are only reported when the OS saves their register state.
+     *
+     * NOTE(sdsmith): Runs CPUID. Prefer the cached \a sds::cpu_features().
+     */
+    [[nodiscard]] static Cpu_Features detect() noexcept;
+
+    [[nodiscard]] constexpr bool has(Cpu_Feature f) const noexcept { return m_bits & bit(f); }
+
+    constexpr void set(Cpu_Feature f, bool v = true) noexcept
+    {
+        m_bits = v ? (m_bits | bit(f)) : (m_bits & ~bit(f));
+    }
+
+    [[nodiscard]] constexpr u64 bits() const noexcept { return m_bits; }
+};
+
+/**
+ * \brief Features of the executing CPU. Detected once and cached.
+ */
+[[nodiscard]] Cpu_Features const& cpu_features() noexcept;
+
+/**
+ * \brief True if the executing CPU supports the feature.
+ */
+[[nodiscard]] inline bool cpu_has(Cpu_Feature f) noexcept { return cpu_features().has(f); }
+
+/**
+ * \brief Rate of \a sds::read_tsc(). Measured against the steady clock on first call and cached.
+ *
+ * NOTE(sdsmith): The first call blocks for about 10ms. Assumes an invariant TSC, which is the
+ * case on x86 CPUs of the last decade.
+ */
+[[nodiscard]] double tsc_ticks_per_ns() noexcept;
+
+template <typename Fn>
+class Cpu_Dispatch;
+
+/**
+ * \brief Function pointer that is resolved to the best implementation for the executing CPU on
+ * first call.
+ *
+ * Constant initialized, so it is safe to use from other static initializers. After resolution a
+ * call costs one relaxed load and an indirect call.
+ *
+ * Usage:
+ *   SDS_INTERNAL s32 foo_scalar(s32 x);
+ *   SDS_TARGET("avx2") SDS_INTERNAL s32 foo_avx2(s32 x);
+ *
+ *   SDS_INTERNAL Cpu_Dispatch<s32(s32)> const foo_dispatch([](Cpu_Features const& f) {
+ *       return f.has(Cpu_Feature::avx2) ? &foo_avx2 : &foo_scalar;
+ *   });
+ *
+ *   s32 foo(s32 x) { return foo_dispatch(x); }
+ *
+ * \tparam R Return type.
+ * \tparam Args Argument types.
+ */
+template <typename R, typename... Args>
+class Cpu_Dispatch<R(Args...)> {
+public:
+    using function_type = R (*)(Args...);
+    using resolver_type = function_type (*)(Cpu_Features const&);
+
+private:
+    resolver_type m_resolver = nullptr;
+    mutable std::atomic<function_type> m_fn{nullptr};
+
+public:
+    constexpr explicit Cpu_Dispatch(resolver_type resolver) noexcept : m_resolver(resolver) {}
+    Cpu_Dispatch(Cpu_Dispatch const&) = delete;
+    Cpu_Dispatch& operator=(Cpu_Dispatch const&) = delete;
+
+    /**
+     * \brief Resolved implementation.
+     */
+    [[nodiscard]] function_type get() const noexcept
+    {
+        // NOTE(sdsmith): Concurrent first calls resolve to the same pointer, so a racing store is
+        // benign and relaxed ordering is enough.
+        function_type fn = m_fn.load(std::memory_order_relaxed);
+        if SDS_UNLIKELY(!fn) {
+            fn = m_resolver(sds::cpu_features());
+            SDS_ASSERT(fn);
+            m_fn.store(fn, std::memory_order_relaxed);
+        }
+        return fn;
+    }
+
+    R operator()(Args... args) const { return get()(static_cast<Args&&>(args)...); }
+};
+} // namespace sds
@@ -0,0 +1,845 @@
+#pragma once
+
+#include "sds/details/common.h"
+#include "sds/bit.h"
+#include "sds/hash.h"
+#include "sds/intrinsics.h"
+#include "sds/move.h"
+#include "sds/swap.h"
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/** \file flat_hash_map.h
+ * \brief Open addressing hash map with SIMD group probing ("Swiss table").
+ *
+ * ref: Matt Kulukundis. "Designing a Fast, Efficient, Cache-friendly Hash Table, Step by Step".
+ * CppCon 2017.
+ */
+
+namespace sds
+{
+namespace details
+{
+/*
+ * One control byte per slot:
+ * - full: top bit clear, the low 7 bits are the H2 bits of the hash
+ * - empty or deleted: top bit set
+ */
+using Ctrl = s8;
+constexpr Ctrl ctrl_empty = -128;
+constexpr Ctrl ctrl_deleted = -2;
+constexpr size_t ctrl_group_width = 16;
+
+/* Control bytes of a table with no capacity. Lookups find no match and stop; never written. */
+alignas(ctrl_group_width) inline Ctrl empty_ctrl_group[ctrl_group_width] = {
+    ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty,
+    ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty,
+    ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty};
+
+/*
+ * 16 control bytes matched at once. Matches are returned as a bit mask, bit i for byte i.
+ */
+#if SDS_SSE2
+class Ctrl_Group {
+    __m128i m_ctrl;
+
+public:
+    explicit Ctrl_Group(Ctrl const* p) noexcept
+        : m_ctrl(_mm_load_si128(reinterpret_cast<__m128i const*>(p)))
+    {}
+
+    [[nodiscard]] u32 match(Ctrl h2) const noexcept
+    {
+        return static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), m_ctrl)));
+    }
+    [[nodiscard]] u32 match_empty() const noexcept { return match(ctrl_empty); }
+    [[nodiscard]] u32 match_empty_or_deleted() const noexcept
+    {
+        return static_cast<u32>(_mm_movemask_epi8(m_ctrl));
+    }
+};
+#else
+class Ctrl_Group {
+    Ctrl m_ctrl[ctrl_group_width];
+
+public:
+    explicit Ctrl_Group(Ctrl const* p) noexcept { std::memcpy(m_ctrl, p, sizeof(m_ctrl)); }
+
+    [[nodiscard]] u32 match(Ctrl h2) const noexcept
+    {
+        u32 m = 0;
+        for (size_t i = 0; i < ctrl_group_width; ++i) {
+            m |= static_cast<u32>(m_ctrl[i] == h2) << i;
+        }
+        return m;
+    }
+    [[nodiscard]] u32 match_empty() const noexcept { return match(ctrl_empty); }
+    [[nodiscard]] u32 match_empty_or_deleted() const noexcept
+    {
+        u32 m = 0;
+        for (size_t i = 0; i < ctrl_group_width; ++i) {
+            m |= static_cast<u32>(m_ctrl[i] < 0) << i;
+        }
+        return m;
+    }
+};
+#endif
+} // namespace details
+
+/**
+ * \brief Hash map storing entries inline in one flat allocation.
+ *
+ * Each slot has a control byte holding 7 bits of its hash. A lookup loads a group of 16 control
+ * bytes and compares them all at once with SSE2, so most probes touch one group and compare only
+ * the keys whose hash bits match. Groups are visited with triangular probing.
+ *
+ * Erasing leaves a tombstone only if the entry's group has been full since the last rehash, since
+ * only then can a probe have passed over it. Tombstones are dropped on the next rehash.
+ *
+ * Differences from std::unordered_map:
+ * - Inserting may move entries, invalidating iterators, pointers and references.
+ * - Erasing invalidates only iterators, pointers and references to the erased entry.
+ * - Keys and values must be move constructible without throwing.
+ *
+ * \tparam Hasher Should mix all bits well. The default sds::Hash does; identity hashes like
+ * std::hash<int> do not.
+ * \tparam Allocator Allocator of value_type, as for Dynamic_Array. Rebound to allocate the
+ * combined control byte and slot array.
+ */
+template <typename Key, typename Value, typename Hasher = Hash<Key>,
+          typename Key_Equal = std::equal_to<Key>,
+          typename Allocator = std::allocator<std::pair<Key const, Value>>>
+class Flat_Hash_Map {
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key const, Value>;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using hasher = Hasher;
+    using key_equal = Key_Equal;
+    using allocator_type = Allocator;
+    using reference = value_type&;
+    using const_reference = value_type const&;
+    using pointer = value_type*;
+    using const_pointer = value_type const*;
+
+private:
+    using Ctrl = details::Ctrl;
+    using Group = details::Ctrl_Group;
+    static constexpr size_t s_group_width = details::ctrl_group_width;
+
+    // NOTE(sdsmith): Entries are moved on rehash through the non-const view of the key, which has
+    // the same layout, so string keys are not copied.
+    union Slot {
+        value_type value;
+        std::pair<Key, Value> mutable_value;
+
+        Slot() noexcept {}
+        ~Slot() noexcept {}
+    };
+
+    // Control bytes and slots share one allocation made of blocks
+    static constexpr size_t s_block_size =
+        alignof(Slot) > s_group_width ? alignof(Slot) : s_group_width;
+    struct alignas(s_block_size) Block {
+        unsigned char bytes[s_block_size];
+    };
+
+    using alloc_traits = std::allocator_traits<Allocator>;
+    using Block_Allocator = typename alloc_traits::template rebind_alloc<Block>;
+    using block_traits = std::allocator_traits<Block_Allocator>;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+public:
+    template <bool is_const>
+    class Iterator {
+        friend class Flat_Hash_Map;
+        template <bool>
+        friend class Iterator;
+
+        Ctrl const* m_ctrl = nullptr;
+        Ctrl const* m_end = nullptr;
+        Slot* m_slot = nullptr;
+
+        Iterator(Ctrl const* ctrl, Ctrl const* end, Slot* slot) noexcept
+            : m_ctrl(ctrl), m_end(end), m_slot(slot)
+        {}
+
+        void skip_empty() noexcept
+        {
+            while (m_ctrl != m_end && *m_ctrl < 0) {
+                ++m_ctrl;
+                ++m_slot;
+            }
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = ptrdiff_t;
+        using value_type = Flat_Hash_Map::value_type;
+        using pointer = std::conditional_t<is_const, value_type const*, value_type*>;
+        using reference = std::conditional_t<is_const, value_type const&, value_type&>;
+
+        Iterator() noexcept = default;
+
+        /* iterator to const_iterator */
+        template <bool other_const, typename = std::enable_if_t<is_const && !other_const>>
+        Iterator(Iterator<other_const> const& o) noexcept
+            : m_ctrl(o.m_ctrl), m_end(o.m_end), m_slot(o.m_slot)
+        {}
+
+        reference operator*() const noexcept { return m_slot->value; }
+        pointer operator->() const noexcept { return &m_slot->value; }
+
+        // prefix inc
+        Iterator& operator++() noexcept
+        {
+            ++m_ctrl;
+            ++m_slot;
+            skip_empty();
+            return *this;
+        }
+        // postfix inc
+        Iterator operator++(int) noexcept
+        {
+            Iterator it = *this;
+            ++(*this);
+            return it;
+        }
+
+        friend bool operator==(Iterator const& a, Iterator const& b) noexcept
+        {
+            return a.m_ctrl == b.m_ctrl;
+        }
+        friend bool operator!=(Iterator const& a, Iterator const& b) noexcept
+        {
+            return !(a == b);
+        }
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    Flat_Hash_Map() : m_storage() {}
+    explicit Flat_Hash_Map(size_type bucket_count, Hasher const& hash = Hasher(),
+                           Key_Equal const& eq = Key_Equal(),
+                           Allocator const& alloc = Allocator())
+        : m_storage(Block_Allocator(alloc)), m_hash(hash), m_eq(eq)
+    {
+        reserve(bucket_count);
+    }
+    explicit Flat_Hash_Map(Allocator const& alloc) : m_storage(Block_Allocator(alloc)) {}
+    Flat_Hash_Map(std::initializer_list<value_type> l, Allocator const& alloc = Allocator())
+        : m_storage(Block_Allocator(alloc))
+    {
+        insert(l);
+    }
+    Flat_Hash_Map(Flat_Hash_Map const& o)
+        : m_storage(block_traits::select_on_container_copy_construction(o.m_storage)),
+          m_hash(o.m_hash),
+          m_eq(o.m_eq)
+    {
+        copy_entries(o);
+    }
+    Flat_Hash_Map(Flat_Hash_Map&& o) noexcept
+        : m_storage(sds::move(o.alloc())), m_hash(sds::move(o.m_hash)), m_eq(sds::move(o.m_eq))
+    {
+        steal(o);
+    }
+    ~Flat_Hash_Map() noexcept { release(); }
+
+    Flat_Hash_Map& operator=(Flat_Hash_Map const& o);
+    Flat_Hash_Map& operator=(Flat_Hash_Map&& o) noexcept(
+        block_traits::propagate_on_container_move_assignment::value ||
+        block_traits::is_always_equal::value);
+
+    [[nodiscard]] allocator_type get_allocator() const noexcept { return allocator_type(alloc()); }
+    [[nodiscard]] hasher hash_function() const { return m_hash; }
+    [[nodiscard]] key_equal key_eq() const { return m_eq; }
+
+    [[nodiscard]] iterator begin() noexcept { return iterator_at(0, true); }
+    [[nodiscard]] const_iterator begin() const noexcept { return cbegin(); }
+    [[nodiscard]] const_iterator cbegin() const noexcept
+    {
+        return const_cast<Flat_Hash_Map*>(this)->begin();
+    }
+    [[nodiscard]] iterator end() noexcept { return iterator_at(m_storage.capacity, false); }
+    [[nodiscard]] const_iterator end() const noexcept { return cend(); }
+    [[nodiscard]] const_iterator cend() const noexcept
+    {
+        return const_cast<Flat_Hash_Map*>(this)->end();
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return m_storage.size == 0; }
+    [[nodiscard]] size_type size() const noexcept { return m_storage.size; }
+    [[nodiscard]] size_type max_size() const noexcept
+    {
+        return static_cast<size_type>(block_traits::max_size(alloc())) / sizeof(Slot);
+    }
+
+    /**
+     * \brief Number of slots. Up to 7/8 of them are used before growing.
+     */
+    [[nodiscard]] size_type capacity() const noexcept { return m_storage.capacity; }
+    [[nodiscard]] float load_factor() const noexcept
+    {
+        return capacity() == 0 ? 0.0f
+                               : static_cast<float>(size()) / static_cast<float>(capacity());
+    }
+
+    /**
+     * \brief Destroy all entries. Keeps the capacity.
+     */
+    void clear() noexcept;
+
+    /**
+     * \brief Make room for \a n entries without rehashing.
+     */
+    void reserve(size_type n);
+
+    std::pair<iterator, bool> insert(value_type const& v) { return try_emplace(v.first, v.second); }
+    std::pair<iterator, bool> insert(value_type&& v)
+    {
+        // NOTE(sdsmith): The key is const, so it is copied
+        return try_emplace(v.first, sds::move(v.second));
+    }
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        for (; first != last; ++first) { insert(*first); }
+    }
+    void insert(std::initializer_list<value_type> l) { insert(l.begin(), l.end()); }
+
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args);
+
+    /**
+     * \brief Insert a value constructed from \a args if \a key is not present. \a key and \a args
+     * are left untouched if it is.
+     */
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(Key const& key, Args&&... args)
+    {
+        return try_emplace_impl(key, std::forward<Args>(args)...);
+    }
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args)
+    {
+        return try_emplace_impl(sds::move(key), std::forward<Args>(args)...);
+    }
+
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(Key const& key, M&& obj)
+    {
+        return insert_or_assign_impl(key, std::forward<M>(obj));
+    }
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(Key&& key, M&& obj)
+    {
+        return insert_or_assign_impl(sds::move(key), std::forward<M>(obj));
+    }
+
+    Value& operator[](Key const& key) { return try_emplace(key).first->second; }
+    Value& operator[](Key&& key) { return try_emplace(sds::move(key)).first->second; }
+
+    Value& at(Key const& key) noexcept(false)
+    {
+        size_type const i = find_index(key, hash_of(key));
+        if SDS_UNLIKELY(i == npos) { throw std::out_of_range("key not in Flat_Hash_Map"); }
+        return m_storage.slots[i].value.second;
+    }
+    Value const& at(Key const& key) const noexcept(false)
+    {
+        return const_cast<Flat_Hash_Map*>(this)->at(key);
+    }
+
+    [[nodiscard]] iterator find(Key const& key) noexcept
+    {
+        size_type const i = find_index(key, hash_of(key));
+        return i == npos ? end() : iterator_at(i, false);
+    }
+    [[nodiscard]] const_iterator find(Key const& key) const noexcept
+    {
+        return const_cast<Flat_Hash_Map*>(this)->find(key);
+    }
+    [[nodiscard]] bool contains(Key const& key) const noexcept
+    {
+        return find_index(key, hash_of(key)) != npos;
+    }
+    [[nodiscard]] size_type count(Key const& key) const noexcept { return contains(key) ? 1 : 0; }
+
+    /**
+     * \brief Erase the entry at \a pos. Returns the iterator following it.
+     */
+    iterator erase(const_iterator pos) noexcept
+    {
+        size_type const i = index_of(pos);
+        erase_at(i);
+        return iterator_at(i + 1, true);
+    }
+    iterator erase(iterator pos) noexcept { return erase(const_iterator(pos)); }
+
+    /**
+     * \brief Erase the entry with \a key. Returns the number of entries erased, 0 or 1.
+     */
+    size_type erase(Key const& key) noexcept
+    {
+        size_type const i = find_index(key, hash_of(key));
+        if (i == npos) { return 0; }
+        erase_at(i);
+        return 1;
+    }
+
+    void swap(Flat_Hash_Map& o) noexcept;
+
+    friend bool operator==(Flat_Hash_Map const& a, Flat_Hash_Map const& b)
+    {
+        if (a.size() != b.size()) { return false; }
+        for (const_reference e : a) {
+            const_iterator const it = b.find(e.first);
+            if (it == b.end() || !(it->second == e.second)) { return false; }
+        }
+        return true;
+    }
+    friend bool operator!=(Flat_Hash_Map const& a, Flat_Hash_Map const& b) { return !(a == b); }
+
+private:
+    // Empty base optimization: stateless allocators take no space
+    struct Storage : Block_Allocator {
+        Ctrl* ctrl = details::empty_ctrl_group;
+        Slot* slots = nullptr;
+        size_type capacity = 0;   // power of 2, at least one group, or 0
+        size_type group_mask = 0; // number of groups - 1
+        size_type size = 0;
+        size_type growth_left = 0; // empty slots that can be filled before growing
+
+        Storage() = default;
+        explicit Storage(Block_Allocator const& alloc) noexcept : Block_Allocator(alloc) {}
+        explicit Storage(Block_Allocator&& alloc) noexcept : Block_Allocator(sds::move(alloc)) {}
+        Storage(Storage const&) = delete;
+        Storage& operator=(Storage const&) = delete;
+    };
+
+    Storage m_storage;
+    Hasher m_hash = Hasher();
+    Key_Equal m_eq = Key_Equal();
+
+    Block_Allocator& alloc() noexcept { return m_storage; }
+    Block_Allocator const& alloc() const noexcept { return m_storage; }
+
+    static constexpr size_type growth_limit(size_type capacity) noexcept
+    {
+        return capacity - capacity / 8;
+    }
+
+    /* Smallest capacity holding \a n entries. */
+    static size_type capacity_for(size_type n) noexcept
+    {
+        size_type cap = s_group_width;
+        while (growth_limit(cap) < n) { cap *= 2; }
+        return cap;
+    }
+
+    static size_type num_blocks(size_type capacity) noexcept
+    {
+        return (capacity + s_block_size - 1) / s_block_size +
+               (capacity * sizeof(Slot) + s_block_size - 1) / s_block_size;
+    }
+
+    /* Low bits pick the control byte tag, the rest the first group to probe. */
+    static Ctrl h2(size_type hash) noexcept { return static_cast<Ctrl>(hash & 0x7F); }
+    static size_type h1(size_type hash) noexcept { return hash >> 7; }
+
+    size_type hash_of(Key const& key) const noexcept { return static_cast<size_type>(m_hash(key)); }
+
+    iterator iterator_at(size_type i, bool skip) noexcept
+    {
+        iterator it(m_storage.ctrl + i, m_storage.ctrl + m_storage.capacity, m_storage.slots + i);
+        if (skip) { it.skip_empty(); }
+        return it;
+    }
+
+    size_type index_of(const_iterator pos) const noexcept
+    {
+        SDS_ASSERT(pos.m_ctrl >= m_storage.ctrl && pos.m_ctrl < m_storage.ctrl + capacity());
+        return static_cast<size_type>(pos.m_ctrl - m_storage.ctrl);
+    }
+
+    /* Slot index of \a key, or npos. */
+    size_type find_index(Key const& key, size_type hash) const noexcept;
+
+    /* First empty or deleted slot on the probe sequence of \a hash. */
+    size_type find_first_non_full(size_type hash) const noexcept;
+
+    /* Claim a slot for a new entry with \a hash, growing if needed. The slot is unconstructed. */
+    size_type prepare_insert(size_type hash);
+
+    template <typename K, typename... Args>
+    std::pair<iterator, bool> try_emplace_impl(K&& key, Args&&... args);
+
+    template <typename K, typename M>
+    std::pair<iterator, bool> insert_or_assign_impl(K&& key, M&& obj);
+
+    /* Construct the entry of a slot claimed by prepare_insert. Releases the slot on throw. */
+    template <typename... Args>
+    void construct_at(size_type i, Args&&... args);
+
+    void erase_at(size_type i) noexcept
+    {
+        block_traits::destroy(alloc(), &m_storage.slots[i].value);
+        erase_ctrl(i);
+    }
+
+    void erase_ctrl(size_type i) noexcept;
+
+    /* Move to a table of \a capacity, dropping tombstones. */
+    void resize(size_type capacity);
+    void grow()
+    {
+        // Rehashing at the same size is enough when at least half the usable slots are tombstones
+        if (capacity() == 0) {
+            resize(s_group_width);
+        } else {
+            resize(size() >= growth_limit(capacity()) / 2 ? capacity() * 2 : capacity());
+        }
+    }
+
+    void allocate(size_type capacity);
+    void destroy_entries() noexcept;
+    void release() noexcept;
+    void reset() noexcept;
+    void steal(Flat_Hash_Map& o) noexcept;
+    void copy_entries(Flat_Hash_Map const& o);
+};
+
+template <typename Key, typename Value, typename Hasher, typename Key_Equal, typename Allocator>
+Flat_Hash_Map<Key, Value, Hasher, Key_Equal, Allocator>&
+Flat_Hash_Map<Key, Value, Hasher, Key_Equal, Allocator>::operator=(Flat_Hash_Map const& o)
+{
+    if SDS_UNLIKELY(this == &o) { return *this; }
+
+    if constexpr (block_traits::propagate_on_container_copy_assignment::value) {
+        if (!block_traits::is_always_equal::value && alloc() != o.alloc()) {
+            release();
+            reset();
+        }
+        alloc() = o.alloc();
+    }
+    clear();
+    m_hash = o.m_hash;
+    m_eq = o.m_eq;
+    copy_entries(o);
+    return *this;
+}
+
+template <typename Key, typename Value, typename Hasher, typename Key_Equal, typename Allocator>
+Flat_Hash_Map<Key, Value, Hasher, Key_Equal, Allocator>&
+Flat_Hash_Map<Key, Value, Hasher, Key_Equal, Allocator>::operator=(Flat_Hash_Map&& o) noexcept(
+    block_traits::propagate_on_container_move_assignment::value ||
+    block_traits::is_always_equal::value)
+{
+    if SDS_UNLIKELY(this == &o) { return *this; }
+
+    m_hash = sds::move(o.m_hash);
+    m_eq = sds::move(o.m_eq);
+    if constexpr (block_traits::propagate_on_container_move_assignment::value) {
+        release();
+        alloc() = sds::move(o.alloc());
+        steal(o);
+    } else {
+        if (block_traits::is_always_equal::value || alloc() == o.alloc()) {
+            release();
+            steal(o);
+        } else {
+            // Memory from another allocator can't be adopted
+            clear();
+            reserve(o.size());
+            for (value_type& e : o) {
+                try_emplace(sds::move(const_cast<Key&>(e.first)), sds::move(e.second));
+            }
+            o.clear();
+        }
+    }
+    return *this;
+}
+
+template <typename Key, typename Value, typename Hasher, typename Key_Equal, typename Allocator>
+void Flat_Hash_Map<Key, Value, Hasher, Key_Equal, Allocator>::clear() noexcept
+{
+    if (capacity() == 0) { return; }
+
+    destroy_entries();
+    std::memset(m_storage.ctrl, details::ctrl_empty, capacity());
+    m_storage.size = 0;
+    m_storage.growth_left = growth_limit(capacity());
+}
+
+template <typename Key, typename Value, typename Hasher, typename Key_Equal, typename Allocator>
+void Flat_Hash_Map<Key, Value, Hasher, Key_Equal, Allocator>::reserve(size_type n)
+{
+    if (n > size() + m_storage.growth_left) { resize(capacity_for(n)); }
+}
+
+template <typename Key, typename Value, typename Hasher, typename Key_Equal, typename Allocator>
+template <typename... Args>
+std::pair<typename Flat_Hash_Map<Key, Value, Hasher, Key_Equal, Allocator>::iterator, bool>
+Flat_Hash_Map<Key, Value, Hasher, Key_Equal, Allocator>::emplace(Args&&... args)
+{
+    // The key is only known once the entry is constructed
+    std::pair<Key, Value> e(std::forward<Args>(args)...);
+    return try_emplace_impl(sds::move(e.first), sds::move(e.second));
+}
+
+template <typename Key, typename Value, typename Hasher, typename Key_Equal, typename Allocator>
+template <typename K, typename... Args>
+std::pair<typename Flat_Hash_Map<Key, Value, Hasher, Key_Equal, Allocator>::iterator, bool>
+Flat_Hash_Map<Key, Value, Hasher, Key_Equal, Allocator>::try_emplace_impl(K&& key,
+                                                                         Args&&... args)
+{
+    size_type const hash = hash_of(key);
+    size_type i = find_index(key, hash);
+    if (i != npos) { return {iterator_at(i, false), false}; }
+
+    i = prepare_insert(hash);
+    construct_at(i, std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+                 std::forward_as_tuple(std::forward<Args>(args)...));
+    return {iterator_at(i, false), true};
+}
+
+template <typename Key, typename Value, typename Hasher, typename Key_Equal, typename Allocator>
+template <typename K, typename M>
+std::pair<typename Flat_Hash_Map<Key, Value, Hasher, Key_Equal, Allocator>::iterator, bool>
+Flat_Hash_Map<Key, Value, Hasher, Key_Equal, Allocator>::insert_or_assign_impl(K&& key, M&& obj)
+{
+    size_type const hash = hash_of(key);
+    size_type i = find_index(key, hash);
+    if (i != npos) {
+        m_storage.slots[i].value.second = std::forward<M>(obj);
+        return {iterator_at(i, false), false};
+    }
+
+    i = prepare_insert(hash);
+    construct_at(i, std::forward<K>(key), std::forward<M>(obj));
+    return {iterator_at(i, false), true};
+}
+
+template <typename Key, typename Value, typename Hasher, typename Key_Equal, typename Allocator>
+typename Flat_Hash_Map<Key, Value, Hasher, Key_Equal, Allocator>::size_type
+Flat_Hash_Map<Key, Value, Hasher, Key_Equal, Allocator>::find_index(Key const& key,
+                                                                   size_type hash) const noexcept
+{
+    Ctrl const tag = h2(hash);
+    size_type g = h1(hash) & m_storage.group_mask;
+    for (size_type step = 1;; ++step) {
+        size_type const base = g * s_group_width;
+        Group const group(m_storage.ctrl + base);
+        for (u32 m = group.match(tag); m != 0; m &= m - 1) {
+            size_type const i = base + static_cast<size_type>(sds::count_trailing_zeros(m));
+            if SDS_LIKELY(m_eq(m_storage.slots[i].value.first, key)) { return i; }
+        }
+        // A probe for a key stops at the first group it could have been inserted in
+        if SDS_LIKELY(group.match_empty() != 0) { return npos; }
+        g = (g + step) & m_storage.group_mask;
+    }
+}
+
+template <typename Key, typename Value, typename Hasher, typename Key_Equal, typename Allocator>
+typename Flat_Hash_Map<Key, Value, Hasher, Key_Equal, Allocator>::size_type
+Flat_Hash_Map<Key, Value, Hasher, Key_Equal, Allocator>::find_first_non_full(
+    size_type hash) const noexcept
+{
+    size_type g = h1(hash) & m_storage.group_mask;
+    for (size_type step = 1;; ++step) {
+        size_type const base = g * s_group_width;
+        u32 const m = Group(m_storage.ctrl + base).match_empty_or_deleted();
+        if SDS_LIKELY(m != 0) {
+            return base + static_cast<size_type>(sds::count_trailing_zeros(m));
+        }
+        g = (g + step) & m_storage.group_mask;
+    }
+}
+
+template <typename Key, typename Value, typename Hasher, typename Key_Equal, typename Allocator>
+typename Flat_Hash_Map<Key, Value, Hasher, Key_Equal, Allocator>::size_type
+Flat_Hash_Map<Key, Value, Hasher, Key_Equal, Allocator>::prepare_insert(size_type hash)
+{
+    size_type i = find_first_non_full(hash);
+
+    // Reusing a tombstone doesn't use up an empty slot
+    if SDS_UNLIKELY(m_storage.growth_left == 0 && m_storage.ctrl[i] != details::ctrl_deleted) {
+        grow();
+        i = find_first_non_full(hash);
+    }
+
+    m_storage.growth_left -= static_cast<size_type>(m_storage.ctrl[i] == details::ctrl_empty);
+    m_storage.ctrl[i] = h2(hash);
+    ++m_storage.size;
+    return i;
+}
+
+template <typename Key, typename Value, typename Hasher, typename Key_Equal, typename Allocator>
+template <typename... Args>
+void Flat_Hash_Map<Key, Value, Hasher, Key_Equal, Allocator>::construct_at(size_type i,
+                                                                           Args&&... args)
+{
+    try {
+        block_traits::construct(alloc(), &m_storage.slots[i].value, std::forward<Args>(args)...);
+    } catch (...) {
+        erase_ctrl(i);
+        throw;
+    }
+}
+
+template <typename Key, typename Value, typename Hasher, typename Key_Equal, typename Allocator>
+void Flat_Hash_Map<Key, Value, Hasher, Key_Equal, Allocator>::erase_ctrl(size_type i) noexcept
+{
+    --m_storage.size;
+
+    // A group that was ever full has no empty slots until the next rehash. If this one has an
+    // empty slot, no probe has passed over it and the slot can be marked empty.
+    size_type const base = i & ~(s_group_width - 1);
+    bool const never_full = Group(m_storage.ctrl + base).match_empty() != 0;
+    m_storage.ctrl[i] = never_full ? details::ctrl_empty : details::ctrl_deleted;
+    m_storage.growth_left += static_cast<size_type>(never_full);
+}
+
+template <typename Key, typename Value, typename Hasher, typename Key_Equal, typename Allocator>
+void Flat_Hash_Map<Key, Value, Hasher, Key_Equal, Allocator>::resize(size_type new_capacity)
+{
+    SDS_ASSERT(growth_limit(new_capacity) >= size());
+
+    Ctrl* const old_ctrl = m_storage.ctrl;
+    Slot* const old_slots = m_storage.slots;
+    size_type const old_capacity = capacity();
+
+    allocate(new_capacity);
+    m_storage.growth_left = growth_limit(new_capacity) - size();
+
+    for (size_type i = 0; i < old_capacity; ++i) {
+        if (old_ctrl[i] < 0) { continue; }
+
+        Slot& src = old_slots[i];
+        size_type const hash = hash_of(src.value.first);
+        size_type const j = find_first_non_full(hash);
+        m_storage.ctrl[j] = h2(hash);
+
+        block_traits::construct(alloc(), &m_storage.slots[j].mutable_value,
+                                sds::move(src.mutable_value));
+        block_traits::destroy(alloc(), &src.mutable_value);
+    }
+
+    if (old_capacity > 0) {
+        block_traits::deallocate(alloc(), reinterpret_cast<Block*>(old_ctrl),
+                                 num_blocks(old_capacity));
+    }
+}
+
+template <typename Key, typename Value, typename Hasher, typename Key_Equal, typename Allocator>
+void Flat_Hash_Map<Key, Value, Hasher, Key_Equal, Allocator>::allocate(size_type new_capacity)
+{
+    SDS_ASSERT(new_capacity >= s_group_width && sds::is_pow2(new_capacity));
+
+    Block* const blocks = block_traits::allocate(alloc(), num_blocks(new_capacity));
+    unsigned char* const p = blocks->bytes;
+    size_type const ctrl_bytes = (new_capacity + s_block_size - 1) / s_block_size * s_block_size;
+
+    m_storage.ctrl = reinterpret_cast<Ctrl*>(p);
+    m_storage.slots = reinterpret_cast<Slot*>(p + ctrl_bytes);
+    m_storage.capacity = new_capacity;
+    m_storage.group_mask = new_capacity / s_group_width - 1;
+    std::memset(m_storage.ctrl, details::ctrl_empty, new_capacity);
+}
+
+template <typename Key, typename Value, typename Hasher, typename Key_Equal, typename Allocator>
+void Flat_Hash_Map<Key, Value, Hasher, Key_Equal, Allocator>::destroy_entries() noexcept
+{
+    if constexpr (!std::is_trivially_destructible<value_type>::value) {
+        for (size_type i = 0; i < capacity(); ++i) {
+            if (m_storage.ctrl[i] >= 0) {
+                block_traits::destroy(alloc(), &m_storage.slots[i].value);
+            }
+        }
+    }
+}
+
+template <typename Key, typename Value, typename Hasher, typename Key_Equal, typename Allocator>
+void Flat_Hash_Map<Key, Value, Hasher, Key_Equal, Allocator>::release() noexcept
+{
+    if (capacity() == 0) { return; }
+
+    destroy_entries();
+    block_traits::deallocate(alloc(), reinterpret_cast<Block*>(m_storage.ctrl),
+                             num_blocks(capacity()));
+}
+
+template <typename Key, typename Value, typename Hasher, typename Key_Equal, typename Allocator>
+void Flat_Hash_Map<Key, Value, Hasher, Key_Equal, Allocator>::reset() noexcept
+{
+    m_storage.ctrl = details::empty_ctrl_group;
+    m_storage.slots = nullptr;
+    m_storage.capacity = 0;
+    m_storage.group_mask = 0;
+    m_storage.size = 0;
+    m_storage.growth_left = 0;
+}
+
+template <typename Key, typename Value, typename Hasher, typename Key_Equal, typename Allocator>
+void Flat_Hash_Map<Key, Value, Hasher, Key_Equal, Allocator>::steal(Flat_Hash_Map& o) noexcept
+{
+    m_storage.ctrl = o.m_storage.ctrl;
+    m_storage.slots = o.m_storage.slots;
+    m_storage.capacity = o.m_storage.capacity;
+    m_storage.group_mask = o.m_storage.group_mask;
+    m_storage.size = o.m_storage.size;
+    m_storage.growth_left = o.m_storage.growth_left;
+    o.reset();
+}
+
+template <typename Key, typename Value, typename Hasher, typename Key_Equal, typename Allocator>
+void Flat_Hash_Map<Key, Value, Hasher, Key_Equal, Allocator>::copy_entries(
+    Flat_Hash_Map const& o)
+{
+    SDS_ASSERT(empty());
+    reserve(o.size());
+
+    // Keys are known to be unique, so only a free slot is needed
+    for (size_type i = 0; i < o.capacity(); ++i) {
+        if (o.m_storage.ctrl[i] < 0) { continue; }
+
+        value_type const& e = o.m_storage.slots[i].value;
+        size_type const j = prepare_insert(hash_of(e.first));
+        construct_at(j, e);
+    }
+}
+
+template <typename Key, typename Value, typename Hasher, typename Key_Equal, typename Allocator>
+void Flat_Hash_Map<Key, Value, Hasher, Key_Equal, Allocator>::swap(Flat_Hash_Map& o) noexcept
+{
+    if constexpr (block_traits::propagate_on_container_swap::value) {
+        sds::swap(alloc(), o.alloc());
+    } else {
+        SDS_ASSERT(block_traits::is_always_equal::value || alloc() == o.alloc());
+    }
+
+    sds::swap(m_hash, o.m_hash);
+    sds::swap(m_eq, o.m_eq);
+    Storage& a = m_storage;
+    Storage& b = o.m_storage;
+    sds::swap(a.ctrl, b.ctrl);
+    sds::swap(a.slots, b.slots);
+    sds::swap(a.capacity, b.capacity);
+    sds::swap(a.group_mask, b.group_mask);
+    sds::swap(a.size, b.size);
+    sds::swap(a.growth_left, b.growth_left);
+}
+} // namespace sds
@@ -0,0 +1,551 @@
+#pragma once
+
+#include "sds/details/common.h"
+#include "sds/array/dynamic_array.h"
+#include "sds/bit.h"
+#include "sds/move.h"
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/** \file flat_map.h
+ * \brief Sorted associative containers stored in one contiguous Dynamic_Array.
+ *
+ * For small to medium read-mostly maps: lookups touch a few cache lines of a single array instead
+ * of chasing tree nodes. Single inserts and erases shift the elements after them, so they are
+ * O(n). Build in bulk with \a insert_sorted_range or the range constructors instead.
+ */
+
+namespace sds
+{
+/**
+ * \brief Lookup strategy of Flat_Map and Flat_Set.
+ */
+enum class Flat_Search {
+    /** Branchless binary search over the sorted elements. No extra memory. */
+    binary,
+    /**
+     * Search a copy of the keys in Eytzinger (BFS) order, where the next probes of a search are
+     * adjacent in memory. Faster once the keys outgrow the cache, at the cost of a key copy and
+     * an index per element, rebuilt on every modification.
+     */
+    eytzinger,
+};
+
+namespace details
+{
+/*
+ * Branchless lower bound: the loop trip count only depends on \a n and the compare result
+ * advances the base arithmetically, so there are no mispredicted branches.
+ *
+ * ref: Paul-Virak Khuong, Pat Morin. "Array Layouts for Comparison-Based Searching". 2017.
+ */
+template <typename T, typename Key, typename Key_Of, typename Compare>
+size_t branchless_lower_bound(T const* base, size_t n, Key const& key, Key_Of const& key_of,
+                              Compare const& comp) noexcept
+{
+    if (n == 0) { return 0; }
+
+    T const* const first = base;
+    while (n > 1) {
+        size_t const half = n / 2;
+        // NOTE(sdsmith): GCC turns the equivalent ternary into a branch
+        base += static_cast<size_t>(comp(key_of(base[half - 1]), key)) * half;
+        n -= half;
+    }
+    return static_cast<size_t>(base - first) + static_cast<size_t>(comp(key_of(*base), key));
+}
+
+/*
+ * Keys in Eytzinger order, node k has children 2k and 2k + 1 (1-based), with the sorted index of
+ * each node.
+ */
+template <typename Key, typename Allocator>
+class Eytzinger_Index {
+    using Key_Allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Key>;
+    using Rank_Allocator =
+        typename std::allocator_traits<Allocator>::template rebind_alloc<size_t>;
+
+    Dynamic_Array<Key, Key_Allocator> m_keys;
+    Dynamic_Array<size_t, Rank_Allocator> m_rank;
+
+public:
+    Eytzinger_Index() : m_keys(), m_rank() {}
+    explicit Eytzinger_Index(Allocator const& alloc)
+        : m_keys(Key_Allocator(alloc)), m_rank(Rank_Allocator(alloc))
+    {}
+
+    template <typename T, typename Key_Of>
+    void build(T const* sorted, size_t n, Key_Of const& key_of)
+    {
+        m_keys.clear();
+        m_rank.resize(n);
+        m_keys.reserve(n);
+        for (size_t i = 0; i < n; ++i) { m_keys.emplace_back(key_of(sorted[i])); }
+
+        // In-order walk of the implicit tree hands out sorted positions
+        size_t i = 0;
+        build_node(sorted, n, key_of, i, 1);
+    }
+
+    template <typename Compare>
+    size_t lower_bound(Key const& key, Compare const& comp) const noexcept
+    {
+        size_t const n = m_keys.size();
+        Key const* const keys = m_keys.data();
+        size_t k = 1;
+        while (k <= n) { k = 2 * k + static_cast<size_t>(comp(keys[k - 1], key)); }
+
+        // Undo the right turns taken after the last left turn. k == 0: every key is less.
+        k >>= sds::count_trailing_zeros(static_cast<u64>(~k)) + 1;
+        return k == 0 ? n : m_rank[k - 1];
+    }
+
+private:
+    template <typename T, typename Key_Of>
+    void build_node(T const* sorted, size_t n, Key_Of const& key_of, size_t& i, size_t k)
+    {
+        if (k > n) { return; }
+        build_node(sorted, n, key_of, i, 2 * k);
+        m_keys[k - 1] = key_of(sorted[i]);
+        m_rank[k - 1] = i++;
+        build_node(sorted, n, key_of, i, 2 * k + 1);
+    }
+};
+
+/* Binary search needs no index. */
+template <typename Key, typename Allocator>
+class No_Index {
+public:
+    No_Index() = default;
+    explicit No_Index(Allocator const&) noexcept {}
+
+    template <typename T, typename Key_Of>
+    void build(T const*, size_t, Key_Of const&) noexcept
+    {}
+};
+
+struct Identity_Key {
+    template <typename T>
+    constexpr T const& operator()(T const& v) const noexcept
+    {
+        return v;
+    }
+};
+
+struct Pair_First_Key {
+    template <typename T>
+    constexpr auto const& operator()(T const& v) const noexcept
+    {
+        return v.first;
+    }
+};
+
+/*
+ * Shared implementation of Flat_Map and Flat_Set: unique elements sorted by key.
+ */
+template <typename Value, typename Key, typename Key_Of, typename Compare, Flat_Search search,
+          typename Allocator>
+class Flat_Base {
+public:
+    using key_type = Key;
+    using value_type = Value;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using key_compare = Compare;
+    using allocator_type = Allocator;
+    using container_type = Dynamic_Array<Value, Allocator>;
+    using reference = value_type&;
+    using const_reference = value_type const&;
+    using const_iterator = typename container_type::const_iterator;
+    using const_reverse_iterator = typename container_type::const_reverse_iterator;
+
+    [[nodiscard]] const_iterator begin() const noexcept { return m_data.begin(); }
+    [[nodiscard]] const_iterator end() const noexcept { return m_data.end(); }
+    [[nodiscard]] const_iterator cbegin() const noexcept { return m_data.cbegin(); }
+    [[nodiscard]] const_iterator cend() const noexcept { return m_data.cend(); }
+    [[nodiscard]] const_reverse_iterator rbegin() const noexcept { return m_data.rbegin(); }
+    [[nodiscard]] const_reverse_iterator rend() const noexcept { return m_data.rend(); }
+
+    [[nodiscard]] bool empty() const noexcept { return m_data.empty(); }
+    [[nodiscard]] size_type size() const noexcept { return m_data.size(); }
+    [[nodiscard]] size_type max_size() const noexcept { return m_data.max_size(); }
+    [[nodiscard]] size_type capacity() const noexcept { return m_data.capacity(); }
+    void reserve(size_type n) { m_data.reserve(n); }
+    void shrink_to_fit() { m_data.shrink_to_fit(); }
+
+    void clear() noexcept
+    {
+        m_data.clear();
+        m_index.build(m_data.data(), 0, Key_Of());
+    }
+
+    [[nodiscard]] allocator_type get_allocator() const noexcept { return m_data.get_allocator(); }
+    [[nodiscard]] key_compare key_comp() const { return m_comp; }
+
+    /**
+     * \brief The sorted elements.
+     */
+    [[nodiscard]] value_type const* data() const noexcept { return m_data.data(); }
+
+    [[nodiscard]] const_iterator lower_bound(Key const& key) const noexcept
+    {
+        return begin() + static_cast<difference_type>(lower_bound_index(key));
+    }
+    [[nodiscard]] const_iterator upper_bound(Key const& key) const noexcept
+    {
+        const_iterator it = lower_bound(key);
+        return it != end() && !m_comp(key, Key_Of()(*it)) ? it + 1 : it;
+    }
+    [[nodiscard]] const_iterator find(Key const& key) const noexcept
+    {
+        size_type const i = find_index(key);
+        return i == npos ? end() : begin() + static_cast<difference_type>(i);
+    }
+    [[nodiscard]] bool contains(Key const& key) const noexcept { return find_index(key) != npos; }
+    [[nodiscard]] size_type count(Key const& key) const noexcept { return contains(key) ? 1 : 0; }
+
+    /**
+     * \brief Insert unsorted elements. Elements whose key is already present are skipped.
+     *
+     * O(m log m + n) for m new elements.
+     */
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last);
+    void insert(std::initializer_list<value_type> l) { insert(l.begin(), l.end()); }
+
+    /**
+     * \brief Merge elements sorted by key. Elements whose key is already present, or repeated in
+     * the range, are skipped.
+     *
+     * O(n + m) for m new elements.
+     */
+    template <typename InputIt>
+    void insert_sorted_range(InputIt first, InputIt last);
+
+    size_type erase(Key const& key)
+    {
+        size_type const i = find_index(key);
+        if (i == npos) { return 0; }
+        erase_at(i);
+        return 1;
+    }
+
+    friend bool operator==(Flat_Base const& a, Flat_Base const& b) { return a.m_data == b.m_data; }
+    friend bool operator!=(Flat_Base const& a, Flat_Base const& b) { return !(a == b); }
+
+protected:
+    using Index = std::conditional_t<search == Flat_Search::eytzinger,
+                                     Eytzinger_Index<Key, Allocator>, No_Index<Key, Allocator>>;
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    container_type m_data;
+    Compare m_comp;
+    Index m_index;
+
+    Flat_Base() : m_data(), m_comp(), m_index() {}
+    explicit Flat_Base(Compare const& comp, Allocator const& alloc = Allocator())
+        : m_data(alloc), m_comp(comp), m_index(alloc)
+    {}
+
+    size_type lower_bound_index(Key const& key) const noexcept
+    {
+        if constexpr (search == Flat_Search::eytzinger) {
+            return m_index.lower_bound(key, m_comp);
+        } else {
+            return branchless_lower_bound(m_data.data(), m_data.size(), key, Key_Of(), m_comp);
+        }
+    }
+
+    size_type find_index(Key const& key) const noexcept
+    {
+        size_type const i = lower_bound_index(key);
+        return i != size() && !m_comp(key, Key_Of()(m_data[i])) ? i : npos;
+    }
+
+    /* Insert \a v at its position unless its key is present. Returns the position. */
+    template <typename V>
+    std::pair<size_type, bool> insert_unique(V&& v)
+    {
+        size_type const i = lower_bound_index(Key_Of()(v));
+        if (i != size() && !m_comp(Key_Of()(v), Key_Of()(m_data[i]))) { return {i, false}; }
+
+        m_data.insert(m_data.begin() + static_cast<difference_type>(i), std::forward<V>(v));
+        reindex();
+        return {i, true};
+    }
+
+    void erase_at(size_type i)
+    {
+        m_data.erase(m_data.begin() + static_cast<difference_type>(i));
+        reindex();
+    }
+
+    void reindex() { m_index.build(m_data.data(), m_data.size(), Key_Of()); }
+
+    /* Sort and drop repeated keys, keeping the first of each. Stable. */
+    template <typename It>
+    It sort_unique(It first, It last)
+    {
+        Key_Of const key_of;
+        Compare const& comp = m_comp;
+        std::stable_sort(first, last, [&](value_type const& a, value_type const& b) {
+            return comp(key_of(a), key_of(b));
+        });
+        return std::unique(first, last, [&](value_type const& a, value_type const& b) {
+            return !comp(key_of(a), key_of(b));
+        });
+    }
+};
+
+template <typename Value, typename Key, typename Key_Of, typename Compare, Flat_Search search,
+          typename Allocator>
+template <typename InputIt>
+void Flat_Base<Value, Key, Key_Of, Compare, search, Allocator>::insert(InputIt first,
+                                                                       InputIt last)
+{
+    // Sort the new elements at the back, then merge them in
+    size_type const old_size = size();
+    for (; first != last; ++first) { m_data.emplace_back(*first); }
+
+    auto const mid = m_data.begin() + static_cast<difference_type>(old_size);
+    auto const new_end = sort_unique(mid, m_data.end());
+    m_data.erase(new_end, m_data.end());
+
+    container_type added(m_data.get_allocator());
+    added.reserve(m_data.size() - old_size);
+    std::move(mid, m_data.end(), std::back_inserter(added));
+    m_data.erase(mid, m_data.end());
+    insert_sorted_range(std::make_move_iterator(added.begin()),
+                        std::make_move_iterator(added.end()));
+}
+
+template <typename Value, typename Key, typename Key_Of, typename Compare, Flat_Search search,
+          typename Allocator>
+template <typename InputIt>
+void Flat_Base<Value, Key, Key_Of, Compare, search, Allocator>::insert_sorted_range(InputIt first,
+                                                                                    InputIt last)
+{
+    Key_Of const key_of;
+
+    container_type merged(m_data.get_allocator());
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value) {
+        merged.reserve(size() + static_cast<size_type>(std::distance(first, last)));
+    } else {
+        merged.reserve(size());
+    }
+
+    // Merge, preferring existing elements on equal keys
+    auto it = m_data.begin();
+    auto const end = m_data.end();
+    while (first != last) {
+        decltype(auto) v = *first;
+        if (it != end && !m_comp(key_of(v), key_of(*it))) {
+            if (!m_comp(key_of(*it), key_of(v))) { ++first; } // already present
+            merged.emplace_back(sds::move(*it));
+            ++it;
+            continue;
+        }
+
+        SDS_ASSERT((merged.empty() || !m_comp(key_of(v), key_of(merged.back()))) &&
+                   "range is not sorted");
+        if (merged.empty() || m_comp(key_of(merged.back()), key_of(v))) {
+            merged.emplace_back(std::forward<decltype(v)>(v));
+        }
+        ++first;
+    }
+    for (; it != end; ++it) { merged.emplace_back(sds::move(*it)); }
+
+    m_data.swap(merged);
+    reindex();
+}
+} // namespace details
+
+/**
+ * \brief Set of unique keys kept sorted in a Dynamic_Array.
+ *
+ * Iterators are invalidated by every modification.
+ *
+ * \tparam search Lookup strategy, see Flat_Search.
+ * \tparam Allocator Allocator of Key, as for Dynamic_Array.
+ */
+template <typename Key, typename Compare = std::less<Key>, Flat_Search search = Flat_Search::binary,
+          typename Allocator = std::allocator<Key>>
+class Flat_Set
+    : public details::Flat_Base<Key, Key, details::Identity_Key, Compare, search, Allocator> {
+    using Base = details::Flat_Base<Key, Key, details::Identity_Key, Compare, search, Allocator>;
+
+public:
+    using typename Base::const_iterator;
+    using typename Base::size_type;
+    using typename Base::value_type;
+    using iterator = const_iterator;
+
+    Flat_Set() = default;
+    explicit Flat_Set(Compare const& comp, Allocator const& alloc = Allocator())
+        : Base(comp, alloc)
+    {}
+    explicit Flat_Set(Allocator const& alloc) : Base(Compare(), alloc) {}
+    template <typename InputIt>
+    Flat_Set(InputIt first, InputIt last, Compare const& comp = Compare(),
+             Allocator const& alloc = Allocator())
+        : Base(comp, alloc)
+    {
+        this->insert(first, last);
+    }
+    Flat_Set(std::initializer_list<Key> l, Compare const& comp = Compare(),
+             Allocator const& alloc = Allocator())
+        : Flat_Set(l.begin(), l.end(), comp, alloc)
+    {}
+
+    using Base::erase;
+    using Base::insert;
+
+    std::pair<iterator, bool> insert(Key const& key)
+    {
+        return to_iterator(this->insert_unique(key));
+    }
+    std::pair<iterator, bool> insert(Key&& key)
+    {
+        return to_iterator(this->insert_unique(sds::move(key)));
+    }
+
+    iterator erase(const_iterator pos)
+    {
+        size_type const i = static_cast<size_type>(pos - this->begin());
+        this->erase_at(i);
+        return this->begin() + static_cast<ptrdiff_t>(i);
+    }
+
+private:
+    std::pair<iterator, bool> to_iterator(std::pair<size_type, bool> r) const noexcept
+    {
+        return {this->begin() + static_cast<ptrdiff_t>(r.first), r.second};
+    }
+};
+
+/**
+ * \brief Map with unique keys kept sorted in a Dynamic_Array of key-value pairs.
+ *
+ * Iterators are invalidated by every modification. Keys must not be modified through iterators.
+ *
+ * \tparam search Lookup strategy, see Flat_Search.
+ * \tparam Allocator Allocator of std::pair<Key, Value>, as for Dynamic_Array.
+ */
+template <typename Key, typename Value, typename Compare = std::less<Key>,
+          Flat_Search search = Flat_Search::binary,
+          typename Allocator = std::allocator<std::pair<Key, Value>>>
+class Flat_Map : public details::Flat_Base<std::pair<Key, Value>, Key, details::Pair_First_Key,
+                                           Compare, search, Allocator> {
+    using Base = details::Flat_Base<std::pair<Key, Value>, Key, details::Pair_First_Key, Compare,
+                                    search, Allocator>;
+
+public:
+    using mapped_type = Value;
+    using typename Base::const_iterator;
+    using typename Base::size_type;
+    using typename Base::value_type;
+    using iterator = typename Base::container_type::iterator;
+
+    Flat_Map() = default;
+    explicit Flat_Map(Compare const& comp, Allocator const& alloc = Allocator())
+        : Base(comp, alloc)
+    {}
+    explicit Flat_Map(Allocator const& alloc) : Base(Compare(), alloc) {}
+    template <typename InputIt>
+    Flat_Map(InputIt first, InputIt last, Compare const& comp = Compare(),
+             Allocator const& alloc = Allocator())
+        : Base(comp, alloc)
+    {
+        this->insert(first, last);
+    }
+    Flat_Map(std::initializer_list<value_type> l, Compare const& comp = Compare(),
+             Allocator const& alloc = Allocator())
+        : Flat_Map(l.begin(), l.end(), comp, alloc)
+    {}
+
+    using Base::begin;
+    using Base::end;
+    using Base::erase;
+    using Base::find;
+    using Base::insert;
+
+    [[nodiscard]] iterator begin() noexcept { return this->m_data.begin(); }
+    [[nodiscard]] iterator end() noexcept { return this->m_data.end(); }
+
+    [[nodiscard]] iterator find(Key const& key) noexcept
+    {
+        size_type const i = this->find_index(key);
+        return i == Base::npos ? end() : at_index(i);
+    }
+
+    Value& at(Key const& key) noexcept(false)
+    {
+        size_type const i = this->find_index(key);
+        if SDS_UNLIKELY(i == Base::npos) { throw std::out_of_range("key not in Flat_Map"); }
+        return this->m_data[i].second;
+    }
+    Value const& at(Key const& key) const noexcept(false)
+    {
+        return const_cast<Flat_Map*>(this)->at(key);
+    }
+
+    Value& operator[](Key const& key) { return try_emplace(key).first->second; }
+
+    std::pair<iterator, bool> insert(value_type const& v)
+    {
+        return to_iterator(this->insert_unique(v));
+    }
+    std::pair<iterator, bool> insert(value_type&& v)
+    {
+        return to_iterator(this->insert_unique(sds::move(v)));
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(Key const& key, Args&&... args)
+    {
+        size_type const i = this->lower_bound_index(key);
+        if (i != this->size() && !this->m_comp(key, this->m_data[i].first)) {
+            return {at_index(i), false};
+        }
+        this->m_data.emplace(this->m_data.begin() + static_cast<ptrdiff_t>(i),
+                             std::piecewise_construct, std::forward_as_tuple(key),
+                             std::forward_as_tuple(std::forward<Args>(args)...));
+        this->reindex();
+        return {at_index(i), true};
+    }
+
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(Key const& key, M&& obj)
+    {
+        size_type const i = this->find_index(key);
+        if (i != Base::npos) {
+            this->m_data[i].second = std::forward<M>(obj);
+            return {at_index(i), false};
+        }
+        return try_emplace(key, std::forward<M>(obj));
+    }
+
+    iterator erase(const_iterator pos)
+    {
+        size_type const i = static_cast<size_type>(pos - this->cbegin());
+        this->erase_at(i);
+        return at_index(i);
+    }
+
+private:
+    iterator at_index(size_type i) noexcept { return begin() + static_cast<ptrdiff_t>(i); }
+
+    std::pair<iterator, bool> to_iterator(std::pair<size_type, bool> r) noexcept
+    {
+        return {at_index(r.first), r.second};
+    }
+};
+} // namespace sds
@@ -0,0 +1,312 @@
+#pragma once
+
+#include "sds/details/common.h"
+#include "sds/string_view.h"
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/** \file hash.h
+ * \brief Fast non-cryptographic 64-bit hashing.
+ *
+ * - Keys up to 256 bytes use a wyhash style core: one 64x64->128 bit multiply per 16 bytes.
+ * - Longer keys use an xxh3 style core of 8 independent accumulator lanes, vectorized with
+ *   SSE2/AVX2 at runtime.
+ *
+ * Every path is constexpr and gives the same value at compile time, at runtime and on every CPU,
+ * so hashes of literals can be computed at compile time and compared with runtime hashes.
+ *
+ * NOTE(sdsmith): Not for security. Hashes are not stable across library versions.
+ *
+ * ref: Wang Yi. "wyhash". https://github.com/wangyi-fudan/wyhash
+ * ref: Yann Collet. "xxHash - XXH3". https://github.com/Cyan4973/xxHash
+ */
+
+namespace sds
+{
+/**
+ * \brief Hash of a byte range.
+ *
+ * \param data Bytes to hash. May be null if \a size is 0.
+ * \param size Number of bytes.
+ * \param seed Seed. Different seeds give independent hash functions.
+ */
+[[nodiscard]] u64 hash_bytes(void const* data, size_t size, u64 seed = 0) noexcept;
+
+namespace details
+{
+inline constexpr u64 hash_secret[4] = {0xA0761D6478BD642FULL, 0xE7037ED1A0B428DBULL,
+                                       0x8EBC6AF09C88C6E3ULL, 0x589965CC75374CC3ULL};
+
+constexpr size_t hash_short_max = 256;
+constexpr size_t hash_stripe_size = 64;
+constexpr size_t hash_block_stripes = 16;
+constexpr size_t hash_block_size = hash_stripe_size * hash_block_stripes;
+constexpr size_t hash_lanes = 8;
+
+/* splitmix64 */
+constexpr u64 hash_secret_word(u64 i) noexcept
+{
+    u64 z = (i + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/* Key material for the long input lanes. Stripe k of a block uses words [k, k + 8). */
+struct Hash_Long_Secret {
+    static constexpr size_t size = 32;
+    static constexpr size_t scramble = hash_block_stripes + hash_lanes; // 24
+    static constexpr size_t last_stripe = 13;
+    static constexpr size_t merge = size - hash_lanes; // 24
+    u64 words[size] = {};
+
+    constexpr Hash_Long_Secret() noexcept
+    {
+        for (size_t i = 0; i < size; ++i) { words[i] = hash_secret_word(i); }
+    }
+};
+
+inline constexpr Hash_Long_Secret hash_long_secret{};
+
+/* Little-endian unaligned reads. */
+constexpr u64 hash_read_bytes(char const* p, size_t n) noexcept
+{
+    u64 v = 0;
+    for (size_t i = 0; i < n; ++i) {
+        v |= static_cast<u64>(static_cast<unsigned char>(p[i])) << (8 * i);
+    }
+    return v;
+}
+
+constexpr u64 hash_read64(char const* p) noexcept
+{
+    if (SDS_IS_CONSTANT_EVALUATED()) { return hash_read_bytes(p, 8); }
+    u64 v = 0;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+constexpr u64 hash_read32(char const* p) noexcept
+{
+    if (SDS_IS_CONSTANT_EVALUATED()) { return hash_read_bytes(p, 4); }
+    u32 v = 0;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/* 64x64->128 bit multiply. Returns the low half in a and the high half in b. */
+constexpr void hash_mum(u64& a, u64& b) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+    __extension__ using u128 = unsigned __int128;
+    u128 const r = static_cast<u128>(a) * b;
+    a = static_cast<u64>(r);
+    b = static_cast<u64>(r >> 64);
+#else
+    u64 const ha = a >> 32;
+    u64 const hb = b >> 32;
+    u64 const la = static_cast<u32>(a);
+    u64 const lb = static_cast<u32>(b);
+    u64 const rh = ha * hb;
+    u64 const rm0 = ha * lb;
+    u64 const rm1 = hb * la;
+    u64 const rl = la * lb;
+    u64 const t = rl + (rm0 << 32);
+    u64 const lo = t + (rm1 << 32);
+    u64 const carry = static_cast<u64>(t < rl) + static_cast<u64>(lo < t);
+    a = lo;
+    b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+}
+
+constexpr u64 hash_mix(u64 a, u64 b) noexcept
+{
+    hash_mum(a, b);
+    return a ^ b;
+}
+
+constexpr u64 hash_short(char const* p, size_t n, u64 seed) noexcept
+{
+    u64 const* const s = hash_secret;
+    seed ^= hash_mix(seed ^ s[0], s[1]);
+
+    u64 a = 0;
+    u64 b = 0;
+    if SDS_LIKELY(n <= 16) {
+        if SDS_LIKELY(n >= 4) {
+            size_t const off = (n >> 3) << 2;
+            a = (hash_read32(p) << 32) | hash_read32(p + off);
+            b = (hash_read32(p + n - 4) << 32) | hash_read32(p + n - 4 - off);
+        } else if SDS_LIKELY(n > 0) {
+            a = (static_cast<u64>(static_cast<unsigned char>(p[0])) << 16) |
+                (static_cast<u64>(static_cast<unsigned char>(p[n >> 1])) << 8) |
+                static_cast<u64>(static_cast<unsigned char>(p[n - 1]));
+        }
+    } else {
+        size_t i = n;
+        if SDS_UNLIKELY(i > 48) {
+            // Three independent lanes
+            u64 see1 = seed;
+            u64 see2 = seed;
+            do {
+                seed = hash_mix(hash_read64(p) ^ s[1], hash_read64(p + 8) ^ seed);
+                see1 = hash_mix(hash_read64(p + 16) ^ s[2], hash_read64(p + 24) ^ see1);
+                see2 = hash_mix(hash_read64(p + 32) ^ s[3], hash_read64(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = hash_mix(hash_read64(p) ^ s[1], hash_read64(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = hash_read64(p + i - 16);
+        b = hash_read64(p + i - 8);
+    }
+
+    a ^= s[1];
+    b ^= seed;
+    hash_mum(a, b);
+    return hash_mix(a ^ s[0] ^ n, b ^ s[1]);
+}
+
+/*
+ * Long input lanes: for each 8 byte word w of a stripe, lane j gets
+ *   acc[j] += lo32(w ^ key) * hi32(w ^ key)  and  acc[j ^ 1] += w
+ * All lanes are independent, which maps directly onto SIMD.
+ */
+using Hash_Accumulate_Fn = void (*)(u64* acc, char const* p, size_t stripes, size_t key);
+
+constexpr void hash_accumulate_scalar(u64* acc, char const* p, size_t stripes,
+                                      size_t key) noexcept
+{
+    for (size_t k = 0; k < stripes; ++k, p += hash_stripe_size) {
+        for (size_t j = 0; j < hash_lanes; ++j) {
+            u64 const w = hash_read64(p + 8 * j);
+            u64 const x = w ^ hash_long_secret.words[key + k + j];
+            acc[j ^ 1] += w;
+            acc[j] += (x & 0xFFFFFFFFULL) * (x >> 32);
+        }
+    }
+}
+
+constexpr void hash_scramble(u64* acc) noexcept
+{
+    for (size_t j = 0; j < hash_lanes; ++j) {
+        u64 const key = hash_long_secret.words[Hash_Long_Secret::scramble + j];
+        acc[j] = (acc[j] ^ (acc[j] >> 47) ^ key) * 0x9E3779B1ULL;
+    }
+}
+
+constexpr u64 hash_long(char const* p, size_t n, u64 seed,
+                        Hash_Accumulate_Fn accumulate) noexcept
+{
+    u64 acc[hash_lanes] = {0xC2B2AE3DULL ^ seed,       0x9E3779B185EBCA87ULL - seed,
+                           0xC2B2AE3D27D4EB4FULL ^ seed, 0x165667B19E3779F9ULL - seed,
+                           0x85EBCA77C2B2AE63ULL ^ seed, 0x85EBCA77ULL - seed,
+                           0x27D4EB2F165667C5ULL ^ seed, 0x9E3779B1ULL - seed};
+
+    size_t const blocks = (n - 1) / hash_block_size;
+    for (size_t b = 0; b < blocks; ++b, p += hash_block_size) {
+        accumulate(acc, p, hash_block_stripes, 0);
+        hash_scramble(acc);
+    }
+
+    // Remaining full stripes, then the last 64 bytes which may overlap them
+    size_t const rest = n - blocks * hash_block_size;
+    size_t const stripes = (rest - 1) / hash_stripe_size;
+    accumulate(acc, p, stripes, 0);
+    accumulate(acc, p + rest - hash_stripe_size, 1, Hash_Long_Secret::last_stripe);
+
+    u64 h = n * 0x9E3779B185EBCA87ULL;
+    for (size_t j = 0; j < hash_lanes; j += 2) {
+        h += hash_mix(acc[j] ^ hash_long_secret.words[Hash_Long_Secret::merge + j],
+                      acc[j + 1] ^ hash_long_secret.words[Hash_Long_Secret::merge + j + 1]);
+    }
+    h ^= h >> 37;
+    h *= 0x165667919E3779F9ULL;
+    return h ^ (h >> 32);
+}
+
+constexpr u64 hash_bytes_constexpr(char const* p, size_t n, u64 seed) noexcept
+{
+    if (n <= hash_short_max) { return hash_short(p, n, seed); }
+    return hash_long(p, n, seed, &hash_accumulate_scalar);
+}
+} // namespace details
+
+/**
+ * \brief Hash of a 64-bit integer. Bijective.
+ *
+ * ref: Pelle Evensen. "moremur". 2019.
+ */
+[[nodiscard]] constexpr u64 hash_u64(u64 x) noexcept
+{
+    x ^= x >> 27;
+    x *= 0x3C79AC492BA7B653ULL;
+    x ^= x >> 33;
+    x *= 0x1C69B3F74AC4AE35ULL;
+    x ^= x >> 27;
+    return x;
+}
+
+/**
+ * \brief Hash of an integer or enum value.
+ */
+template <typename T,
+          typename = std::enable_if_t<std::is_integral<T>::value || std::is_enum<T>::value>>
+[[nodiscard]] constexpr u64 hash(T v) noexcept
+{
+    if constexpr (std::is_enum<T>::value) {
+        return hash_u64(static_cast<u64>(static_cast<std::underlying_type_t<T>>(v)));
+    } else {
+        return hash_u64(static_cast<u64>(v));
+    }
+}
+
+/**
+ * \brief Hash of a string. Usable at compile time.
+ *
+ * ex. `constexpr u64 h = sds::hash("literal");`
+ */
+[[nodiscard]] constexpr u64 hash(String_View s, u64 seed = 0) noexcept
+{
+    if (SDS_IS_CONSTANT_EVALUATED()) {
+        return details::hash_bytes_constexpr(s.data(), s.size(), seed);
+    }
+    return hash_bytes(s.data(), s.size(), seed);
+}
+
+/**
+ * \brief Hash of a pointer value. Character pointers are hashed as strings instead.
+ */
+template <typename T, typename = std::enable_if_t<!std::is_same<std::remove_cv_t<T>, char>::value>>
+[[nodiscard]] u64 hash(T* p) noexcept
+{
+    return hash_u64(static_cast<u64>(reinterpret_cast<uintptr_t>(p)));
+}
+
+/**
+ * \brief Hash function object for containers.
+ */
+template <typename T>
+struct Hash {
+    [[nodiscard]] constexpr size_t operator()(T const& v) const noexcept
+    {
+        return static_cast<size_t>(sds::hash(v));
+    }
+};
+} // namespace sds
+
+/**
+ * \brief Compile-time hash of a string literal. Equal to `sds::hash("literal")`.
+ *
+ * ex. `switch (sds::hash(key)) { case "get"_hash: ... }`
+ */
+constexpr sds::u64 operator""_hash(char const* s, size_t n) noexcept
+{
+    return sds::details::hash_bytes_constexpr(s, n, 0);
+}
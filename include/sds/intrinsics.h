@@ -2,23 +2,108 @@
 
 #include "sds/details/common.h"
 
-#include <immintrin.h>
-#include <intrin.h>
+#if SDS_COMPILER_MSC
+#    include <intrin.h>
+#elif SDS_ARCH_X86 || SDS_ARCH_AMD64
+#    include <immintrin.h>
+#else
+#    include <chrono>
+#    include <thread>
+#endif
+
+/**
+ * \def SDS_TARGET
+ * \brief Compile a function for the given instruction set extensions regardless of the global
+ * compile target (ex. no `-mavx2` needed).
+ *
+ * Only call such a function after checking the CPU supports the extensions. See \a sds/cpu.h.
+ * MSVC always allows intrinsics, so this is a no-op there.
+ *
+ * Usage: `SDS_TARGET("avx2,bmi2") void foo();`
+ */
+#ifndef SDS_TARGET
+#    if SDS_COMPILER_GCC || SDS_COMPILER_CLANG
+#        define SDS_TARGET(isa) __attribute__((target(isa)))
+#    else
+#        define SDS_TARGET(isa)
+#    endif
+#endif
+
+/**
+ * \def SDS_NO_SANITIZE_ADDRESS
+ * \brief Exclude a function from AddressSanitizer instrumentation.
+ *
+ * For SIMD kernels that deliberately read past the end of a buffer without leaving its page.
+ */
+#ifndef SDS_NO_SANITIZE_ADDRESS
+#    if SDS_COMPILER_GCC || SDS_COMPILER_CLANG
+#        define SDS_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#    elif SDS_COMPILER_MSC
+#        define SDS_NO_SANITIZE_ADDRESS __declspec(no_sanitize_address)
+#    else
+#        define SDS_NO_SANITIZE_ADDRESS
+#    endif
+#endif
+
+/**
+ * \def SDS_NO_SANITIZE_THREAD
+ * \brief Exclude a function from ThreadSanitizer instrumentation.
+ *
+ * ThreadSanitizer also reports reads of freed memory, so the kernels that carry
+ * \a SDS_NO_SANITIZE_ADDRESS need this as well.
+ */
+#ifndef SDS_NO_SANITIZE_THREAD
+#    if SDS_COMPILER_GCC || SDS_COMPILER_CLANG
+#        define SDS_NO_SANITIZE_THREAD __attribute__((no_sanitize_thread))
+#    else
+#        define SDS_NO_SANITIZE_THREAD
+#    endif
+#endif
+
+/**
+ * \def SDS_SSE2
+ * \brief 1 when SSE2 can be used without a runtime check. Always the case on x86-64.
+ *
+ * Usage: `#if SDS_SSE2`
+ */
+#ifndef SDS_SSE2
+#    if defined(__SSE2__) || SDS_ARCH_AMD64 || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#        define SDS_SSE2 1
+#    else
+#        define SDS_SSE2 0
+#    endif
+#endif
 
 namespace sds
 {
 /**
  * \brief Reduse CPU power or yield when pause is unavailable.
  */
-void pause_or_yield() noexcept
+inline void pause_or_yield() noexcept
 {
-    // TODO(sdsmith): AMD also supports pause
-
-#if 1
+    // NOTE(sdsmith): pause is part of SSE2 and supported by both Intel and AMD.
+#if SDS_ARCH_X86 || SDS_ARCH_AMD64
     _mm_pause();
 #else
-    // TODO(sdsmith): for platforms that don't support pause
     std::this_thread::yield();
 #endif
 }
+
+/**
+ * \brief Read the CPU time stamp counter.
+ *
+ * A few cycles and not serializing, so only meaningful over intervals much longer than the
+ * pipeline. Convert to time with \a sds::tsc_ticks_per_ns(). Falls back to steady clock
+ * nanoseconds on architectures without one.
+ */
+[[nodiscard]] inline u64 read_tsc() noexcept
+{
+#if SDS_ARCH_X86 || SDS_ARCH_AMD64
+    return static_cast<u64>(__rdtsc());
+#else
+    return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                std::chrono::steady_clock::now().time_since_epoch())
+                                .count());
+#endif
+}
 } // namespace sds
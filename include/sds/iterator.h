@@ -59,8 +59,8 @@ struct Iterator_Traits<T const*> {
     using iterator_category = sds::contiguous_iterator_tag;
     using difference_type = ptrdiff;
     using value_type = T;
-    using pointer = T*;
-    using reference = T&;
+    using pointer = T const*;
+    using reference = T const&;
 };
 
 template <typename Iterator>
@@ -77,6 +77,11 @@ public:
     Reverse_Iterator() = default;
     explicit Reverse_Iterator(Iterator it) : m_iterator(it) {}
 
+    /**
+     * \brief The underlying iterator. Refers to the element after the one this refers to.
+     */
+    constexpr Iterator base() const { return m_iterator; }
+
     // TODO(sdsmith): noexcept propagation
 
     constexpr reference operator*() const
@@ -140,14 +145,22 @@ template <typename Iterator1, typename Iterator2>
 constexpr bool operator==(sds::Reverse_Iterator<Iterator1> const& a,
                           sds::Reverse_Iterator<Iterator2> const& b)
 {
-    return a.m_iterator == b.m_iterator;
+    return a.base() == b.base();
 }
 
 template <typename Iterator1, typename Iterator2>
 constexpr bool operator!=(sds::Reverse_Iterator<Iterator1> const& a,
                           sds::Reverse_Iterator<Iterator2> const& b)
 {
-    return a.m_iterator != b.m_iterator;
+    return a.base() != b.base();
+}
+
+template <typename Iterator1, typename Iterator2>
+constexpr auto operator-(sds::Reverse_Iterator<Iterator1> const& a,
+                         sds::Reverse_Iterator<Iterator2> const& b)
+    -> decltype(b.base() - a.base())
+{
+    return b.base() - a.base();
 }
 
 } // namespace sds
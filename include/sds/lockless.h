@@ -1,13 +1,17 @@
 #pragma once
 
 #include "sds/types.h"
+#include "sds/cache_aligned.h"
 #include "sds/intrinsics.h"
 #include <atomic>
-#include <functional>
-#include <thread>
+#include <type_traits>
+#include <utility>
 
 namespace sds
 {
+/*
+ * \brief Lock in a single byte. Locks next to each other false share; see \a Cache_Aligned_Lock.
+ */
 class Spin_Lock {
     std::atomic_flag m_atomic{false};
 
@@ -29,14 +33,29 @@ template <typename Lock>
 class Scoped_Lock {
     using lock_t = Lock;
 
-    lock_t m_lock;
+    lock_t* m_lock;
 
 public:
     explicit Scoped_Lock(lock_t& lock) : m_lock(&lock) { m_lock->aquire(); }
 
     ~Scoped_Lock() { m_lock->release(); }
+
+    Scoped_Lock(Scoped_Lock const&) = delete;
+    Scoped_Lock& operator=(Scoped_Lock const&) = delete;
 };
 
+namespace details
+{
+/*
+ * Non-zero value unique to each running thread. Cheaper than hashing std::thread::id.
+ */
+inline size_t current_thread_token() noexcept
+{
+    thread_local char token;
+    return reinterpret_cast<size_t>(&token);
+}
+} // namespace details
+
 template <typename RefCountT>
 class Reentrant_Spin_Lock {
     std::atomic<std::size_t> m_atomic{0};
@@ -47,8 +66,7 @@ public:
 
     void acquire() noexcept
     {
-        std::hash<std::thread::id> hasher;
-        size_t tid = hasher(std::this_thread::get_id());
+        size_t const tid = details::current_thread_token();
 
         if (m_atomic.load(std::memory_order_relaxed) != tid) {
             // thread doesn't hold lock. spin until it does.
@@ -72,22 +90,22 @@ public:
     {
         // release semantics to ensure prior writes are fully committed before unlock
 
-        std::hash<std::thread::id> hasher;
-        size_t tid = hasher(std::this_thread::get_id());
-        size_t actual = m_atomic.load(std::memory_order_release);
+        // NOTE(sdsmith): A load can't have release semantics. Only the owner reaches here, so a
+        // relaxed load suffices for the check and the unlocking store carries the release.
+        [[maybe_unused]] size_t const tid = details::current_thread_token();
+        [[maybe_unused]] size_t const actual = m_atomic.load(std::memory_order_relaxed);
         SDS_ASSERT(actual == tid);
 
         --m_ref_count;
         if (m_ref_count == 0) {
             // release lock. safe since we own it.
-            m_atomic.store(0, std::memory_order_relaxed);
+            m_atomic.store(0, std::memory_order_release);
         }
     }
 
     bool try_acquire() noexcept
     {
-        std::hash<std::thread::id> hasher;
-        size_t tid = hasher(std::this_thread::get_id());
+        size_t const tid = details::current_thread_token();
 
         bool acquired = false;
         if (m_atomic.load(std::memory_order_relaxed) == tid) {
@@ -111,7 +129,86 @@ public:
 using Reentrant_Spin_Lock32 = Reentrant_Spin_Lock<s32>;
 using Reentrant_Spin_Lock64 = Reentrant_Spin_Lock<s64>;
 
-// TODO(sdsmith): class Readers_Writer_Lock
+/**
+ * \brief Spin lock that allows many readers or one writer.
+ *
+ * A waiting writer blocks new readers, so a steady stream of readers cannot starve it.
+ */
+class Readers_Writer_Spin_Lock {
+    // Bit 0 is set while a writer holds or waits for the lock. The rest counts readers.
+    std::atomic<u32> m_state{0};
+
+    static constexpr u32 s_writer = 1;
+    static constexpr u32 s_reader = 2;
+
+public:
+    Readers_Writer_Spin_Lock() = default;
+
+    /*
+     * \brief Exclusive aquire.
+     */
+    void aquire() noexcept;
+    void release() noexcept;
+
+    /*
+     * \brief Shared aquire. Other readers may hold the lock at the same time.
+     */
+    void aquire_shared() noexcept;
+    void release_shared() noexcept;
+};
+
+namespace details
+{
+template <typename Lock, typename = void>
+struct Has_Shared_Aquire : std::false_type {};
+
+template <typename Lock>
+struct Has_Shared_Aquire<Lock, std::void_t<decltype(std::declval<Lock&>().aquire_shared())>>
+    : std::true_type {};
+} // namespace details
+
+/*
+ * \brief Releases given shared lock on destruction. Takes the lock exclusively when \a Lock has
+ * no shared mode.
+ */
+template <typename Lock>
+class Scoped_Shared_Lock {
+    using lock_t = Lock;
+
+    lock_t* m_lock;
+
+public:
+    explicit Scoped_Shared_Lock(lock_t& lock) : m_lock(&lock)
+    {
+        if constexpr (details::Has_Shared_Aquire<Lock>::value) {
+            m_lock->aquire_shared();
+        } else {
+            m_lock->aquire();
+        }
+    }
+
+    ~Scoped_Shared_Lock()
+    {
+        if constexpr (details::Has_Shared_Aquire<Lock>::value) {
+            m_lock->release_shared();
+        } else {
+            m_lock->release();
+        }
+    }
+
+    Scoped_Shared_Lock(Scoped_Shared_Lock const&) = delete;
+    Scoped_Shared_Lock& operator=(Scoped_Shared_Lock const&) = delete;
+};
+
+/**
+ * \brief \a Lock on a cache line of its own, for arrays of locks that are taken by different
+ * threads. Usable wherever \a Lock is.
+ */
+template <typename Lock>
+class alignas(hardware_destructive_interference_size) Cache_Aligned_Lock : public Lock {
+public:
+    Cache_Aligned_Lock() = default;
+};
 
 // TODO(sdsmith): cheap lock assertion
 
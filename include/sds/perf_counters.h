@@ -0,0 +1,112 @@
+#pragma once
+
+/**
+ * \file perf_counters.h
+ * \brief Hardware performance counters of the calling thread, read through Linux perf_event_open.
+ *
+ * Wall time says that code got slower, counters say why: more instructions, fewer instructions
+ * per cycle, cache or branch misses.
+ *
+ * Counters the kernel refuses are skipped, so this degrades to fewer or no counters on other
+ * platforms, in VMs without a virtual PMU and when `/proc/sys/kernel/perf_event_paranoid` forbids
+ * them. Only user space events are counted, which the default paranoid level permits.
+ *
+ * Usage:
+ *   sds::Perf_Counters counters;
+ *   counters.start();
+ *   work();
+ *   sds::Perf_Counter_Values const v = counters.stop();
+ *   if (v.has(sds::Perf_Counter::instructions)) { ... v[sds::Perf_Counter::instructions] ... }
+ */
+
+#include "sds/details/common.h"
+
+namespace sds
+{
+enum class Perf_Counter : u32 {
+    cycles = 0,
+    instructions,
+    cache_misses, // last level cache misses as defined by the CPU
+    branch_misses,
+    l1d_loads,        // L1 data cache read accesses
+    llc_loads,        // last level cache read accesses
+    page_faults,      // software event, counted without a PMU
+    context_switches, // software event, counted without a PMU
+
+    count
+};
+
+inline constexpr u32 perf_counter_count = static_cast<u32>(Perf_Counter::count);
+
+/**
+ * \brief Short name of the counter, ex. "llc_loads".
+ */
+char const* to_string(Perf_Counter c) noexcept;
+
+/**
+ * \brief Counter readings. Readings of multiplexed counters are scaled up to the full interval,
+ * so they need not be whole numbers.
+ */
+struct Perf_Counter_Values {
+    double values[perf_counter_count] = {};
+    /* Bit per Perf_Counter that was counted. */
+    u32 valid = 0;
+
+    [[nodiscard]] constexpr bool has(Perf_Counter c) const noexcept
+    {
+        return (valid >> static_cast<u32>(c)) & 1U;
+    }
+    [[nodiscard]] constexpr double operator[](Perf_Counter c) const noexcept
+    {
+        return values[static_cast<u32>(c)];
+    }
+
+    /**
+     * \brief Add the readings of \a o. Counters missing from either side become invalid.
+     */
+    Perf_Counter_Values& operator+=(Perf_Counter_Values const& o) noexcept;
+    /**
+     * \brief Divide all readings by \a d, ex. to get them per iteration.
+     */
+    Perf_Counter_Values& operator/=(double d) noexcept;
+};
+
+/**
+ * \brief Set of counters of the calling thread, opened on construction.
+ *
+ * Counts only the thread that constructed it, not threads it spawns. Not thread safe.
+ */
+class Perf_Counters {
+public:
+    Perf_Counters() noexcept;
+    ~Perf_Counters();
+
+    Perf_Counters(Perf_Counters const&) = delete;
+    Perf_Counters& operator=(Perf_Counters const&) = delete;
+
+    /**
+     * \brief Bit per Perf_Counter that could be opened.
+     */
+    [[nodiscard]] u32 available() const noexcept { return m_available; }
+    [[nodiscard]] bool has(Perf_Counter c) const noexcept
+    {
+        return (m_available >> static_cast<u32>(c)) & 1U;
+    }
+
+    /**
+     * \brief Zero and enable the counters.
+     */
+    void start() noexcept;
+    /**
+     * \brief Disable the counters and read them.
+     *
+     * A counter that the kernel never got to schedule during the interval, because more counters
+     * were requested than the PMU has, is left out of \a Perf_Counter_Values::valid.
+     */
+    Perf_Counter_Values stop() noexcept;
+
+private:
+    s32 m_fds[perf_counter_count] = {};
+    u32 m_available = 0;
+};
+} // namespace sds
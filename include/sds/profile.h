@@ -0,0 +1,116 @@
+#pragma once
+
+/**
+ * \file profile.h
+ * \brief Lightweight instrumentation zones, written out as a Chrome trace.
+ *
+ * Each zone records its name and begin and end time stamp counter readings into a ring buffer
+ * owned by the calling thread. Recording takes no locks and makes no allocations after a
+ * thread's first zone. \a sds::profile_write_chrome_trace drains all buffers into a JSON file
+ * that loads in chrome://tracing or https://ui.perfetto.dev.
+ *
+ * When a thread exits its zones are set aside for the next write and its buffer goes to the next
+ * thread that records, so thread churn doesn't grow the profiler.
+ *
+ * The macros compile to nothing unless \a SDS_USE_PROFILER is defined (see \a sds/config.h).
+ *
+ * Usage:
+ *   void update()
+ *   {
+ *       SDS_PROFILE_FUNCTION();
+ *       {
+ *           SDS_PROFILE_SCOPE("physics");
+ *           ...
+ *       }
+ *   }
+ *
+ *   sds::profile_write_chrome_trace("trace.json");
+ */
+
+#include "sds/details/common.h"
+
+#include "sds/intrinsics.h"
+#include <cstdio>
+
+/**
+ * \def SDS_PROFILE_SCOPE
+ * \brief Record the enclosing scope as a zone. \a name must outlive the profiler, ie. a string
+ * literal.
+ *
+ * Usage: `SDS_PROFILE_SCOPE("name");`
+ */
+/**
+ * \def SDS_PROFILE_FUNCTION
+ * \brief Record the enclosing function as a zone named after it.
+ *
+ * Usage: `SDS_PROFILE_FUNCTION();`
+ */
+/**
+ * \def SDS_PROFILE_THREAD_NAME
+ * \brief Name the calling thread in the trace. \a name must outlive the profiler.
+ *
+ * Usage: `SDS_PROFILE_THREAD_NAME("worker");`
+ */
+#if SDS_USE_PROFILER
+#    define SDS_PROFILE_SCOPE(name) \
+        ::sds::Profile_Scope const SDS_CONCAT(sds_profile_scope_, __LINE__)(name)
+#    define SDS_PROFILE_FUNCTION() SDS_PROFILE_SCOPE(__func__)
+#    define SDS_PROFILE_THREAD_NAME(name) ::sds::profile_set_thread_name(name)
+#else
+#    define SDS_PROFILE_SCOPE(name) static_cast<void>(0)
+#    define SDS_PROFILE_FUNCTION() static_cast<void>(0)
+#    define SDS_PROFILE_THREAD_NAME(name) static_cast<void>(0)
+#endif
+
+namespace sds
+{
+namespace details
+{
+void profile_record(char const* name, u64 begin, u64 end) noexcept;
+} // namespace details
+
+/**
+ * \brief Records a zone from construction to destruction. Use through \a SDS_PROFILE_SCOPE.
+ */
+class Profile_Scope {
+    char const* m_name = nullptr;
+    u64 m_begin = 0;
+
+public:
+    explicit Profile_Scope(char const* name) noexcept : m_name(name), m_begin(sds::read_tsc()) {}
+    ~Profile_Scope() { details::profile_record(m_name, m_begin, sds::read_tsc()); }
+
+    Profile_Scope(Profile_Scope const&) = delete;
+    Profile_Scope& operator=(Profile_Scope const&) = delete;
+};
+
+/**
+ * \brief Name the calling thread in the trace.
+ */
+void profile_set_thread_name(char const* name);
+
+/**
+ * \brief Number of zones each thread buffers between writes. Older zones are overwritten and
+ * counted as dropped.
+ */
+inline constexpr u32 profile_buffer_capacity = 16 * 1024;
+
+/**
+ * \brief Drain the zones recorded since the last write into a Chrome trace JSON document.
+ *
+ * Safe to call while other threads record zones. Zones that complete during the write are
+ * left for the next one.
+ *
+ * \return Number of zones written.
+ */
+u64 profile_write_chrome_trace(std::FILE* out);
+/**
+ * \return False if \a path couldn't be written.
+ */
+bool profile_write_chrome_trace(char const* path);
+
+/**
+ * \brief Zones overwritten before they were written out, since the start of the program.
+ */
+[[nodiscard]] u64 profile_dropped_count() noexcept;
+} // namespace sds
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "sds/details/common.h"
+#include "sds/move.h"
 #include <cstddef>
 #include <initializer_list>
 #include <iterator>
@@ -9,10 +10,17 @@
 
 namespace sds
 {
-template <typename T>
+/**
+ * \brief Singly linked list with O(1) push at both ends.
+ *
+ * \tparam T Element type.
+ * \tparam Allocator Allocator of T. Rebound to allocate nodes.
+ */
+template <typename T, typename Allocator = std::allocator<T>>
 class S_List {
 public:
     using value_type = T;
+    using allocator_type = Allocator;
     using size_type = size_t;
     using difference_type = ptrdiff_t;
     using reference = value_type&;
@@ -22,7 +30,7 @@ public:
 
     struct Node {
         value_type value = {};
-        std::unique_ptr<Node> next = nullptr;
+        Node* next = nullptr;
 
         Node(value_type value) : value(value) {}
     };
@@ -43,7 +51,7 @@ public:
         // prefix inc
         Iterator& operator++()
         {
-            m_p = m_p->next.get();
+            m_p = m_p->next;
             return *this;
         }
         // postfix inc
@@ -74,7 +82,7 @@ public:
         // prefix inc
         Const_Iterator& operator++()
         {
-            m_p = m_p->next.get();
+            m_p = m_p->next;
             return *this;
         }
         // postfix inc
@@ -98,77 +106,83 @@ public:
     using iterator = Iterator;
     using const_iterator = Const_Iterator;
 
-    S_List() {}
+private:
+    using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using node_traits = std::allocator_traits<node_allocator>;
+
+    // Empty base optimization: stateless allocators take no space
+    struct Storage : node_allocator {
+        Node* head = nullptr;
+        Node* tail = nullptr;
+        size_type size = 0;
+
+        Storage() = default;
+        explicit Storage(node_allocator const& alloc) noexcept : node_allocator(alloc) {}
+        explicit Storage(node_allocator&& alloc) noexcept : node_allocator(sds::move(alloc)) {}
+        Storage(Storage const&) = delete;
+        Storage& operator=(Storage const&) = delete;
+    };
+
+    Storage m_storage;
 
-    S_List(std::initializer_list<T> l)
+public:
+    S_List() noexcept(noexcept(Allocator())) : m_storage() {}
+    explicit S_List(Allocator const& alloc) noexcept : m_storage(node_allocator(alloc)) {}
+
+    S_List(std::initializer_list<T> l, Allocator const& alloc = Allocator())
+        : m_storage(node_allocator(alloc))
     {
-        for (value_type e : l) { push_back(e); }
+        append(l.begin(), l.end());
     }
 
     /**
      * O(n)
      */
     S_List(S_List const& o) noexcept(false)
+        : m_storage(node_traits::select_on_container_copy_construction(o.alloc()))
     {
-        std::unique_ptr<Node>* cur = &m_head;
-        std::unique_ptr<Node> const* o_cur = &o.m_head;
-        while (*o_cur) {
-            *cur = std::make_unique<Node>((*o_cur)->value);
-            o_cur = &(*o_cur)->next;
-            if (!*o_cur) {
-                m_tail = cur;
-            } else {
-                cur = &(*cur)->next;
-            }
-        }
-
-        m_size = o.m_size;
+        append(o.cbegin(), o.cend());
     }
 
     /**
        O(1)
     */
-    S_List(S_List&& o)
-    {
-        m_tail = o.m_tail;
-        m_size = o.m_size;
-        m_head = std::move(o.m_head);
-
-        if (m_size <= 1) { m_tail = &m_head; }
-    }
+    S_List(S_List&& o) noexcept : m_storage(sds::move(o.alloc())) { steal(o); }
 
     /**
        O(n)
     */
     ~S_List() { clear(); }
 
-    iterator begin() const { return Iterator(m_head.get()); }
-    iterator end() const { return Iterator((*m_tail)->next.get()); }
-    const_iterator cbegin() const { return Const_Iterator(m_head.get()); }
-    const_iterator cend() const { return Const_Iterator((*m_tail)->next.get()); }
+    allocator_type get_allocator() const noexcept { return allocator_type(alloc()); }
+
+    iterator begin() const { return Iterator(m_storage.head); }
+    iterator end() const { return Iterator(nullptr); }
+    const_iterator cbegin() const { return Const_Iterator(m_storage.head); }
+    const_iterator cend() const { return Const_Iterator(nullptr); }
 
     reference front()
     {
-        SDS_ASSERT(m_head && "UB to call front when empty");
-        return m_head->value;
+        SDS_ASSERT(m_storage.head && "UB to call front when empty");
+        return m_storage.head->value;
     }
 
     const_reference front() const
     {
-        SDS_ASSERT(m_head && "UB to call front when empty");
-        return m_head->value;
+        SDS_ASSERT(m_storage.head && "UB to call front when empty");
+        return m_storage.head->value;
     }
 
     reference back()
     {
-        SDS_ASSERT(*m_tail && "UB to call back when empty");
-        return (*m_tail)->value;
+        SDS_ASSERT(m_storage.tail && "UB to call back when empty");
+        return m_storage.tail->value;
     }
 
     const_reference back() const
     {
-        SDS_ASSERT(*m_tail && "UB to call back when empty");
-        return (*m_tail)->value;
+        SDS_ASSERT(m_storage.tail && "UB to call back when empty");
+        return m_storage.tail->value;
     }
 
     /**
@@ -176,12 +190,11 @@ public:
      */
     void push_front(value_type value)
     {
-        std::unique_ptr<Node> node = std::make_unique<Node>(value);
-        std::swap(m_head, node);
-        std::swap(m_head->next, node);
-        m_size++;
-
-        if (size() == 2) { m_tail = &m_head->next; }
+        Node* const node = make_node(sds::move(value));
+        node->next = m_storage.head;
+        m_storage.head = node;
+        if (!m_storage.tail) { m_storage.tail = node; }
+        m_storage.size++;
     }
 
     /**
@@ -189,16 +202,14 @@ public:
     */
     void push_back(value_type value)
     {
-        std::unique_ptr<Node> node = std::make_unique<Node>(value);
-
-        if (size() == 0) {
-            *m_tail = std::move(node);
+        Node* const node = make_node(sds::move(value));
+        if (m_storage.tail) {
+            m_storage.tail->next = node;
         } else {
-            (*m_tail)->next = std::move(node);
-            m_tail = &(*m_tail)->next;
+            m_storage.head = node;
         }
-
-        m_size++;
+        m_storage.tail = node;
+        m_storage.size++;
     }
 
     /**
@@ -208,13 +219,11 @@ public:
     {
         SDS_ASSERT(!empty());
 
-        std::unique_ptr<Node> node(nullptr);
-        std::swap(m_head->next, node);
-        std::swap(m_head, node);
-        node.reset();
-        m_size--;
-
-        if (m_size <= 1) { m_tail = &m_head; }
+        Node* const node = m_storage.head;
+        m_storage.head = node->next;
+        if (!m_storage.head) { m_storage.tail = nullptr; }
+        destroy_node(node);
+        m_storage.size--;
     }
 
     /**
@@ -224,17 +233,17 @@ public:
     {
         SDS_ASSERT(!empty());
 
-        m_tail->reset();
+        Node* prev = nullptr;
+        for (Node* cur = m_storage.head; cur != m_storage.tail; cur = cur->next) { prev = cur; }
 
-        std::unique_ptr<Node>* p1 = &m_head;
-        std::unique_ptr<Node>* p2 = (m_head ? &m_head->next : nullptr);
-        while (p2 && *p2) {
-            p1 = p2;
-            p2 = &(*p2)->next;
+        destroy_node(m_storage.tail);
+        m_storage.tail = prev;
+        if (prev) {
+            prev->next = nullptr;
+        } else {
+            m_storage.head = nullptr;
         }
-
-        m_tail = p1;
-        m_size--;
+        m_storage.size--;
     }
 
     /**
@@ -242,52 +251,36 @@ public:
     */
     void remove(value_type value)
     {
-        std::unique_ptr<Node>* prev = nullptr;
-        std::unique_ptr<Node>* cur = &m_head;
-        while (*cur) {
-            if ((*cur)->value == value) {
-                // Update tail
-                if (*cur == *m_tail) {
-                    m_tail = (prev ? prev : &m_head);
-                } else if ((*cur)->next == *m_tail) {
-                    // Moving this node will invalidate our pointer to it
-                    // TODO(sdsmith): we should probably make sure that pointers to elements are not
-                    // invalidated when something moves.
-                    m_tail = cur;
-                }
-
-                // Remove the node
-                *cur = std::move((*cur)->next);
-
-                m_size--;
+        Node* prev = nullptr;
+        for (Node* cur = m_storage.head; cur; cur = cur->next) {
+            if (cur->value == value) {
+                (prev ? prev->next : m_storage.head) = cur->next;
+                if (cur == m_storage.tail) { m_storage.tail = prev; }
+                destroy_node(cur);
+                m_storage.size--;
                 return;
             }
-
             prev = cur;
-            cur = &(*cur)->next;
         }
     }
 
     /**
        O(1)
     */
-    [[nodiscard]] bool empty() const { return m_size == 0; }
+    [[nodiscard]] bool empty() const { return m_storage.size == 0; }
 
     /**
        O(1)
     */
-    [[nodiscard]] size_type size() const { return m_size; }
+    [[nodiscard]] size_type size() const { return m_storage.size; }
 
     /**
        O(n)
     */
     [[nodiscard]] bool contains(value_type value) const
     {
-        Node* cur = m_head.get();
-        while (cur) {
+        for (Node const* cur = m_storage.head; cur; cur = cur->next) {
             if (cur->value == value) { return true; }
-
-            cur = cur->next.get();
         }
 
         return false;
@@ -298,14 +291,16 @@ public:
     */
     void clear() noexcept
     {
-        if (m_head) {
-            // Avoid stack overflow from chain destructors
-            while (m_head->next) { m_head = std::move(m_head->next); }
-            m_head.reset();
+        Node* cur = m_storage.head;
+        while (cur) {
+            Node* const next = cur->next;
+            destroy_node(cur);
+            cur = next;
         }
 
-        m_tail = &m_head;
-        m_size = 0;
+        m_storage.head = nullptr;
+        m_storage.tail = nullptr;
+        m_storage.size = 0;
     }
 
     S_List& operator=(S_List const& o)
@@ -313,31 +308,78 @@ public:
         SDS_ASSERT(this != &o);
         clear();
 
-        Node const* cur = o.m_head.get();
-        while (cur) {
-            push_back(cur->value);
-            cur = cur->next.get();
+        if constexpr (node_traits::propagate_on_container_copy_assignment::value) {
+            alloc() = o.alloc();
         }
+        append(o.cbegin(), o.cend());
         return *this;
     }
 
-    S_List& operator=(S_List&& o) noexcept
+    S_List& operator=(S_List&& o) noexcept(
+        node_traits::propagate_on_container_move_assignment::value ||
+        node_traits::is_always_equal::value)
     {
         SDS_ASSERT(this != &o);
         clear();
 
-        m_tail = o.m_tail;
-        m_size = o.m_size;
-        m_head = std::move(o.m_head);
-
-        if (m_size <= 1) { m_tail = &m_head; }
+        if constexpr (node_traits::propagate_on_container_move_assignment::value) {
+            alloc() = sds::move(o.alloc());
+            steal(o);
+        } else {
+            if (node_traits::is_always_equal::value || alloc() == o.alloc()) {
+                steal(o);
+            } else {
+                // Nodes from another allocator can't be adopted
+                append(o.cbegin(), o.cend());
+                o.clear();
+            }
+        }
         return *this;
     }
 
 private:
-    std::unique_ptr<Node> m_head = nullptr;
-    std::unique_ptr<Node>* m_tail = &m_head;
-    size_type m_size = 0;
+    node_allocator& alloc() noexcept { return m_storage; }
+    node_allocator const& alloc() const noexcept { return m_storage; }
+
+    Node* make_node(value_type&& value)
+    {
+        Node* const node = node_traits::allocate(alloc(), 1);
+        try {
+            node_traits::construct(alloc(), node, sds::move(value));
+        } catch (...) {
+            node_traits::deallocate(alloc(), node, 1);
+            throw;
+        }
+        return node;
+    }
+
+    void destroy_node(Node* node) noexcept
+    {
+        node_traits::destroy(alloc(), node);
+        node_traits::deallocate(alloc(), node, 1);
+    }
+
+    /* Push back a copy of each element. Strong guarantee when the list starts empty. */
+    template <typename InputIt>
+    void append(InputIt first, InputIt last)
+    {
+        try {
+            for (; first != last; ++first) { push_back(*first); }
+        } catch (...) {
+            clear();
+            throw;
+        }
+    }
+
+    void steal(S_List& o) noexcept
+    {
+        m_storage.head = o.m_storage.head;
+        m_storage.tail = o.m_storage.tail;
+        m_storage.size = o.m_storage.size;
+        o.m_storage.head = nullptr;
+        o.m_storage.tail = nullptr;
+        o.m_storage.size = 0;
+    }
 };
 
 } // namespace sds
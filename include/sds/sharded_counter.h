@@ -0,0 +1,227 @@
+#pragma once
+
+/**
+ * \file sharded_counter.h
+ * \brief Counters, maxima and histograms updated from many threads without contention.
+ *
+ * A shared std::atomic that every thread increments moves its cache line between cores on every
+ * update. These types instead spread their state over cache line sized shards. An update touches
+ * the shard of the calling thread or CPU only, and a read sums the shards:
+ *
+ *   sds::Sharded_Counter requests;
+ *   sds::Sharded_Histogram latency_ns;
+ *
+ *   // request threads
+ *   requests.add();
+ *   latency_ns.record(elapsed);
+ *
+ *   // metrics thread, once a second
+ *   export_rate("requests", requests.take());
+ *   sds::Histogram_Snapshot const h = latency_ns.take();
+ *   export_value("latency_p99", h.percentile(0.99));
+ *
+ * There are as many shards as CPUs, at least 4 and at most 256. Reads load every shard, which
+ * takes microseconds on a large host: fine for periodic export, too slow for the hot path.
+ */
+
+#include "sds/details/common.h"
+
+#include "sds/bit.h"
+#include "sds/cache_aligned.h"
+#include <atomic>
+#include <limits>
+#include <memory>
+
+namespace sds
+{
+/**
+ * \brief How updates pick their shard.
+ */
+enum class Shard_Policy : u32 {
+    /* Threads are dealt shards round robin. Threads only share shards once there are more of
+     * them than shards. */
+    thread = 0,
+    /* Shard of the CPU the thread runs on, from sched_getcpu. Never more sharing than there are
+     * threads per CPU, however many threads come and go. Same as thread outside Linux. */
+    cpu,
+};
+
+char const* to_string(Shard_Policy p) noexcept;
+
+namespace details
+{
+/* Shards per sharded type. Power of 2, at least the number of CPUs up to 256. */
+[[nodiscard]] u32 counter_shard_count() noexcept;
+/* CPU the calling thread runs on. */
+[[nodiscard]] u32 current_cpu() noexcept;
+
+inline u32 counter_shard(Shard_Policy policy, u32 mask) noexcept
+{
+    if (policy == Shard_Policy::cpu) { return current_cpu() & mask; }
+    return thread_index() & mask;
+}
+} // namespace details
+
+/**
+ * \brief Signed counter summed over shards.
+ *
+ * A read during updates is a sum of shards read at slightly different times, so it matches no
+ * single instant but never loses an update.
+ */
+class Sharded_Counter {
+public:
+    explicit Sharded_Counter(Shard_Policy policy = Shard_Policy::thread);
+
+    Sharded_Counter(Sharded_Counter const&) = delete;
+    Sharded_Counter& operator=(Sharded_Counter const&) = delete;
+
+    void add(s64 n = 1) noexcept
+    {
+        m_shards[details::counter_shard(m_policy, m_mask)]->fetch_add(n, std::memory_order_relaxed);
+    }
+    void sub(s64 n = 1) noexcept { add(-n); }
+
+    [[nodiscard]] s64 value() const noexcept;
+    /**
+     * \brief Value since the last take, and restart from zero. Updates racing with the take
+     * count towards the next one.
+     */
+    s64 take() noexcept;
+    void reset() noexcept { static_cast<void>(take()); }
+
+    [[nodiscard]] Shard_Policy policy() const noexcept { return m_policy; }
+
+private:
+    std::unique_ptr<Cache_Aligned<std::atomic<s64>>[]> m_shards;
+    u32 m_mask = 0;
+    Shard_Policy m_policy = Shard_Policy::thread;
+};
+
+/**
+ * \brief Maximum of the values recorded, kept per shard.
+ */
+class Sharded_Max {
+public:
+    /**
+     * \brief Value of an empty maximum.
+     */
+    static constexpr s64 empty = std::numeric_limits<s64>::min();
+
+    explicit Sharded_Max(Shard_Policy policy = Shard_Policy::thread);
+
+    Sharded_Max(Sharded_Max const&) = delete;
+    Sharded_Max& operator=(Sharded_Max const&) = delete;
+
+    void record(s64 v) noexcept
+    {
+        std::atomic<s64>& shard = *m_shards[details::counter_shard(m_policy, m_mask)];
+        // Only writes when the maximum grows, which quickly becomes rare
+        s64 cur = shard.load(std::memory_order_relaxed);
+        while (v > cur && !shard.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {}
+    }
+
+    /**
+     * \return \a empty if nothing was recorded.
+     */
+    [[nodiscard]] s64 value() const noexcept;
+    /**
+     * \brief Maximum since the last take, and restart empty.
+     */
+    s64 take() noexcept;
+    void reset() noexcept { static_cast<void>(take()); }
+
+    [[nodiscard]] Shard_Policy policy() const noexcept { return m_policy; }
+
+private:
+    std::unique_ptr<Cache_Aligned<std::atomic<s64>>[]> m_shards;
+    u32 m_mask = 0;
+    Shard_Policy m_policy = Shard_Policy::thread;
+};
+
+/**
+ * \brief Number of buckets of a \a Sharded_Histogram. Bucket 0 counts zeros, bucket i > 0 values
+ * in [2^(i-1), 2^i).
+ */
+inline constexpr s32 histogram_buckets = 65;
+
+/**
+ * \brief Contents of a \a Sharded_Histogram.
+ */
+struct Histogram_Snapshot {
+    u64 buckets[histogram_buckets] = {};
+    u64 count = 0;
+    /* Wraps if the values recorded add up to more than 2^64. */
+    u64 sum = 0;
+
+    /**
+     * \brief Smallest value that falls in bucket \a i.
+     */
+    [[nodiscard]] static constexpr u64 bucket_min(s32 i) noexcept
+    {
+        return i == 0 ? 0 : u64{1} << (i - 1);
+    }
+    /**
+     * \brief Largest value that falls in bucket \a i.
+     */
+    [[nodiscard]] static constexpr u64 bucket_max(s32 i) noexcept
+    {
+        return i == 0 ? 0 : bucket_min(i) + (bucket_min(i) - 1);
+    }
+
+    [[nodiscard]] double mean() const noexcept
+    {
+        return count == 0 ? 0.0 : static_cast<double>(sum) / static_cast<double>(count);
+    }
+
+    /**
+     * \brief Upper bound of the \a q quantile: at least that fraction of the values are less than
+     * or equal to it. Overstates by less than 2 times. 0 when empty.
+     *
+     * \param q In [0, 1], ex. 0.99 for the 99th percentile.
+     */
+    [[nodiscard]] u64 percentile(double q) const noexcept;
+};
+
+/**
+ * \brief Histogram of unsigned values in power of 2 buckets, with their count and sum.
+ *
+ * Each shard is a little over 8 cache lines, so prefer a \a Sharded_Counter where only the count
+ * is needed.
+ */
+class Sharded_Histogram {
+public:
+    explicit Sharded_Histogram(Shard_Policy policy = Shard_Policy::thread);
+
+    Sharded_Histogram(Sharded_Histogram const&) = delete;
+    Sharded_Histogram& operator=(Sharded_Histogram const&) = delete;
+
+    void record(u64 v) noexcept
+    {
+        Shard& shard = m_shards[details::counter_shard(m_policy, m_mask)];
+        shard.buckets[bucket_of(v)].fetch_add(1, std::memory_order_relaxed);
+        shard.sum.fetch_add(v, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] static s32 bucket_of(u64 v) noexcept { return v == 0 ? 0 : sds::log2(v) + 1; }
+
+    [[nodiscard]] Histogram_Snapshot snapshot() const noexcept;
+    /**
+     * \brief Contents since the last take, and restart empty. A value recorded during the take
+     * can have its bucket in one snapshot and its sum in the next.
+     */
+    Histogram_Snapshot take() noexcept;
+    void reset() noexcept { static_cast<void>(take()); }
+
+    [[nodiscard]] Shard_Policy policy() const noexcept { return m_policy; }
+
+private:
+    struct alignas(hardware_destructive_interference_size) Shard {
+        std::atomic<u64> buckets[histogram_buckets] = {};
+        std::atomic<u64> sum{0};
+    };
+
+    std::unique_ptr<Shard[]> m_shards;
+    u32 m_mask = 0;
+    Shard_Policy m_policy = Shard_Policy::thread;
+};
+} // namespace sds
@@ -0,0 +1,285 @@
+#pragma once
+
+#include "sds/details/common.h"
+#include "sds/array/dynamic_array.h"
+#include "sds/move.h"
+#include "sds/swap.h"
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace sds
+{
+/**
+ * \brief Stable id of an element in a Slot_Map.
+ *
+ * An index into the map's slots plus the generation of the slot when the element was inserted.
+ * Once the element is erased its handle no longer matches the slot and lookups fail, even after
+ * the slot is reused.
+ */
+class Slot_Handle {
+public:
+    static constexpr u32 invalid_index = ~0U;
+
+    constexpr Slot_Handle() noexcept = default;
+    constexpr Slot_Handle(u32 index, u32 generation) noexcept
+        : m_index(index), m_generation(generation)
+    {}
+
+    [[nodiscard]] constexpr u32 index() const noexcept { return m_index; }
+    [[nodiscard]] constexpr u32 generation() const noexcept { return m_generation; }
+    [[nodiscard]] constexpr bool is_valid() const noexcept { return m_index != invalid_index; }
+
+    /**
+     * \brief Both fields packed in one integer, for hashing or serialization.
+     */
+    [[nodiscard]] constexpr u64 bits() const noexcept
+    {
+        return static_cast<u64>(m_generation) << 32 | m_index;
+    }
+
+    [[nodiscard]] constexpr bool operator==(Slot_Handle o) const noexcept
+    {
+        return m_index == o.m_index && m_generation == o.m_generation;
+    }
+    [[nodiscard]] constexpr bool operator!=(Slot_Handle o) const noexcept { return !(*this == o); }
+
+private:
+    u32 m_index = invalid_index;
+    u32 m_generation = 0;
+};
+
+/**
+ * \brief Unordered container that hands out generational handles instead of pointers.
+ *
+ * Values are kept densely packed in a Dynamic_Array, so iteration is a linear scan. Handles go
+ * through a sparse array of slots that holds each value's dense index and a generation counter.
+ * Erasing moves the last value into the hole and bumps the slot's generation, so stale handles
+ * are detected. Freed slots are reused through an intrusive free list.
+ *
+ * Insert, erase and lookup are O(1). Pointers and iterators are invalidated by insert and erase,
+ * handles are not.
+ *
+ * A slot's generation is odd while it holds a value, so occupancy needs no separate bitmap. A
+ * handle can only alias a new value after its slot is reused 2^31 times.
+ *
+ * \tparam T Value type.
+ * \tparam Allocator Allocator of T.
+ */
+template <typename T, typename Allocator = std::allocator<T>>
+class Slot_Map {
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using handle_type = Slot_Handle;
+    using size_type = size_t;
+    using reference = T&;
+    using const_reference = T const&;
+    using pointer = T*;
+    using const_pointer = T const*;
+
+private:
+    template <typename U>
+    using rebind_alloc = typename std::allocator_traits<Allocator>::template rebind_alloc<U>;
+
+    struct Slot {
+        u32 generation; // odd when occupied
+        u32 index;      // dense index when occupied, next free slot otherwise
+    };
+
+    using data_array = Dynamic_Array<T, Allocator>;
+
+public:
+    using iterator = typename data_array::iterator;
+    using const_iterator = typename data_array::const_iterator;
+
+    Slot_Map() = default;
+    explicit Slot_Map(Allocator const& alloc)
+        : m_data(alloc), m_dense_to_slot(alloc), m_slots(alloc), m_free_head(s_npos)
+    {}
+
+    /**
+     * \return Handle of the new value.
+     */
+    handle_type insert(T const& v) { return emplace(v); }
+    handle_type insert(T&& v) { return emplace(sds::move(v)); }
+    template <typename... Args>
+    handle_type emplace(Args&&... args);
+
+    /**
+     * \brief Erase the value of \a h by moving the last value into its place.
+     * \return False if \a h is stale.
+     */
+    bool erase(handle_type h);
+
+    [[nodiscard]] bool contains(handle_type h) const noexcept { return dense_index(h) != s_npos; }
+
+    /**
+     * \return The value of \a h, or nullptr if \a h is stale.
+     */
+    [[nodiscard]] pointer find(handle_type h) noexcept
+    {
+        u32 const i = dense_index(h);
+        return i == s_npos ? nullptr : &m_data[i];
+    }
+    [[nodiscard]] const_pointer find(handle_type h) const noexcept
+    {
+        u32 const i = dense_index(h);
+        return i == s_npos ? nullptr : &m_data[i];
+    }
+
+    [[nodiscard]] reference operator[](handle_type h) noexcept
+    {
+        SDS_ASSERT(contains(h));
+        return m_data[m_slots[h.index()].index];
+    }
+    [[nodiscard]] const_reference operator[](handle_type h) const noexcept
+    {
+        SDS_ASSERT(contains(h));
+        return m_data[m_slots[h.index()].index];
+    }
+    [[nodiscard]] reference at(handle_type h)
+    {
+        pointer const p = find(h);
+        if (p == nullptr) { throw std::out_of_range("Slot_Map::at: stale handle"); }
+        return *p;
+    }
+    [[nodiscard]] const_reference at(handle_type h) const
+    {
+        const_pointer const p = find(h);
+        if (p == nullptr) { throw std::out_of_range("Slot_Map::at: stale handle"); }
+        return *p;
+    }
+
+    /**
+     * \brief Handle of the value at dense position \a i, as seen when iterating.
+     */
+    [[nodiscard]] handle_type handle_at(size_type i) const noexcept
+    {
+        u32 const slot = m_dense_to_slot[i];
+        return {slot, m_slots[slot].generation};
+    }
+
+    [[nodiscard]] size_type size() const noexcept { return m_data.size(); }
+    [[nodiscard]] bool empty() const noexcept { return m_data.empty(); }
+    [[nodiscard]] size_type capacity() const noexcept { return m_data.capacity(); }
+    /**
+     * \brief Number of slots, including free ones. Never shrinks.
+     */
+    [[nodiscard]] size_type slot_count() const noexcept { return m_slots.size(); }
+
+    void reserve(size_type n);
+    /**
+     * \brief Erase every value. All outstanding handles become stale.
+     */
+    void clear() noexcept;
+
+    [[nodiscard]] pointer data() noexcept { return m_data.data(); }
+    [[nodiscard]] const_pointer data() const noexcept { return m_data.data(); }
+
+    /* Dense iteration in no particular order. */
+    [[nodiscard]] iterator begin() noexcept { return m_data.begin(); }
+    [[nodiscard]] iterator end() noexcept { return m_data.end(); }
+    [[nodiscard]] const_iterator begin() const noexcept { return m_data.begin(); }
+    [[nodiscard]] const_iterator end() const noexcept { return m_data.end(); }
+    [[nodiscard]] const_iterator cbegin() const noexcept { return m_data.cbegin(); }
+    [[nodiscard]] const_iterator cend() const noexcept { return m_data.cend(); }
+
+    void swap(Slot_Map& o) noexcept
+    {
+        m_data.swap(o.m_data);
+        m_dense_to_slot.swap(o.m_dense_to_slot);
+        m_slots.swap(o.m_slots);
+        sds::swap(m_free_head, o.m_free_head);
+    }
+
+private:
+    static constexpr u32 s_npos = ~0U;
+
+    data_array m_data{};
+    Dynamic_Array<u32, rebind_alloc<u32>> m_dense_to_slot{};
+    Dynamic_Array<Slot, rebind_alloc<Slot>> m_slots{};
+    u32 m_free_head = s_npos;
+
+    /* Dense index of the value of \a h, or s_npos if \a h is stale. */
+    u32 dense_index(handle_type h) const noexcept
+    {
+        if (h.index() >= m_slots.size()) { return s_npos; }
+        Slot const& s = m_slots[h.index()];
+        return s.generation == h.generation() && (s.generation & 1) ? s.index : s_npos;
+    }
+};
+
+template <typename T, typename Allocator>
+template <typename... Args>
+auto Slot_Map<T, Allocator>::emplace(Args&&... args) -> handle_type
+{
+    SDS_ASSERT(m_data.size() < s_npos);
+
+    // Each step either succeeds or leaves the map as it was
+    if (m_free_head == s_npos) {
+        SDS_ASSERT(m_slots.size() < s_npos);
+        m_slots.push_back(Slot{0, s_npos});
+        m_free_head = static_cast<u32>(m_slots.size() - 1);
+    }
+
+    m_data.emplace_back(std::forward<Args>(args)...);
+    try {
+        m_dense_to_slot.push_back(m_free_head);
+    } catch (...) {
+        m_data.pop_back();
+        throw;
+    }
+
+    u32 const slot_index = m_free_head;
+    Slot& slot = m_slots[slot_index];
+    m_free_head = slot.index;
+    ++slot.generation;
+    slot.index = static_cast<u32>(m_data.size() - 1);
+    return {slot_index, slot.generation};
+}
+
+template <typename T, typename Allocator>
+bool Slot_Map<T, Allocator>::erase(handle_type h)
+{
+    u32 const i = dense_index(h);
+    if (i == s_npos) { return false; }
+
+    // Keep the values dense: move the last one into the hole and repoint its slot
+    u32 const last = static_cast<u32>(m_data.size() - 1);
+    if (i != last) {
+        m_data[i] = sds::move(m_data[last]);
+        m_dense_to_slot[i] = m_dense_to_slot[last];
+        m_slots[m_dense_to_slot[i]].index = i;
+    }
+    m_data.pop_back();
+    m_dense_to_slot.pop_back();
+
+    Slot& slot = m_slots[h.index()];
+    ++slot.generation;
+    slot.index = m_free_head;
+    m_free_head = h.index();
+    return true;
+}
+
+template <typename T, typename Allocator>
+void Slot_Map<T, Allocator>::reserve(size_type n)
+{
+    m_data.reserve(n);
+    m_dense_to_slot.reserve(n);
+    m_slots.reserve(n);
+}
+
+template <typename T, typename Allocator>
+void Slot_Map<T, Allocator>::clear() noexcept
+{
+    for (u32 const slot_index : m_dense_to_slot) {
+        Slot& slot = m_slots[slot_index];
+        ++slot.generation;
+        slot.index = m_free_head;
+        m_free_head = slot_index;
+    }
+    m_data.clear();
+    m_dense_to_slot.clear();
+}
+} // namespace sds
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "sds/details/common.h"
+#include "sds/iterator.h"
+#include <type_traits>
+
+namespace sds
+{
+/**
+ * \brief Non-owning view of a contiguous run of \a T.
+ *
+ * Like \a std::span with a dynamic extent. The view can't resize what it refers to, so it is safe
+ * to hand out for containers that must keep several arrays in sync.
+ */
+template <typename T>
+class Span {
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using pointer = T*;
+    using const_pointer = T const*;
+    using reference = T&;
+    using const_reference = T const&;
+    using iterator = T*;
+    using reverse_iterator = sds::Reverse_Iterator<iterator>;
+
+    constexpr Span() noexcept = default;
+    constexpr Span(T* data, size_type size) noexcept : m_data(data), m_size(size) {}
+    constexpr Span(T* first, T* last) noexcept
+        : m_data(first), m_size(static_cast<size_type>(last - first))
+    {}
+
+    /* Span<T> to Span<T const> */
+    template <typename U, typename = std::enable_if_t<std::is_same<U const, T>::value &&
+                                                      !std::is_same<U, T>::value>>
+    constexpr Span(Span<U> const& o) noexcept : m_data(o.data()), m_size(o.size())
+    {}
+
+    [[nodiscard]] constexpr pointer data() const noexcept { return m_data; }
+    [[nodiscard]] constexpr size_type size() const noexcept { return m_size; }
+    [[nodiscard]] constexpr size_type size_bytes() const noexcept { return m_size * sizeof(T); }
+    [[nodiscard]] constexpr bool empty() const noexcept { return m_size == 0; }
+
+    [[nodiscard]] constexpr reference operator[](size_type i) const noexcept
+    {
+        SDS_ASSERT(i < m_size);
+        return m_data[i];
+    }
+    [[nodiscard]] constexpr reference front() const noexcept { return (*this)[0]; }
+    [[nodiscard]] constexpr reference back() const noexcept { return (*this)[m_size - 1]; }
+
+    [[nodiscard]] constexpr iterator begin() const noexcept { return m_data; }
+    [[nodiscard]] constexpr iterator end() const noexcept { return m_data + m_size; }
+    [[nodiscard]] constexpr reverse_iterator rbegin() const noexcept
+    {
+        return reverse_iterator(end());
+    }
+    [[nodiscard]] constexpr reverse_iterator rend() const noexcept
+    {
+        return reverse_iterator(begin());
+    }
+
+    [[nodiscard]] constexpr Span first(size_type count) const noexcept
+    {
+        SDS_ASSERT(count <= m_size);
+        return {m_data, count};
+    }
+    [[nodiscard]] constexpr Span last(size_type count) const noexcept
+    {
+        SDS_ASSERT(count <= m_size);
+        return {m_data + (m_size - count), count};
+    }
+    [[nodiscard]] constexpr Span subspan(size_type offset, size_type count) const noexcept
+    {
+        SDS_ASSERT(offset <= m_size && count <= m_size - offset);
+        return {m_data + offset, count};
+    }
+
+private:
+    T* m_data = nullptr;
+    size_type m_size = 0;
+};
+} // namespace sds
@@ -0,0 +1,314 @@
+#pragma once
+
+#include "sds/details/common.h"
+#include "sds/array/dynamic_array.h"
+#include "sds/bit.h"
+#include "sds/move.h"
+#include "sds/swap.h"
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+
+namespace sds
+{
+/**
+ * \brief Set of integer ids with O(1) insert, erase and contains, and dense iteration.
+ *
+ * Members are packed in a dense array, which is what iteration walks. A sparse array indexed by
+ * id holds each member's position in the dense array. The sparse array is split into pages of
+ * \a Page_Size entries that are only allocated once an id in their range is inserted, so a few
+ * ids spread over a large id space stay cheap.
+ *
+ * Erase moves the last member into the hole, so iteration order is not insertion order.
+ *
+ * \tparam Id Unsigned integer id type.
+ * \tparam Page_Size Sparse entries per page. Power of 2.
+ * \tparam Allocator Allocator of Id.
+ */
+template <typename Id = u32, size_t Page_Size = 4096, typename Allocator = std::allocator<Id>>
+class Sparse_Set {
+    SDS_STATIC_ASSERT(std::is_unsigned_v<Id>);
+    SDS_STATIC_ASSERT(sds::is_pow2(Page_Size));
+
+    template <typename U>
+    using rebind_alloc = typename std::allocator_traits<Allocator>::template rebind_alloc<U>;
+    using page_allocator = rebind_alloc<Id>;
+    using page_alloc_traits = std::allocator_traits<page_allocator>;
+
+public:
+    using value_type = Id;
+    using size_type = size_t;
+    using allocator_type = Allocator;
+    using dense_array = Dynamic_Array<Id, Allocator>;
+    using const_iterator = typename dense_array::const_iterator;
+    using iterator = const_iterator;
+
+    static constexpr size_t page_size = Page_Size;
+
+    Sparse_Set() = default;
+    explicit Sparse_Set(Allocator const& alloc)
+        : m_dense(alloc), m_pages(alloc), m_page_alloc(alloc)
+    {}
+    Sparse_Set(Sparse_Set const& o);
+    Sparse_Set(Sparse_Set&& o) noexcept
+        : m_dense(sds::move(o.m_dense)),
+          m_pages(sds::move(o.m_pages)),
+          m_page_alloc(sds::move(o.m_page_alloc))
+    {}
+    ~Sparse_Set() { release_pages(); }
+
+    Sparse_Set& operator=(Sparse_Set const& o);
+    Sparse_Set& operator=(Sparse_Set&& o) noexcept(
+        page_alloc_traits::propagate_on_container_move_assignment::value ||
+        page_alloc_traits::is_always_equal::value);
+
+    /**
+     * \return True if \a id was added, false if it was already a member.
+     */
+    bool insert(Id id);
+    /**
+     * \return True if \a id was removed, false if it wasn't a member.
+     */
+    bool erase(Id id) noexcept;
+
+    [[nodiscard]] bool contains(Id id) const noexcept { return dense_index(id) != s_npos; }
+    /**
+     * \brief Position of \a id in the dense array, or `size()` if it isn't a member.
+     */
+    [[nodiscard]] size_type index_of(Id id) const noexcept
+    {
+        Id const i = dense_index(id);
+        return i == s_npos ? size() : static_cast<size_type>(i);
+    }
+
+    [[nodiscard]] size_type size() const noexcept { return m_dense.size(); }
+    [[nodiscard]] bool empty() const noexcept { return m_dense.empty(); }
+    /**
+     * \brief Number of allocated sparse pages.
+     */
+    [[nodiscard]] size_type page_count() const noexcept;
+
+    void reserve(size_type n) { m_dense.reserve(n); }
+    /**
+     * \brief Remove every member. Pages are kept for reuse.
+     */
+    void clear() noexcept;
+
+    [[nodiscard]] Id const* data() const noexcept { return m_dense.data(); }
+    [[nodiscard]] const_iterator begin() const noexcept { return m_dense.cbegin(); }
+    [[nodiscard]] const_iterator end() const noexcept { return m_dense.cend(); }
+
+    void swap(Sparse_Set& o) noexcept;
+
+    /**
+     * \brief Call `f(id)` for each member of both \a a and \a b. Walks the smaller set and probes
+     * the larger.
+     */
+    template <typename F>
+    friend void for_each_intersection(Sparse_Set const& a, Sparse_Set const& b, F&& f)
+    {
+        Sparse_Set const& small = a.size() <= b.size() ? a : b;
+        Sparse_Set const& large = a.size() <= b.size() ? b : a;
+        for (Id const id : small) {
+            if (large.contains(id)) { f(id); }
+        }
+    }
+
+    /**
+     * \brief Members of both \a a and \a b.
+     */
+    friend Sparse_Set intersection(Sparse_Set const& a, Sparse_Set const& b)
+    {
+        Sparse_Set out(a.m_dense.get_allocator());
+        for_each_intersection(a, b, [&out](Id id) { out.insert(id); });
+        return out;
+    }
+
+    friend bool operator==(Sparse_Set const& a, Sparse_Set const& b) noexcept
+    {
+        if (a.size() != b.size()) { return false; }
+        for (Id const id : a) {
+            if (!b.contains(id)) { return false; }
+        }
+        return true;
+    }
+    friend bool operator!=(Sparse_Set const& a, Sparse_Set const& b) noexcept { return !(a == b); }
+
+private:
+    static constexpr Id s_npos = static_cast<Id>(~Id{0});
+    static constexpr s32 s_page_shift = sds::log2(static_cast<u64>(Page_Size));
+    static constexpr Id s_page_mask = static_cast<Id>(Page_Size - 1);
+
+    dense_array m_dense{};
+    // Page p holds the dense index of ids [p * Page_Size, (p + 1) * Page_Size), or s_npos
+    Dynamic_Array<Id*, rebind_alloc<Id*>> m_pages{};
+    page_allocator m_page_alloc{};
+
+    Id dense_index(Id id) const noexcept
+    {
+        size_t const p = static_cast<size_t>(id >> s_page_shift);
+        if (p >= m_pages.size() || m_pages[p] == nullptr) { return s_npos; }
+        return m_pages[p][id & s_page_mask];
+    }
+
+    /* Sparse entry of \a id, allocating its page if needed. */
+    Id& sparse_entry(Id id);
+
+    Id* allocate_page();
+    void release_pages() noexcept;
+    void copy_from(Sparse_Set const& o);
+};
+
+template <typename Id, size_t Page_Size, typename Allocator>
+Sparse_Set<Id, Page_Size, Allocator>::Sparse_Set(Sparse_Set const& o)
+    : m_dense(o.m_dense),
+      m_pages(page_alloc_traits::select_on_container_copy_construction(o.m_page_alloc)),
+      m_page_alloc(page_alloc_traits::select_on_container_copy_construction(o.m_page_alloc))
+{
+    copy_from(o);
+}
+
+template <typename Id, size_t Page_Size, typename Allocator>
+auto Sparse_Set<Id, Page_Size, Allocator>::operator=(Sparse_Set const& o) -> Sparse_Set&
+{
+    if (this == &o) { return *this; }
+    release_pages();
+    m_pages.clear();
+    if constexpr (page_alloc_traits::propagate_on_container_copy_assignment::value) {
+        m_page_alloc = o.m_page_alloc;
+    }
+    m_dense = o.m_dense;
+    copy_from(o);
+    return *this;
+}
+
+template <typename Id, size_t Page_Size, typename Allocator>
+auto Sparse_Set<Id, Page_Size, Allocator>::operator=(Sparse_Set&& o) noexcept(
+    page_alloc_traits::propagate_on_container_move_assignment::value ||
+    page_alloc_traits::is_always_equal::value) -> Sparse_Set&
+{
+    if (this == &o) { return *this; }
+    if constexpr (page_alloc_traits::propagate_on_container_move_assignment::value ||
+                  page_alloc_traits::is_always_equal::value) {
+        release_pages();
+        m_pages.clear();
+        if constexpr (page_alloc_traits::propagate_on_container_move_assignment::value) {
+            m_page_alloc = sds::move(o.m_page_alloc);
+        }
+        m_dense = sds::move(o.m_dense);
+        m_pages = sds::move(o.m_pages);
+        o.m_pages.clear();
+    } else if (m_page_alloc == o.m_page_alloc) {
+        release_pages();
+        m_pages.clear();
+        m_dense = sds::move(o.m_dense);
+        m_pages = sds::move(o.m_pages);
+        o.m_pages.clear();
+    } else {
+        // Pages can't change allocator. Copy and leave o as is.
+        *this = static_cast<Sparse_Set const&>(o);
+    }
+    return *this;
+}
+
+template <typename Id, size_t Page_Size, typename Allocator>
+bool Sparse_Set<Id, Page_Size, Allocator>::insert(Id id)
+{
+    SDS_ASSERT(id != s_npos);
+    Id& entry = sparse_entry(id);
+    if (entry != s_npos) { return false; }
+
+    SDS_ASSERT(m_dense.size() < s_npos);
+    m_dense.push_back(id);
+    entry = static_cast<Id>(m_dense.size() - 1);
+    return true;
+}
+
+template <typename Id, size_t Page_Size, typename Allocator>
+bool Sparse_Set<Id, Page_Size, Allocator>::erase(Id id) noexcept
+{
+    Id const i = dense_index(id);
+    if (i == s_npos) { return false; }
+
+    Id const last = m_dense.back();
+    m_dense[i] = last;
+    m_pages[last >> s_page_shift][last & s_page_mask] = i;
+    m_pages[id >> s_page_shift][id & s_page_mask] = s_npos;
+    m_dense.pop_back();
+    return true;
+}
+
+template <typename Id, size_t Page_Size, typename Allocator>
+auto Sparse_Set<Id, Page_Size, Allocator>::page_count() const noexcept -> size_type
+{
+    return static_cast<size_type>(
+        std::count_if(m_pages.begin(), m_pages.end(), [](Id* p) { return p != nullptr; }));
+}
+
+template <typename Id, size_t Page_Size, typename Allocator>
+void Sparse_Set<Id, Page_Size, Allocator>::clear() noexcept
+{
+    // Cheaper than wiping every page when the set is small relative to its id range
+    for (Id const id : m_dense) { m_pages[id >> s_page_shift][id & s_page_mask] = s_npos; }
+    m_dense.clear();
+}
+
+template <typename Id, size_t Page_Size, typename Allocator>
+void Sparse_Set<Id, Page_Size, Allocator>::swap(Sparse_Set& o) noexcept
+{
+    m_dense.swap(o.m_dense);
+    m_pages.swap(o.m_pages);
+    if constexpr (page_alloc_traits::propagate_on_container_swap::value) {
+        sds::swap(m_page_alloc, o.m_page_alloc);
+    } else {
+        SDS_ASSERT(m_page_alloc == o.m_page_alloc);
+    }
+}
+
+template <typename Id, size_t Page_Size, typename Allocator>
+Id& Sparse_Set<Id, Page_Size, Allocator>::sparse_entry(Id id)
+{
+    size_t const p = static_cast<size_t>(id >> s_page_shift);
+    if (p >= m_pages.size()) { m_pages.resize(p + 1, nullptr); }
+    if (m_pages[p] == nullptr) { m_pages[p] = allocate_page(); }
+    return m_pages[p][id & s_page_mask];
+}
+
+template <typename Id, size_t Page_Size, typename Allocator>
+Id* Sparse_Set<Id, Page_Size, Allocator>::allocate_page()
+{
+    Id* const page = page_alloc_traits::allocate(m_page_alloc, Page_Size);
+    std::fill_n(page, Page_Size, s_npos);
+    return page;
+}
+
+template <typename Id, size_t Page_Size, typename Allocator>
+void Sparse_Set<Id, Page_Size, Allocator>::release_pages() noexcept
+{
+    for (Id*& page : m_pages) {
+        if (page != nullptr) {
+            page_alloc_traits::deallocate(m_page_alloc, page, Page_Size);
+            page = nullptr;
+        }
+    }
+}
+
+template <typename Id, size_t Page_Size, typename Allocator>
+void Sparse_Set<Id, Page_Size, Allocator>::copy_from(Sparse_Set const& o)
+{
+    // Pages are fully initialized, so copy them whole
+    try {
+        m_pages.resize(o.m_pages.size(), nullptr);
+        for (size_t p = 0; p < o.m_pages.size(); ++p) {
+            if (o.m_pages[p] == nullptr) { continue; }
+            m_pages[p] = allocate_page();
+            std::copy_n(o.m_pages[p], Page_Size, m_pages[p]);
+        }
+    } catch (...) {
+        release_pages();
+        m_pages.clear();
+        m_dense.clear();
+        throw;
+    }
+}
+} // namespace sds
@@ -1,7 +1,13 @@
 #pragma once
 
 #include "sds/details/common.h"
-#include <string>
+#include "sds/move.h"
+#include "sds/string_view.h"
+#include "sds/swap.h"
+#include <climits>
+#include <cstring>
+#include <memory>
+#include <type_traits>
 
 namespace sds
 {
@@ -36,12 +42,24 @@ int str_size(CodeUnit const* s) noexcept
     return size;
 }
 
+/**
+ * \brief Number of characters in the string. Does not include the null-terminator.
+ *
+ * Scans 16 or 32 bytes per iteration with SSE2/AVX2, picked at runtime.
+ *
+ * NOTE(sdsmith): Reads whole aligned blocks, so it may read past the null-terminator but never
+ * across a page boundary.
+ *
+ * \param s Null-terminated string.
+ */
+int str_size(char const* s) noexcept;
+
 /**
  * \brief True if the given chracter is an ASCII character.
  *
  * NOTE(sdsmith): This does not include the extended ASCII characters.
  */
-constexpr bool is_ascii(char c) noexcept { return c <= 0 && c <= 127; }
+constexpr bool is_ascii(char c) noexcept { return static_cast<unsigned char>(c) <= 127; }
 
 /**
  * \brief Checks if string is equal to the given ascii string up to the n-th character.
@@ -53,6 +71,9 @@ constexpr bool is_ascii(char c) noexcept { return c <= 0 && c <= 127; }
  * NOTE(sdsmith): It's valid to compare an ascii string with a UTF-8 encoded string because UTF-8 is
  * backwards compatible with ASCII.
  *
+ * Compares 16 or 32 bytes per iteration with SSE2/AVX2, picked at runtime. Blocks that would read
+ * across a page boundary are compared byte by byte.
+ *
  * \param s String.
  * \param ascii Ascii string.
  * \param len Number of ascii code points to compare.
@@ -74,7 +95,527 @@ bool ascii_cmp(char const* s, char const* ascii, s32 len) noexcept;
  */
 bool ascii_cmp(char const* s, char const* ascii) noexcept;
 
-// TODO(sdsmith):
-using String = std::string;
+/**
+ * \brief Checks if the view is equal to the given ascii string, sizes included. Unlike
+ * \a ascii_cmp, a longer \a s doesn't match.
+ *
+ * \param s String.
+ * \param ascii Ascii string.
+ */
+bool ascii_eq(String_View s, String_View ascii) noexcept;
+
+/**
+ * \brief Growable, null-terminated string with small string optimization.
+ *
+ * Strings of up to `3 * sizeof(void*) - 1` characters (23 on 64-bit) are stored inline without
+ * allocating. The inline and heap representations share storage: the last inline byte holds the
+ * unused inline capacity, which doubles as the null-terminator when the buffer is full. A heap
+ * string sets the top bit of that byte.
+ *
+ * Growth policy: when an append does not fit, the capacity grows to the larger of 1.5x the current
+ * capacity and the required size. `reserve` allocates exactly what is asked for.
+ *
+ * NOTE(sdsmith): Unlike std::string, `substr` returns a String_View into this string instead of a
+ * copy.
+ *
+ * \tparam Allocator Char allocator. Stateful allocators (ex. arenas) are stored in the string,
+ * stateless ones take no space.
+ */
+template <typename Allocator = std::allocator<char>>
+class Basic_String {
+public:
+    using value_type = char;
+    using allocator_type = Allocator;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using reference = char&;
+    using const_reference = char const&;
+    using pointer = char*;
+    using const_pointer = char const*;
+    using iterator = char*;
+    using const_iterator = char const*;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+private:
+    using alloc_traits = std::allocator_traits<Allocator>;
+    SDS_STATIC_ASSERT_MSG((std::is_same<typename alloc_traits::value_type, char>::value),
+                          "allocator must allocate char")
+
+    struct Heap {
+        char* data;
+        size_type size;
+        size_type capacity; // Includes s_heap_flag
+    };
+
+    union Rep {
+        Heap heap;
+        char buf[sizeof(Heap)];
+    };
+
+    static constexpr size_type s_inline_capacity = sizeof(Heap) - 1;
+
+    // NOTE(sdsmith): The top bit of the capacity is the top bit of the last inline byte on
+    // little-endian targets, which are the only ones supported (see types.h).
+    static constexpr size_type s_heap_flag = size_type{1} << (sizeof(size_type) * CHAR_BIT - 1);
+    static constexpr unsigned char s_heap_flag_byte = 0x80;
+
+    // Empty base optimization: stateless allocators take no space
+    struct Storage : Allocator {
+        Rep rep{};
+
+        Storage() = default;
+        explicit Storage(Allocator const& alloc) noexcept : Allocator(alloc) {}
+        explicit Storage(Allocator&& alloc) noexcept : Allocator(sds::move(alloc)) {}
+    };
+
+    Storage m_storage;
+
+public:
+    Basic_String() noexcept(noexcept(Allocator())) : m_storage() { set_inline_size(0); }
+    explicit Basic_String(Allocator const& alloc) noexcept : m_storage(alloc)
+    {
+        set_inline_size(0);
+    }
+    Basic_String(char const* s, size_type n, Allocator const& alloc = Allocator())
+        : m_storage(alloc)
+    {
+        init(s, n);
+    }
+    Basic_String(char const* s, Allocator const& alloc = Allocator())
+        : Basic_String(String_View(s), alloc)
+    {}
+    explicit Basic_String(String_View s, Allocator const& alloc = Allocator()) : m_storage(alloc)
+    {
+        init(s.data(), s.size());
+    }
+    Basic_String(size_type count, char c, Allocator const& alloc = Allocator()) : m_storage(alloc)
+    {
+        init(nullptr, count);
+        std::memset(data(), c, count);
+    }
+    Basic_String(Basic_String const& o)
+        : m_storage(alloc_traits::select_on_container_copy_construction(o.alloc()))
+    {
+        copy_init(o);
+    }
+    Basic_String(Basic_String const& o, Allocator const& alloc) : m_storage(alloc) { copy_init(o); }
+    Basic_String(Basic_String&& o) noexcept : m_storage(sds::move(o.alloc())) { steal(o); }
+    ~Basic_String() noexcept { release(); }
+
+    Basic_String& operator=(Basic_String const& o);
+    Basic_String& operator=(Basic_String&& o) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value ||
+        alloc_traits::is_always_equal::value);
+    Basic_String& operator=(String_View s) { return assign(s.data(), s.size()); }
+    Basic_String& operator=(char const* s) { return assign(String_View(s)); }
+
+    Basic_String& assign(char const* s, size_type n);
+    Basic_String& assign(String_View s) { return assign(s.data(), s.size()); }
+
+    [[nodiscard]] allocator_type get_allocator() const noexcept { return alloc(); }
+
+    [[nodiscard]] pointer data() noexcept
+    {
+        return is_inline() ? m_storage.rep.buf : m_storage.rep.heap.data;
+    }
+    [[nodiscard]] const_pointer data() const noexcept
+    {
+        return is_inline() ? m_storage.rep.buf : m_storage.rep.heap.data;
+    }
+    [[nodiscard]] const_pointer c_str() const noexcept { return data(); }
+
+    [[nodiscard]] size_type size() const noexcept
+    {
+        return is_inline() ? s_inline_capacity - tag() : m_storage.rep.heap.size;
+    }
+    [[nodiscard]] size_type length() const noexcept { return size(); }
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    /**
+     * \brief Number of characters that fit without reallocating. Excludes the null-terminator.
+     */
+    [[nodiscard]] size_type capacity() const noexcept
+    {
+        return is_inline() ? s_inline_capacity : heap_capacity();
+    }
+    [[nodiscard]] size_type max_size() const noexcept;
+
+    /**
+     * \brief True if the contents are stored inline in the string object.
+     */
+    [[nodiscard]] bool is_inline() const noexcept { return (tag() & s_heap_flag_byte) == 0; }
+
+    [[nodiscard]] static constexpr size_type inline_capacity() noexcept
+    {
+        return s_inline_capacity;
+    }
+
+    [[nodiscard]] reference operator[](size_type pos) noexcept
+    {
+        SDS_ASSERT(pos <= size());
+        return data()[pos];
+    }
+    [[nodiscard]] const_reference operator[](size_type pos) const noexcept
+    {
+        SDS_ASSERT(pos <= size());
+        return data()[pos];
+    }
+    [[nodiscard]] reference front() noexcept
+    {
+        SDS_ASSERT(!empty());
+        return data()[0];
+    }
+    [[nodiscard]] const_reference front() const noexcept
+    {
+        SDS_ASSERT(!empty());
+        return data()[0];
+    }
+    [[nodiscard]] reference back() noexcept
+    {
+        SDS_ASSERT(!empty());
+        return data()[size() - 1];
+    }
+    [[nodiscard]] const_reference back() const noexcept
+    {
+        SDS_ASSERT(!empty());
+        return data()[size() - 1];
+    }
+
+    [[nodiscard]] iterator begin() noexcept { return data(); }
+    [[nodiscard]] const_iterator begin() const noexcept { return data(); }
+    [[nodiscard]] const_iterator cbegin() const noexcept { return data(); }
+    [[nodiscard]] iterator end() noexcept { return data() + size(); }
+    [[nodiscard]] const_iterator end() const noexcept { return data() + size(); }
+    [[nodiscard]] const_iterator cend() const noexcept { return end(); }
+
+    /**
+     * \brief Allocate space for at least \a new_cap characters. Never shrinks.
+     */
+    void reserve(size_type new_cap);
+
+    /**
+     * \brief Release unused capacity. Moves the contents back inline if they fit.
+     */
+    void shrink_to_fit();
+
+    /**
+     * \brief Resize to \a count characters, filling new characters with \a c.
+     */
+    void resize(size_type count, char c = '\0');
+    void clear() noexcept { set_size(0); }
+
+    void push_back(char c);
+    void pop_back() noexcept
+    {
+        SDS_ASSERT(!empty());
+        set_size(size() - 1);
+    }
+
+    Basic_String& append(char const* s, size_type n);
+    Basic_String& append(String_View s) { return append(s.data(), s.size()); }
+    Basic_String& append(size_type count, char c);
+
+    Basic_String& operator+=(char c)
+    {
+        push_back(c);
+        return *this;
+    }
+    Basic_String& operator+=(String_View s) { return append(s.data(), s.size()); }
+
+    /**
+     * \brief View of [pos, pos + count), clamped to the end of the string. Does not copy.
+     *
+     * NOTE(sdsmith): Invalidated by any operation that modifies the string.
+     */
+    [[nodiscard]] String_View substr(size_type pos = 0, size_type count = npos) const noexcept
+    {
+        return String_View(data(), size()).substr(pos, count);
+    }
+
+    [[nodiscard]] int compare(String_View o) const noexcept
+    {
+        return String_View(data(), size()).compare(o);
+    }
+
+    operator String_View() const noexcept { return {data(), size()}; }
+
+    void swap(Basic_String& o) noexcept;
+
+private:
+    Allocator& alloc() noexcept { return m_storage; }
+    Allocator const& alloc() const noexcept { return m_storage; }
+
+    /* Last byte of the storage. Unused inline capacity, or the top byte of the heap capacity. */
+    unsigned char tag() const noexcept
+    {
+        return reinterpret_cast<unsigned char const*>(&m_storage.rep)[s_inline_capacity];
+    }
+    size_type heap_capacity() const noexcept { return m_storage.rep.heap.capacity & ~s_heap_flag; }
+
+    void set_inline_size(size_type n) noexcept
+    {
+        SDS_ASSERT(n <= s_inline_capacity);
+        m_storage.rep.buf[n] = '\0';
+        m_storage.rep.buf[s_inline_capacity] = static_cast<char>(s_inline_capacity - n);
+    }
+    void set_heap(char* p, size_type cap, size_type n) noexcept
+    {
+        SDS_ASSERT(n <= cap && cap < s_heap_flag);
+        m_storage.rep.heap.data = p;
+        m_storage.rep.heap.capacity = cap | s_heap_flag;
+        m_storage.rep.heap.size = n;
+        p[n] = '\0';
+    }
+    void set_size(size_type n) noexcept
+    {
+        if (is_inline()) {
+            set_inline_size(n);
+        } else {
+            SDS_ASSERT(n <= heap_capacity());
+            m_storage.rep.heap.size = n;
+            m_storage.rep.heap.data[n] = '\0';
+        }
+    }
+
+    /* Allocates room for \a cap characters plus the null-terminator. */
+    char* allocate_buf(size_type cap) { return alloc_traits::allocate(alloc(), cap + 1); }
+    void deallocate_buf(char* p, size_type cap) noexcept
+    {
+        alloc_traits::deallocate(alloc(), p, cap + 1);
+    }
+    void release() noexcept
+    {
+        if (!is_inline()) { deallocate_buf(m_storage.rep.heap.data, heap_capacity()); }
+    }
+
+    void steal(Basic_String& o) noexcept
+    {
+        m_storage.rep = o.m_storage.rep;
+        o.set_inline_size(0);
+    }
+
+    /* Size an empty string to \a n, copying \a s if given. */
+    void init(char const* s, size_type n);
+
+    void copy_init(Basic_String const& o)
+    {
+        if (o.is_inline()) {
+            m_storage.rep = o.m_storage.rep; // whole buffer, no size dependent copy
+        } else {
+            init(o.m_storage.rep.heap.data, o.m_storage.rep.heap.size);
+        }
+    }
+
+    /* Move to a new heap buffer of \a cap, then append \a extra. \a extra may point into this
+     * string. */
+    void reallocate(size_type cap, char const* extra, size_type extra_size);
+
+    /* Capacity to grow to so \a required characters fit. */
+    size_type grown_capacity(size_type required) const noexcept;
+};
+
+using String = Basic_String<>;
+
+template <typename Allocator>
+Basic_String<Allocator>& Basic_String<Allocator>::operator=(Basic_String const& o)
+{
+    if SDS_UNLIKELY(this == &o) { return *this; }
+
+    if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+        if (!alloc_traits::is_always_equal::value && alloc() != o.alloc()) {
+            release();
+            set_inline_size(0);
+        }
+        alloc() = o.alloc();
+    }
+    return assign(o.data(), o.size());
+}
+
+template <typename Allocator>
+Basic_String<Allocator>& Basic_String<Allocator>::operator=(Basic_String&& o) noexcept(
+    alloc_traits::propagate_on_container_move_assignment::value ||
+    alloc_traits::is_always_equal::value)
+{
+    if SDS_UNLIKELY(this == &o) { return *this; }
+
+    if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+        release();
+        alloc() = sds::move(o.alloc());
+        steal(o);
+    } else {
+        if (alloc_traits::is_always_equal::value || alloc() == o.alloc()) {
+            release();
+            steal(o);
+        } else {
+            // Memory from another allocator can't be adopted
+            assign(o.data(), o.size());
+        }
+    }
+    return *this;
+}
+
+template <typename Allocator>
+Basic_String<Allocator>& Basic_String<Allocator>::assign(char const* s, size_type n)
+{
+    if (n <= capacity()) {
+        if (n > 0) { std::memmove(data(), s, n); }
+        set_size(n);
+        return *this;
+    }
 
+    // Can't overlap: the source is larger than the current buffer
+    char* p = allocate_buf(n);
+    std::memcpy(p, s, n);
+    release();
+    set_heap(p, n, n);
+    return *this;
+}
+
+template <typename Allocator>
+typename Basic_String<Allocator>::size_type Basic_String<Allocator>::max_size() const noexcept
+{
+    size_type const alloc_max = static_cast<size_type>(alloc_traits::max_size(alloc())) - 1;
+    return alloc_max < s_heap_flag - 1 ? alloc_max : s_heap_flag - 1;
+}
+
+template <typename Allocator>
+void Basic_String<Allocator>::reserve(size_type new_cap)
+{
+    if (new_cap > capacity()) { reallocate(new_cap, nullptr, 0); }
+}
+
+template <typename Allocator>
+void Basic_String<Allocator>::shrink_to_fit()
+{
+    if (is_inline()) { return; }
+
+    size_type const n = m_storage.rep.heap.size;
+    if (n <= s_inline_capacity) {
+        char* const p = m_storage.rep.heap.data;
+        size_type const cap = heap_capacity();
+        std::memcpy(m_storage.rep.buf, p, n);
+        set_inline_size(n);
+        deallocate_buf(p, cap);
+    } else if (n < heap_capacity()) {
+        reallocate(n, nullptr, 0);
+    }
+}
+
+template <typename Allocator>
+void Basic_String<Allocator>::resize(size_type count, char c)
+{
+    size_type const old_size = size();
+    if (count > old_size) {
+        if (count > capacity()) { reallocate(grown_capacity(count), nullptr, 0); }
+        std::memset(data() + old_size, c, count - old_size);
+    }
+    set_size(count);
+}
+
+template <typename Allocator>
+void Basic_String<Allocator>::push_back(char c)
+{
+    // One representation check on the fast path
+    Rep& rep = m_storage.rep;
+    if (is_inline()) {
+        size_type const n = s_inline_capacity - tag();
+        if SDS_LIKELY(n < s_inline_capacity) {
+            rep.buf[n] = c;
+            set_inline_size(n + 1);
+            return;
+        }
+    } else {
+        size_type const n = rep.heap.size;
+        if SDS_LIKELY(n < heap_capacity()) {
+            rep.heap.data[n] = c;
+            rep.heap.data[n + 1] = '\0';
+            rep.heap.size = n + 1;
+            return;
+        }
+    }
+
+    reallocate(grown_capacity(size() + 1), &c, 1);
+}
+
+template <typename Allocator>
+Basic_String<Allocator>& Basic_String<Allocator>::append(char const* s, size_type n)
+{
+    size_type const old_size = size();
+    if (n > capacity() - old_size) {
+        SDS_ASSERT(n <= max_size() - old_size);
+        reallocate(grown_capacity(old_size + n), s, n);
+        return *this;
+    }
+
+    // Can't overlap: the destination is past the end of the string
+    if (n > 0) { std::memcpy(data() + old_size, s, n); }
+    set_size(old_size + n);
+    return *this;
+}
+
+template <typename Allocator>
+Basic_String<Allocator>& Basic_String<Allocator>::append(size_type count, char c)
+{
+    resize(size() + count, c);
+    return *this;
+}
+
+template <typename Allocator>
+void Basic_String<Allocator>::swap(Basic_String& o) noexcept
+{
+    if constexpr (alloc_traits::propagate_on_container_swap::value) {
+        sds::swap(alloc(), o.alloc());
+    } else {
+        SDS_ASSERT(alloc_traits::is_always_equal::value || alloc() == o.alloc());
+    }
+
+    Rep const tmp = m_storage.rep;
+    m_storage.rep = o.m_storage.rep;
+    o.m_storage.rep = tmp;
+}
+
+template <typename Allocator>
+void Basic_String<Allocator>::init(char const* s, size_type n)
+{
+    if (n <= s_inline_capacity) {
+        if (s && n > 0) { std::memcpy(m_storage.rep.buf, s, n); }
+        set_inline_size(n);
+        return;
+    }
+
+    SDS_ASSERT(n <= max_size());
+    char* p = allocate_buf(n);
+    if (s) { std::memcpy(p, s, n); }
+    set_heap(p, n, n);
+}
+
+template <typename Allocator>
+void Basic_String<Allocator>::reallocate(size_type cap, char const* extra, size_type extra_size)
+{
+    size_type const old_size = size();
+    SDS_ASSERT(old_size + extra_size <= cap);
+
+    char* p = allocate_buf(cap);
+    std::memcpy(p, data(), old_size);
+    if (extra_size > 0) { std::memcpy(p + old_size, extra, extra_size); }
+    release(); // after the copy, extra may have pointed into the old buffer
+    set_heap(p, cap, old_size + extra_size);
+}
+
+template <typename Allocator>
+typename Basic_String<Allocator>::size_type
+Basic_String<Allocator>::grown_capacity(size_type required) const noexcept
+{
+    size_type const cap = capacity();
+    size_type const max = max_size();
+    size_type const grown = cap < max - cap / 2 ? cap + cap / 2 : max;
+    return grown > required ? grown : required;
+}
+
+template <typename Allocator>
+void swap(Basic_String<Allocator>& a, Basic_String<Allocator>& b) noexcept
+{
+    a.swap(b);
+}
 } // namespace sds
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "sds/details/common.h"
+#include "sds/lockless.h"
+#include "sds/string_view.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace sds
+{
+/**
+ * \brief Handle to a string stored in a String_Interner.
+ *
+ * Handles from the same interner are equal if and only if their strings are equal, so comparison
+ * is an integer compare.
+ */
+class Interned_String {
+public:
+    static constexpr u32 invalid_id = ~0U;
+
+    constexpr Interned_String() noexcept = default;
+    constexpr explicit Interned_String(u32 id) noexcept : m_id(id) {}
+
+    [[nodiscard]] constexpr u32 id() const noexcept { return m_id; }
+    [[nodiscard]] constexpr bool is_valid() const noexcept { return m_id != invalid_id; }
+
+    [[nodiscard]] constexpr bool operator==(Interned_String o) const noexcept
+    {
+        return m_id == o.m_id;
+    }
+    [[nodiscard]] constexpr bool operator!=(Interned_String o) const noexcept
+    {
+        return m_id != o.m_id;
+    }
+
+    /**
+     * \brief Order of interning. Not lexicographic.
+     */
+    [[nodiscard]] constexpr bool operator<(Interned_String o) const noexcept
+    {
+        return m_id < o.m_id;
+    }
+
+private:
+    u32 m_id = invalid_id;
+};
+
+/**
+ * \brief Thread-safe pool of unique strings.
+ *
+ * Each distinct string is stored once, null-terminated, in arena chunks that are only freed with
+ * the interner. Views and pointers to interned strings stay valid for the life of the interner.
+ *
+ * The lookup table is split into lock-striped shards picked by hash, so threads interning
+ * different strings rarely contend. Resolving a handle back to its string is lock-free.
+ */
+class String_Interner {
+public:
+    String_Interner();
+    ~String_Interner() noexcept;
+
+    String_Interner(String_Interner const&) = delete;
+    String_Interner& operator=(String_Interner const&) = delete;
+
+    /**
+     * \brief Handle for \a s, adding it to the pool if needed.
+     */
+    [[nodiscard]] Interned_String intern(String_View s);
+
+    /**
+     * \brief Handle for \a s if it has been interned, otherwise an invalid handle.
+     */
+    [[nodiscard]] Interned_String find(String_View s) const noexcept;
+
+    /**
+     * \brief The interned string. Null-terminated.
+     */
+    [[nodiscard]] String_View view(Interned_String h) const noexcept;
+    [[nodiscard]] char const* c_str(Interned_String h) const noexcept { return view(h).data(); }
+
+    /**
+     * \brief Number of unique strings.
+     */
+    [[nodiscard]] u32 size() const noexcept { return m_next_id.load(std::memory_order_relaxed); }
+
+    /**
+     * \brief Bytes of string storage in use, including null-terminators.
+     */
+    [[nodiscard]] size_t string_bytes() const noexcept
+    {
+        return m_string_bytes.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Entry {
+        char const* data;
+        u32 size;
+    };
+
+    struct Slot {
+        u32 hash;
+        u32 id; // Interned_String::invalid_id when empty
+    };
+
+    /* Bump allocator for string storage. */
+    struct Arena {
+        std::vector<std::unique_ptr<char[]>> chunks{};
+        char* next = nullptr;
+        size_t remaining = 0;
+
+        char* allocate(size_t n);
+    };
+
+    /* Open addressing table with linear probing. */
+    struct alignas(hardware_destructive_interference_size) Stripe {
+        mutable Spin_Lock lock{};
+        std::unique_ptr<Slot[]> slots{};
+        u32 capacity = 0; // power of 2
+        u32 count = 0;
+        Arena arena{};
+    };
+
+    static constexpr s32 s_stripe_bits = 6;
+    static constexpr s32 s_num_stripes = 1 << s_stripe_bits;
+
+    // Entries are stored in segments that double in size, so existing entries never move and can
+    // be read without a lock.
+    static constexpr s32 s_first_segment_bits = 10;
+    static constexpr s32 s_max_segments = 32 - s_first_segment_bits + 1;
+
+    Stripe m_stripes[s_num_stripes];
+    std::atomic<Entry*> m_segments[s_max_segments] = {};
+    std::atomic<u32> m_next_id{0};
+    std::atomic<size_t> m_string_bytes{0};
+
+    Stripe& stripe(u64 hash) noexcept { return m_stripes[hash >> (64 - s_stripe_bits)]; }
+    Stripe const& stripe(u64 hash) const noexcept
+    {
+        return m_stripes[hash >> (64 - s_stripe_bits)];
+    }
+
+    Entry const& entry(u32 id) const noexcept;
+    /* Entry of \a id, allocating its segment if needed. */
+    Entry& new_entry(u32 id);
+
+    /* Id of \a s in \a st, or invalid_id. Caller holds the stripe lock. */
+    u32 find_locked(Stripe const& st, u32 hash, String_View s) const noexcept;
+    static void grow(Stripe& st);
+};
+} // namespace sds
@@ -0,0 +1,427 @@
+#pragma once
+
+#include "sds/details/common.h"
+#include <cstring>
+#include <iterator>
+#include <string>
+
+#if SDS_INCLUDE_STL_FEATURES
+#    include <ostream>
+#    include <string_view>
+#endif
+
+namespace sds
+{
+int str_size(char const* s) noexcept;
+
+namespace details
+{
+/*
+ * Byte search kernels. SSE2/SSSE3/AVX2, picked at runtime. Return a pointer to the first match in
+ * [s, s + n), or nullptr. Never read outside of the given ranges.
+ */
+char const* find_char(char const* s, size_t n, char c) noexcept;
+char const* find_any_of(char const* s, size_t n, char const* set, size_t set_n) noexcept;
+char const* find_substr(char const* s, size_t n, char const* needle, size_t needle_n) noexcept;
+
+/* Scalar versions for constant evaluation. */
+constexpr char const* find_char_constexpr(char const* s, size_t n, char c) noexcept
+{
+    for (size_t i = 0; i < n; ++i) {
+        if (s[i] == c) { return s + i; }
+    }
+    return nullptr;
+}
+
+constexpr char const* find_any_of_constexpr(char const* s, size_t n, char const* set,
+                                            size_t set_n) noexcept
+{
+    for (size_t i = 0; i < n; ++i) {
+        if (find_char_constexpr(set, set_n, s[i])) { return s + i; }
+    }
+    return nullptr;
+}
+
+constexpr char const* find_substr_constexpr(char const* s, size_t n, char const* needle,
+                                            size_t needle_n) noexcept
+{
+    if (needle_n > n) { return nullptr; }
+    for (size_t i = 0; i <= n - needle_n; ++i) {
+        if (std::char_traits<char>::compare(s + i, needle, needle_n) == 0) { return s + i; }
+    }
+    return nullptr;
+}
+} // namespace details
+
+class String_Split;
+
+/**
+ * \brief Non-owning view of a contiguous character sequence. Pointer plus length.
+ *
+ * Does not require a null-terminator. The viewed memory must outlive the view.
+ */
+class String_View {
+public:
+    using value_type = char;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using const_reference = char const&;
+    using const_pointer = char const*;
+    using const_iterator = char const*;
+    using iterator = const_iterator;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+private:
+    char const* m_data = nullptr;
+    size_type m_size = 0;
+
+public:
+    constexpr String_View() noexcept = default;
+    constexpr String_View(char const* s, size_type size) noexcept : m_data(s), m_size(size) {}
+
+    /**
+     * \param s Null-terminated string.
+     */
+    constexpr String_View(char const* s) noexcept : m_data(s), m_size(length_of(s)) {}
+
+#if SDS_INCLUDE_STL_FEATURES
+    constexpr String_View(std::string_view s) noexcept : m_data(s.data()), m_size(s.size()) {}
+    constexpr operator std::string_view() const noexcept { return {m_data, m_size}; }
+#endif
+
+    [[nodiscard]] constexpr const_pointer data() const noexcept { return m_data; }
+    [[nodiscard]] constexpr size_type size() const noexcept { return m_size; }
+    [[nodiscard]] constexpr size_type length() const noexcept { return m_size; }
+    [[nodiscard]] constexpr bool empty() const noexcept { return m_size == 0; }
+
+    [[nodiscard]] constexpr const_iterator begin() const noexcept { return m_data; }
+    [[nodiscard]] constexpr const_iterator end() const noexcept { return m_data + m_size; }
+    [[nodiscard]] constexpr const_iterator cbegin() const noexcept { return begin(); }
+    [[nodiscard]] constexpr const_iterator cend() const noexcept { return end(); }
+
+    [[nodiscard]] constexpr const_reference operator[](size_type pos) const noexcept
+    {
+        SDS_ASSERT(pos < m_size);
+        return m_data[pos];
+    }
+
+    [[nodiscard]] constexpr const_reference front() const noexcept
+    {
+        SDS_ASSERT(!empty());
+        return m_data[0];
+    }
+
+    [[nodiscard]] constexpr const_reference back() const noexcept
+    {
+        SDS_ASSERT(!empty());
+        return m_data[m_size - 1];
+    }
+
+    constexpr void remove_prefix(size_type n) noexcept
+    {
+        SDS_ASSERT(n <= m_size);
+        m_data += n;
+        m_size -= n;
+    }
+
+    constexpr void remove_suffix(size_type n) noexcept
+    {
+        SDS_ASSERT(n <= m_size);
+        m_size -= n;
+    }
+
+    /**
+     * \brief View of [pos, pos + count), clamped to the end of the view.
+     */
+    [[nodiscard]] constexpr String_View substr(size_type pos = 0, size_type count = npos) const
+        noexcept
+    {
+        SDS_ASSERT(pos <= m_size);
+        size_type const rest = m_size - pos;
+        return {m_data + pos, count < rest ? count : rest};
+    }
+
+    [[nodiscard]] constexpr bool starts_with(String_View prefix) const noexcept
+    {
+        return m_size >= prefix.m_size &&
+               std::char_traits<char>::compare(m_data, prefix.m_data, prefix.m_size) == 0;
+    }
+    [[nodiscard]] constexpr bool starts_with(char c) const noexcept
+    {
+        return m_size > 0 && m_data[0] == c;
+    }
+
+    [[nodiscard]] constexpr bool ends_with(String_View suffix) const noexcept
+    {
+        return m_size >= suffix.m_size &&
+               std::char_traits<char>::compare(m_data + m_size - suffix.m_size, suffix.m_data,
+                                               suffix.m_size) == 0;
+    }
+    [[nodiscard]] constexpr bool ends_with(char c) const noexcept
+    {
+        return m_size > 0 && m_data[m_size - 1] == c;
+    }
+
+    /**
+     * \brief Position of the first \a c at or after \a pos, or npos.
+     */
+    [[nodiscard]] constexpr size_type find(char c, size_type pos = 0) const noexcept
+    {
+        if (pos >= m_size) { return npos; }
+        char const* const p = SDS_IS_CONSTANT_EVALUATED()
+                                  ? details::find_char_constexpr(m_data + pos, m_size - pos, c)
+                                  : details::find_char(m_data + pos, m_size - pos, c);
+        return to_pos(p);
+    }
+
+    /**
+     * \brief Position of the first occurrence of \a needle at or after \a pos, or npos.
+     */
+    [[nodiscard]] constexpr size_type find(String_View needle, size_type pos = 0) const noexcept
+    {
+        if (pos > m_size) { return npos; }
+        // Empty needles match at pos, even in a view with no data
+        if (needle.m_size == 0) { return pos; }
+        char const* const p =
+            SDS_IS_CONSTANT_EVALUATED()
+                ? details::find_substr_constexpr(m_data + pos, m_size - pos, needle.m_data,
+                                                 needle.m_size)
+                : details::find_substr(m_data + pos, m_size - pos, needle.m_data, needle.m_size);
+        return to_pos(p);
+    }
+
+    /**
+     * \brief Position of the first character at or after \a pos that is in \a set, or npos.
+     *
+     * Any byte values may be in the set. The search is a table lookup per byte, so the cost
+     * does not depend on the size of the set.
+     */
+    [[nodiscard]] constexpr size_type find_first_of(String_View set, size_type pos = 0) const
+        noexcept
+    {
+        if (pos >= m_size) { return npos; }
+        char const* const p =
+            SDS_IS_CONSTANT_EVALUATED()
+                ? details::find_any_of_constexpr(m_data + pos, m_size - pos, set.m_data,
+                                                 set.m_size)
+                : details::find_any_of(m_data + pos, m_size - pos, set.m_data, set.m_size);
+        return to_pos(p);
+    }
+
+    [[nodiscard]] constexpr bool contains(char c) const noexcept { return find(c) != npos; }
+    [[nodiscard]] constexpr bool contains(String_View s) const noexcept
+    {
+        return find(s) != npos;
+    }
+
+    /**
+     * \brief Split on every \a delim. Returns views into this view; nothing is allocated.
+     *
+     * Adjacent delimiters produce empty tokens, and n delimiters produce n + 1 tokens.
+     * ex. "a,,b" -> "a", "", "b"
+     */
+    [[nodiscard]] constexpr String_Split split(char delim) const noexcept;
+
+    /**
+     * \brief Split on every occurrence of \a separator. See split(char).
+     */
+    [[nodiscard]] constexpr String_Split split(String_View separator) const noexcept;
+
+    /**
+     * \brief Split on every character in \a delims. See split(char).
+     */
+    [[nodiscard]] constexpr String_Split split_any_of(String_View delims) const noexcept;
+
+    /**
+     * \brief Three-way lexicographic comparison.
+     */
+    [[nodiscard]] constexpr int compare(String_View o) const noexcept
+    {
+        size_type const n = m_size < o.m_size ? m_size : o.m_size;
+        int const c = std::char_traits<char>::compare(m_data, o.m_data, n);
+        if (c != 0) { return c; }
+        return m_size == o.m_size ? 0 : (m_size < o.m_size ? -1 : 1);
+    }
+
+private:
+    constexpr size_type to_pos(char const* p) const noexcept
+    {
+        return p ? static_cast<size_type>(p - m_data) : npos;
+    }
+
+    static constexpr size_type length_of(char const* s) noexcept
+    {
+        if (!s) { return 0; }
+        if (SDS_IS_CONSTANT_EVALUATED()) { return std::char_traits<char>::length(s); }
+        return static_cast<size_type>(sds::str_size(s));
+    }
+};
+
+/**
+ * \brief Range of the tokens of a String_View between delimiters.
+ *
+ * Usage: `for (String_View field : line.split(',')) { ... }`
+ */
+class String_Split {
+public:
+    enum class Mode : u8 { character, substring, any_of };
+
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = String_View;
+        using difference_type = ptrdiff_t;
+        using pointer = String_View const*;
+        using reference = String_View const&;
+
+        constexpr Iterator() noexcept = default;
+
+        [[nodiscard]] constexpr reference operator*() const noexcept { return m_token; }
+        [[nodiscard]] constexpr pointer operator->() const noexcept { return &m_token; }
+
+        constexpr Iterator& operator++() noexcept
+        {
+            advance();
+            return *this;
+        }
+        constexpr Iterator operator++(int) noexcept
+        {
+            Iterator tmp = *this;
+            advance();
+            return tmp;
+        }
+
+        [[nodiscard]] constexpr bool operator==(Iterator const& o) const noexcept
+        {
+            return m_done == o.m_done && (m_done || m_token.data() == o.m_token.data());
+        }
+        [[nodiscard]] constexpr bool operator!=(Iterator const& o) const noexcept
+        {
+            return !(*this == o);
+        }
+
+    private:
+        friend class String_Split;
+
+        String_View m_delim{};
+        Mode m_mode = Mode::character;
+        char m_char = '\0';
+        String_View m_token{};
+        String_View m_rest{};
+        bool m_last = false; // m_token is the final token
+        bool m_done = true;
+
+        constexpr explicit Iterator(String_Split const& split) noexcept
+            : m_delim(split.m_delim),
+              m_mode(split.m_mode),
+              m_char(split.m_char),
+              m_rest(split.m_str),
+              m_done(false)
+        {
+            advance();
+        }
+
+        constexpr void advance() noexcept
+        {
+            if (m_last) {
+                m_done = true;
+                return;
+            }
+
+            String_View::size_type pos = String_View::npos;
+            String_View::size_type delim_size = 1;
+            switch (m_mode) {
+                case Mode::character: pos = m_rest.find(m_char); break;
+                case Mode::substring:
+                    pos = m_rest.find(m_delim);
+                    delim_size = m_delim.size();
+                    break;
+                case Mode::any_of: pos = m_rest.find_first_of(m_delim); break;
+                default: SDS_ASSERT(false); break;
+            }
+
+            if (pos == String_View::npos) {
+                m_token = m_rest;
+                m_last = true;
+            } else {
+                m_token = m_rest.substr(0, pos);
+                m_rest.remove_prefix(pos + delim_size);
+            }
+        }
+    };
+
+    using iterator = Iterator;
+    using const_iterator = Iterator;
+
+    constexpr String_Split(String_View str, String_View delim, Mode mode) noexcept
+        : m_str(str), m_delim(delim), m_mode(mode)
+    {
+        SDS_ASSERT(mode == Mode::any_of || !delim.empty());
+    }
+
+    constexpr String_Split(String_Split const&) noexcept = default;
+    constexpr String_Split& operator=(String_Split const&) noexcept = default;
+
+    [[nodiscard]] constexpr Iterator begin() const noexcept { return Iterator(*this); }
+    [[nodiscard]] constexpr Iterator end() const noexcept { return Iterator(); }
+
+private:
+    String_View m_str;
+    String_View m_delim;
+    Mode m_mode;
+    char m_char = '\0'; // storage for a single character delimiter
+
+    friend class String_View;
+
+    constexpr String_Split(String_View str, char delim) noexcept
+        : m_str(str), m_delim(), m_mode(Mode::character), m_char(delim)
+    {}
+};
+
+constexpr String_Split String_View::split(char delim) const noexcept
+{
+    return String_Split(*this, delim);
+}
+
+constexpr String_Split String_View::split(String_View separator) const noexcept
+{
+    return String_Split(*this, separator, String_Split::Mode::substring);
+}
+
+constexpr String_Split String_View::split_any_of(String_View delims) const noexcept
+{
+    return String_Split(*this, delims, String_Split::Mode::any_of);
+}
+
+[[nodiscard]] constexpr bool operator==(String_View a, String_View b) noexcept
+{
+    return a.size() == b.size() &&
+           std::char_traits<char>::compare(a.data(), b.data(), a.size()) == 0;
+}
+
+[[nodiscard]] constexpr bool operator!=(String_View a, String_View b) noexcept { return !(a == b); }
+[[nodiscard]] constexpr bool operator<(String_View a, String_View b) noexcept
+{
+    return a.compare(b) < 0;
+}
+[[nodiscard]] constexpr bool operator<=(String_View a, String_View b) noexcept
+{
+    return a.compare(b) <= 0;
+}
+[[nodiscard]] constexpr bool operator>(String_View a, String_View b) noexcept
+{
+    return a.compare(b) > 0;
+}
+[[nodiscard]] constexpr bool operator>=(String_View a, String_View b) noexcept
+{
+    return a.compare(b) >= 0;
+}
+
+#if SDS_INCLUDE_STL_FEATURES
+inline std::ostream& operator<<(std::ostream& os, String_View s)
+{
+    return os.write(s.data(), static_cast<std::streamsize>(s.size()));
+}
+#endif
+} // namespace sds
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "sds/details/common.h"
+#include <tuple>
 #include <type_traits>
 
 #if SDS_USE_RTTI_FEATURES
@@ -22,8 +23,53 @@ struct contains : std::disjunction<std::is_same<T, Ts>...> {};
  *
  * \see contains
  */
-template <typename T>
-inline constexpr bool contains_v = contains<T>::value;
+template <typename T, typename... Ts>
+inline constexpr bool contains_v = contains<T, Ts...>::value;
+
+/**
+ * \brief Number of times type \a T appears in the type list \a Ts.
+ *
+ * Usage: `type_count<int, Args...>::value`.
+ */
+template <typename T, typename... Ts>
+struct type_count : std::integral_constant<size_t, (size_t{std::is_same_v<T, Ts>} + ... + 0)> {};
+
+template <typename T, typename... Ts>
+inline constexpr size_t type_count_v = type_count<T, Ts...>::value;
+
+namespace details
+{
+template <size_t I, typename T, typename... Ts>
+struct type_index_impl : std::integral_constant<size_t, I> {};
+
+template <size_t I, typename T, typename Head, typename... Tail>
+struct type_index_impl<I, T, Head, Tail...>
+    : std::conditional_t<std::is_same_v<T, Head>, std::integral_constant<size_t, I>,
+                         type_index_impl<I + 1, T, Tail...>> {};
+} // namespace details
+
+/**
+ * \brief Index of the first \a T in the type list \a Ts, or `sizeof...(Ts)` if absent.
+ *
+ * Usage: `type_index<float, int, float>::value == 1`.
+ */
+template <typename T, typename... Ts>
+struct type_index : details::type_index_impl<0, T, Ts...> {};
+
+template <typename T, typename... Ts>
+inline constexpr size_t type_index_v = type_index<T, Ts...>::value;
+
+/**
+ * \brief Type at index \a I of the type list \a Ts.
+ */
+template <size_t I, typename... Ts>
+struct type_at {
+    SDS_STATIC_ASSERT(I < sizeof...(Ts));
+    using type = std::tuple_element_t<I, std::tuple<Ts...>>;
+};
+
+template <size_t I, typename... Ts>
+using type_at_t = typename type_at<I, Ts...>::type;
 
 #if SDS_USE_RTTI_FEATURES
 template <typename T>
@@ -28,6 +28,17 @@
 #define SDS_I_STR(X) #X
 #define SDS_STR(X) SDS_I_STR(X)
 
+/**
+ * \def SDS_CONCAT
+ * \brief Paste two tokens together after expanding them.
+ *
+ * Ex usage:
+ *  int SDS_CONCAT(tmp_, __LINE__);
+ *      => int tmp_42;
+ */
+#define SDS_I_CONCAT(A, B) A##B
+#define SDS_CONCAT(A, B) SDS_I_CONCAT(A, B)
+
 /**
  * \def SDS_OS_WINDOWS
  * \brief True if compiling on Windows.
@@ -166,6 +177,10 @@
 #   else
 #       define SDS_32_BIT 1
     #endif
+#elif SDS_ARCH_AMD64
+#   define SDS_64_BIT 1
+#elif SDS_ARCH_X86
+#   define SDS_32_BIT 1
 #else
 #   error Unsupported OS
 #endif
@@ -317,6 +332,23 @@
  */
 #define SDS_INTERNAL static
 
+/**
+ * \def SDS_IS_CONSTANT_EVALUATED
+ * \brief Portable `std::is_constant_evaluated()`. True when evaluated in a constant expression.
+ *
+ * Used to pick a constexpr-friendly path over a non-constexpr intrinsic.
+ *
+ * Usage: `if (SDS_IS_CONSTANT_EVALUATED()) { ... }`
+ */
+#ifndef SDS_IS_CONSTANT_EVALUATED
+#    if SDS_COMPILER_MSC || SDS_COMPILER_GCC || SDS_COMPILER_CLANG
+#        define SDS_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#    else
+// Conservative: always take the constexpr-friendly path.
+#        define SDS_IS_CONSTANT_EVALUATED() true
+#    endif
+#endif
+
 /**
  * \def SDS_LIKELY
  * \brief Portable `likely` branch attribute for if statements. Does not work on case statements.
@@ -382,11 +414,11 @@ using sz = s32; /** Size type (size_t equivalent) */
 using ptrdiff = std::ptrdiff_t;
 using byte = std::byte;
 
-constexpr auto operator""_KB(u64 s) { return s * 1024; }
+constexpr auto operator""_KB(unsigned long long s) { return s * 1024; }
 
-constexpr auto operator""_MB(u64 s) { return s * 1024_KB; }
+constexpr auto operator""_MB(unsigned long long s) { return s * 1024_KB; }
 
-constexpr auto operator""_GB(u64 s) { return s * 1024_MB; }
+constexpr auto operator""_GB(unsigned long long s) { return s * 1024_MB; }
 
 /**
  * \def SDS_STATIC_ASSERT(expr)
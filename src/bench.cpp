@@ -0,0 +1,301 @@
+#include "sds/bench.h"
+
+#include "sds/cpu.h"
+#include "sds/intrinsics.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+using namespace sds;
+
+namespace
+{
+constexpr char const* baseline_header = "sds-bench-results 1";
+
+double ticks_to_ns(Bench_Clock clock, u64 ticks) noexcept
+{
+    double const t = static_cast<double>(ticks);
+    return clock == Bench_Clock::tsc ? t / sds::tsc_ticks_per_ns() : t;
+}
+
+double median_of_sorted(double const* sorted, size_t count) noexcept
+{
+    return sds::percentile(sorted, count, 0.5);
+}
+
+/* Two-sided p-value of the Mann-Whitney U test, by normal approximation with tie correction. */
+double mann_whitney_p(std::vector<double> const& a, std::vector<double> const& b)
+{
+    size_t const na = a.size();
+    size_t const nb = b.size();
+    size_t const n = na + nb;
+
+    struct Ranked {
+        double v;
+        bool from_a;
+    };
+    std::vector<Ranked> all;
+    all.reserve(n);
+    for (double v : a) { all.push_back({v, true}); }
+    for (double v : b) { all.push_back({v, false}); }
+    std::sort(all.begin(), all.end(), [](Ranked const& x, Ranked const& y) { return x.v < y.v; });
+
+    // Tied values share the average of their ranks
+    double rank_sum_a = 0.0;
+    double tie_term = 0.0;
+    for (size_t i = 0; i < n;) {
+        size_t j = i + 1;
+        // Sorted, so not less means equal
+        while (j < n && !(all[i].v < all[j].v)) { ++j; }
+        double const avg_rank = (static_cast<double>(i + j) + 1.0) / 2.0;
+        for (size_t k = i; k < j; ++k) {
+            if (all[k].from_a) { rank_sum_a += avg_rank; }
+        }
+        double const t = static_cast<double>(j - i);
+        tie_term += t * t * t - t;
+        i = j;
+    }
+
+    double const dna = static_cast<double>(na);
+    double const dnb = static_cast<double>(nb);
+    double const dn = static_cast<double>(n);
+    double const u = rank_sum_a - dna * (dna + 1.0) / 2.0;
+    double const mean = dna * dnb / 2.0;
+    double const var = dna * dnb / 12.0 * ((dn + 1.0) - tie_term / (dn * (dn - 1.0)));
+    if (var <= 0.0) { return 1.0; } // all values equal
+
+    // Continuity correction towards the mean
+    double const diff = std::abs(u - mean);
+    double const z = std::max(0.0, diff - 0.5) / std::sqrt(var);
+    return std::erfc(z / std::sqrt(2.0));
+}
+} // namespace
+
+double sds::percentile(double const* sorted, size_t count, double p) noexcept
+{
+    SDS_ASSERT(p >= 0.0 && p <= 1.0);
+    if (count == 0) { return 0.0; }
+
+    double const pos = p * static_cast<double>(count - 1);
+    size_t const lo = static_cast<size_t>(pos);
+    size_t const hi = std::min(lo + 1, count - 1);
+    double const frac = pos - static_cast<double>(lo);
+    return sorted[lo] + (sorted[hi] - sorted[lo]) * frac;
+}
+
+Bench_Stats sds::bench_stats(double* samples, size_t count)
+{
+    Bench_Stats s;
+    if (count == 0) { return s; }
+
+    std::sort(samples, samples + count);
+    s.median = median_of_sorted(samples, count);
+    s.min = samples[0];
+    s.max = samples[count - 1];
+    s.p10 = sds::percentile(samples, count, 0.10);
+    s.p90 = sds::percentile(samples, count, 0.90);
+    s.p99 = sds::percentile(samples, count, 0.99);
+
+    double sum = 0.0;
+    std::vector<double> deviations(count);
+    for (size_t i = 0; i < count; ++i) {
+        sum += samples[i];
+        deviations[i] = std::abs(samples[i] - s.median);
+    }
+    s.mean = sum / static_cast<double>(count);
+
+    std::sort(deviations.begin(), deviations.end());
+    s.mad = median_of_sorted(deviations.data(), count);
+    return s;
+}
+
+u64 sds::details::bench_now(Bench_Clock clock) noexcept
+{
+    if (clock == Bench_Clock::tsc) { return sds::read_tsc(); }
+    return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                std::chrono::steady_clock::now().time_since_epoch())
+                                .count());
+}
+
+Bench_Result sds::details::run_bench(String_View name, Bench_Config const& config,
+                                     Bench_Sample_Fn sample, void* ctx)
+{
+    SDS_ASSERT(config.sample_count > 0);
+    Bench_Clock const clock = config.clock;
+    double const min_sample_ns = config.min_sample_ms * 1e6;
+    double const warmup_ns = config.warmup_ms * 1e6;
+
+    // Calibrate: double the iterations until a sample is long enough. Counts as warm-up.
+    u64 iterations = 1;
+    double warm_ns = 0.0;
+    for (;;) {
+        double const ns = ticks_to_ns(clock, sample(ctx, iterations, clock));
+        warm_ns += ns;
+        if (ns >= min_sample_ns || iterations >= config.max_iterations) { break; }
+        iterations = std::min(iterations * 2, config.max_iterations);
+    }
+    while (warm_ns < warmup_ns) { warm_ns += ticks_to_ns(clock, sample(ctx, iterations, clock)); }
+
+    Bench_Result r;
+    r.name.assign(name.data(), name.size());
+    r.iterations = iterations;
+    r.samples.resize(static_cast<size_t>(config.sample_count));
+    if (config.perf_counters) {
+        // Counters are read outside the timed loop, so they don't affect the timings
+        Perf_Counters counters;
+        r.counters.valid = counters.available();
+        for (double& s : r.samples) {
+            counters.start();
+            u64 const ticks = sample(ctx, iterations, clock);
+            r.counters += counters.stop();
+            s = ticks_to_ns(clock, ticks) / static_cast<double>(iterations);
+        }
+        r.counters /= static_cast<double>(iterations) * static_cast<double>(r.samples.size());
+    } else {
+        for (double& s : r.samples) {
+            s = ticks_to_ns(clock, sample(ctx, iterations, clock)) /
+                static_cast<double>(iterations);
+        }
+    }
+    r.stats = sds::bench_stats(r.samples.data(), r.samples.size());
+    return r;
+}
+
+char const* sds::to_string(Bench_Verdict v) noexcept
+{
+    switch (v) {
+        case Bench_Verdict::unchanged: return "unchanged";
+        case Bench_Verdict::improved: return "improved";
+        case Bench_Verdict::regressed: return "REGRESSED";
+        case Bench_Verdict::missing: return "new";
+        default: break;
+    }
+    return "unknown";
+}
+
+Bench_Comparison sds::compare(Bench_Result const& baseline, Bench_Result const& current,
+                              Bench_Compare_Config const& config)
+{
+    Bench_Comparison c;
+    if (baseline.samples.empty() || current.samples.empty() || baseline.stats.median <= 0.0) {
+        return c;
+    }
+
+    c.ratio = current.stats.median / baseline.stats.median;
+    c.p_value = mann_whitney_p(baseline.samples, current.samples);
+    c.verdict = Bench_Verdict::unchanged;
+    if (c.p_value < config.alpha && std::abs(c.ratio - 1.0) >= config.min_effect) {
+        c.verdict = c.ratio > 1.0 ? Bench_Verdict::regressed : Bench_Verdict::improved;
+    }
+    return c;
+}
+
+Bench_Result const& Bench_Results::add(Bench_Result r)
+{
+    for (Bench_Result& existing : m_results) {
+        if (existing.name == r.name) {
+            existing = std::move(r);
+            return existing;
+        }
+    }
+    m_results.push_back(std::move(r));
+    return m_results.back();
+}
+
+Bench_Result const* Bench_Results::find(std::string_view name) const noexcept
+{
+    for (Bench_Result const& r : m_results) {
+        if (r.name == name) { return &r; }
+    }
+    return nullptr;
+}
+
+bool Bench_Results::save(char const* path) const
+{
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) { return false; }
+
+    out.precision(17);
+    out << baseline_header << '\n';
+    for (Bench_Result const& r : m_results) {
+        SDS_ASSERT(r.name.find_first_of("\t\n") == std::string::npos);
+        out << r.name << '\t' << r.iterations;
+        for (double s : r.samples) { out << '\t' << s; }
+        out << '\n';
+    }
+    out.flush();
+    return static_cast<bool>(out);
+}
+
+bool Bench_Results::load(char const* path)
+{
+    std::ifstream in(path);
+    if (!in) { return false; }
+
+    std::string line;
+    if (!std::getline(in, line) || line != baseline_header) { return false; }
+
+    std::vector<Bench_Result> results;
+    while (std::getline(in, line)) {
+        if (line.empty()) { continue; }
+        size_t const tab = line.find('\t');
+        if (tab == std::string::npos || tab == 0) { return false; }
+
+        Bench_Result r;
+        r.name = line.substr(0, tab);
+        std::istringstream fields(line.substr(tab + 1));
+        if (!(fields >> r.iterations)) { return false; }
+        double s = 0.0;
+        while (fields >> s) { r.samples.push_back(s); }
+        if (!fields.eof() || r.samples.empty()) { return false; }
+
+        r.stats = sds::bench_stats(r.samples.data(), r.samples.size());
+        results.push_back(std::move(r));
+    }
+
+    m_results = std::move(results);
+    return true;
+}
+
+s32 sds::print_report(std::FILE* out, Bench_Results const& current, Bench_Results const* baseline,
+                      Bench_Compare_Config const& config)
+{
+    s32 regressions = 0;
+    for (Bench_Result const& r : current) {
+        Bench_Stats const& s = r.stats;
+        std::fprintf(out, "%-40s median %12.2f ns  mad %8.2f  p10 %12.2f  p90 %12.2f  p99 %12.2f",
+                     r.name.c_str(), s.median, s.mad, s.p10, s.p90, s.p99);
+
+        if (baseline) {
+            Bench_Result const* const base = baseline->find(r.name);
+            Bench_Comparison const c = base ? sds::compare(*base, r, config) : Bench_Comparison{};
+            if (c.verdict == Bench_Verdict::missing) {
+                std::fprintf(out, "  %s", sds::to_string(c.verdict));
+            } else {
+                std::fprintf(out, "  %+7.2f%% (p=%.2g) %s", (c.ratio - 1.0) * 100.0, c.p_value,
+                             sds::to_string(c.verdict));
+            }
+            if (c.verdict == Bench_Verdict::regressed) { ++regressions; }
+        }
+        std::fputc('\n', out);
+
+        Perf_Counter_Values const& pc = r.counters;
+        if (pc.valid != 0) {
+            std::fputs("   ", out);
+            for (u32 i = 0; i < perf_counter_count; ++i) {
+                Perf_Counter const c = static_cast<Perf_Counter>(i);
+                if (pc.has(c)) { std::fprintf(out, " %s %.2f", sds::to_string(c), pc[c]); }
+            }
+            if (pc.has(Perf_Counter::cycles) && pc.has(Perf_Counter::instructions) &&
+                pc[Perf_Counter::cycles] > 0.0) {
+                std::fprintf(out, " ipc %.2f",
+                             pc[Perf_Counter::instructions] / pc[Perf_Counter::cycles]);
+            }
+            std::fputc('\n', out);
+        }
+    }
+    return regressions;
+}
@@ -1,29 +1,190 @@
 #include "sds/bit.h"
 
+#include "sds/cpu.h"
+#include <cstring>
+
 using namespace sds;
 
-s32 bit_count(u32 x) noexcept
+/*
+ * Bulk popcount kernels. All operate on a byte range so they serve every word size.
+ *
+ * ref: Muła, Kurz, Lemire. "Faster Population Counts Using AVX2 Instructions". 2016.
+ */
+
+namespace
 {
-#if SDS_USE_COMPILER_BUILTINS
-#    if SDS_COMPILER_MSC
-    return static_cast<s32>(__popcnt(x));
-#    elif SDS_COMPILER_GCC || SDS_COMPILER_CLANG
-    return __builtin_popcount(x);
-#    endif
-#else
-#    error unimplemented
-#endif
+using Bit_Count_Fn = s64 (*)(u8 const*, size_t);
+
+u64 load_u64(u8 const* p) noexcept
+{
+    u64 v = 0;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+s64 bit_count_tail(u8 const* p, size_t n) noexcept
+{
+    s64 count = 0;
+    for (; n >= sizeof(u64); n -= sizeof(u64), p += sizeof(u64)) {
+        count += sds::bit_count(load_u64(p));
+    }
+    for (; n > 0; --n, ++p) { count += sds::bit_count(static_cast<u32>(*p)); }
+    return count;
+}
+
+s64 bit_count_generic(u8 const* p, size_t n) noexcept { return bit_count_tail(p, n); }
+
+#if SDS_ARCH_X86 || SDS_ARCH_AMD64
+SDS_TARGET("popcnt") s64 bit_count_popcnt(u8 const* p, size_t n) noexcept
+{
+    // Independent accumulators so the popcnt latency overlaps
+    s64 c0 = 0;
+    s64 c1 = 0;
+    s64 c2 = 0;
+    s64 c3 = 0;
+    for (; n >= 4 * sizeof(u64); n -= 4 * sizeof(u64), p += 4 * sizeof(u64)) {
+        c0 += sds::bit_count(load_u64(p));
+        c1 += sds::bit_count(load_u64(p + 8));
+        c2 += sds::bit_count(load_u64(p + 16));
+        c3 += sds::bit_count(load_u64(p + 24));
+    }
+    return c0 + c1 + c2 + c3 + bit_count_tail(p, n);
+}
+
+/* Per-byte popcount via nibble lookup, summed into four 64-bit lanes. */
+SDS_TARGET("avx2") inline __m256i popcount256(__m256i v) noexcept
+{
+    __m256i const lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1,
+                                            1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    __m256i const low_mask = _mm256_set1_epi8(0x0F);
+    __m256i const lo = _mm256_and_si256(v, low_mask);
+    __m256i const hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+    __m256i const cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo),
+                                        _mm256_shuffle_epi8(lookup, hi));
+    return _mm256_sad_epu8(cnt, _mm256_setzero_si256());
+}
+
+SDS_TARGET("avx2") inline __m256i load(u8 const* p) noexcept
+{
+    return _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p));
+}
+
+/* Carry-save adder: h:l = a + b + c */
+SDS_TARGET("avx2") inline void csa(__m256i& h, __m256i& l, __m256i a, __m256i b, __m256i c) noexcept
+{
+    __m256i const u = _mm256_xor_si256(a, b);
+    h = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(u, c));
+    l = _mm256_xor_si256(u, c);
+}
+
+SDS_TARGET("avx2") s64 bit_count_avx2(u8 const* p, size_t n) noexcept
+{
+    constexpr size_t vec_bytes = sizeof(__m256i);
+    constexpr size_t block_bytes = 16 * vec_bytes;
+
+    __m256i total = _mm256_setzero_si256();
+    __m256i ones = _mm256_setzero_si256();
+    __m256i twos = _mm256_setzero_si256();
+    __m256i fours = _mm256_setzero_si256();
+    __m256i eights = _mm256_setzero_si256();
+    __m256i sixteens = _mm256_setzero_si256();
+    __m256i twos_a;
+    __m256i twos_b;
+    __m256i fours_a;
+    __m256i fours_b;
+    __m256i eights_a;
+    __m256i eights_b;
+
+    // Harley-Seal: only one popcount per 16 vectors
+    for (; n >= block_bytes; n -= block_bytes, p += block_bytes) {
+        csa(twos_a, ones, ones, load(p + 0 * vec_bytes), load(p + 1 * vec_bytes));
+        csa(twos_b, ones, ones, load(p + 2 * vec_bytes), load(p + 3 * vec_bytes));
+        csa(fours_a, twos, twos, twos_a, twos_b);
+        csa(twos_a, ones, ones, load(p + 4 * vec_bytes), load(p + 5 * vec_bytes));
+        csa(twos_b, ones, ones, load(p + 6 * vec_bytes), load(p + 7 * vec_bytes));
+        csa(fours_b, twos, twos, twos_a, twos_b);
+        csa(eights_a, fours, fours, fours_a, fours_b);
+        csa(twos_a, ones, ones, load(p + 8 * vec_bytes), load(p + 9 * vec_bytes));
+        csa(twos_b, ones, ones, load(p + 10 * vec_bytes), load(p + 11 * vec_bytes));
+        csa(fours_a, twos, twos, twos_a, twos_b);
+        csa(twos_a, ones, ones, load(p + 12 * vec_bytes), load(p + 13 * vec_bytes));
+        csa(twos_b, ones, ones, load(p + 14 * vec_bytes), load(p + 15 * vec_bytes));
+        csa(fours_b, twos, twos, twos_a, twos_b);
+        csa(eights_b, fours, fours, fours_a, fours_b);
+        csa(sixteens, eights, eights, eights_a, eights_b);
+
+        total = _mm256_add_epi64(total, popcount256(sixteens));
+    }
+
+    total = _mm256_slli_epi64(total, 4);
+    total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount256(eights), 3));
+    total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount256(fours), 2));
+    total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount256(twos), 1));
+    total = _mm256_add_epi64(total, popcount256(ones));
+
+    for (; n >= vec_bytes; n -= vec_bytes, p += vec_bytes) {
+        total = _mm256_add_epi64(total, popcount256(load(p)));
+    }
+
+    alignas(32) u64 lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), total);
+    return static_cast<s64>(lanes[0] + lanes[1] + lanes[2] + lanes[3]) + bit_count_popcnt(p, n);
 }
 
-s32 bit_count(u64 x) noexcept
+SDS_TARGET("avx512f,avx512vpopcntdq")
+s64 bit_count_avx512_vpopcntdq(u8 const* p, size_t n) noexcept
 {
-#if SDS_USE_COMPILER_BUILTINS
-#    if SDS_COMPILER_MSC
-    return static_cast<s32>(__popcnt64(x));
-#    elif SDS_COMPILER_GCC || SDS_COMPILER_CLANG
-    return __builtin_popcountll(x);
-#    endif
-#else
-#    error unimplemented
+    constexpr size_t vec_bytes = sizeof(__m512i);
+
+    // Two accumulators to hide the add latency
+    __m512i total0 = _mm512_setzero_si512();
+    __m512i total1 = _mm512_setzero_si512();
+    for (; n >= 2 * vec_bytes; n -= 2 * vec_bytes, p += 2 * vec_bytes) {
+        total0 = _mm512_add_epi64(total0, _mm512_popcnt_epi64(_mm512_loadu_si512(p)));
+        total1 = _mm512_add_epi64(total1, _mm512_popcnt_epi64(_mm512_loadu_si512(p + vec_bytes)));
+    }
+    if (n >= vec_bytes) {
+        total0 = _mm512_add_epi64(total0, _mm512_popcnt_epi64(_mm512_loadu_si512(p)));
+        n -= vec_bytes;
+        p += vec_bytes;
+    }
+
+    // NOTE(sdsmith): Not _mm512_reduce_add_epi64, which trips -Wuninitialized in GCC 12's header
+    alignas(64) u64 lanes[8];
+    _mm512_store_si512(lanes, _mm512_add_epi64(total0, total1));
+    u64 count = 0;
+    for (u64 const lane : lanes) { count += lane; }
+    return static_cast<s64>(count) + bit_count_popcnt(p, n);
+}
+#endif
+
+Cpu_Dispatch<s64(u8 const*, size_t)> const bit_count_dispatch([](Cpu_Features const& f) {
+    Bit_Count_Fn fn = &bit_count_generic;
+#if SDS_ARCH_X86 || SDS_ARCH_AMD64
+    if (f.has(Cpu_Feature::avx512vpopcntdq) && f.has(Cpu_Feature::popcnt)) {
+        fn = &bit_count_avx512_vpopcntdq;
+    } else if (f.has(Cpu_Feature::avx2) && f.has(Cpu_Feature::popcnt)) {
+        fn = &bit_count_avx2;
+    } else if (f.has(Cpu_Feature::popcnt)) {
+        fn = &bit_count_popcnt;
+    }
 #endif
+    return fn;
+});
+} // namespace
+
+s64 sds::bit_count(u64 const* words, sz count) noexcept
+{
+    SDS_ASSERT(words || count == 0);
+    SDS_ASSERT(count >= 0);
+    return bit_count_dispatch(reinterpret_cast<u8 const*>(words),
+                              static_cast<size_t>(count) * sizeof(u64));
+}
+
+s64 sds::bit_count(u32 const* words, sz count) noexcept
+{
+    SDS_ASSERT(words || count == 0);
+    SDS_ASSERT(count >= 0);
+    return bit_count_dispatch(reinterpret_cast<u8 const*>(words),
+                              static_cast<size_t>(count) * sizeof(u32));
 }
@@ -0,0 +1,153 @@
+#include "sds/cpu.h"
+
+#if (SDS_ARCH_X86 || SDS_ARCH_AMD64) && (SDS_COMPILER_GCC || SDS_COMPILER_CLANG)
+#    include <cpuid.h>
+#endif
+
+#include <chrono>
+
+using namespace sds;
+
+namespace
+{
+#if SDS_ARCH_X86 || SDS_ARCH_AMD64
+struct Cpuid_Regs {
+    u32 eax = 0;
+    u32 ebx = 0;
+    u32 ecx = 0;
+    u32 edx = 0;
+};
+
+Cpuid_Regs cpuid(u32 leaf, u32 subleaf) noexcept
+{
+    Cpuid_Regs r;
+#if SDS_COMPILER_MSC
+    int regs[4] = {};
+    __cpuidex(regs, static_cast<int>(leaf), static_cast<int>(subleaf));
+    r.eax = static_cast<u32>(regs[0]);
+    r.ebx = static_cast<u32>(regs[1]);
+    r.ecx = static_cast<u32>(regs[2]);
+    r.edx = static_cast<u32>(regs[3]);
+#else
+    __cpuid_count(leaf, subleaf, r.eax, r.ebx, r.ecx, r.edx);
+#endif
+    return r;
+}
+
+/* Extended control register 0. Which register state the OS saves on context switch. */
+u64 xgetbv0() noexcept
+{
+#if SDS_COMPILER_MSC
+    return _xgetbv(0);
+#else
+    u32 eax = 0;
+    u32 edx = 0;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<u64>(edx) << 32) | eax;
+#endif
+}
+
+constexpr bool has_bit(u32 reg, u32 bit) noexcept { return (reg >> bit) & 1U; }
+#endif
+} // namespace
+
+char const* sds::to_string(Cpu_Feature f) noexcept
+{
+    switch (f) {
+        case Cpu_Feature::sse2: return "sse2";
+        case Cpu_Feature::sse3: return "sse3";
+        case Cpu_Feature::ssse3: return "ssse3";
+        case Cpu_Feature::sse41: return "sse4.1";
+        case Cpu_Feature::sse42: return "sse4.2";
+        case Cpu_Feature::popcnt: return "popcnt";
+        case Cpu_Feature::lzcnt: return "lzcnt";
+        case Cpu_Feature::bmi1: return "bmi1";
+        case Cpu_Feature::bmi2: return "bmi2";
+        case Cpu_Feature::fma: return "fma";
+        case Cpu_Feature::avx: return "avx";
+        case Cpu_Feature::avx2: return "avx2";
+        case Cpu_Feature::avx512f: return "avx512f";
+        case Cpu_Feature::avx512dq: return "avx512dq";
+        case Cpu_Feature::avx512cd: return "avx512cd";
+        case Cpu_Feature::avx512bw: return "avx512bw";
+        case Cpu_Feature::avx512vl: return "avx512vl";
+        case Cpu_Feature::avx512vbmi: return "avx512vbmi";
+        case Cpu_Feature::avx512vpopcntdq: return "avx512vpopcntdq";
+        case Cpu_Feature::count: break;
+        default: break;
+    }
+    return "unknown";
+}
+
+Cpu_Features Cpu_Features::detect() noexcept
+{
+    Cpu_Features f;
+#if SDS_ARCH_X86 || SDS_ARCH_AMD64
+    u32 const max_leaf = cpuid(0, 0).eax;
+    if (max_leaf < 1) { return f; }
+
+    Cpuid_Regs const l1 = cpuid(1, 0);
+    f.set(Cpu_Feature::sse2, has_bit(l1.edx, 26));
+    f.set(Cpu_Feature::sse3, has_bit(l1.ecx, 0));
+    f.set(Cpu_Feature::ssse3, has_bit(l1.ecx, 9));
+    f.set(Cpu_Feature::sse41, has_bit(l1.ecx, 19));
+    f.set(Cpu_Feature::sse42, has_bit(l1.ecx, 20));
+    f.set(Cpu_Feature::popcnt, has_bit(l1.ecx, 23));
+
+    // AVX state must be enabled by the OS (XCR0 bits 1 and 2), and AVX-512 additionally needs the
+    // opmask and upper ZMM state (bits 5, 6, 7).
+    bool const osxsave = has_bit(l1.ecx, 27);
+    u64 const xcr0 = osxsave ? xgetbv0() : 0;
+    bool const os_avx = (xcr0 & 0x6) == 0x6;
+    bool const os_avx512 = (xcr0 & 0xE6) == 0xE6;
+
+    f.set(Cpu_Feature::avx, os_avx && has_bit(l1.ecx, 28));
+    f.set(Cpu_Feature::fma, os_avx && has_bit(l1.ecx, 12));
+
+    if (max_leaf >= 7) {
+        Cpuid_Regs const l7 = cpuid(7, 0);
+        f.set(Cpu_Feature::bmi1, has_bit(l7.ebx, 3));
+        f.set(Cpu_Feature::bmi2, has_bit(l7.ebx, 8));
+        f.set(Cpu_Feature::avx2, os_avx && has_bit(l7.ebx, 5));
+        f.set(Cpu_Feature::avx512f, os_avx512 && has_bit(l7.ebx, 16));
+        f.set(Cpu_Feature::avx512dq, os_avx512 && has_bit(l7.ebx, 17));
+        f.set(Cpu_Feature::avx512cd, os_avx512 && has_bit(l7.ebx, 28));
+        f.set(Cpu_Feature::avx512bw, os_avx512 && has_bit(l7.ebx, 30));
+        f.set(Cpu_Feature::avx512vl, os_avx512 && has_bit(l7.ebx, 31));
+        f.set(Cpu_Feature::avx512vbmi, os_avx512 && has_bit(l7.ecx, 1));
+        f.set(Cpu_Feature::avx512vpopcntdq, os_avx512 && has_bit(l7.ecx, 14));
+    }
+
+    if (cpuid(0x80000000, 0).eax >= 0x80000001) {
+        Cpuid_Regs const ext1 = cpuid(0x80000001, 0);
+        f.set(Cpu_Feature::lzcnt, has_bit(ext1.ecx, 5));
+    }
+#endif
+    return f;
+}
+
+Cpu_Features const& sds::cpu_features() noexcept
+{
+    static Cpu_Features const s_features = Cpu_Features::detect();
+    return s_features;
+}
+
+double sds::tsc_ticks_per_ns() noexcept
+{
+#if SDS_ARCH_X86 || SDS_ARCH_AMD64
+    static double const s_rate = [] {
+        using clock = std::chrono::steady_clock;
+        // Spin rather than sleep so the interval isn't stretched by a late wake up
+        clock::time_point const t0 = clock::now();
+        u64 const c0 = sds::read_tsc();
+        clock::time_point t1 = t0;
+        while (t1 - t0 < std::chrono::milliseconds(10)) { t1 = clock::now(); }
+        u64 const c1 = sds::read_tsc();
+        auto const ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+        return static_cast<double>(c1 - c0) / static_cast<double>(ns);
+    }();
+    return s_rate;
+#else
+    return 1.0;
+#endif
+}
@@ -0,0 +1,92 @@
+#include "sds/hash.h"
+
+#include "sds/cpu.h"
+
+using namespace sds;
+
+/*
+ * SIMD versions of details::hash_accumulate_scalar. Each 64 byte stripe is one AVX2 register pair
+ * or four SSE2 registers of lanes. Results are bit-identical to the scalar version.
+ */
+
+namespace
+{
+using details::Hash_Accumulate_Fn;
+
+#if SDS_ARCH_X86 || SDS_ARCH_AMD64
+void hash_accumulate_sse2(u64* acc, char const* p, size_t stripes, size_t key) noexcept
+{
+    __m128i a[4];
+    for (int i = 0; i < 4; ++i) {
+        a[i] = _mm_loadu_si128(reinterpret_cast<__m128i const*>(acc + 2 * i));
+    }
+
+    u64 const* secret = details::hash_long_secret.words + key;
+    for (size_t k = 0; k < stripes; ++k, p += details::hash_stripe_size, ++secret) {
+        for (int i = 0; i < 4; ++i) {
+            __m128i const d = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p + 16 * i));
+            __m128i const x =
+                _mm_xor_si128(d, _mm_loadu_si128(reinterpret_cast<__m128i const*>(secret + 2 * i)));
+            __m128i const product = _mm_mul_epu32(x, _mm_srli_epi64(x, 32));
+            __m128i const swapped = _mm_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2));
+            a[i] = _mm_add_epi64(a[i], _mm_add_epi64(product, swapped));
+        }
+    }
+
+    for (int i = 0; i < 4; ++i) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(acc + 2 * i), a[i]);
+    }
+}
+
+SDS_TARGET("avx2")
+void hash_accumulate_avx2(u64* acc, char const* p, size_t stripes, size_t key) noexcept
+{
+    __m256i a0 = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(acc));
+    __m256i a1 = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(acc + 4));
+
+    u64 const* secret = details::hash_long_secret.words + key;
+    for (size_t k = 0; k < stripes; ++k, p += details::hash_stripe_size, ++secret) {
+        __m256i const d0 = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p));
+        __m256i const d1 = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p + 32));
+        __m256i const x0 =
+            _mm256_xor_si256(d0, _mm256_loadu_si256(reinterpret_cast<__m256i const*>(secret)));
+        __m256i const x1 = _mm256_xor_si256(
+            d1, _mm256_loadu_si256(reinterpret_cast<__m256i const*>(secret + 4)));
+
+        // acc[j] += lo32(x) * hi32(x), acc[j ^ 1] += w
+        __m256i const product0 = _mm256_mul_epu32(x0, _mm256_srli_epi64(x0, 32));
+        __m256i const product1 = _mm256_mul_epu32(x1, _mm256_srli_epi64(x1, 32));
+        __m256i const swapped0 = _mm256_shuffle_epi32(d0, _MM_SHUFFLE(1, 0, 3, 2));
+        __m256i const swapped1 = _mm256_shuffle_epi32(d1, _MM_SHUFFLE(1, 0, 3, 2));
+        a0 = _mm256_add_epi64(a0, _mm256_add_epi64(product0, swapped0));
+        a1 = _mm256_add_epi64(a1, _mm256_add_epi64(product1, swapped1));
+    }
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc), a0);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + 4), a1);
+}
+#endif
+
+void hash_accumulate_generic(u64* acc, char const* p, size_t stripes, size_t key) noexcept
+{
+    details::hash_accumulate_scalar(acc, p, stripes, key);
+}
+
+Cpu_Dispatch<void(u64*, char const*, size_t, size_t)> const
+    hash_accumulate_dispatch([](Cpu_Features const& f) -> Hash_Accumulate_Fn {
+#if SDS_ARCH_X86 || SDS_ARCH_AMD64
+        if (f.has(Cpu_Feature::avx2)) { return &hash_accumulate_avx2; }
+        if (f.has(Cpu_Feature::sse2)) { return &hash_accumulate_sse2; }
+#endif
+        (void)f;
+        return &hash_accumulate_generic;
+    });
+} // namespace
+
+u64 sds::hash_bytes(void const* data, size_t size, u64 seed) noexcept
+{
+    SDS_ASSERT(data || size == 0);
+    auto const* p = static_cast<char const*>(data);
+    if SDS_LIKELY(size <= details::hash_short_max) { return details::hash_short(p, size, seed); }
+    return details::hash_long(p, size, seed, hash_accumulate_dispatch.get());
+}
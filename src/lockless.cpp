@@ -11,7 +11,7 @@ bool Spin_Lock::try_aquire() noexcept
 
 void Spin_Lock::aquire() noexcept
 {
-    while (!try_aquire()) { sds::pause_or_yield(); }
+    while (try_aquire()) { sds::pause_or_yield(); }
 }
 
 void Spin_Lock::release() noexcept
@@ -19,3 +19,46 @@ void Spin_Lock::release() noexcept
     // use re/ease semantics ensure writes committed before unlock
     m_atomic.clear(std::memory_order_release);
 }
+
+void Readers_Writer_Spin_Lock::aquire() noexcept
+{
+    // claim the writer bit, then wait for readers already inside to leave
+    u32 state = m_state.load(std::memory_order_relaxed);
+    for (;;) {
+        if ((state & s_writer) == 0 &&
+            m_state.compare_exchange_weak(state, state | s_writer, std::memory_order_relaxed,
+                                          std::memory_order_relaxed)) {
+            break;
+        }
+        sds::pause_or_yield();
+        state = m_state.load(std::memory_order_relaxed);
+    }
+
+    while (m_state.load(std::memory_order_acquire) != s_writer) { sds::pause_or_yield(); }
+}
+
+void Readers_Writer_Spin_Lock::release() noexcept
+{
+    SDS_ASSERT(m_state.load(std::memory_order_relaxed) == s_writer);
+    m_state.store(0, std::memory_order_release);
+}
+
+void Readers_Writer_Spin_Lock::aquire_shared() noexcept
+{
+    u32 state = m_state.load(std::memory_order_relaxed);
+    for (;;) {
+        if ((state & s_writer) == 0 &&
+            m_state.compare_exchange_weak(state, state + s_reader, std::memory_order_acquire,
+                                          std::memory_order_relaxed)) {
+            break;
+        }
+        sds::pause_or_yield();
+        state = m_state.load(std::memory_order_relaxed);
+    }
+}
+
+void Readers_Writer_Spin_Lock::release_shared() noexcept
+{
+    SDS_ASSERT(m_state.load(std::memory_order_relaxed) >= s_reader);
+    m_state.fetch_sub(s_reader, std::memory_order_release);
+}
@@ -0,0 +1,150 @@
+#include "sds/perf_counters.h"
+
+#if SDS_OS_LINUX
+#    include <linux/perf_event.h>
+#    include <sys/ioctl.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#endif
+
+#include <cstring>
+
+using namespace sds;
+
+namespace
+{
+#if SDS_OS_LINUX
+struct Event {
+    u32 type;
+    u64 config;
+};
+
+constexpr u64 cache_read_access(u64 cache) noexcept
+{
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_ACCESS << 16);
+}
+
+/* Indexed by Perf_Counter */
+constexpr Event events[perf_counter_count] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE, cache_read_access(PERF_COUNT_HW_CACHE_L1D)},
+    {PERF_TYPE_HW_CACHE, cache_read_access(PERF_COUNT_HW_CACHE_LL)},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES},
+};
+
+s32 open_event(Event const& e) noexcept
+{
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = e.type;
+    attr.config = e.config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    // NOTE(sdsmith): Each counter is its own group. A single group is only scheduled when all of
+    // its counters fit on the PMU at once, which they often don't; separate counters are
+    // multiplexed and scaled instead.
+    long const fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC);
+    return static_cast<s32>(fd);
+}
+#endif
+} // namespace
+
+char const* sds::to_string(Perf_Counter c) noexcept
+{
+    switch (c) {
+        case Perf_Counter::cycles: return "cycles";
+        case Perf_Counter::instructions: return "instructions";
+        case Perf_Counter::cache_misses: return "cache_misses";
+        case Perf_Counter::branch_misses: return "branch_misses";
+        case Perf_Counter::l1d_loads: return "l1d_loads";
+        case Perf_Counter::llc_loads: return "llc_loads";
+        case Perf_Counter::page_faults: return "page_faults";
+        case Perf_Counter::context_switches: return "context_switches";
+        case Perf_Counter::count: break;
+        default: break;
+    }
+    return "unknown";
+}
+
+Perf_Counter_Values& Perf_Counter_Values::operator+=(Perf_Counter_Values const& o) noexcept
+{
+    for (u32 i = 0; i < perf_counter_count; ++i) { values[i] += o.values[i]; }
+    valid &= o.valid;
+    return *this;
+}
+
+Perf_Counter_Values& Perf_Counter_Values::operator/=(double d) noexcept
+{
+    for (double& v : values) { v /= d; }
+    return *this;
+}
+
+Perf_Counters::Perf_Counters() noexcept
+{
+    for (u32 i = 0; i < perf_counter_count; ++i) {
+        m_fds[i] = -1;
+#if SDS_OS_LINUX
+        m_fds[i] = open_event(events[i]);
+        if (m_fds[i] >= 0) { m_available |= 1U << i; }
+#endif
+    }
+}
+
+Perf_Counters::~Perf_Counters()
+{
+#if SDS_OS_LINUX
+    for (s32 fd : m_fds) {
+        if (fd >= 0) { close(fd); }
+    }
+#endif
+}
+
+void Perf_Counters::start() noexcept
+{
+#if SDS_OS_LINUX
+    for (s32 fd : m_fds) {
+        if (fd < 0) { continue; }
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+Perf_Counter_Values Perf_Counters::stop() noexcept
+{
+    Perf_Counter_Values r;
+#if SDS_OS_LINUX
+    for (s32 fd : m_fds) {
+        if (fd >= 0) { ioctl(fd, PERF_EVENT_IOC_DISABLE, 0); }
+    }
+
+    for (u32 i = 0; i < perf_counter_count; ++i) {
+        if (m_fds[i] < 0) { continue; }
+
+        // Layout given by read_format
+        u64 data[3] = {};
+        if (read(m_fds[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) {
+            continue;
+        }
+        u64 const value = data[0];
+        u64 const enabled = data[1];
+        u64 const running = data[2];
+        if (running == 0) { continue; }
+
+        r.values[i] = static_cast<double>(value);
+        if (running < enabled) {
+            r.values[i] *= static_cast<double>(enabled) / static_cast<double>(running);
+        }
+        r.valid |= 1U << i;
+    }
+#endif
+    return r;
+}
@@ -0,0 +1,284 @@
+#include "sds/profile.h"
+
+#include "sds/bit.h"
+#include "sds/cpu.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+using namespace sds;
+
+namespace
+{
+SDS_STATIC_ASSERT(sds::is_pow2(profile_buffer_capacity));
+constexpr u64 buffer_mask = profile_buffer_capacity - 1;
+
+/* Fields are atomics only so a write can read them while the owner overwrites them. All accesses
+ * are relaxed and compile to plain moves. */
+struct Event {
+    std::atomic<char const*> name{nullptr};
+    std::atomic<u64> begin{0};
+    std::atomic<u64> end{0};
+};
+
+/*
+ * Single producer ring of zones. The owning thread bumps `claimed` before overwriting a slot and
+ * `head` once the slot is complete. A reader copies up to `head`, then rereads `claimed` to find
+ * out which of the copied slots may have been overwritten meanwhile and drops those, like a
+ * seqlock.
+ */
+struct Thread_Buffer {
+    std::atomic<u64> claimed{0};
+    std::atomic<u64> head{0};
+    Event events[profile_buffer_capacity];
+
+    // Reader side. Guarded by the registry mutex.
+    u64 tail = 0;
+    u32 tid = 0;
+    char const* thread_name = nullptr;
+};
+
+struct Zone {
+    char const* name;
+    u64 begin;
+    u64 end;
+    u32 tid;
+};
+
+struct Thread_Name {
+    u32 tid;
+    char const* name;
+};
+
+struct Registry {
+    std::mutex mutex{};
+    std::vector<std::unique_ptr<Thread_Buffer>> buffers{};
+    // Buffers of exited threads, drained and ready for new threads
+    std::vector<Thread_Buffer*> free_buffers{};
+    // Zones and names of exited threads, kept until the next write. At most a buffer's worth.
+    std::vector<Zone> exited_zones{};
+    std::vector<Thread_Name> exited_names{};
+    u32 next_tid = 1;
+    // Time stamp trace times are relative to. Set by the first write.
+    u64 epoch = 0;
+    bool has_epoch = false;
+    std::atomic<u64> dropped{0};
+};
+
+/* Never destroyed, so threads still recording during static destruction stay safe. */
+Registry& registry()
+{
+    static Registry* const s_registry = new Registry;
+    return *s_registry;
+}
+
+
+/* Move the complete zones of \a b into \a out. */
+void drain(Thread_Buffer& b, std::vector<Zone>& out, std::atomic<u64>& dropped)
+{
+    u64 const head = b.head.load(std::memory_order_acquire);
+    u64 const oldest = head > profile_buffer_capacity ? head - profile_buffer_capacity : 0;
+    u64 const first = std::max(b.tail, oldest);
+    size_t const copied_from = out.size();
+    for (u64 i = first; i < head; ++i) {
+        Event const& e = b.events[i & buffer_mask];
+        out.push_back({e.name.load(std::memory_order_relaxed),
+                       e.begin.load(std::memory_order_relaxed),
+                       e.end.load(std::memory_order_relaxed), b.tid});
+    }
+
+    // Slots below claimed - capacity may have been rewritten while they were copied
+    std::atomic_thread_fence(std::memory_order_acquire);
+    u64 const claimed = b.claimed.load(std::memory_order_relaxed);
+    u64 const valid = claimed > profile_buffer_capacity ? claimed - profile_buffer_capacity : 0;
+    u64 torn = 0;
+    if (valid > first) {
+        torn = std::min(valid, head) - first;
+        out.erase(out.begin() + static_cast<ptrdiff>(copied_from),
+                  out.begin() + static_cast<ptrdiff>(copied_from + torn));
+    }
+
+    dropped.fetch_add(first - b.tail + torn, std::memory_order_relaxed);
+    b.tail = head;
+}
+
+thread_local Thread_Buffer* t_buffer = nullptr;
+thread_local bool t_buffer_released = false;
+
+/* Parks the buffer of the thread when it exits. */
+struct Buffer_Guard {
+    Thread_Buffer* buffer = nullptr;
+
+    Buffer_Guard() = default;
+    Buffer_Guard(Buffer_Guard const&) = delete;
+    Buffer_Guard& operator=(Buffer_Guard const&) = delete;
+
+    ~Buffer_Guard()
+    {
+        if (!buffer) { return; }
+        t_buffer = nullptr;
+        t_buffer_released = true;
+
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        size_t const before = reg.exited_zones.size();
+        drain(*buffer, reg.exited_zones, reg.dropped);
+        if (reg.exited_zones.size() > before && buffer->thread_name) {
+            reg.exited_names.push_back({buffer->tid, buffer->thread_name});
+        }
+        // Without a write to take them, keep only the most recent
+        if (reg.exited_zones.size() > profile_buffer_capacity) {
+            size_t const excess = reg.exited_zones.size() - profile_buffer_capacity;
+            reg.exited_zones.erase(reg.exited_zones.begin(),
+                                   reg.exited_zones.begin() + static_cast<ptrdiff>(excess));
+            reg.dropped.fetch_add(excess, std::memory_order_relaxed);
+        }
+        if (reg.exited_names.size() > profile_buffer_capacity) {
+            reg.exited_names.erase(reg.exited_names.begin());
+        }
+        buffer->thread_name = nullptr;
+        reg.free_buffers.push_back(buffer);
+    }
+};
+
+thread_local Buffer_Guard t_buffer_guard;
+
+Thread_Buffer* register_thread()
+{
+    Registry& reg = registry();
+    Thread_Buffer* buffer = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        if (!reg.free_buffers.empty()) {
+            buffer = reg.free_buffers.back();
+            reg.free_buffers.pop_back();
+            buffer->tid = reg.next_tid++;
+        }
+    }
+    if (!buffer) {
+        auto created = std::make_unique<Thread_Buffer>();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        created->tid = reg.next_tid++;
+        reg.buffers.push_back(std::move(created));
+        buffer = reg.buffers.back().get();
+    }
+
+    // NOTE(sdsmith): A zone that ends in a later thread-local destructor, after the guard parked
+    // the first ring, gets a ring the guard can't park since it's already destroyed. That ring
+    // stays registered, so writes still include its zones, but no thread reuses it.
+    if (!t_buffer_released) { t_buffer_guard.buffer = buffer; }
+    t_buffer = buffer;
+    return buffer;
+}
+
+void write_json_string(std::FILE* out, char const* s)
+{
+    std::fputc('"', out);
+    for (; *s != '\0'; ++s) {
+        unsigned char const c = static_cast<unsigned char>(*s);
+        if (c == '"' || c == '\\') {
+            std::fputc('\\', out);
+            std::fputc(c, out);
+        } else if (c < 0x20) {
+            std::fprintf(out, "\\u%04x", c);
+        } else {
+            std::fputc(c, out);
+        }
+    }
+    std::fputc('"', out);
+}
+} // namespace
+
+void sds::details::profile_record(char const* name, u64 begin, u64 end) noexcept
+{
+    Thread_Buffer* b = t_buffer;
+    if SDS_UNLIKELY(!b) {
+        try {
+            b = register_thread();
+        } catch (std::bad_alloc const&) {
+            return;
+        }
+    }
+
+    u64 const h = b->head.load(std::memory_order_relaxed);
+    b->claimed.store(h + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    Event& e = b->events[h & buffer_mask];
+    e.name.store(name, std::memory_order_relaxed);
+    e.begin.store(begin, std::memory_order_relaxed);
+    e.end.store(end, std::memory_order_relaxed);
+    b->head.store(h + 1, std::memory_order_release);
+}
+
+void sds::profile_set_thread_name(char const* name)
+{
+    Thread_Buffer* const b = t_buffer ? t_buffer : register_thread();
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    b->thread_name = name;
+}
+
+u64 sds::profile_write_chrome_trace(std::FILE* out)
+{
+    Registry& reg = registry();
+    std::vector<Zone> zones;
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    zones.swap(reg.exited_zones);
+    for (std::unique_ptr<Thread_Buffer> const& b : reg.buffers) { drain(*b, zones, reg.dropped); }
+    std::sort(zones.begin(), zones.end(),
+              [](Zone const& a, Zone const& b) { return a.begin < b.begin; });
+
+    if (!reg.has_epoch) {
+        reg.epoch = zones.empty() ? sds::read_tsc() : zones.front().begin;
+        reg.has_epoch = true;
+    }
+    double const us_per_tick = 1.0 / (sds::tsc_ticks_per_ns() * 1000.0);
+
+    std::fputs("{\"traceEvents\":[", out);
+    bool first = true;
+    auto const write_thread_name = [&](u32 tid, char const* name) {
+        std::fprintf(out, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,",
+                     first ? "" : ",", tid);
+        std::fputs("\"args\":{\"name\":", out);
+        write_json_string(out, name);
+        std::fputs("}}", out);
+        first = false;
+    };
+    for (std::unique_ptr<Thread_Buffer> const& b : reg.buffers) {
+        if (b->thread_name) { write_thread_name(b->tid, b->thread_name); }
+    }
+    for (Thread_Name const& n : reg.exited_names) { write_thread_name(n.tid, n.name); }
+    reg.exited_names.clear();
+    for (Zone const& z : zones) {
+        std::fputs(first ? "\n{\"name\":" : ",\n{\"name\":", out);
+        write_json_string(out, z.name);
+        // Zones from before the epoch only exist if a thread raced the first write
+        double const ts = (static_cast<double>(z.begin) - static_cast<double>(reg.epoch)) *
+                          us_per_tick;
+        double const dur = static_cast<double>(z.end - z.begin) * us_per_tick;
+        std::fprintf(out, ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}", ts, dur,
+                     z.tid);
+        first = false;
+    }
+    std::fprintf(out, "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"dropped_zones\":%llu}}\n",
+                 static_cast<unsigned long long>(reg.dropped.load(std::memory_order_relaxed)));
+    return static_cast<u64>(zones.size());
+}
+
+bool sds::profile_write_chrome_trace(char const* path)
+{
+    std::FILE* const out = std::fopen(path, "w");
+    if (!out) { return false; }
+    sds::profile_write_chrome_trace(out);
+    bool const ok = std::ferror(out) == 0;
+    return std::fclose(out) == 0 && ok;
+}
+
+u64 sds::profile_dropped_count() noexcept
+{
+    return registry().dropped.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,143 @@
+#include "sds/allocator/region_allocator.h"
+
+#if SDS_OS_LINUX
+#    include <linux/mempolicy.h>
+#    include <sys/mman.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#    include <cstdio>
+#else
+#    include <cstring>
+#endif
+
+using namespace sds;
+
+namespace
+{
+/* Mapped length of a region. Huge page requests are rounded to huge pages even when they fall
+ * back, so unmapping doesn't need to know what the region got. */
+size_t region_length(size_t bytes, Page_Size pages) noexcept
+{
+    size_t const granularity = pages == Page_Size::normal ? 4096 : huge_page_size;
+    size_t const length = (bytes + granularity - 1) & ~(granularity - 1);
+    return length == 0 ? granularity : length;
+}
+
+#if SDS_OS_LINUX
+void* map(size_t length, int extra_flags) noexcept
+{
+    void* const p = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | extra_flags, -1, 0);
+    return p == MAP_FAILED ? nullptr : p;
+}
+
+/* Map \a length bytes aligned to huge pages, so the whole region is eligible for them. */
+void* map_huge_aligned(size_t length) noexcept
+{
+    char* const raw = static_cast<char*>(map(length + huge_page_size, 0));
+    if (!raw) { return nullptr; }
+    uintptr_t const addr = reinterpret_cast<uintptr_t>(raw);
+    size_t const head = ((huge_page_size - (addr & (huge_page_size - 1))) & (huge_page_size - 1));
+    char* const p = raw + head;
+    if (head != 0) { munmap(raw, head); }
+    munmap(p + length, huge_page_size - head);
+    return p;
+}
+
+bool bind_to_node(void* p, size_t length, s32 node) noexcept
+{
+    constexpr size_t max_nodes = 1024;
+    constexpr size_t word_bits = sizeof(unsigned long) * 8;
+    if (node < 0 || static_cast<size_t>(node) >= max_nodes) { return false; }
+
+    unsigned long mask[max_nodes / word_bits] = {};
+    mask[static_cast<size_t>(node) / word_bits] = 1UL << (static_cast<size_t>(node) % word_bits);
+    // NOTE(sdsmith): The kernel reads one bit less than maxnode says, like libnuma passes it
+    return syscall(SYS_mbind, p, length, MPOL_PREFERRED, mask, max_nodes + 1, 0) == 0;
+}
+#endif
+} // namespace
+
+char const* sds::to_string(Page_Size p) noexcept
+{
+    switch (p) {
+        case Page_Size::normal: return "normal";
+        case Page_Size::transparent_huge: return "transparent_huge";
+        case Page_Size::huge: return "huge";
+        default: break;
+    }
+    return "unknown";
+}
+
+void* sds::region_allocate(size_t bytes, Region_Options const& options, Region_Info* info)
+{
+    size_t const length = region_length(bytes, options.pages);
+    Region_Info got;
+
+#if SDS_OS_LINUX
+    void* p = nullptr;
+    if (options.pages == Page_Size::huge) {
+        p = map(length, MAP_HUGETLB);
+        if (p) { got.pages = Page_Size::huge; }
+    }
+    if (!p && options.pages != Page_Size::normal) {
+        p = map_huge_aligned(length);
+        if (p && madvise(p, length, MADV_HUGEPAGE) == 0) {
+            got.pages = Page_Size::transparent_huge;
+        }
+    }
+    if (!p) { p = map(length, 0); }
+    if (!p) { throw std::bad_alloc(); }
+
+    // Before first touch, which is when pages are placed
+    if (options.numa_node >= 0) { got.numa_bound = bind_to_node(p, length, options.numa_node); }
+#else
+    void* const p = ::operator new(length, std::align_val_t(4096));
+    std::memset(p, 0, length);
+#endif
+
+    if (info) { *info = got; }
+    return p;
+}
+
+void sds::region_deallocate(void* p, size_t bytes, Region_Options const& options) noexcept
+{
+    if (!p) { return; }
+    size_t const length = region_length(bytes, options.pages);
+#if SDS_OS_LINUX
+    munmap(p, length);
+#else
+    ::operator delete(p, length, std::align_val_t(4096));
+#endif
+}
+
+s32 sds::numa_node_count() noexcept
+{
+#if SDS_OS_LINUX
+    // A range like "0-3", or "0" on single node hosts
+    std::FILE* const f = std::fopen("/sys/devices/system/node/possible", "r");
+    if (!f) { return 1; }
+    int first = 0;
+    int last = 0;
+    int const fields = std::fscanf(f, "%d-%d", &first, &last);
+    std::fclose(f);
+    if (fields == 2 && last >= first) { return last + 1; }
+    return 1;
+#else
+    return 1;
+#endif
+}
+
+s32 sds::numa_node_of(void const* p) noexcept
+{
+#if SDS_OS_LINUX
+    int node = -1;
+    if (syscall(SYS_get_mempolicy, &node, nullptr, 0, p, MPOL_F_NODE | MPOL_F_ADDR) != 0) {
+        return -1;
+    }
+    return node;
+#else
+    static_cast<void>(p);
+    return -1;
+#endif
+}
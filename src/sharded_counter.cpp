@@ -0,0 +1,137 @@
+#include "sds/sharded_counter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#if SDS_OS_LINUX
+#    include <sched.h>
+#endif
+
+using namespace sds;
+
+char const* sds::to_string(Shard_Policy p) noexcept
+{
+    switch (p) {
+        case Shard_Policy::thread: return "thread";
+        case Shard_Policy::cpu: return "cpu";
+        default: break;
+    }
+    return "unknown";
+}
+
+u32 details::counter_shard_count() noexcept
+{
+    static u32 const s_count = [] {
+        u32 const cpus = std::thread::hardware_concurrency();
+        // Room for a few threads per CPU before threads share shards
+        return sds::bit_ceil(std::clamp(cpus, 4U, 256U));
+    }();
+    return s_count;
+}
+
+u32 details::current_cpu() noexcept
+{
+#if SDS_OS_LINUX
+    // NOTE(sdsmith): A vDSO or rseq read on current kernels, not a syscall
+    int const cpu = sched_getcpu();
+    if SDS_LIKELY(cpu >= 0) { return static_cast<u32>(cpu); }
+#endif
+    return thread_index();
+}
+
+Sharded_Counter::Sharded_Counter(Shard_Policy policy)
+    : m_shards(new Cache_Aligned<std::atomic<s64>>[details::counter_shard_count()]),
+      m_mask(details::counter_shard_count() - 1),
+      m_policy(policy)
+{}
+
+s64 Sharded_Counter::value() const noexcept
+{
+    s64 sum = 0;
+    for (u32 i = 0; i <= m_mask; ++i) { sum += m_shards[i]->load(std::memory_order_relaxed); }
+    return sum;
+}
+
+s64 Sharded_Counter::take() noexcept
+{
+    s64 sum = 0;
+    for (u32 i = 0; i <= m_mask; ++i) {
+        sum += m_shards[i]->exchange(0, std::memory_order_relaxed);
+    }
+    return sum;
+}
+
+Sharded_Max::Sharded_Max(Shard_Policy policy)
+    : m_shards(new Cache_Aligned<std::atomic<s64>>[details::counter_shard_count()]),
+      m_mask(details::counter_shard_count() - 1),
+      m_policy(policy)
+{
+    for (u32 i = 0; i <= m_mask; ++i) { m_shards[i]->store(empty, std::memory_order_relaxed); }
+}
+
+s64 Sharded_Max::value() const noexcept
+{
+    s64 max = empty;
+    for (u32 i = 0; i <= m_mask; ++i) {
+        max = std::max(max, m_shards[i]->load(std::memory_order_relaxed));
+    }
+    return max;
+}
+
+s64 Sharded_Max::take() noexcept
+{
+    s64 max = empty;
+    for (u32 i = 0; i <= m_mask; ++i) {
+        max = std::max(max, m_shards[i]->exchange(empty, std::memory_order_relaxed));
+    }
+    return max;
+}
+
+u64 Histogram_Snapshot::percentile(double q) const noexcept
+{
+    if (count == 0) { return 0; }
+    q = std::clamp(q, 0.0, 1.0);
+    // Rank of the value, 1 based. Rounded up so at least a q fraction of values are at or below.
+    u64 const rank = std::max(u64{1}, static_cast<u64>(std::ceil(q * static_cast<double>(count))));
+    u64 seen = 0;
+    for (s32 i = 0; i < histogram_buckets; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) { return bucket_max(i); }
+    }
+    return bucket_max(histogram_buckets - 1);
+}
+
+Sharded_Histogram::Sharded_Histogram(Shard_Policy policy)
+    : m_shards(new Shard[details::counter_shard_count()]),
+      m_mask(details::counter_shard_count() - 1),
+      m_policy(policy)
+{}
+
+Histogram_Snapshot Sharded_Histogram::snapshot() const noexcept
+{
+    Histogram_Snapshot s;
+    for (u32 i = 0; i <= m_mask; ++i) {
+        Shard const& shard = m_shards[i];
+        for (s32 b = 0; b < histogram_buckets; ++b) {
+            s.buckets[b] += shard.buckets[b].load(std::memory_order_relaxed);
+        }
+        s.sum += shard.sum.load(std::memory_order_relaxed);
+    }
+    for (u64 const n : s.buckets) { s.count += n; }
+    return s;
+}
+
+Histogram_Snapshot Sharded_Histogram::take() noexcept
+{
+    Histogram_Snapshot s;
+    for (u32 i = 0; i <= m_mask; ++i) {
+        Shard& shard = m_shards[i];
+        for (s32 b = 0; b < histogram_buckets; ++b) {
+            s.buckets[b] += shard.buckets[b].exchange(0, std::memory_order_relaxed);
+        }
+        s.sum += shard.sum.exchange(0, std::memory_order_relaxed);
+    }
+    for (u64 const n : s.buckets) { s.count += n; }
+    return s;
+}
@@ -0,0 +1,91 @@
+#include "sds/allocator/stack_allocator.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace sds;
+
+bool Stack_Arena::canaries_by_default() noexcept
+{
+#ifdef NDEBUG
+    return false;
+#else
+    return true;
+#endif
+}
+
+Stack_Arena::~Stack_Arena()
+{
+    for (Block* b = first_block(); b;) {
+        Block* const next = b->next;
+        size_t const bytes = sizeof(Block) + b->size;
+        b->~Block();
+        ::operator delete(b, bytes);
+        b = next;
+    }
+}
+
+void Stack_Arena::grow(size_t min_bytes)
+{
+    Block* const next = m_block ? m_block->next : nullptr;
+    Block* b = next;
+    if (!b || b->size < min_bytes) {
+        // Too small cached blocks stay in the chain after the new one
+        size_t const size = std::max(m_block_size, min_bytes);
+        b = new (::operator new(sizeof(Block) + size)) Block;
+        b->size = size;
+        b->prev = m_block;
+        b->next = next;
+        if (next) { next->prev = b; }
+        if (m_block) { m_block->next = b; }
+    }
+    m_block = b;
+    m_top = b->begin();
+    m_end = b->end();
+}
+
+void Stack_Arena::check_canaries(void* last) const noexcept
+{
+    // NOTE(sdsmith): Not SDS_ASSERT, so arenas asked for canaries check them in release builds
+    // of the library too
+    auto const fail = [](char const* what) {
+        std::fprintf(stderr, "sds::Stack_Arena: %s\n", what);
+        std::abort();
+    };
+    for (void* p = m_last; p != last; p = header_of(p)->prev) {
+        if (!p) { fail("rewind to a marker that is not on the stack"); }
+        char const* const end = static_cast<char*>(p) + header_of(p)->bytes;
+        if (std::memcmp(end, canary, sizeof(canary)) != 0) {
+            fail("allocation written past its end");
+        }
+    }
+}
+
+Stack_Arena::Block* Stack_Arena::first_block() const noexcept
+{
+    Block* b = m_block;
+    while (b && b->prev) { b = b->prev; }
+    return b;
+}
+
+size_t Stack_Arena::used() const noexcept
+{
+    if (!m_block) { return 0; }
+    size_t bytes = static_cast<size_t>(m_top - m_block->begin());
+    for (Block* b = m_block->prev; b; b = b->prev) { bytes += b->size; }
+    return bytes;
+}
+
+size_t Stack_Arena::reserved() const noexcept
+{
+    size_t bytes = 0;
+    for (Block* b = first_block(); b; b = b->next) { bytes += b->size; }
+    return bytes;
+}
+
+Stack_Arena& sds::thread_stack_arena() noexcept
+{
+    thread_local Stack_Arena t_arena;
+    return t_arena;
+}
@@ -1,39 +1,668 @@
 #include "sds/string.h"
 
-int sds::byte_size(char const* s) noexcept
+#include "sds/bit.h"
+#include "sds/cpu.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+using namespace sds;
+
+/*
+ * String kernels.
+ *
+ * NOTE(sdsmith): The SIMD paths read whole blocks and may read past the end of the string. Memory
+ * protection is per page, so a read is safe as long as it does not cross into the next page:
+ * - str_size aligns its loads to the block size, which never straddle a page.
+ * - ascii_cmp has two arbitrarily aligned inputs, so blocks that cross a page are compared a byte
+ *   at a time.
+ */
+
+namespace
 {
-    if (!s) { return 0; }
+constexpr uintptr_t page_size = 4096;
+
+/* True if reading \a n bytes from \a p would cross into the next page. */
+bool crosses_page(void const* p, uintptr_t n) noexcept
+{
+    return (reinterpret_cast<uintptr_t>(p) & (page_size - 1)) > page_size - n;
+}
 
+int str_size_scalar(char const* s) noexcept
+{
     char const* p = s;
-    int len = 1; // count null-terminator
-    while (*p != '\0') {
-        ++p;
-        ++len;
+    while (*p != '\0') { ++p; }
+    return static_cast<int>(p - s);
+}
+
+bool ascii_cmp_scalar(char const* p1, char const* p2, s32 len) noexcept
+{
+    for (s32 n = 0; n < len; ++n, ++p1, ++p2) {
+        SDS_ASSERT(*p2 == '\0' || is_ascii(*p2));
+        if (*p1 == '\0' || *p2 == '\0' || *p1 != *p2) { return false; }
     }
-    return len;
+    return true;
 }
 
-bool sds::ascii_cmp(char const* s, char const* ascii, s32 len) noexcept
+#if SDS_ARCH_X86 || SDS_ARCH_AMD64
+SDS_NO_SANITIZE_ADDRESS SDS_NO_SANITIZE_THREAD int str_size_sse2(char const* s) noexcept
 {
-    SDS_ASSERT(s);
-    SDS_ASSERT(ascii);
-    SDS_ASSERT(len > 0);
+    constexpr uintptr_t block = sizeof(__m128i);
+    uintptr_t const misalign = reinterpret_cast<uintptr_t>(s) & (block - 1);
+    char const* p = s - misalign;
+    __m128i const zero = _mm_setzero_si128();
+
+    // First block: ignore bytes before the start of the string
+    u32 mask = static_cast<u32>(_mm_movemask_epi8(
+        _mm_cmpeq_epi8(_mm_load_si128(reinterpret_cast<__m128i const*>(p)), zero)));
+    mask >>= misalign;
+    if (mask != 0) { return sds::count_trailing_zeros(mask); }
+
+    for (;;) {
+        p += block;
+        mask = static_cast<u32>(_mm_movemask_epi8(
+            _mm_cmpeq_epi8(_mm_load_si128(reinterpret_cast<__m128i const*>(p)), zero)));
+        if (mask != 0) { return static_cast<int>(p - s) + sds::count_trailing_zeros(mask); }
+    }
+}
+
+SDS_NO_SANITIZE_ADDRESS SDS_NO_SANITIZE_THREAD SDS_TARGET("avx2")
+int str_size_avx2(char const* s) noexcept
+{
+    constexpr uintptr_t block = sizeof(__m256i);
+    uintptr_t const misalign = reinterpret_cast<uintptr_t>(s) & (block - 1);
+    char const* p = s - misalign;
+    __m256i const zero = _mm256_setzero_si256();
+
+    u32 mask = static_cast<u32>(_mm256_movemask_epi8(
+        _mm256_cmpeq_epi8(_mm256_load_si256(reinterpret_cast<__m256i const*>(p)), zero)));
+    mask >>= misalign;
+    if (mask != 0) { return sds::count_trailing_zeros(mask); }
+
+    for (;;) {
+        p += block;
+        mask = static_cast<u32>(_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(_mm256_load_si256(reinterpret_cast<__m256i const*>(p)), zero)));
+        if (mask != 0) { return static_cast<int>(p - s) + sds::count_trailing_zeros(mask); }
+    }
+}
+
+/*
+ * Per-byte "still matching" vectors: zero where the strings differ or where they both end (equal
+ * bytes that are zero are zero in both strings). Several blocks can be merged with a byte-wise min
+ * and tested with a single branch.
+ *
+ * ref: glibc sysdeps/x86_64/multiarch/strcmp-sse2.S
+ */
+SDS_NO_SANITIZE_ADDRESS SDS_NO_SANITIZE_THREAD inline __m128i load128(char const* p) noexcept
+{
+    return _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+}
+
+SDS_NO_SANITIZE_ADDRESS SDS_NO_SANITIZE_THREAD SDS_TARGET("avx2")
+inline __m256i load256(char const* p) noexcept
+{
+    return _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p));
+}
+
+inline __m128i ascii_cmp_match(__m128i a, __m128i b) noexcept
+{
+    return _mm_min_epu8(_mm_cmpeq_epi8(a, b), a);
+}
+
+SDS_TARGET("avx2") inline __m256i ascii_cmp_match(__m256i a, __m256i b) noexcept
+{
+    return _mm256_min_epu8(_mm256_cmpeq_epi8(a, b), a);
+}
+
+SDS_NO_SANITIZE_ADDRESS SDS_NO_SANITIZE_THREAD
+bool ascii_cmp_sse2(char const* s, char const* ascii, s32 len) noexcept
+{
+    constexpr s32 block = sizeof(__m128i);
+    constexpr s32 unroll = 4;
+    __m128i const zero = _mm_setzero_si128();
 
-    char const* p1 = s;
-    char const* p2 = ascii;
     s32 n = 0;
     while (n < len) {
-        SDS_ASSERT(is_ascii(*p2));
-        if (*p1 == '\0' || *p2 == '\0' || *p1 != *p2) { return false; }
-        ++n;
-        ++p1;
-        ++p2;
+        s32 const remaining = len - n;
+
+        // Fast path: four blocks per branch
+        if SDS_LIKELY(remaining >= unroll * block && !crosses_page(s + n, unroll * block) &&
+                      !crosses_page(ascii + n, unroll * block)) {
+            __m128i const b0 = load128(ascii + n);
+            __m128i const b1 = load128(ascii + n + block);
+            __m128i const b2 = load128(ascii + n + 2 * block);
+            __m128i const b3 = load128(ascii + n + 3 * block);
+            __m128i const m = _mm_min_epu8(
+                _mm_min_epu8(ascii_cmp_match(load128(s + n), b0),
+                             ascii_cmp_match(load128(s + n + block), b1)),
+                _mm_min_epu8(ascii_cmp_match(load128(s + n + 2 * block), b2),
+                             ascii_cmp_match(load128(s + n + 3 * block), b3)));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(m, zero)) != 0) { return false; }
+            SDS_ASSERT(
+                _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(b0, b1), _mm_or_si128(b2, b3))) == 0 &&
+                "expected ascii string");
+            n += unroll * block;
+            continue;
+        }
+
+        // Slow path: one block, or bytes when the block would cross a page
+        if SDS_UNLIKELY(crosses_page(s + n, block) || crosses_page(ascii + n, block)) {
+            s32 const count = remaining < block ? remaining : block;
+            if (!ascii_cmp_scalar(s + n, ascii + n, count)) { return false; }
+            n += count;
+            continue;
+        }
+
+        __m128i const b = load128(ascii + n);
+        u32 const valid = remaining >= block ? 0xFFFFU : (1U << remaining) - 1;
+        u32 const mismatch = static_cast<u32>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(ascii_cmp_match(load128(s + n), b), zero)));
+        if ((mismatch & valid) != 0) { return false; }
+        SDS_ASSERT((static_cast<u32>(_mm_movemask_epi8(b)) & valid) == 0 &&
+                   "expected ascii string");
+        n += block;
     }
 
     return true;
 }
 
+SDS_NO_SANITIZE_ADDRESS SDS_NO_SANITIZE_THREAD SDS_TARGET("avx2")
+bool ascii_cmp_avx2(char const* s, char const* ascii, s32 len) noexcept
+{
+    constexpr s32 block = sizeof(__m256i);
+    constexpr s32 unroll = 4;
+    __m256i const zero = _mm256_setzero_si256();
+
+    s32 n = 0;
+    while (n < len) {
+        s32 const remaining = len - n;
+
+        // Fast path: four blocks per branch
+        if SDS_LIKELY(remaining >= unroll * block && !crosses_page(s + n, unroll * block) &&
+                      !crosses_page(ascii + n, unroll * block)) {
+            __m256i const b0 = load256(ascii + n);
+            __m256i const b1 = load256(ascii + n + block);
+            __m256i const b2 = load256(ascii + n + 2 * block);
+            __m256i const b3 = load256(ascii + n + 3 * block);
+            __m256i const m = _mm256_min_epu8(
+                _mm256_min_epu8(ascii_cmp_match(load256(s + n), b0),
+                                ascii_cmp_match(load256(s + n + block), b1)),
+                _mm256_min_epu8(ascii_cmp_match(load256(s + n + 2 * block), b2),
+                                ascii_cmp_match(load256(s + n + 3 * block), b3)));
+            if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(m, zero)) != 0) { return false; }
+            SDS_ASSERT(_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(b0, b1),
+                                                            _mm256_or_si256(b2, b3))) == 0 &&
+                       "expected ascii string");
+            n += unroll * block;
+            continue;
+        }
+
+        // Slow path: one block, or bytes when the block would cross a page
+        if SDS_UNLIKELY(crosses_page(s + n, block) || crosses_page(ascii + n, block)) {
+            s32 const count = remaining < block ? remaining : block;
+            if (!ascii_cmp_scalar(s + n, ascii + n, count)) { return false; }
+            n += count;
+            continue;
+        }
+
+        __m256i const b = load256(ascii + n);
+        u32 const valid = remaining >= block ? ~0U : (1U << remaining) - 1;
+        u32 const mismatch = static_cast<u32>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(ascii_cmp_match(load256(s + n), b), zero)));
+        if ((mismatch & valid) != 0) { return false; }
+        SDS_ASSERT((static_cast<u32>(_mm256_movemask_epi8(b)) & valid) == 0 &&
+                   "expected ascii string");
+        n += block;
+    }
+
+    return true;
+}
+#endif
+
+/*
+ * Byte search over an explicit range. The length is known, so blocks never read past the end: the
+ * last partial block is handled by re-reading the final full block, and ranges shorter than a block
+ * are searched a byte at a time.
+ */
+char const* find_char_scalar(char const* s, size_t n, char c) noexcept
+{
+    return details::find_char_constexpr(s, n, c);
+}
+
+/* Membership bitmap of all 256 byte values. */
+struct Byte_Set {
+    u64 bits[4] = {};
+
+    Byte_Set(char const* set, size_t n) noexcept
+    {
+        for (size_t i = 0; i < n; ++i) {
+            auto const b = static_cast<unsigned char>(set[i]);
+            bits[b >> 6] |= u64{1} << (b & 63);
+        }
+    }
+
+    bool has(char c) const noexcept
+    {
+        auto const b = static_cast<unsigned char>(c);
+        return (bits[b >> 6] >> (b & 63)) & 1;
+    }
+};
+
+char const* find_any_of_scalar(char const* s, size_t n, char const* set, size_t set_n) noexcept
+{
+    Byte_Set const table(set, set_n);
+    for (size_t i = 0; i < n; ++i) {
+        if (table.has(s[i])) { return s + i; }
+    }
+    return nullptr;
+}
+
+char const* find_substr_scalar(char const* s, size_t n, char const* needle,
+                               size_t needle_n) noexcept
+{
+    SDS_ASSERT(needle_n >= 2 && needle_n <= n);
+    size_t const last = n - needle_n;
+    for (size_t i = 0; i <= last; ++i) {
+        char const* const p = find_char_scalar(s + i, last - i + 1, needle[0]);
+        if (!p) { return nullptr; }
+        if (p[needle_n - 1] == needle[needle_n - 1] &&
+            std::memcmp(p + 1, needle + 1, needle_n - 2) == 0) {
+            return p;
+        }
+        i = static_cast<size_t>(p - s);
+    }
+    return nullptr;
+}
+
+#if SDS_ARCH_X86 || SDS_ARCH_AMD64
+char const* find_char_sse2(char const* s, size_t n, char c) noexcept
+{
+    constexpr size_t block = sizeof(__m128i);
+    if (n < block) { return find_char_scalar(s, n, c); }
+
+    __m128i const needle = _mm_set1_epi8(c);
+    char const* const end = s + n;
+    char const* p = s;
+
+    // Four blocks per branch
+    for (; static_cast<size_t>(end - p) >= 4 * block; p += 4 * block) {
+        __m128i const m0 = _mm_cmpeq_epi8(load128(p), needle);
+        __m128i const m1 = _mm_cmpeq_epi8(load128(p + block), needle);
+        __m128i const m2 = _mm_cmpeq_epi8(load128(p + 2 * block), needle);
+        __m128i const m3 = _mm_cmpeq_epi8(load128(p + 3 * block), needle);
+        if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(m0, m1), _mm_or_si128(m2, m3))) != 0) {
+            break; // locate it below
+        }
+    }
+
+    for (; static_cast<size_t>(end - p) >= block; p += block) {
+        u32 const mask = static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(load128(p), needle)));
+        if (mask != 0) { return p + sds::count_trailing_zeros(mask); }
+    }
+
+    if (p != end) {
+        p = end - block;
+        u32 const mask = static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(load128(p), needle)));
+        if (mask != 0) { return p + sds::count_trailing_zeros(mask); }
+    }
+    return nullptr;
+}
+
+SDS_TARGET("avx2") char const* find_char_avx2(char const* s, size_t n, char c) noexcept
+{
+    constexpr size_t block = sizeof(__m256i);
+    if (n < block) { return find_char_sse2(s, n, c); }
+
+    __m256i const needle = _mm256_set1_epi8(c);
+    char const* const end = s + n;
+    char const* p = s;
+
+    for (; static_cast<size_t>(end - p) >= 4 * block; p += 4 * block) {
+        __m256i const m0 = _mm256_cmpeq_epi8(load256(p), needle);
+        __m256i const m1 = _mm256_cmpeq_epi8(load256(p + block), needle);
+        __m256i const m2 = _mm256_cmpeq_epi8(load256(p + 2 * block), needle);
+        __m256i const m3 = _mm256_cmpeq_epi8(load256(p + 3 * block), needle);
+        if (_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(m0, m1),
+                                                 _mm256_or_si256(m2, m3))) != 0) {
+            break;
+        }
+    }
+
+    for (; static_cast<size_t>(end - p) >= block; p += block) {
+        u32 const mask =
+            static_cast<u32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(load256(p), needle)));
+        if (mask != 0) { return p + sds::count_trailing_zeros(mask); }
+    }
+
+    if (p != end) {
+        p = end - block;
+        u32 const mask =
+            static_cast<u32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(load256(p), needle)));
+        if (mask != 0) { return p + sds::count_trailing_zeros(mask); }
+    }
+    return nullptr;
+}
+
+/*
+ * Set membership of 16/32 bytes at once for any set of byte values.
+ *
+ * The 256-bit membership bitmap is stored as two 16 byte tables indexed by the low nibble, where
+ * bit (high nibble & 7) is set for members. One table covers high nibbles 0-7, the other 8-15. Both
+ * lookups are a pshufb.
+ *
+ * ref: Wojciech Muła. "SIMD-ized searching for any of a set of bytes". 2018.
+ */
+struct Nibble_Tables {
+    alignas(16) u8 lo[16] = {}; // high nibble 0-7
+    alignas(16) u8 hi[16] = {}; // high nibble 8-15
+
+    Nibble_Tables(char const* set, size_t n) noexcept
+    {
+        for (size_t i = 0; i < n; ++i) {
+            auto const b = static_cast<unsigned char>(set[i]);
+            u8 const bit = static_cast<u8>(1U << ((b >> 4) & 7));
+            if (b < 0x80) {
+                lo[b & 0x0F] |= bit;
+            } else {
+                hi[b & 0x0F] |= bit;
+            }
+        }
+    }
+};
+
+SDS_TARGET("ssse3") inline __m128i any_of_match(__m128i v, __m128i lo, __m128i hi) noexcept
+{
+    __m128i const nibble_mask = _mm_set1_epi8(0x0F);
+    __m128i const bit_lookup =
+        _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+
+    __m128i const low = _mm_and_si128(v, nibble_mask);
+    __m128i const high = _mm_and_si128(_mm_srli_epi16(v, 4), nibble_mask);
+    __m128i const row_lo = _mm_shuffle_epi8(lo, low);
+    __m128i const row_hi = _mm_shuffle_epi8(hi, low);
+    __m128i const use_hi = _mm_cmpgt_epi8(high, _mm_set1_epi8(7));
+    __m128i const row =
+        _mm_or_si128(_mm_andnot_si128(use_hi, row_lo), _mm_and_si128(use_hi, row_hi));
+    __m128i const bit = _mm_shuffle_epi8(bit_lookup, high);
+    return _mm_cmpeq_epi8(_mm_and_si128(row, bit), bit);
+}
+
+SDS_TARGET("avx2") inline __m256i any_of_match(__m256i v, __m256i lo, __m256i hi) noexcept
+{
+    __m256i const nibble_mask = _mm256_set1_epi8(0x0F);
+    __m256i const bit_lookup =
+        _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8,
+                         16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+
+    __m256i const low = _mm256_and_si256(v, nibble_mask);
+    __m256i const high = _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble_mask);
+    __m256i const row_lo = _mm256_shuffle_epi8(lo, low);
+    __m256i const row_hi = _mm256_shuffle_epi8(hi, low);
+    __m256i const use_hi = _mm256_cmpgt_epi8(high, _mm256_set1_epi8(7));
+    __m256i const row = _mm256_blendv_epi8(row_lo, row_hi, use_hi);
+    __m256i const bit = _mm256_shuffle_epi8(bit_lookup, high);
+    return _mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit);
+}
+
+SDS_TARGET("ssse3")
+char const* find_any_of_ssse3(char const* s, size_t n, char const* set, size_t set_n) noexcept
+{
+    constexpr size_t block = sizeof(__m128i);
+    if (n < block) { return find_any_of_scalar(s, n, set, set_n); }
+
+    Nibble_Tables const tables(set, set_n);
+    __m128i const lo = _mm_load_si128(reinterpret_cast<__m128i const*>(tables.lo));
+    __m128i const hi = _mm_load_si128(reinterpret_cast<__m128i const*>(tables.hi));
+    char const* const end = s + n;
+    char const* p = s;
+
+    for (; static_cast<size_t>(end - p) >= block; p += block) {
+        u32 const mask = static_cast<u32>(_mm_movemask_epi8(any_of_match(load128(p), lo, hi)));
+        if (mask != 0) { return p + sds::count_trailing_zeros(mask); }
+    }
+
+    if (p != end) {
+        p = end - block;
+        u32 const mask = static_cast<u32>(_mm_movemask_epi8(any_of_match(load128(p), lo, hi)));
+        if (mask != 0) { return p + sds::count_trailing_zeros(mask); }
+    }
+    return nullptr;
+}
+
+SDS_TARGET("avx2")
+char const* find_any_of_avx2(char const* s, size_t n, char const* set, size_t set_n) noexcept
+{
+    constexpr size_t block = sizeof(__m256i);
+    if (n < block) { return find_any_of_ssse3(s, n, set, set_n); }
+
+    Nibble_Tables const tables(set, set_n);
+    __m256i const lo =
+        _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<__m128i const*>(tables.lo)));
+    __m256i const hi =
+        _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<__m128i const*>(tables.hi)));
+    char const* const end = s + n;
+    char const* p = s;
+
+    // Two blocks per branch
+    for (; static_cast<size_t>(end - p) >= 2 * block; p += 2 * block) {
+        __m256i const m0 = any_of_match(load256(p), lo, hi);
+        __m256i const m1 = any_of_match(load256(p + block), lo, hi);
+        u64 const mask = static_cast<u32>(_mm256_movemask_epi8(m0)) |
+                         (u64{static_cast<u32>(_mm256_movemask_epi8(m1))} << 32);
+        if (mask != 0) { return p + sds::count_trailing_zeros(mask); }
+    }
+
+    for (; static_cast<size_t>(end - p) >= block; p += block) {
+        u32 const mask = static_cast<u32>(_mm256_movemask_epi8(any_of_match(load256(p), lo, hi)));
+        if (mask != 0) { return p + sds::count_trailing_zeros(mask); }
+    }
+
+    if (p != end) {
+        p = end - block;
+        u32 const mask = static_cast<u32>(_mm256_movemask_epi8(any_of_match(load256(p), lo, hi)));
+        if (mask != 0) { return p + sds::count_trailing_zeros(mask); }
+    }
+    return nullptr;
+}
+
+/*
+ * Substring search: compare the first and last needle characters against every position of a block
+ * at once, then verify the candidates where both match.
+ *
+ * ref: Wojciech Muła. "SIMD-friendly algorithms for substring searching". 2016.
+ */
+char const* find_substr_sse2(char const* s, size_t n, char const* needle, size_t needle_n) noexcept
+{
+    constexpr size_t block = sizeof(__m128i);
+    SDS_ASSERT(needle_n >= 2 && needle_n <= n);
+
+    __m128i const first = _mm_set1_epi8(needle[0]);
+    __m128i const last = _mm_set1_epi8(needle[needle_n - 1]);
+    size_t const positions = n - needle_n + 1;
+
+    size_t i = 0;
+    for (; positions - i >= block; i += block) {
+        __m128i const eq_first = _mm_cmpeq_epi8(first, load128(s + i));
+        __m128i const eq_last = _mm_cmpeq_epi8(last, load128(s + i + needle_n - 1));
+        u32 mask = static_cast<u32>(_mm_movemask_epi8(_mm_and_si128(eq_first, eq_last)));
+        while (mask != 0) {
+            size_t const bit = static_cast<size_t>(sds::count_trailing_zeros(mask));
+            if (std::memcmp(s + i + bit + 1, needle + 1, needle_n - 2) == 0) { return s + i + bit; }
+            mask &= mask - 1;
+        }
+    }
+
+    if (i == positions) { return nullptr; }
+    if (positions < block) { return find_substr_scalar(s, n, needle, needle_n); }
+
+    // Re-check the last full block of positions, overlapping the ones already checked
+    i = positions - block;
+    __m128i const eq_first = _mm_cmpeq_epi8(first, load128(s + i));
+    __m128i const eq_last = _mm_cmpeq_epi8(last, load128(s + i + needle_n - 1));
+    u32 mask = static_cast<u32>(_mm_movemask_epi8(_mm_and_si128(eq_first, eq_last)));
+    while (mask != 0) {
+        size_t const bit = static_cast<size_t>(sds::count_trailing_zeros(mask));
+        if (std::memcmp(s + i + bit + 1, needle + 1, needle_n - 2) == 0) {
+            return s + i + bit;
+        }
+        mask &= mask - 1;
+    }
+    return nullptr;
+}
+
+SDS_TARGET("avx2")
+char const* find_substr_avx2(char const* s, size_t n, char const* needle, size_t needle_n) noexcept
+{
+    constexpr size_t block = sizeof(__m256i);
+    SDS_ASSERT(needle_n >= 2 && needle_n <= n);
+
+    __m256i const first = _mm256_set1_epi8(needle[0]);
+    __m256i const last = _mm256_set1_epi8(needle[needle_n - 1]);
+    size_t const positions = n - needle_n + 1;
+
+    size_t i = 0;
+    for (; positions - i >= block; i += block) {
+        __m256i const eq_first = _mm256_cmpeq_epi8(first, load256(s + i));
+        __m256i const eq_last = _mm256_cmpeq_epi8(last, load256(s + i + needle_n - 1));
+        u32 mask = static_cast<u32>(_mm256_movemask_epi8(_mm256_and_si256(eq_first, eq_last)));
+        while (mask != 0) {
+            size_t const bit = static_cast<size_t>(sds::count_trailing_zeros(mask));
+            if (std::memcmp(s + i + bit + 1, needle + 1, needle_n - 2) == 0) { return s + i + bit; }
+            mask &= mask - 1;
+        }
+    }
+
+    if (i == positions) { return nullptr; }
+    if (positions < block) { return find_substr_sse2(s, n, needle, needle_n); }
+
+    // Re-check the last full block of positions, overlapping the ones already checked
+    i = positions - block;
+    __m256i const eq_first = _mm256_cmpeq_epi8(first, load256(s + i));
+    __m256i const eq_last = _mm256_cmpeq_epi8(last, load256(s + i + needle_n - 1));
+    u32 mask = static_cast<u32>(_mm256_movemask_epi8(_mm256_and_si256(eq_first, eq_last)));
+    while (mask != 0) {
+        size_t const bit = static_cast<size_t>(sds::count_trailing_zeros(mask));
+        if (std::memcmp(s + i + bit + 1, needle + 1, needle_n - 2) == 0) {
+            return s + i + bit;
+        }
+        mask &= mask - 1;
+    }
+    return nullptr;
+}
+#endif
+
+using Str_Size_Fn = int (*)(char const*);
+using Ascii_Cmp_Fn = bool (*)(char const*, char const*, s32);
+
+Cpu_Dispatch<int(char const*)> const str_size_dispatch([](Cpu_Features const& f) -> Str_Size_Fn {
+#if SDS_ARCH_X86 || SDS_ARCH_AMD64
+    if (f.has(Cpu_Feature::avx2)) { return &str_size_avx2; }
+    if (f.has(Cpu_Feature::sse2)) { return &str_size_sse2; }
+#endif
+    (void)f;
+    return &str_size_scalar;
+});
+
+Cpu_Dispatch<bool(char const*, char const*, s32)> const
+    ascii_cmp_dispatch([](Cpu_Features const& f) -> Ascii_Cmp_Fn {
+#if SDS_ARCH_X86 || SDS_ARCH_AMD64
+        if (f.has(Cpu_Feature::avx2)) { return &ascii_cmp_avx2; }
+        if (f.has(Cpu_Feature::sse2)) { return &ascii_cmp_sse2; }
+#endif
+        (void)f;
+        return &ascii_cmp_scalar;
+    });
+using Find_Char_Fn = char const* (*)(char const*, size_t, char);
+using Find_Set_Fn = char const* (*)(char const*, size_t, char const*, size_t);
+
+Cpu_Dispatch<char const*(char const*, size_t, char)> const
+    find_char_dispatch([](Cpu_Features const& f) -> Find_Char_Fn {
+#if SDS_ARCH_X86 || SDS_ARCH_AMD64
+        if (f.has(Cpu_Feature::avx2)) { return &find_char_avx2; }
+        if (f.has(Cpu_Feature::sse2)) { return &find_char_sse2; }
+#endif
+        (void)f;
+        return &find_char_scalar;
+    });
+
+Cpu_Dispatch<char const*(char const*, size_t, char const*, size_t)> const
+    find_any_of_dispatch([](Cpu_Features const& f) -> Find_Set_Fn {
+#if SDS_ARCH_X86 || SDS_ARCH_AMD64
+        if (f.has(Cpu_Feature::avx2)) { return &find_any_of_avx2; }
+        if (f.has(Cpu_Feature::ssse3)) { return &find_any_of_ssse3; }
+#endif
+        (void)f;
+        return &find_any_of_scalar;
+    });
+
+Cpu_Dispatch<char const*(char const*, size_t, char const*, size_t)> const
+    find_substr_dispatch([](Cpu_Features const& f) -> Find_Set_Fn {
+#if SDS_ARCH_X86 || SDS_ARCH_AMD64
+        if (f.has(Cpu_Feature::avx2)) { return &find_substr_avx2; }
+        if (f.has(Cpu_Feature::sse2)) { return &find_substr_sse2; }
+#endif
+        (void)f;
+        return &find_substr_scalar;
+    });
+} // namespace
+
+int sds::str_size(char const* s) noexcept
+{
+    if (!s) { return 0; }
+    return str_size_dispatch(s);
+}
+
+int sds::byte_size(char const* s) noexcept
+{
+    if (!s) { return 0; }
+    return sds::str_size(s) + 1; // count null-terminator
+}
+
+bool sds::ascii_cmp(char const* s, char const* ascii, s32 len) noexcept
+{
+    SDS_ASSERT(s);
+    SDS_ASSERT(ascii);
+    SDS_ASSERT(len > 0);
+
+    return ascii_cmp_dispatch(s, ascii, len);
+}
+
 bool sds::ascii_cmp(char const* s, char const* ascii) noexcept
 {
     return ascii_cmp(s, ascii, sds::str_size(ascii));
 }
+
+bool sds::ascii_eq(String_View s, String_View ascii) noexcept
+{
+    SDS_ASSERT(std::all_of(ascii.begin(), ascii.end(), is_ascii) && "expected ascii string");
+    return s.size() == ascii.size() &&
+           (s.empty() || std::memcmp(s.data(), ascii.data(), s.size()) == 0);
+}
+
+char const* sds::details::find_char(char const* s, size_t n, char c) noexcept
+{
+    SDS_ASSERT(s || n == 0);
+    return find_char_dispatch(s, n, c);
+}
+
+char const* sds::details::find_any_of(char const* s, size_t n, char const* set,
+                                      size_t set_n) noexcept
+{
+    SDS_ASSERT(s || n == 0);
+    SDS_ASSERT(set || set_n == 0);
+    if (set_n == 0) { return nullptr; }
+    if (set_n == 1) { return find_char_dispatch(s, n, set[0]); }
+    return find_any_of_dispatch(s, n, set, set_n);
+}
+
+char const* sds::details::find_substr(char const* s, size_t n, char const* needle,
+                                      size_t needle_n) noexcept
+{
+    SDS_ASSERT(s || n == 0);
+    SDS_ASSERT(needle || needle_n == 0);
+    if (needle_n == 0) { return s; }
+    if (needle_n > n) { return nullptr; }
+    if (needle_n == 1) { return find_char_dispatch(s, n, needle[0]); }
+    return find_substr_dispatch(s, n, needle, needle_n);
+}
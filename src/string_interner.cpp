@@ -0,0 +1,162 @@
+#include "sds/string_interner.h"
+
+#include "sds/bit.h"
+#include "sds/hash.h"
+#include "sds/move.h"
+#include <cstring>
+
+using namespace sds;
+
+namespace
+{
+constexpr size_t arena_chunk_size = 16 * 1024;
+constexpr u32 initial_capacity = 16;
+} // namespace
+
+char* String_Interner::Arena::allocate(size_t n)
+{
+    if (n > remaining) {
+        size_t const chunk = n > arena_chunk_size ? n : arena_chunk_size;
+        chunks.emplace_back(new char[chunk]);
+        next = chunks.back().get();
+        remaining = chunk;
+    }
+
+    char* const p = next;
+    next += n;
+    remaining -= n;
+    return p;
+}
+
+String_Interner::String_Interner() = default;
+
+String_Interner::~String_Interner() noexcept
+{
+    for (std::atomic<Entry*>& segment : m_segments) {
+        delete[] segment.load(std::memory_order_relaxed);
+    }
+}
+
+Interned_String String_Interner::intern(String_View s)
+{
+    SDS_ASSERT(s.size() < ~0U);
+
+    u64 const h = sds::hash(s);
+    u32 const h32 = static_cast<u32>(h);
+    Stripe& st = stripe(h);
+
+    Scoped_Lock<Spin_Lock> lock(st.lock);
+
+    u32 const existing = find_locked(st, h32, s);
+    if (existing != Interned_String::invalid_id) { return Interned_String(existing); }
+
+    // Keep the load factor under 3/4
+    if ((st.count + 1) * 4 > st.capacity * 3) { grow(st); }
+
+    size_t const bytes = s.size() + 1;
+    char* const p = st.arena.allocate(bytes);
+    if (!s.empty()) { std::memcpy(p, s.data(), s.size()); }
+    p[s.size()] = '\0';
+
+    // Take the id only once its entry exists, so a failed allocation leaves no gap in the ids
+    u32 id = m_next_id.load(std::memory_order_relaxed);
+    Entry* e = nullptr;
+    do {
+        SDS_ASSERT(id != Interned_String::invalid_id && "interner is full");
+        e = &new_entry(id);
+    } while (!m_next_id.compare_exchange_weak(id, id + 1, std::memory_order_relaxed));
+    *e = Entry{p, static_cast<u32>(s.size())};
+
+    u32 const mask = st.capacity - 1;
+    u32 i = h32 & mask;
+    while (st.slots[i].id != Interned_String::invalid_id) { i = (i + 1) & mask; }
+    st.slots[i] = Slot{h32, id};
+    ++st.count;
+
+    m_string_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    return Interned_String(id);
+}
+
+Interned_String String_Interner::find(String_View s) const noexcept
+{
+    u64 const h = sds::hash(s);
+    Stripe const& st = stripe(h);
+
+    Scoped_Lock<Spin_Lock> lock(st.lock);
+    return Interned_String(find_locked(st, static_cast<u32>(h), s));
+}
+
+String_View String_Interner::view(Interned_String h) const noexcept
+{
+    SDS_ASSERT(h.is_valid());
+    Entry const& e = entry(h.id());
+    return {e.data, e.size};
+}
+
+String_Interner::Entry const& String_Interner::entry(u32 id) const noexcept
+{
+    u64 const i = u64{id} + (u64{1} << s_first_segment_bits);
+    s32 const bit = sds::log2(i);
+    Entry const* const segment =
+        m_segments[bit - s_first_segment_bits].load(std::memory_order_acquire);
+    SDS_ASSERT(segment && "handle is not from this interner");
+    return segment[i - (u64{1} << bit)];
+}
+
+String_Interner::Entry& String_Interner::new_entry(u32 id)
+{
+    u64 const i = u64{id} + (u64{1} << s_first_segment_bits);
+    s32 const bit = sds::log2(i);
+    std::atomic<Entry*>& slot = m_segments[bit - s_first_segment_bits];
+
+    Entry* segment = slot.load(std::memory_order_acquire);
+    if (!segment) {
+        // Several stripes may race to add the same segment
+        Entry* fresh = new Entry[size_t{1} << bit];
+        if (slot.compare_exchange_strong(segment, fresh, std::memory_order_acq_rel,
+                                         std::memory_order_acquire)) {
+            segment = fresh;
+        } else {
+            delete[] fresh;
+        }
+    }
+    return segment[i - (u64{1} << bit)];
+}
+
+u32 String_Interner::find_locked(Stripe const& st, u32 hash, String_View s) const noexcept
+{
+    if (st.capacity == 0) { return Interned_String::invalid_id; }
+
+    u32 const mask = st.capacity - 1;
+    for (u32 i = hash & mask;; i = (i + 1) & mask) {
+        Slot const& slot = st.slots[i];
+        if (slot.id == Interned_String::invalid_id) { return Interned_String::invalid_id; }
+        if (slot.hash == hash) {
+            Entry const& e = entry(slot.id);
+            if (e.size == s.size() &&
+                (s.empty() || std::memcmp(e.data, s.data(), s.size()) == 0)) {
+                return slot.id;
+            }
+        }
+    }
+}
+
+void String_Interner::grow(Stripe& st)
+{
+    u32 const capacity = st.capacity == 0 ? initial_capacity : st.capacity * 2;
+    std::unique_ptr<Slot[]> slots(new Slot[capacity]);
+    for (u32 i = 0; i < capacity; ++i) { slots[i] = Slot{0, Interned_String::invalid_id}; }
+
+    u32 const mask = capacity - 1;
+    for (u32 i = 0; i < st.capacity; ++i) {
+        Slot const& slot = st.slots[i];
+        if (slot.id == Interned_String::invalid_id) { continue; }
+
+        u32 j = slot.hash & mask;
+        while (slots[j].id != Interned_String::invalid_id) { j = (j + 1) & mask; }
+        slots[j] = slot;
+    }
+
+    st.slots = sds::move(slots);
+    st.capacity = capacity;
+}
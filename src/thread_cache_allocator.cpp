@@ -0,0 +1,369 @@
+#include "sds/allocator/thread_cache_allocator.h"
+
+#include "sds/bit.h"
+#include "sds/cache_aligned.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+using namespace sds;
+
+namespace
+{
+/*
+ * Size classes: multiples of 16 up to 128 bytes, then four classes per power of two up to
+ * thread_cache_max_size, so no more than 20% of a block above 128 bytes is wasted.
+ */
+constexpr u32 small_class_count = 8;
+constexpr u32 class_count = small_class_count + 4 * 7;
+
+constexpr u32 size_class(size_t bytes) noexcept
+{
+    if (bytes <= 128) { return bytes == 0 ? 0 : static_cast<u32>((bytes - 1) >> 4); }
+    u64 const n = static_cast<u64>(bytes) - 1;
+    u32 const lg = static_cast<u32>(sds::log2(n));
+    return small_class_count + (lg - 7) * 4 + static_cast<u32>(n >> (lg - 2)) - 4;
+}
+
+constexpr size_t class_size(u32 c) noexcept
+{
+    if (c < small_class_count) { return (c + 1) * 16; }
+    u32 const k = c - small_class_count;
+    u32 const lg = 7 + k / 4;
+    return (size_t{1} << lg) + (k % 4 + 1) * (size_t{1} << (lg - 2));
+}
+
+SDS_STATIC_ASSERT(class_size(class_count - 1) == thread_cache_max_size);
+SDS_STATIC_ASSERT(size_class(thread_cache_max_size) == class_count - 1);
+SDS_STATIC_ASSERT(size_class(129) == small_class_count && class_size(small_class_count) == 160);
+
+/* Slabs are aligned to their size so a block finds its slab by masking its address */
+constexpr size_t slab_size = 256 * 1024;
+constexpr size_t segment_slabs = 16;
+constexpr size_t segment_size = segment_slabs * slab_size;
+/* Non-current slabs checked for remote frees before taking a new slab */
+constexpr u32 max_scan = 8;
+
+struct Block {
+    Block* next;
+};
+
+struct Heap;
+
+struct alignas(hardware_destructive_interference_size) Slab {
+    // Owner side
+    Block* free = nullptr;
+    char* bump = nullptr; // next never allocated block
+    char* end = nullptr;  // end of the last whole block
+    Slab* prev = nullptr;
+    Slab* next = nullptr;
+    u32 used = 0; // blocks not on the free list, including uncollected remote frees
+    u32 size_class = 0;
+    u32 block_size = 0;
+    // Read by freeing threads. Only changes while the slab has no live blocks.
+    std::atomic<Heap*> owner{nullptr};
+
+    // Freeing threads side, on its own line
+    alignas(hardware_destructive_interference_size) std::atomic<Block*> remote{nullptr};
+};
+
+constexpr size_t slab_header_size = sizeof(Slab);
+SDS_STATIC_ASSERT(slab_header_size == 2 * hardware_destructive_interference_size);
+SDS_STATIC_ASSERT(slab_header_size % alignof(std::max_align_t) == 0);
+SDS_STATIC_ASSERT((slab_size - slab_header_size) / thread_cache_max_size >= 8);
+
+/* Slabs of one size class in a heap. */
+struct Class_Slabs {
+    Slab* current = nullptr;
+    // Other slabs. Ones that regained free blocks go to the front, full ones to the back.
+    Slab* head = nullptr;
+    Slab* tail = nullptr;
+    u32 count = 0;
+
+    void push_front(Slab* s) noexcept
+    {
+        s->prev = nullptr;
+        s->next = head;
+        (head ? head->prev : tail) = s;
+        head = s;
+        ++count;
+    }
+
+    void push_back(Slab* s) noexcept
+    {
+        s->next = nullptr;
+        s->prev = tail;
+        (tail ? tail->next : head) = s;
+        tail = s;
+        ++count;
+    }
+
+    void unlink(Slab* s) noexcept
+    {
+        (s->prev ? s->prev->next : head) = s->next;
+        (s->next ? s->next->prev : tail) = s->prev;
+        s->prev = nullptr;
+        s->next = nullptr;
+        --count;
+    }
+};
+
+struct Heap {
+    Class_Slabs classes[class_count] = {};
+    Heap* next_free = nullptr; // in the pool of heaps of exited threads
+};
+
+/* Slabs and heaps shared by all threads. */
+struct Pool {
+    std::mutex mutex{};
+    Slab* free_slabs = nullptr;
+    Heap* free_heaps = nullptr;
+    size_t reserved_bytes = 0;
+    size_t pooled_bytes = 0;
+};
+
+/* Never destroyed, so memory can be released during static destruction. */
+Pool& pool()
+{
+    static Pool* const s_pool = new Pool;
+    return *s_pool;
+}
+
+Slab* slab_of(void* p) noexcept
+{
+    return reinterpret_cast<Slab*>(reinterpret_cast<uintptr_t>(p) & ~(uintptr_t{slab_size} - 1));
+}
+
+Slab* acquire_slab(Heap* heap, u32 c)
+{
+    Pool& p = pool();
+    Slab* s = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(p.mutex);
+        if (!p.free_slabs) {
+            char* const segment =
+                static_cast<char*>(::operator new(segment_size, std::align_val_t(slab_size)));
+            for (size_t i = 0; i < segment_slabs; ++i) {
+                Slab* const fresh = new (segment + i * slab_size) Slab;
+                fresh->next = p.free_slabs;
+                p.free_slabs = fresh;
+            }
+            p.reserved_bytes += segment_size;
+            p.pooled_bytes += segment_size;
+        }
+        s = p.free_slabs;
+        p.free_slabs = s->next;
+        p.pooled_bytes -= slab_size;
+    }
+
+    SDS_ASSERT(s->used == 0 && !s->remote.load(std::memory_order_relaxed));
+    size_t const block_size = class_size(c);
+    size_t const blocks = (slab_size - slab_header_size) / block_size;
+    s->free = nullptr;
+    s->bump = reinterpret_cast<char*>(s) + slab_header_size;
+    s->end = s->bump + blocks * block_size;
+    s->prev = nullptr;
+    s->next = nullptr;
+    s->size_class = c;
+    s->block_size = static_cast<u32>(block_size);
+    s->owner.store(heap, std::memory_order_relaxed);
+    return s;
+}
+
+void release_slab(Slab* s) noexcept
+{
+    SDS_ASSERT(s->used == 0);
+    s->owner.store(nullptr, std::memory_order_relaxed);
+    Pool& p = pool();
+    std::lock_guard<std::mutex> lock(p.mutex);
+    s->next = p.free_slabs;
+    p.free_slabs = s;
+    p.pooled_bytes += slab_size;
+}
+
+/* Move blocks freed by other threads onto the free list. */
+void collect_remote(Slab& s) noexcept
+{
+    if (!s.remote.load(std::memory_order_relaxed)) { return; }
+    Block* const first = s.remote.exchange(nullptr, std::memory_order_acquire);
+    Block* last = first;
+    u32 n = 1;
+    for (; last->next; last = last->next) { ++n; }
+    last->next = s.free;
+    s.free = first;
+    SDS_ASSERT(s.used >= n);
+    s.used -= n;
+}
+
+void* pop(Slab& s) noexcept
+{
+    ++s.used;
+    if (Block* const b = s.free) {
+        s.free = b->next;
+        return b;
+    }
+    SDS_ASSERT(s.bump != s.end);
+    void* const b = s.bump;
+    s.bump += s.block_size;
+    return b;
+}
+
+bool has_free(Slab const& s) noexcept { return s.free || s.bump != s.end; }
+
+void* allocate_slow(Heap& heap, u32 c)
+{
+    Class_Slabs& slabs = heap.classes[c];
+    Slab* const full = slabs.current;
+    if (full) {
+        collect_remote(*full);
+        if (full->free) { return pop(*full); }
+    }
+
+    // Look for a slab with freed blocks. Full ones rotate to the back so a later scan checks
+    // others for remote frees.
+    Slab* next = slabs.head;
+    for (u32 i = 0, n = std::min(max_scan, slabs.count); i < n; ++i) {
+        Slab* const s = next;
+        next = s->next;
+        slabs.unlink(s);
+        collect_remote(*s);
+        if (has_free(*s)) {
+            if (full) { slabs.push_back(full); }
+            slabs.current = s;
+            return pop(*s);
+        }
+        slabs.push_back(s);
+    }
+
+    Slab* const s = acquire_slab(&heap, c);
+    if (full) { slabs.push_back(full); }
+    slabs.current = s;
+    return pop(*s);
+}
+
+/* Hand back the empty slabs and put the heap in the pool for the next new thread. */
+void release_heap(Heap* heap) noexcept
+{
+    for (Class_Slabs& slabs : heap->classes) {
+        for (Slab* s = slabs.head; s;) {
+            Slab* const next = s->next;
+            collect_remote(*s);
+            if (s->used == 0) {
+                slabs.unlink(s);
+                release_slab(s);
+            }
+            s = next;
+        }
+        if (Slab* const s = slabs.current) {
+            collect_remote(*s);
+            if (s->used == 0) {
+                slabs.current = nullptr;
+                release_slab(s);
+            }
+        }
+    }
+
+    Pool& p = pool();
+    std::lock_guard<std::mutex> lock(p.mutex);
+    heap->next_free = p.free_heaps;
+    p.free_heaps = heap;
+}
+
+thread_local Heap* t_heap = nullptr;
+thread_local bool t_heap_released = false;
+
+struct Heap_Guard {
+    Heap* heap = nullptr;
+
+    Heap_Guard() = default;
+    Heap_Guard(Heap_Guard const&) = delete;
+    Heap_Guard& operator=(Heap_Guard const&) = delete;
+
+    ~Heap_Guard()
+    {
+        if (!heap) { return; }
+        t_heap = nullptr;
+        t_heap_released = true;
+        release_heap(heap);
+    }
+};
+
+thread_local Heap_Guard t_heap_guard;
+
+Heap& acquire_heap()
+{
+    Heap* heap = nullptr;
+    {
+        Pool& p = pool();
+        std::lock_guard<std::mutex> lock(p.mutex);
+        heap = p.free_heaps;
+        if (heap) { p.free_heaps = heap->next_free; }
+    }
+    if (!heap) { heap = new Heap; }
+    heap->next_free = nullptr;
+
+    // NOTE(sdsmith): A thread allocating after its thread-local destructors ran keeps this heap
+    // to itself for good. Registering a new guard then isn't reliable.
+    if (!t_heap_released) { t_heap_guard.heap = heap; }
+    t_heap = heap;
+    return *heap;
+}
+} // namespace
+
+void* sds::thread_cache_allocate(size_t bytes)
+{
+    if (bytes > thread_cache_max_size) { return ::operator new(bytes); }
+
+    Heap* const heap = t_heap;
+    Heap& h = SDS_LIKELY(heap) ? *heap : acquire_heap();
+    u32 const c = size_class(bytes);
+    Slab* const s = h.classes[c].current;
+    if SDS_LIKELY(s && has_free(*s)) { return pop(*s); }
+    return allocate_slow(h, c);
+}
+
+void sds::thread_cache_deallocate(void* p, size_t bytes) noexcept
+{
+    if (!p) { return; }
+    if (bytes > thread_cache_max_size) {
+        ::operator delete(p, bytes);
+        return;
+    }
+
+    Slab* const s = slab_of(p);
+    Block* const b = static_cast<Block*>(p);
+    Heap* const heap = t_heap;
+    if (heap && s->owner.load(std::memory_order_relaxed) == heap) {
+        Class_Slabs& slabs = heap->classes[s->size_class];
+        bool const was_full = !has_free(*s);
+        b->next = s->free;
+        s->free = b;
+        --s->used;
+        if (s != slabs.current) {
+            if (s->used == 0) {
+                slabs.unlink(s);
+                release_slab(s);
+            } else if (was_full) {
+                slabs.unlink(s);
+                slabs.push_front(s);
+            }
+        }
+        return;
+    }
+
+    Block* head = s->remote.load(std::memory_order_relaxed);
+    do {
+        b->next = head;
+    } while (!s->remote.compare_exchange_weak(head, b, std::memory_order_release,
+                                              std::memory_order_relaxed));
+}
+
+Thread_Cache_Stats sds::thread_cache_stats() noexcept
+{
+    Pool& p = pool();
+    std::lock_guard<std::mutex> lock(p.mutex);
+    Thread_Cache_Stats s;
+    s.reserved_bytes = p.reserved_bytes;
+    s.pooled_bytes = p.pooled_bytes;
+    return s;
+}
@@ -0,0 +1,129 @@
+#include "sds/allocator/tracking_allocator.h"
+
+#include "sds/bit.h"
+#include <mutex>
+
+using namespace sds;
+
+namespace sds
+{
+/* Intrusive list of live tags. */
+struct Memory_Tag_Registry {
+    std::mutex mutex{};
+    Memory_Tag* head = nullptr;
+
+    static Memory_Tag_Registry& get() noexcept
+    {
+        // Never destroyed, so tags with static storage can unregister in any order
+        static Memory_Tag_Registry* const s_registry = new Memory_Tag_Registry;
+        return *s_registry;
+    }
+
+    void add(Memory_Tag& tag)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tag.m_next = head;
+        head = &tag;
+    }
+
+    void remove(Memory_Tag& tag)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (Memory_Tag** p = &head; *p; p = &(*p)->m_next) {
+            if (*p == &tag) {
+                *p = tag.m_next;
+                return;
+            }
+        }
+    }
+
+    void visit(details::Memory_Tag_Visitor fn, void* ctx)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (Memory_Tag const* tag = head; tag; tag = tag->m_next) { fn(*tag, ctx); }
+    }
+};
+} // namespace sds
+
+namespace
+{
+s32 histogram_bucket(size_t bytes) noexcept
+{
+    if (bytes <= 1) { return 0; }
+    s32 const b = sds::log2(static_cast<u64>(bytes));
+    return b < memory_histogram_buckets ? b : memory_histogram_buckets - 1;
+}
+} // namespace
+
+Memory_Tag::Memory_Tag(char const* name) : m_name(name)
+{
+    Memory_Tag_Registry::get().add(*this);
+}
+
+Memory_Tag::~Memory_Tag() { Memory_Tag_Registry::get().remove(*this); }
+
+Memory_Tag::Shard& Memory_Tag::local_shard() noexcept
+{
+    // The first shard_count threads get a shard each
+    return m_shards[thread_index() % static_cast<u32>(shard_count)];
+}
+
+void Memory_Tag::fold(Shard& shard, s64 pending) noexcept
+{
+    if (pending < peak_batch_bytes && pending > -peak_batch_bytes) { return; }
+
+    s64 const taken = shard.pending_bytes.exchange(0, std::memory_order_relaxed);
+    s64 const live = m_live_bytes.fetch_add(taken, std::memory_order_relaxed) + taken;
+    s64 peak = m_peak_bytes.load(std::memory_order_relaxed);
+    while (live > peak) {
+        if (m_peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) { break; }
+    }
+}
+
+void Memory_Tag::record_allocate(size_t bytes) noexcept
+{
+    Shard& shard = local_shard();
+    shard.allocations.fetch_add(1, std::memory_order_relaxed);
+    shard.size_histogram[histogram_bucket(bytes)].fetch_add(1, std::memory_order_relaxed);
+    s64 const n = static_cast<s64>(bytes);
+    fold(shard, shard.pending_bytes.fetch_add(n, std::memory_order_relaxed) + n);
+}
+
+void Memory_Tag::record_deallocate(size_t bytes) noexcept
+{
+    Shard& shard = local_shard();
+    shard.deallocations.fetch_add(1, std::memory_order_relaxed);
+    s64 const n = static_cast<s64>(bytes);
+    fold(shard, shard.pending_bytes.fetch_sub(n, std::memory_order_relaxed) - n);
+}
+
+Memory_Stats Memory_Tag::stats() const noexcept
+{
+    Memory_Stats s;
+    s64 pending = 0;
+    for (Shard const& shard : m_shards) {
+        pending += shard.pending_bytes.load(std::memory_order_relaxed);
+        s.allocations += shard.allocations.load(std::memory_order_relaxed);
+        s.deallocations += shard.deallocations.load(std::memory_order_relaxed);
+        for (s32 i = 0; i < memory_histogram_buckets; ++i) {
+            s.size_histogram[i] += shard.size_histogram[i].load(std::memory_order_relaxed);
+        }
+    }
+    // A fold clears its shard before adding to the total, so a delta in flight is in neither
+    s.live_bytes = m_live_bytes.load(std::memory_order_relaxed) + pending;
+    s64 const peak = m_peak_bytes.load(std::memory_order_relaxed);
+    s.peak_bytes = peak > s.live_bytes ? peak : s.live_bytes;
+    return s;
+}
+
+Memory_Tag& Memory_Tag::untagged() noexcept
+{
+    // Never destroyed, so containers with static storage can free into it during shutdown
+    static Memory_Tag* const s_untagged = new Memory_Tag("untagged");
+    return *s_untagged;
+}
+
+void sds::details::for_each_memory_tag(Memory_Tag_Visitor visit, void* ctx)
+{
+    Memory_Tag_Registry::get().visit(visit, ctx);
+}
@@ -1,7 +1,10 @@
 #include "gtest/gtest.h"
 
 #include "sds/array/dynamic_array.h"
+#include "sds/move.h"
 #include <iterator>
+#include <stdexcept>
+#include <string>
 
 
 /** \file dynamic_array_test.cpp
@@ -206,3 +209,181 @@ TYPED_TEST(Is_Container_Test, const_iterator_types) {
     std::iterator_traits<typename Container::const_iterator>::reference;
 }
 */
+
+TEST(Dynamic_Array, basics)
+{
+    sds::Dynamic_Array<int> a;
+    EXPECT_TRUE(a.empty());
+    EXPECT_EQ(a.begin(), a.end());
+
+    for (int i = 0; i < 100; ++i) { a.push_back(i); }
+    EXPECT_EQ(a.size(), 100u);
+    EXPECT_GE(a.capacity(), 100u);
+    EXPECT_EQ(a.front(), 0);
+    EXPECT_EQ(a.back(), 99);
+    EXPECT_EQ(a[50], 50);
+    EXPECT_EQ(a.at(99), 99);
+    EXPECT_THROW(static_cast<void>(a.at(100)), std::out_of_range);
+    EXPECT_EQ(std::distance(a.begin(), a.end()), 100);
+    EXPECT_EQ(*a.rbegin(), 99);
+
+    a.pop_back();
+    EXPECT_EQ(a.back(), 98);
+    a.resize(10);
+    EXPECT_EQ(a.size(), 10u);
+    a.resize(12, 7);
+    EXPECT_EQ(a, (sds::Dynamic_Array<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 7, 7}));
+    a.shrink_to_fit();
+    EXPECT_EQ(a.capacity(), 12u);
+
+    a.clear();
+    EXPECT_TRUE(a.empty());
+}
+
+TEST(Dynamic_Array, insert_erase)
+{
+    sds::Dynamic_Array<int> a{1, 2, 5};
+    auto it = a.insert(a.begin() + 2, {3, 4});
+    EXPECT_EQ(*it, 3);
+    EXPECT_EQ(a, (sds::Dynamic_Array<int>{1, 2, 3, 4, 5}));
+
+    a.insert(a.begin(), 0);
+    a.insert(a.end(), 2, 6);
+    a.emplace(a.begin() + 1, 9);
+    EXPECT_EQ(a, (sds::Dynamic_Array<int>{0, 9, 1, 2, 3, 4, 5, 6, 6}));
+
+    // Insert an element of the array itself, with and without reallocation
+    a.shrink_to_fit();
+    a.insert(a.begin(), a.back());
+    a.insert(a.begin(), a[1]);
+    EXPECT_EQ(a, (sds::Dynamic_Array<int>{0, 6, 0, 9, 1, 2, 3, 4, 5, 6, 6}));
+
+    it = a.erase(a.begin() + 3);
+    EXPECT_EQ(*it, 1);
+    it = a.erase(a.begin(), a.begin() + 3);
+    EXPECT_EQ(*it, 1);
+    EXPECT_EQ(a, (sds::Dynamic_Array<int>{1, 2, 3, 4, 5, 6, 6}));
+}
+
+TEST(Dynamic_Array, non_trivial_elements)
+{
+    sds::Dynamic_Array<std::string> a(3, "x");
+    a.emplace_back(40, 'y');
+    a.insert(a.begin() + 1, std::string(30, 'z'));
+    EXPECT_EQ(a.size(), 5u);
+    EXPECT_EQ(a[1], std::string(30, 'z'));
+    EXPECT_EQ(a[4], std::string(40, 'y'));
+
+    sds::Dynamic_Array<std::string> b(a);
+    EXPECT_EQ(a, b);
+    sds::Dynamic_Array<std::string> c(sds::move(b));
+    EXPECT_EQ(a, c);
+    EXPECT_TRUE(b.empty());
+
+    b = c;
+    c.erase(c.begin());
+    EXPECT_NE(b, c);
+    b.swap(c);
+    EXPECT_EQ(b.size(), 4u);
+    EXPECT_EQ(c.size(), 5u);
+
+    c = {"a", "b"};
+    EXPECT_EQ(c.size(), 2u);
+    EXPECT_EQ(c.back(), "b");
+}
+
+namespace
+{
+/* Counts live objects. Copies, constructed or assigned, throw once \a copies_left runs out. Moves
+ * may throw, so the array copies to reallocate. */
+struct Throwing_Copy {
+    static inline int live = 0;
+    static inline int copies_left = -1;
+
+    int value = 0;
+
+    Throwing_Copy(int v) : value(v) { ++live; }
+    Throwing_Copy(Throwing_Copy const& o) : value(o.value)
+    {
+        copied();
+        ++live;
+    }
+    Throwing_Copy(Throwing_Copy&& o) noexcept(false) : value(o.value) { ++live; }
+    ~Throwing_Copy() { --live; }
+
+    Throwing_Copy& operator=(Throwing_Copy const& o)
+    {
+        copied();
+        value = o.value;
+        return *this;
+    }
+    Throwing_Copy& operator=(Throwing_Copy&& o) noexcept(false)
+    {
+        value = o.value;
+        return *this;
+    }
+
+    static void copied()
+    {
+        if (copies_left == 0) { throw std::runtime_error("copy"); }
+        if (copies_left > 0) { --copies_left; }
+    }
+};
+
+sds::Dynamic_Array<int> values(sds::Dynamic_Array<Throwing_Copy> const& a)
+{
+    sds::Dynamic_Array<int> v;
+    for (Throwing_Copy const& e : a) { v.push_back(e.value); }
+    return v;
+}
+} // namespace
+
+TEST(Dynamic_Array, throwing_copy)
+{
+    Throwing_Copy const src[] = {10, 11};
+    {
+        // In place, the gap inside the elements
+        sds::Dynamic_Array<Throwing_Copy> a;
+        a.reserve(16);
+        for (int i = 0; i < 6; ++i) { a.emplace_back(i); }
+        Throwing_Copy::copies_left = 1;
+        EXPECT_THROW(a.insert(a.cbegin() + 1, std::begin(src), std::end(src)), std::runtime_error);
+        EXPECT_EQ(Throwing_Copy::live, static_cast<int>(a.size()) + 2);
+
+        // In place, the gap reaching past the end
+        Throwing_Copy::copies_left = 1;
+        EXPECT_THROW(a.insert(a.cend() - 1, std::begin(src), std::end(src)), std::runtime_error);
+        EXPECT_EQ(Throwing_Copy::live, static_cast<int>(a.size()) + 2);
+        Throwing_Copy::copies_left = 0;
+        EXPECT_THROW(a.insert(a.cbegin(), 2, src[0]), std::runtime_error);
+        EXPECT_EQ(Throwing_Copy::live, static_cast<int>(a.size()) + 2);
+        Throwing_Copy::copies_left = -1;
+    }
+    EXPECT_EQ(Throwing_Copy::live, 2);
+
+    {
+        // Reallocating leaves the array as it was
+        sds::Dynamic_Array<Throwing_Copy> a;
+        for (int i = 0; i < 6; ++i) { a.emplace_back(i); }
+        a.shrink_to_fit();
+        sds::Dynamic_Array<int> const before = values(a);
+
+        Throwing_Copy::copies_left = 3;
+        EXPECT_THROW(a.insert(a.cbegin() + 1, std::begin(src), std::end(src)), std::runtime_error);
+        EXPECT_EQ(values(a), before);
+        Throwing_Copy::copies_left = 0;
+        EXPECT_THROW(a.emplace(a.cbegin() + 1, 7), std::runtime_error);
+        EXPECT_EQ(values(a), before);
+        Throwing_Copy::copies_left = 2;
+        EXPECT_THROW(a.emplace_back(7), std::runtime_error);
+        EXPECT_EQ(values(a), before);
+        EXPECT_EQ(a.capacity(), 6u);
+        EXPECT_EQ(Throwing_Copy::live, 6 + 2);
+        Throwing_Copy::copies_left = -1;
+
+        a.emplace_back(6);
+        a.emplace(a.cbegin(), -1);
+        EXPECT_EQ(values(a), (sds::Dynamic_Array<int>{-1, 0, 1, 2, 3, 4, 5, 6}));
+    }
+    EXPECT_EQ(Throwing_Copy::live, 2);
+}
@@ -0,0 +1,116 @@
+#include "gtest/gtest.h"
+
+#include "sds/array/ring_buffer.h"
+#include <algorithm>
+#include <deque>
+#include <string>
+#include <vector>
+
+TEST(Ring_Buffer, push_and_overwrite)
+{
+    sds::Ring_Buffer<int, 4> r;
+    EXPECT_TRUE(r.empty());
+    EXPECT_EQ(r.capacity(), 4);
+    EXPECT_EQ(r.begin(), r.end());
+
+    for (int i = 0; i < 3; ++i) { r.push_back(i); }
+    EXPECT_EQ(r.size(), 3);
+    EXPECT_FALSE(r.full());
+    EXPECT_EQ(r.front(), 0);
+    EXPECT_EQ(r.back(), 2);
+
+    // Overwrites the oldest once full
+    for (int i = 3; i < 10; ++i) { r.push_back(i); }
+    EXPECT_TRUE(r.full());
+    EXPECT_EQ(r.size(), 4);
+    EXPECT_EQ(r[0], 6);
+    EXPECT_EQ(r[3], 9);
+    EXPECT_EQ(r.at(1), 7);
+    EXPECT_THROW(static_cast<void>(r.at(4)), std::out_of_range);
+    EXPECT_EQ(std::vector<int>(r.begin(), r.end()), (std::vector<int>{6, 7, 8, 9}));
+
+    r.pop_front();
+    r.pop_back();
+    EXPECT_EQ(std::vector<int>(r.begin(), r.end()), (std::vector<int>{7, 8}));
+    r.assign_back(10);
+    EXPECT_EQ(r.back(), 10);
+
+    r.clear();
+    EXPECT_TRUE(r.empty());
+}
+
+TEST(Ring_Buffer, iterators)
+{
+    sds::Ring_Buffer<int, 8> r;
+    for (int i = 0; i < 13; ++i) { r.push_back(i); }
+
+    EXPECT_EQ(r.end() - r.begin(), 8);
+    EXPECT_EQ(r.begin()[2], 7);
+    EXPECT_EQ(*(r.begin() + 7), 12);
+    EXPECT_TRUE(r.begin() < r.end());
+
+    sds::Ring_Buffer<int, 8>::const_iterator const c = r.begin();
+    EXPECT_EQ(*c, 5);
+
+    std::vector<int> rev;
+    for (auto it = r.rbegin(); it != r.rend(); ++it) { rev.push_back(*it); }
+    EXPECT_EQ(rev, (std::vector<int>{12, 11, 10, 9, 8, 7, 6, 5}));
+    EXPECT_EQ(r.rend() - r.rbegin(), 8);
+
+    for (int& v : r) { v *= 2; }
+    EXPECT_EQ(r.front(), 10);
+    EXPECT_TRUE(std::is_sorted(r.begin(), r.end()));
+}
+
+TEST(Ring_Buffer, segments)
+{
+    sds::Ring_Buffer<int, 8> r;
+    auto s = r.segments();
+    EXPECT_TRUE(s.first.empty());
+    EXPECT_TRUE(s.second.empty());
+
+    for (int i = 0; i < 5; ++i) { r.push_back(i); }
+    s = r.segments();
+    EXPECT_EQ(s.first.size, 5);
+    EXPECT_TRUE(s.second.empty());
+
+    // Wrapped: oldest run at the back of the storage, the rest at the front
+    for (int i = 5; i < 11; ++i) { r.push_back(i); }
+    auto const& cr = r;
+    auto const cs = cr.segments();
+    EXPECT_EQ(cs.first.size, 5);
+    EXPECT_EQ(cs.second.size, 3);
+    EXPECT_EQ(cs.first.data[0], 3);
+    EXPECT_EQ(cs.second.data[0], 8);
+
+    int out[8] = {};
+    int* const last = r.copy_to(out);
+    EXPECT_EQ(last, out + 8);
+    EXPECT_TRUE(std::equal(r.begin(), r.end(), out));
+}
+
+TEST(Ring_Buffer, matches_deque)
+{
+    sds::Ring_Buffer<std::string, 16> r;
+    std::deque<std::string> d;
+    for (int i = 0; i < 1000; ++i) {
+        std::string const s = std::to_string(i);
+        if (i % 7 == 3 && !d.empty()) {
+            r.pop_front();
+            d.pop_front();
+        } else {
+            r.push_back(s);
+            d.push_back(s);
+            if (d.size() > 16) { d.pop_front(); }
+        }
+        ASSERT_EQ(static_cast<size_t>(r.size()), d.size());
+        ASSERT_TRUE(std::equal(r.begin(), r.end(), d.begin()));
+    }
+
+    sds::Ring_Buffer<std::string, 16> copy(r);
+    EXPECT_EQ(copy, r);
+    copy.push_back("x");
+    EXPECT_NE(copy, r);
+    copy = r;
+    EXPECT_EQ(copy, r);
+}
@@ -0,0 +1,130 @@
+#include "gtest/gtest.h"
+
+#include "sds/array/soa_array.h"
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using Particles = sds::Soa_Array<float, double, sds::u32>;
+
+TEST(Soa_Array, rows)
+{
+    Particles p;
+    EXPECT_TRUE(p.empty());
+    EXPECT_EQ(p.begin(), p.end());
+
+    for (sds::u32 i = 0; i < 100; ++i) { p.push_back(float(i), double(i) * 2, i); }
+    EXPECT_EQ(p.size(), 100u);
+    EXPECT_GE(p.capacity(), 100u);
+
+    auto [x, y, id] = p[10];
+    EXPECT_EQ(x, 10.0f);
+    EXPECT_EQ(y, 20.0);
+    EXPECT_EQ(id, 10u);
+
+    // Row proxies refer to the columns
+    x = -1.0f;
+    std::get<2>(p[11]) = 99;
+    EXPECT_EQ(p.column<0>()[10], -1.0f);
+    EXPECT_EQ(p.column<sds::u32>()[11], 99u);
+    EXPECT_THROW(static_cast<void>(p.at(100)), std::out_of_range);
+
+    p.push_back(std::make_tuple(1.5f, 2.5, sds::u32{7}));
+    EXPECT_EQ(p.at(100), (std::make_tuple(1.5f, 2.5, sds::u32{7})));
+
+    sds::u32 count = 0;
+    for (auto [px, py, pid] : p) {
+        px += 1.0f;
+        static_cast<void>(py);
+        static_cast<void>(pid);
+        ++count;
+    }
+    EXPECT_EQ(count, 101u);
+    EXPECT_EQ(std::get<0>(p[0]), 1.0f);
+
+    Particles const& cp = p;
+    Particles::const_iterator it = p.begin();
+    EXPECT_EQ(std::get<1>(*(it + 3)), 6.0);
+    EXPECT_EQ(cp.end() - cp.begin(), 101);
+}
+
+TEST(Soa_Array, columns)
+{
+    Particles p;
+    for (sds::u32 i = 0; i < 1000; ++i) { p.push_back(float(i), 0.0, i); }
+
+    // Columns are separate, aligned arrays
+    auto const xs = p.column<float>();
+    auto const ids = p.column<2>();
+    EXPECT_EQ(xs.size(), 1000u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(xs.data()) % Particles::column_alignment, 0u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ids.data()) % Particles::column_alignment, 0u);
+    EXPECT_EQ(std::accumulate(ids.begin(), ids.end(), sds::u64{0}), 999u * 1000u / 2);
+
+    for (double& y : p.column<1>()) { y = 3.0; }
+    EXPECT_EQ(std::get<1>(p[500]), 3.0);
+}
+
+TEST(Soa_Array, bulk)
+{
+    Particles p;
+    std::vector<float> xs = {0, 1, 2, 3, 4, 5};
+    std::vector<double> ys = {0, 10, 20, 30, 40, 50};
+    std::vector<sds::u32> ids = {0, 1, 2, 3, 4, 5};
+    p.append(xs.size(), xs.data(), ys.data(), ids.data());
+    p.append(2, xs.data(), ys.data(), ids.data());
+    EXPECT_EQ(p.size(), 8u);
+    EXPECT_EQ(std::get<1>(p[7]), 10.0);
+
+    p.erase(1, 3);
+    EXPECT_EQ(p.size(), 6u);
+    EXPECT_EQ(p.column<2>()[1], 3u);
+    EXPECT_EQ(p.column<1>()[1], 30.0);
+
+    p.erase(0);
+    EXPECT_EQ(p.column<2>()[0], 3u);
+
+    // Last row moves into the hole
+    p.swap_remove(0);
+    EXPECT_EQ(p.size(), 4u);
+    EXPECT_EQ(p.column<2>()[0], 1u);
+    EXPECT_EQ(p.column<0>()[0], 1.0f);
+
+    p.pop_back();
+    EXPECT_EQ(p.size(), 3u);
+    p.resize(10);
+    EXPECT_EQ(p.size(), 10u);
+    EXPECT_EQ(p.column<1>().size(), 10u);
+    EXPECT_EQ(std::get<2>(p[9]), 0u);
+
+    Particles copy = p;
+    EXPECT_EQ(copy, p);
+    copy.swap_remove(0);
+    EXPECT_NE(copy, p);
+
+    p.clear();
+    EXPECT_TRUE(p.empty());
+    EXPECT_TRUE(p.column<0>().empty());
+}
+
+TEST(Soa_Array, non_trivial_fields)
+{
+    sds::Soa_Array<std::string, int> s;
+    for (int i = 0; i < 50; ++i) { s.push_back("name_" + std::to_string(i), i); }
+    s.erase(0, 10);
+    s.swap_remove(0);
+    EXPECT_EQ(std::get<0>(s[0]), "name_49");
+    EXPECT_EQ(std::get<1>(s[1]), 11);
+    EXPECT_EQ(s.size(), 39u);
+}
+
+TEST(Type_Traits, type_list)
+{
+    EXPECT_TRUE((sds::contains_v<int, char, int>));
+    EXPECT_FALSE((sds::contains_v<int, char, float>));
+    EXPECT_EQ((sds::type_count_v<int, int, char, int>), 2u);
+    EXPECT_EQ((sds::type_index_v<float, int, float, float>), 1u);
+    EXPECT_EQ((sds::type_index_v<double, int, float>), 2u);
+    EXPECT_TRUE((std::is_same_v<sds::type_at_t<1, int, float>, float>));
+}
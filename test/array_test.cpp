@@ -5,3 +5,13 @@
 using namespace sds;
 
 TEST(Array_Test, constructor) { Array<int, 10> arr; }
+
+TEST(Array_Test, reverse_iterator)
+{
+    Array<int, 3> arr = {{1, 2, 3}};
+    EXPECT_EQ(*arr.rbegin(), 3);
+    EXPECT_EQ(arr.rend() - arr.rbegin(), 3);
+
+    int expected = 3;
+    for (auto it = arr.crbegin(); it != arr.crend(); ++it) { EXPECT_EQ(*it, expected--); }
+}
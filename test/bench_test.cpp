@@ -0,0 +1,194 @@
+#include "gtest/gtest.h"
+
+#include "sds/bench.h"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+
+namespace
+{
+std::vector<double> normal_samples(double mean, double stddev, size_t n, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> dist(mean, stddev);
+    std::vector<double> v(n);
+    for (double& x : v) { x = dist(rng); }
+    return v;
+}
+
+sds::Bench_Result make_result(char const* name, std::vector<double> samples)
+{
+    sds::Bench_Result r;
+    r.name = name;
+    r.iterations = 1;
+    r.samples = std::move(samples);
+    r.stats = sds::bench_stats(r.samples.data(), r.samples.size());
+    return r;
+}
+
+sds::Bench_Config fast_config(sds::Bench_Clock clock)
+{
+    sds::Bench_Config c;
+    c.clock = clock;
+    c.warmup_ms = 1.0;
+    c.min_sample_ms = 0.1;
+    c.sample_count = 7;
+    return c;
+}
+} // namespace
+
+TEST(Bench_Test, stats)
+{
+    std::vector<double> v = {9, 1, 5, 3, 7, 100};
+    sds::Bench_Stats const s = sds::bench_stats(v.data(), v.size());
+
+    EXPECT_EQ(v.front(), 1);
+    EXPECT_EQ(v.back(), 100);
+    EXPECT_DOUBLE_EQ(s.median, 6.0);
+    EXPECT_DOUBLE_EQ(s.min, 1.0);
+    EXPECT_DOUBLE_EQ(s.max, 100.0);
+    EXPECT_DOUBLE_EQ(s.mean, 125.0 / 6.0);
+    // Deviations from 6: 5 3 1 1 3 94
+    EXPECT_DOUBLE_EQ(s.mad, 3.0);
+    EXPECT_DOUBLE_EQ(s.p10, 2.0);
+
+    EXPECT_DOUBLE_EQ(sds::percentile(v.data(), v.size(), 0.0), 1.0);
+    EXPECT_DOUBLE_EQ(sds::percentile(v.data(), v.size(), 1.0), 100.0);
+    EXPECT_DOUBLE_EQ(sds::percentile(v.data(), 1, 0.5), 1.0);
+}
+
+TEST(Bench_Test, run)
+{
+    for (sds::Bench_Clock clock : {sds::Bench_Clock::steady, sds::Bench_Clock::tsc}) {
+        std::vector<int> v(256, 1);
+        sds::Bench_Result const r = sds::run_bench(
+            "sum",
+            [&] {
+                int s = 0;
+                for (int x : v) { s += x; }
+                sds::do_not_optimize(s);
+            },
+            fast_config(clock));
+
+        EXPECT_EQ(r.name, "sum");
+        EXPECT_EQ(r.samples.size(), 7U);
+        EXPECT_GE(r.iterations, 1U);
+        EXPECT_TRUE(std::is_sorted(r.samples.begin(), r.samples.end()));
+        EXPECT_GT(r.stats.median, 0.0);
+        EXPECT_LE(r.stats.min, r.stats.median);
+        EXPECT_GE(r.stats.max, r.stats.median);
+    }
+}
+
+TEST(Bench_Test, perf_counters)
+{
+    sds::Bench_Config config = fast_config(sds::Bench_Clock::steady);
+    config.perf_counters = true;
+    std::vector<int> v(4096, 1);
+    sds::Bench_Result const r = sds::run_bench(
+        "sum",
+        [&] {
+            int s = 0;
+            for (int x : v) { s += x; }
+            sds::do_not_optimize(s);
+        },
+        config);
+
+    // Counters that can't be opened here are left out rather than failing the run
+    EXPECT_EQ(r.counters.valid & ~sds::Perf_Counters().available(), 0U);
+    if (r.counters.has(sds::Perf_Counter::instructions)) {
+        EXPECT_GT(r.counters[sds::Perf_Counter::instructions], 4096.0);
+    }
+
+    config.perf_counters = false;
+    EXPECT_EQ(sds::run_bench("nop", [] {}, config).counters.valid, 0U);
+}
+
+TEST(Bench_Test, compare)
+{
+    sds::Bench_Result const base = make_result("a", normal_samples(100, 2, 31, 1));
+    sds::Bench_Result const same = make_result("a", normal_samples(100, 2, 31, 2));
+    sds::Bench_Result const slow = make_result("a", normal_samples(120, 2, 31, 3));
+    sds::Bench_Result const fast = make_result("a", normal_samples(80, 2, 31, 4));
+    sds::Bench_Result const tiny = make_result("a", normal_samples(101, 0.1, 31, 5));
+
+    sds::Bench_Comparison c = sds::compare(base, same);
+    EXPECT_EQ(c.verdict, sds::Bench_Verdict::unchanged);
+    EXPECT_GT(c.p_value, 0.001);
+
+    c = sds::compare(base, slow);
+    EXPECT_EQ(c.verdict, sds::Bench_Verdict::regressed);
+    EXPECT_NEAR(c.ratio, 1.2, 0.03);
+    EXPECT_LT(c.p_value, 1e-6);
+
+    c = sds::compare(base, fast);
+    EXPECT_EQ(c.verdict, sds::Bench_Verdict::improved);
+    EXPECT_NEAR(c.ratio, 0.8, 0.03);
+
+    // Significant but below the minimum effect
+    c = sds::compare(make_result("a", normal_samples(100, 0.1, 31, 6)), tiny);
+    EXPECT_LT(c.p_value, 0.001);
+    EXPECT_EQ(c.verdict, sds::Bench_Verdict::unchanged);
+
+    EXPECT_EQ(sds::compare(sds::Bench_Result{}, base).verdict, sds::Bench_Verdict::missing);
+}
+
+TEST(Bench_Test, results_save_load)
+{
+    sds::Bench_Results results;
+    results.add(make_result("first", {3.5, 1.25, 2.0}));
+    results.add(make_result("second bench", {10.0}));
+    results.add(make_result("first", {1.0, 2.0, 3.0}));
+    EXPECT_EQ(results.size(), 2U);
+    ASSERT_NE(results.find("first"), nullptr);
+    EXPECT_DOUBLE_EQ(results.find("first")->stats.median, 2.0);
+    EXPECT_EQ(results.find("third"), nullptr);
+
+    std::string const path = testing::TempDir() + "sds_bench_test_results.txt";
+    ASSERT_TRUE(results.save(path.c_str()));
+
+    sds::Bench_Results loaded;
+    ASSERT_TRUE(loaded.load(path.c_str()));
+    ASSERT_EQ(loaded.size(), 2U);
+    for (sds::Bench_Result const& r : results) {
+        sds::Bench_Result const* l = loaded.find(r.name);
+        ASSERT_NE(l, nullptr);
+        EXPECT_EQ(l->iterations, r.iterations);
+        EXPECT_EQ(l->samples, r.samples);
+        EXPECT_DOUBLE_EQ(l->stats.median, r.stats.median);
+    }
+
+    // Malformed files leave the contents alone
+    std::FILE* f = std::fopen(path.c_str(), "w");
+    ASSERT_NE(f, nullptr);
+    std::fputs("sds-bench-results 1\nbroken\t1\tx\n", f);
+    std::fclose(f);
+    EXPECT_FALSE(loaded.load(path.c_str()));
+    EXPECT_EQ(loaded.size(), 2U);
+    EXPECT_FALSE(loaded.load((path + ".missing").c_str()));
+    std::remove(path.c_str());
+}
+
+TEST(Bench_Test, report)
+{
+    sds::Bench_Results baseline;
+    baseline.add(make_result("a", normal_samples(100, 2, 31, 1)));
+    baseline.add(make_result("b", normal_samples(100, 2, 31, 2)));
+
+    sds::Bench_Results current;
+    current.add(make_result("a", normal_samples(130, 2, 31, 3)));
+    current.add(make_result("b", normal_samples(100, 2, 31, 4)));
+    current.add(make_result("c", normal_samples(100, 2, 31, 5)));
+
+    std::FILE* out = std::tmpfile();
+    ASSERT_NE(out, nullptr);
+    EXPECT_EQ(sds::print_report(out, current, &baseline), 1);
+    EXPECT_EQ(sds::print_report(out, current), 0);
+
+    std::rewind(out);
+    std::string text;
+    for (int c = std::fgetc(out); c != EOF; c = std::fgetc(out)) { text += static_cast<char>(c); }
+    std::fclose(out);
+    EXPECT_NE(text.find("REGRESSED"), std::string::npos);
+    EXPECT_NE(text.find("new"), std::string::npos);
+}
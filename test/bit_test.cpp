@@ -2,6 +2,8 @@
 
 #include "sds/bit.h"
 #include "sds/experimental/const.h"
+#include <random>
+#include <vector>
 
 TEST(BitTest, align_up) {
 #define BIT_ALIGN_UP_EQ(Bits, Type, Val) \
@@ -51,3 +53,128 @@ TEST(BitTest, bit_size) {
     EXPECT_EQ(sds::bit_size<int32_t>(), 32);
     EXPECT_EQ(sds::bit_size<int64_t>(), 64);
 }
+
+TEST(BitTest, bit_count) {
+    static_assert(sds::bit_count(0xF0F0U) == 8);
+    static_assert(sds::bit_count(~uint64_t{0}) == 64);
+
+    EXPECT_EQ(sds::bit_count(0U), 0);
+    EXPECT_EQ(sds::bit_count(1U), 1);
+    EXPECT_EQ(sds::bit_count(0x80000001U), 2);
+    EXPECT_EQ(sds::bit_count(~0U), 32);
+    EXPECT_EQ(sds::bit_count(uint64_t{0}), 0);
+    EXPECT_EQ(sds::bit_count(uint64_t{0x8000000000000001}), 2);
+    EXPECT_EQ(sds::bit_count(~uint64_t{0}), 64);
+}
+
+TEST(BitTest, count_leading_zeros) {
+    static_assert(sds::count_leading_zeros(1U) == 31);
+    static_assert(sds::count_leading_zeros(uint64_t{1}) == 63);
+
+    EXPECT_EQ(sds::count_leading_zeros(0U), 32);
+    EXPECT_EQ(sds::count_leading_zeros(1U), 31);
+    EXPECT_EQ(sds::count_leading_zeros(0x00010000U), 15);
+    EXPECT_EQ(sds::count_leading_zeros(~0U), 0);
+    EXPECT_EQ(sds::count_leading_zeros(uint64_t{0}), 64);
+    EXPECT_EQ(sds::count_leading_zeros(uint64_t{1} << 40), 23);
+    EXPECT_EQ(sds::count_leading_zeros(~uint64_t{0}), 0);
+}
+
+TEST(BitTest, count_trailing_zeros) {
+    static_assert(sds::count_trailing_zeros(0x80000000U) == 31);
+    static_assert(sds::count_trailing_zeros(uint64_t{1} << 63) == 63);
+
+    EXPECT_EQ(sds::count_trailing_zeros(0U), 32);
+    EXPECT_EQ(sds::count_trailing_zeros(1U), 0);
+    EXPECT_EQ(sds::count_trailing_zeros(0x00010000U), 16);
+    EXPECT_EQ(sds::count_trailing_zeros(uint64_t{0}), 64);
+    EXPECT_EQ(sds::count_trailing_zeros(uint64_t{1} << 40), 40);
+}
+
+TEST(BitTest, rotate) {
+    static_assert(sds::rotl(0x80000001U, 1) == 0x00000003U);
+    static_assert(sds::rotr(uint64_t{1}, 1) == uint64_t{1} << 63);
+
+    EXPECT_EQ(sds::rotl(0x12345678U, 0), 0x12345678U);
+    EXPECT_EQ(sds::rotl(0x12345678U, 8), 0x34567812U);
+    EXPECT_EQ(sds::rotl(0x12345678U, 32), 0x12345678U);
+    EXPECT_EQ(sds::rotl(0x12345678U, -8), 0x78123456U);
+    EXPECT_EQ(sds::rotr(0x12345678U, 8), 0x78123456U);
+    EXPECT_EQ(sds::rotr(0x12345678U, -8), 0x34567812U);
+    EXPECT_EQ(sds::rotl(uint64_t{0x0123456789ABCDEF}, 16), uint64_t{0x456789ABCDEF0123});
+    EXPECT_EQ(sds::rotr(uint64_t{0x0123456789ABCDEF}, 16), uint64_t{0xCDEF0123456789AB});
+}
+
+TEST(BitTest, byte_swap) {
+    static_assert(sds::byte_swap(uint16_t{0x1234}) == 0x3412);
+    static_assert(sds::byte_swap(0x12345678U) == 0x78563412U);
+
+    EXPECT_EQ(sds::byte_swap(uint16_t{0x1234}), 0x3412);
+    EXPECT_EQ(sds::byte_swap(0x12345678U), 0x78563412U);
+    EXPECT_EQ(sds::byte_swap(uint64_t{0x0123456789ABCDEF}), uint64_t{0xEFCDAB8967452301});
+}
+
+TEST(BitTest, pow2) {
+    static_assert(sds::log2(1024U) == 10);
+    static_assert(sds::bit_ceil(5U) == 8U);
+    static_assert(sds::bit_floor(uint64_t{5}) == 4U);
+
+    EXPECT_EQ(sds::log2(1U), 0);
+    EXPECT_EQ(sds::log2(3U), 1);
+    EXPECT_EQ(sds::log2(~0U), 31);
+    EXPECT_EQ(sds::log2(~uint64_t{0}), 63);
+
+    EXPECT_EQ(sds::bit_floor(0U), 0U);
+    EXPECT_EQ(sds::bit_floor(1U), 1U);
+    EXPECT_EQ(sds::bit_floor(17U), 16U);
+    EXPECT_EQ(sds::bit_floor(~uint64_t{0}), uint64_t{1} << 63);
+
+    EXPECT_EQ(sds::bit_ceil(0U), 1U);
+    EXPECT_EQ(sds::bit_ceil(1U), 1U);
+    EXPECT_EQ(sds::bit_ceil(16U), 16U);
+    EXPECT_EQ(sds::bit_ceil(17U), 32U);
+    EXPECT_EQ(sds::bit_ceil((uint64_t{1} << 40) + 1), uint64_t{1} << 41);
+
+    EXPECT_TRUE(sds::is_pow2(1));
+    EXPECT_TRUE(sds::is_pow2(64));
+    EXPECT_FALSE(sds::is_pow2(0));
+    EXPECT_FALSE(sds::is_pow2(12));
+}
+
+TEST(BitTest, pdep_pext) {
+    static_assert(sds::pdep(0b101U, 0b11010U) == 0b10010U);
+    static_assert(sds::pext(0b10110U, 0b11010U) == 0b101U);
+
+    EXPECT_EQ(sds::pdep(0b101U, 0b11010U), 0b10010U);
+    EXPECT_EQ(sds::pext(0b10110U, 0b11010U), 0b101U);
+    EXPECT_EQ(sds::pdep(~0U, 0xF0F0F0F0U), 0xF0F0F0F0U);
+    EXPECT_EQ(sds::pext(0xFFFF0000U, 0xFFFF0000U), 0xFFFFU);
+    EXPECT_EQ(sds::pdep(uint64_t{0xFF}, uint64_t{0xFF} << 56), uint64_t{0xFF} << 56);
+    EXPECT_EQ(sds::pext(uint64_t{0xAB} << 56, uint64_t{0xFF} << 56), uint64_t{0xAB});
+
+    // Round trip
+    uint64_t const mask = 0x00FF00F00F0F0FF0;
+    uint64_t const src = 0x0123456789ABCDEF;
+    EXPECT_EQ(sds::pext(sds::pdep(src, mask), mask),
+              src & ((uint64_t{1} << sds::bit_count(mask)) - 1));
+}
+
+TEST(BitTest, bit_count_range) {
+    EXPECT_EQ(sds::bit_count(static_cast<uint64_t const*>(nullptr), 0), 0);
+
+    std::mt19937_64 rng(42);
+    std::vector<uint64_t> words(4096 + 7);
+    for (uint64_t& w : words) { w = rng(); }
+
+    // Cover the vector block, single vector and scalar tail paths, plus unaligned starts
+    for (int offset : {0, 1, 3}) {
+        for (int n : {0, 1, 3, 4, 7, 8, 16, 63, 64, 65, 127, 128, 129, 1000, 4096}) {
+            int64_t expected = 0;
+            for (int i = 0; i < n; ++i) { expected += sds::bit_count(words[offset + i]); }
+            EXPECT_EQ(sds::bit_count(words.data() + offset, n), expected) << n << " " << offset;
+        }
+    }
+
+    std::vector<uint32_t> half_words(1001, ~0U);
+    EXPECT_EQ(sds::bit_count(half_words.data(), static_cast<int>(half_words.size())), 1001 * 32);
+}
@@ -32,3 +32,47 @@ TEST(BitarrayTest, Bitarray)
     EXPECT_FALSE(a.any());
     EXPECT_TRUE(a.none());
 }
+
+TEST(BitarrayTest, first_unset)
+{
+    sds::Bitarray<40> a;
+    EXPECT_EQ(a.first_unset(), 0);
+
+    a.set(0);
+    a.set(1);
+    EXPECT_EQ(a.first_unset(), 2);
+
+    for (int i = 0; i < 33; ++i) { a.set(i); }
+    EXPECT_EQ(a.first_unset(), 33);
+    EXPECT_EQ(a.count(), 33);
+
+    a.set_all();
+    EXPECT_FALSE(a.first_unset().has_value());
+    EXPECT_EQ(a.count(), 40);
+}
+
+TEST(BitarrayTest, count_large)
+{
+    sds::Bitarray<5000> a;
+    EXPECT_EQ(a.count(), 0);
+
+    for (int i = 0; i < 5000; i += 3) { a.set(i); }
+    EXPECT_EQ(a.count(), 1667);
+
+    a.set_all();
+    EXPECT_EQ(a.count(), 5000);
+}
+
+TEST(BitarrayTest, to_string)
+{
+    sds::Bitarray<40> a;
+    a.set(0);
+    a.set(2);
+    a.set(39);
+
+    sds::String const s = a.to_string();
+    ASSERT_EQ(s.size(), 40u);
+    EXPECT_EQ(s.substr(0, 4), "1010");
+    EXPECT_EQ(s[39], '1');
+    EXPECT_EQ(s.substr(3, 36), sds::String(36, '0'));
+}
@@ -0,0 +1,101 @@
+#include "gtest/gtest.h"
+
+#include "sds/array/dynamic_array.h"
+#include "sds/cache_aligned.h"
+#include "sds/lockless.h"
+#include <atomic>
+#include <string>
+#include <thread>
+
+namespace
+{
+constexpr size_t line = sds::hardware_destructive_interference_size;
+
+/* Whether [a, a + a_size) and [b, b + b_size) touch a common cache line. */
+bool share_line(void const* a, size_t a_size, void const* b, size_t b_size)
+{
+    uintptr_t const a_first = reinterpret_cast<uintptr_t>(a) / line;
+    uintptr_t const a_last = (reinterpret_cast<uintptr_t>(a) + a_size - 1) / line;
+    uintptr_t const b_first = reinterpret_cast<uintptr_t>(b) / line;
+    uintptr_t const b_last = (reinterpret_cast<uintptr_t>(b) + b_size - 1) / line;
+    return a_first <= b_last && b_first <= a_last;
+}
+} // namespace
+
+TEST(Cache_Aligned_Test, layout)
+{
+    SDS_STATIC_ASSERT(alignof(sds::Cache_Aligned<char>) == line);
+    SDS_STATIC_ASSERT(sizeof(sds::Cache_Aligned<char>) == line);
+    SDS_STATIC_ASSERT(sizeof(sds::Cache_Aligned<char[line + 1]>) == 2 * line);
+    SDS_STATIC_ASSERT(alignof(sds::Padded<sds::u64>) == alignof(sds::u64));
+    SDS_STATIC_ASSERT(alignof(sds::Cache_Aligned_Lock<sds::Spin_Lock>) == line);
+    SDS_STATIC_ASSERT(sizeof(sds::Cache_Aligned_Lock<sds::Spin_Lock>) == line);
+
+    sds::Cache_Aligned<std::atomic<sds::u64>> counters[4];
+    for (auto& c : counters) {
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(&c.value) % line, 0U);
+        EXPECT_EQ(c->load(), 0U);
+    }
+    EXPECT_FALSE(share_line(&counters[0].value, sizeof(sds::u64), &counters[1].value,
+                            sizeof(sds::u64)));
+
+    // Padding keeps neighbours apart even in storage that is only aligned for the value
+    alignas(8) char storage[3 * sizeof(sds::Padded<sds::u64>)];
+    for (size_t offset : {size_t{0}, size_t{8}, size_t{40}}) {
+        auto* const p = new (storage + offset) sds::Padded<sds::u64>;
+        EXPECT_FALSE(share_line(&p->value, sizeof(sds::u64), storage, offset));
+        EXPECT_FALSE(share_line(&p->value, sizeof(sds::u64), p + 1, 1));
+        p->~Padded();
+    }
+}
+
+TEST(Cache_Aligned_Test, access)
+{
+    sds::Cache_Aligned<std::string> a(std::in_place, 3, 'x');
+    EXPECT_EQ(*a, "xxx");
+    a->push_back('y');
+    EXPECT_EQ(a.value, "xxxy");
+
+    sds::Padded<std::string> const p(std::in_place, "padded");
+    EXPECT_EQ(p->size(), 6U);
+    EXPECT_EQ(*p, "padded");
+
+    sds::Cache_Aligned_Lock<sds::Spin_Lock> lock;
+    {
+        sds::Scoped_Lock<sds::Spin_Lock> guard(lock);
+        EXPECT_TRUE(lock.try_aquire());
+    }
+    EXPECT_FALSE(lock.try_aquire());
+    lock.release();
+}
+
+TEST(Cache_Aligned_Test, dynamic_array)
+{
+    // Over-aligned elements with the default allocator
+    sds::Dynamic_Array<sds::Cache_Aligned<int>> v;
+    for (int i = 0; i < 100; ++i) { v.emplace_back(std::in_place, i); }
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(&v[i]) % line, 0U);
+        EXPECT_EQ(*v[i], i);
+    }
+
+    // Aligned buffer of plain elements, across reallocations
+    sds::Aligned_Dynamic_Array<float> f;
+    for (int i = 0; i < 1000; ++i) {
+        f.push_back(static_cast<float>(i));
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(f.data()) % line, 0U);
+    }
+    sds::Aligned_Dynamic_Array<float, 256> const g(f.begin(), f.end());
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(g.data()) % 256, 0U);
+    EXPECT_EQ(g[999], 999.0f);
+}
+
+TEST(Cache_Aligned_Test, thread_index)
+{
+    sds::u32 const mine = sds::thread_index();
+    EXPECT_EQ(sds::thread_index(), mine);
+
+    sds::u32 other = mine;
+    std::thread([&other] { other = sds::thread_index(); }).join();
+    EXPECT_NE(other, mine);
+}
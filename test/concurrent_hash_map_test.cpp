@@ -0,0 +1,136 @@
+#include "gtest/gtest.h"
+
+#include "sds/concurrent_hash_map.h"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+template <typename Lock>
+class Concurrent_Hash_Map_Test : public ::testing::Test {
+public:
+    using map_type = sds::Concurrent_Hash_Map<sds::u64, sds::u64, sds::Hash<sds::u64>,
+                                              std::equal_to<sds::u64>, Lock>;
+};
+
+using Lock_Types = ::testing::Types<sds::Spin_Lock, sds::Readers_Writer_Spin_Lock>;
+TYPED_TEST_SUITE(Concurrent_Hash_Map_Test, Lock_Types);
+
+TYPED_TEST(Concurrent_Hash_Map_Test, basics)
+{
+    typename TestFixture::map_type m;
+    EXPECT_TRUE(m.empty());
+    EXPECT_EQ(m.shard_count(), 64u);
+    EXPECT_FALSE(m.find(1).has_value());
+
+    EXPECT_TRUE(m.insert_or_assign(1, 10));
+    EXPECT_FALSE(m.insert_or_assign(1, 11));
+    EXPECT_TRUE(m.try_emplace(2, 20));
+    EXPECT_FALSE(m.try_emplace(2, 21));
+    EXPECT_EQ(m.size(), 2u);
+    EXPECT_EQ(m.find(1), 11u);
+    EXPECT_EQ(m.find(2), 20u);
+    EXPECT_TRUE(m.contains(2));
+
+    sds::u64 seen = 0;
+    EXPECT_TRUE(m.visit(1, [&seen](sds::u64 const& v) { seen = v; }));
+    EXPECT_EQ(seen, 11u);
+    EXPECT_FALSE(m.visit(3, [&seen](sds::u64 const& v) { seen = v; }));
+
+    EXPECT_TRUE(m.update(2, [](sds::u64& v) { ++v; }));
+    EXPECT_EQ(m.find(2), 21u);
+
+    int calls = 0;
+    EXPECT_EQ(m.compute_if_absent(3, [&calls] { ++calls; return sds::u64(30); }), 30u);
+    EXPECT_EQ(m.compute_if_absent(3, [&calls] { ++calls; return sds::u64(31); }), 30u);
+    EXPECT_EQ(calls, 1);
+
+    EXPECT_EQ(m.erase(1), 1u);
+    EXPECT_EQ(m.erase(1), 0u);
+    EXPECT_FALSE(m.contains(1));
+
+    sds::u64 sum = 0;
+    m.for_each([&sum](auto const& kv) { sum += kv.first; });
+    EXPECT_EQ(sum, 5u);
+
+    m.clear();
+    EXPECT_EQ(m.size(), 0u);
+
+    typename TestFixture::map_type one(1);
+    EXPECT_EQ(one.shard_count(), 1u);
+    one.reserve(100);
+    for (sds::u64 i = 0; i < 100; ++i) { one.insert_or_assign(i, i); }
+    EXPECT_EQ(one.size(), 100u);
+    EXPECT_EQ(typename TestFixture::map_type(5).shard_count(), 8u);
+}
+
+TYPED_TEST(Concurrent_Hash_Map_Test, concurrent)
+{
+    constexpr int num_threads = 8;
+    constexpr sds::u64 num_keys = 20000;
+    typename TestFixture::map_type m;
+    std::atomic<int> computed{0};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&m, &computed, t] {
+            // Every thread computes the same keys in a different order
+            for (sds::u64 i = 0; i < num_keys; ++i) {
+                sds::u64 const k = (i * 7919 + static_cast<sds::u64>(t) * 131) % num_keys;
+                sds::u64 const v = m.compute_if_absent(k, [&computed, k] {
+                    computed.fetch_add(1, std::memory_order_relaxed);
+                    return k * 2;
+                });
+                ASSERT_EQ(v, k * 2);
+            }
+            // Disjoint writes and erases
+            for (sds::u64 i = 0; i < 1000; ++i) {
+                sds::u64 const k = num_keys + static_cast<sds::u64>(t) * 1000 + i;
+                m.insert_or_assign(k, i);
+                if (i % 2 == 0) { m.erase(k); }
+            }
+        });
+    }
+    for (std::thread& th : threads) { th.join(); }
+
+    EXPECT_EQ(computed.load(), static_cast<int>(num_keys));
+    EXPECT_EQ(m.size(), num_keys + num_threads * 500);
+    for (sds::u64 k = 0; k < num_keys; ++k) { ASSERT_EQ(m.find(k), k * 2); }
+}
+
+TEST(Concurrent_Hash_Map, string_keys)
+{
+    sds::Concurrent_Hash_Map<std::string, int, std::hash<std::string>> m(4);
+    EXPECT_TRUE(m.insert_or_assign(std::string("alpha"), 1));
+    EXPECT_TRUE(m.insert_or_assign("beta", 2));
+    EXPECT_EQ(m.find("alpha"), 1);
+    EXPECT_EQ(m.compute_if_absent("gamma", [] { return 3; }), 3);
+    EXPECT_EQ(m.size(), 3u);
+}
+
+TEST(Readers_Writer_Spin_Lock, exclusion)
+{
+    sds::Readers_Writer_Spin_Lock lock;
+    int value = 0;
+    std::atomic<bool> torn{false};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 10000; ++i) {
+                {
+                    sds::Scoped_Lock<sds::Readers_Writer_Spin_Lock> guard(lock);
+                    ++value;
+                }
+                sds::Scoped_Shared_Lock<sds::Readers_Writer_Spin_Lock> guard(lock);
+                int const a = value;
+                int const b = value;
+                if (a != b) { torn = true; }
+            }
+        });
+    }
+    for (std::thread& th : threads) { th.join(); }
+
+    EXPECT_EQ(value, 40000);
+    EXPECT_FALSE(torn.load());
+}
@@ -0,0 +1,64 @@
+#include "gtest/gtest.h"
+
+#include "sds/cpu.h"
+
+namespace
+{
+int add_scalar(int a, int b) { return a + b; }
+int add_fast(int a, int b) { return a + b + 1000; }
+
+int g_resolve_count = 0;
+
+sds::Cpu_Dispatch<int(int, int)> const add_dispatch([](sds::Cpu_Features const& f) {
+    ++g_resolve_count;
+    return f.has(sds::Cpu_Feature::sse2) ? &add_fast : &add_scalar;
+});
+} // namespace
+
+TEST(Cpu_Test, features)
+{
+    sds::Cpu_Features f;
+    EXPECT_EQ(f.bits(), 0U);
+    EXPECT_FALSE(f.has(sds::Cpu_Feature::avx2));
+
+    f.set(sds::Cpu_Feature::avx2);
+    EXPECT_TRUE(f.has(sds::Cpu_Feature::avx2));
+    EXPECT_FALSE(f.has(sds::Cpu_Feature::avx));
+
+    f.set(sds::Cpu_Feature::avx2, false);
+    EXPECT_FALSE(f.has(sds::Cpu_Feature::avx2));
+}
+
+TEST(Cpu_Test, detect)
+{
+    sds::Cpu_Features const& f = sds::cpu_features();
+    EXPECT_EQ(&f, &sds::cpu_features());
+    EXPECT_EQ(f.bits(), sds::Cpu_Features::detect().bits());
+
+#if SDS_ARCH_AMD64
+    // SSE2 is part of the x86-64 baseline
+    EXPECT_TRUE(f.has(sds::Cpu_Feature::sse2));
+#endif
+
+    // Extensions imply the ones they build on
+    if (f.has(sds::Cpu_Feature::avx2)) { EXPECT_TRUE(f.has(sds::Cpu_Feature::avx)); }
+    if (f.has(sds::Cpu_Feature::avx512bw)) { EXPECT_TRUE(f.has(sds::Cpu_Feature::avx512f)); }
+    if (f.has(sds::Cpu_Feature::avx512f)) { EXPECT_TRUE(f.has(sds::Cpu_Feature::avx)); }
+}
+
+TEST(Cpu_Test, to_string)
+{
+    EXPECT_STREQ(sds::to_string(sds::Cpu_Feature::avx2), "avx2");
+    EXPECT_STREQ(sds::to_string(sds::Cpu_Feature::sse42), "sse4.2");
+    EXPECT_STREQ(sds::to_string(sds::Cpu_Feature::count), "unknown");
+}
+
+TEST(Cpu_Test, dispatch)
+{
+    int const expected = sds::cpu_has(sds::Cpu_Feature::sse2) ? 1003 : 3;
+
+    EXPECT_EQ(add_dispatch(1, 2), expected);
+    EXPECT_EQ(add_dispatch(1, 2), expected);
+    EXPECT_EQ(g_resolve_count, 1);
+    EXPECT_EQ(add_dispatch.get(), add_dispatch.get());
+}
@@ -0,0 +1,146 @@
+#include "gtest/gtest.h"
+
+#include "sds/flat_hash_map.h"
+#include "sds/string.h"
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+TEST(Flat_Hash_Map, basics)
+{
+    sds::Flat_Hash_Map<int, int> m;
+    EXPECT_TRUE(m.empty());
+    EXPECT_EQ(m.capacity(), 0u);
+    EXPECT_EQ(m.find(1), m.end());
+    EXPECT_EQ(m.begin(), m.end());
+    EXPECT_EQ(m.erase(1), 0u);
+
+    auto const [it, inserted] = m.insert({1, 10});
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(it->first, 1);
+    EXPECT_EQ(it->second, 10);
+    EXPECT_FALSE(m.insert({1, 20}).second);
+    EXPECT_EQ(m.at(1), 10);
+
+    m[2] = 20;
+    EXPECT_EQ(m.size(), 2u);
+    EXPECT_TRUE(m.contains(2));
+    EXPECT_EQ(m.count(3), 0u);
+    EXPECT_THROW(static_cast<void>(m.at(3)), std::out_of_range);
+
+    EXPECT_FALSE(m.insert_or_assign(2, 25).second);
+    EXPECT_EQ(m[2], 25);
+    EXPECT_TRUE(m.try_emplace(3, 30).second);
+    EXPECT_FALSE(m.try_emplace(3, 35).second);
+    EXPECT_TRUE(m.emplace(4, 40).second);
+    EXPECT_EQ(m[3], 30);
+
+    int sum = 0;
+    for (auto const& [k, v] : m) { sum += k * v; }
+    EXPECT_EQ(sum, 10 + 2 * 25 + 3 * 30 + 4 * 40);
+
+    EXPECT_EQ(m.erase(2), 1u);
+    EXPECT_FALSE(m.contains(2));
+    EXPECT_EQ(m.size(), 3u);
+
+    m.clear();
+    EXPECT_TRUE(m.empty());
+    EXPECT_NE(m.capacity(), 0u);
+    EXPECT_EQ(m.begin(), m.end());
+}
+
+TEST(Flat_Hash_Map, matches_unordered_map)
+{
+    // Random inserts and erases over a small key range, so tombstones and rehashes are exercised
+    sds::Flat_Hash_Map<sds::u32, sds::u32> m;
+    std::unordered_map<sds::u32, sds::u32> ref;
+    std::mt19937 rng(3);
+
+    for (int i = 0; i < 200000; ++i) {
+        sds::u32 const key = static_cast<sds::u32>(rng() % 5000);
+        switch (rng() % 4) {
+        case 0:
+        case 1:
+            EXPECT_EQ(m.insert_or_assign(key, i).second, ref.insert_or_assign(key, i).second);
+            break;
+        case 2: EXPECT_EQ(m.erase(key), ref.erase(key)); break;
+        default: {
+            auto const it = m.find(key);
+            auto const ref_it = ref.find(key);
+            ASSERT_EQ(it == m.end(), ref_it == ref.end());
+            if (it != m.end()) { EXPECT_EQ(it->second, ref_it->second); }
+            break;
+        }
+        }
+        ASSERT_EQ(m.size(), ref.size());
+    }
+
+    size_t n = 0;
+    for (auto const& [k, v] : m) {
+        EXPECT_EQ(ref.at(k), v);
+        ++n;
+    }
+    EXPECT_EQ(n, ref.size());
+    EXPECT_LE(m.load_factor(), 0.875f);
+}
+
+TEST(Flat_Hash_Map, erase_iterator)
+{
+    sds::Flat_Hash_Map<int, int> m;
+    for (int i = 0; i < 1000; ++i) { m[i] = i; }
+
+    // Erase the odd keys while iterating
+    for (auto it = m.begin(); it != m.end();) {
+        if (it->first % 2 != 0) {
+            it = m.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    EXPECT_EQ(m.size(), 500u);
+    for (int i = 0; i < 1000; ++i) { EXPECT_EQ(m.contains(i), i % 2 == 0) << i; }
+}
+
+TEST(Flat_Hash_Map, string_keys)
+{
+    sds::Flat_Hash_Map<sds::String, sds::String> m;
+    for (int i = 0; i < 2000; ++i) {
+        std::string const key = "a_fairly_long_key_that_lives_on_the_heap_" + std::to_string(i);
+        m.try_emplace(sds::String(key.c_str()), sds::String(std::to_string(i).c_str()));
+    }
+    EXPECT_EQ(m.size(), 2000u);
+    EXPECT_EQ(m.at(sds::String("a_fairly_long_key_that_lives_on_the_heap_1234")), "1234");
+
+    // Copies and moves keep every entry
+    sds::Flat_Hash_Map<sds::String, sds::String> copy(m);
+    EXPECT_EQ(copy, m);
+    sds::Flat_Hash_Map<sds::String, sds::String> moved(sds::move(copy));
+    EXPECT_EQ(moved, m);
+    EXPECT_TRUE(copy.empty());
+
+    moved.erase(sds::String("a_fairly_long_key_that_lives_on_the_heap_7"));
+    EXPECT_NE(moved, m);
+    copy = moved;
+    EXPECT_EQ(copy, moved);
+
+    copy.swap(m);
+    EXPECT_EQ(copy.size(), 2000u);
+    EXPECT_EQ(m.size(), 1999u);
+}
+
+TEST(Flat_Hash_Map, allocator)
+{
+    // All memory comes from the arena
+    alignas(64) static char buf[1 << 16];
+    std::pmr::monotonic_buffer_resource arena(buf, sizeof(buf), std::pmr::null_memory_resource());
+    using Alloc = std::pmr::polymorphic_allocator<std::pair<int const, int>>;
+    sds::Flat_Hash_Map<int, int, sds::Hash<int>, std::equal_to<int>, Alloc> m(Alloc{&arena});
+
+    m.reserve(1000);
+    size_t const cap = m.capacity();
+    for (int i = 0; i < 1000; ++i) { m[i] = i * 2; }
+    EXPECT_EQ(m.capacity(), cap);
+    EXPECT_EQ(m.at(999), 1998);
+    EXPECT_EQ(m.get_allocator().resource(), &arena);
+}
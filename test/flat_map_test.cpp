@@ -0,0 +1,148 @@
+#include "gtest/gtest.h"
+
+#include "sds/flat_map.h"
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+template <typename T>
+class Flat_Map_Search_Test : public testing::Test {};
+
+template <sds::Flat_Search search>
+struct Search_Param {
+    static constexpr sds::Flat_Search value = search;
+};
+
+using Search_Types = testing::Types<Search_Param<sds::Flat_Search::binary>,
+                                    Search_Param<sds::Flat_Search::eytzinger>>;
+TYPED_TEST_SUITE(Flat_Map_Search_Test, Search_Types);
+
+TYPED_TEST(Flat_Map_Search_Test, map)
+{
+    using Map = sds::Flat_Map<int, std::string, std::less<int>, TypeParam::value>;
+    Map m{{3, "c"}, {1, "a"}, {2, "b"}, {1, "dup"}};
+    EXPECT_EQ(m.size(), 3u);
+    EXPECT_EQ(m.begin()->first, 1);
+    EXPECT_EQ(m.at(1), "a"); // first of repeated keys wins
+
+    EXPECT_TRUE(m.insert({0, "zero"}).second);
+    EXPECT_FALSE(m.insert({0, "again"}).second);
+    m[5] = "e";
+    EXPECT_FALSE(m.insert_or_assign(5, "five").second);
+    EXPECT_EQ(m.at(5), "five");
+    EXPECT_THROW(static_cast<void>(m.at(4)), std::out_of_range);
+
+    std::vector<int> keys;
+    for (auto const& [k, v] : m) { keys.push_back(k); }
+    EXPECT_EQ(keys, (std::vector<int>{0, 1, 2, 3, 5}));
+
+    EXPECT_EQ(m.lower_bound(4)->first, 5);
+    EXPECT_EQ(m.upper_bound(3)->first, 5);
+    EXPECT_EQ(m.lower_bound(6), m.end());
+    EXPECT_EQ(m.find(4), m.end());
+    EXPECT_EQ(m.find(2)->second, "b");
+
+    EXPECT_EQ(m.erase(2), 1u);
+    EXPECT_EQ(m.erase(2), 0u);
+    auto it = m.erase(m.find(0));
+    EXPECT_EQ(it->first, 1);
+    EXPECT_FALSE(m.contains(2));
+    EXPECT_TRUE(m.contains(3));
+
+    m.clear();
+    EXPECT_TRUE(m.empty());
+    EXPECT_EQ(m.find(1), m.end());
+}
+
+TYPED_TEST(Flat_Map_Search_Test, insert_sorted_range)
+{
+    using Set = sds::Flat_Set<int, std::less<int>, TypeParam::value>;
+    Set s{10, 20, 30};
+
+    // Interleaved, overlapping and repeated keys
+    std::vector<int> const more{5, 10, 15, 15, 25, 30, 35};
+    s.insert_sorted_range(more.begin(), more.end());
+    EXPECT_EQ(std::vector<int>(s.begin(), s.end()),
+              (std::vector<int>{5, 10, 15, 20, 25, 30, 35}));
+
+    Set empty;
+    empty.insert_sorted_range(more.begin(), more.end());
+    EXPECT_EQ(empty.size(), 6u);
+    s.insert_sorted_range(more.end(), more.end());
+    EXPECT_EQ(s.size(), 7u);
+}
+
+TYPED_TEST(Flat_Map_Search_Test, matches_std_map)
+{
+    using Map = sds::Flat_Map<sds::u32, sds::u32, std::less<sds::u32>, TypeParam::value>;
+    Map m;
+    std::map<sds::u32, sds::u32> ref;
+    std::mt19937 rng(5);
+
+    for (int round = 0; round < 20; ++round) {
+        // Bulk unsorted insert, some single inserts and erases
+        std::vector<std::pair<sds::u32, sds::u32>> batch;
+        for (int i = 0; i < 200; ++i) {
+            sds::u32 const k = static_cast<sds::u32>(rng() % 3000);
+            batch.emplace_back(k, static_cast<sds::u32>(i));
+            ref.emplace(k, static_cast<sds::u32>(i));
+        }
+        m.insert(batch.begin(), batch.end());
+
+        for (int i = 0; i < 50; ++i) {
+            sds::u32 const k = static_cast<sds::u32>(rng() % 3000);
+            EXPECT_EQ(m.erase(k), ref.erase(k));
+            sds::u32 const j = static_cast<sds::u32>(rng() % 3000);
+            EXPECT_EQ(m.insert({j, j}).second, ref.insert({j, j}).second);
+        }
+        ASSERT_EQ(m.size(), ref.size());
+
+        for (sds::u32 k = 0; k <= 3000; k += 7) {
+            auto const it = m.lower_bound(k);
+            auto const ref_it = ref.lower_bound(k);
+            ASSERT_EQ(it == m.end(), ref_it == ref.end()) << k;
+            if (it != m.end()) {
+                EXPECT_EQ(it->first, ref_it->first);
+                EXPECT_EQ(it->second, ref_it->second);
+            }
+        }
+    }
+    EXPECT_TRUE(std::equal(m.begin(), m.end(), ref.begin(), ref.end(),
+                           [](auto const& a, auto const& b) {
+                               return a.first == b.first && a.second == b.second;
+                           }));
+}
+
+TEST(Flat_Map, branchless_lower_bound)
+{
+    // Every size and probe, including both ends
+    for (size_t n = 0; n < 40; ++n) {
+        std::vector<int> v(n);
+        for (size_t i = 0; i < n; ++i) { v[i] = static_cast<int>(2 * i); }
+        for (int key = -1; key <= static_cast<int>(2 * n); ++key) {
+            size_t const expected =
+                static_cast<size_t>(std::lower_bound(v.begin(), v.end(), key) - v.begin());
+            EXPECT_EQ(sds::details::branchless_lower_bound(v.data(), n, key,
+                                                           sds::details::Identity_Key(),
+                                                           std::less<int>()),
+                      expected);
+        }
+    }
+}
+
+TEST(Flat_Map, string_keys)
+{
+    sds::Flat_Map<std::string, int> m;
+    m["pear"] = 3;
+    m["apple"] = 1;
+    m["fig"] = 2;
+    EXPECT_EQ(m.begin()->first, "apple");
+    EXPECT_EQ(m.at("fig"), 2);
+
+    sds::Flat_Map<std::string, int> copy(m);
+    EXPECT_EQ(copy, m);
+    copy.erase("pear");
+    EXPECT_NE(copy, m);
+}
@@ -0,0 +1,105 @@
+#include "gtest/gtest.h"
+
+#include "sds/bit.h"
+#include "sds/hash.h"
+#include "sds/string.h"
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace
+{
+enum class Color : sds::u8 { red, green };
+
+constexpr sds::u64 hello_hash = sds::hash("hello");
+static_assert(hello_hash == "hello"_hash);
+static_assert(sds::hash("hello") != sds::hash("hellp"));
+static_assert(sds::hash(sds::u64{1}) != sds::hash(sds::u64{2}));
+static_assert(sds::hash(Color::green) == sds::hash(1));
+} // namespace
+
+TEST(Hash, compile_time_matches_runtime)
+{
+    std::string const hello("hello");
+    EXPECT_EQ(sds::hash(hello.c_str()), hello_hash);
+    EXPECT_EQ(sds::hash_bytes(hello.data(), hello.size()), hello_hash);
+    EXPECT_EQ(sds::hash(sds::String("hello")), hello_hash);
+
+    // Long enough for the multi-lane path
+    constexpr char long_literal[] =
+        "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef"
+        "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef"
+        "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef"
+        "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef"
+        "0123456789abcdef0123456789abcdef";
+    constexpr sds::u64 long_hash = sds::hash(long_literal);
+    EXPECT_EQ(sds::hash_bytes(long_literal, sizeof(long_literal) - 1), long_hash);
+}
+
+TEST(Hash, simd_matches_scalar)
+{
+    // Every length across the short/long boundary and several blocks, plus a few seeds
+    std::mt19937_64 rng(7);
+    std::vector<char> buf(5000);
+    for (char& c : buf) { c = static_cast<char>(rng()); }
+
+    for (size_t len = 0; len <= buf.size(); len += (len < 1100 ? 1 : 37)) {
+        for (sds::u64 seed : {sds::u64{0}, sds::u64{1}, ~sds::u64{0}}) {
+            ASSERT_EQ(sds::hash_bytes(buf.data(), len, seed),
+                      sds::details::hash_bytes_constexpr(buf.data(), len, seed))
+                << len << " " << seed;
+        }
+    }
+}
+
+TEST(Hash, distribution)
+{
+    // No collisions on similar keys, and every input byte matters
+    std::set<sds::u64> seen;
+    for (int i = 0; i < 100000; ++i) {
+        std::string const key = "key_" + std::to_string(i);
+        EXPECT_TRUE(seen.insert(sds::hash(key.c_str())).second) << key;
+    }
+
+    std::vector<char> buf(2048, 'x');
+    sds::u64 const base = sds::hash_bytes(buf.data(), buf.size());
+    for (size_t i = 0; i < buf.size(); i += 61) {
+        buf[i] = 'y';
+        EXPECT_NE(sds::hash_bytes(buf.data(), buf.size()), base) << i;
+        buf[i] = 'x';
+    }
+
+    EXPECT_NE(sds::hash_bytes("a", 1, 1), sds::hash_bytes("a", 1, 2));
+    EXPECT_NE(sds::hash_bytes("", 0), sds::hash_bytes("\0", 1));
+}
+
+TEST(Hash, avalanche)
+{
+    // Flipping one input bit flips about half of the output bits
+    std::mt19937_64 rng(11);
+    double total = 0;
+    int samples = 0;
+    for (int i = 0; i < 2000; ++i) {
+        sds::u64 const x = rng();
+        for (int bit = 0; bit < 64; bit += 7) {
+            sds::u64 const diff = sds::hash_u64(x) ^ sds::hash_u64(x ^ (sds::u64{1} << bit));
+            total += sds::bit_count(diff);
+            ++samples;
+        }
+    }
+    double const mean = total / samples;
+    EXPECT_GT(mean, 30.0);
+    EXPECT_LT(mean, 34.0);
+}
+
+TEST(Hash, functor)
+{
+    sds::Hash<int> const hash_int;
+    sds::Hash<sds::String_View> const hash_view;
+    EXPECT_EQ(hash_int(42), static_cast<size_t>(sds::hash(42)));
+    EXPECT_EQ(hash_view("abc"), static_cast<size_t>(sds::hash("abc")));
+
+    int x = 0;
+    EXPECT_EQ(sds::hash(&x), sds::hash(&x));
+}
@@ -0,0 +1,59 @@
+#include "gtest/gtest.h"
+
+#include "sds/perf_counters.h"
+#include <memory>
+#include <string>
+
+TEST(Perf_Counters_Test, names)
+{
+    EXPECT_EQ(std::string(sds::to_string(sds::Perf_Counter::cycles)), "cycles");
+    EXPECT_EQ(std::string(sds::to_string(sds::Perf_Counter::llc_loads)), "llc_loads");
+    EXPECT_EQ(std::string(sds::to_string(sds::Perf_Counter::count)), "unknown");
+}
+
+TEST(Perf_Counters_Test, values)
+{
+    sds::Perf_Counter_Values a;
+    a.values[0] = 10.0;
+    a.values[1] = 20.0;
+    a.valid = 0b11;
+    sds::Perf_Counter_Values b;
+    b.values[0] = 30.0;
+    b.values[1] = 40.0;
+    b.valid = 0b01;
+
+    a += b;
+    a /= 2.0;
+    EXPECT_TRUE(a.has(sds::Perf_Counter::cycles));
+    EXPECT_FALSE(a.has(sds::Perf_Counter::instructions));
+    EXPECT_DOUBLE_EQ(a[sds::Perf_Counter::cycles], 20.0);
+}
+
+TEST(Perf_Counters_Test, count)
+{
+    // Counters may all be unavailable, ex. in a VM without a PMU or outside Linux. Whatever is
+    // available must count.
+    sds::Perf_Counters counters;
+
+    counters.start();
+    constexpr size_t bytes = 16 * 1024 * 1024;
+    std::unique_ptr<char[]> memory(new char[bytes]);
+    for (size_t i = 0; i < bytes; i += 4096) { memory[i] = static_cast<char>(i); }
+    sds::Perf_Counter_Values const v = counters.stop();
+
+    EXPECT_EQ(v.valid & ~counters.available(), 0U);
+    if (v.has(sds::Perf_Counter::instructions)) {
+        EXPECT_GT(v[sds::Perf_Counter::instructions], static_cast<double>(bytes / 4096));
+    }
+    if (v.has(sds::Perf_Counter::cycles)) { EXPECT_GT(v[sds::Perf_Counter::cycles], 0.0); }
+    if (v.has(sds::Perf_Counter::page_faults)) {
+        EXPECT_GE(v[sds::Perf_Counter::page_faults], static_cast<double>(bytes / 4096 / 2));
+    }
+
+    // Restarting zeroes the counters
+    counters.start();
+    sds::Perf_Counter_Values const empty = counters.stop();
+    if (empty.has(sds::Perf_Counter::page_faults)) {
+        EXPECT_LT(empty[sds::Perf_Counter::page_faults], 10.0);
+    }
+}
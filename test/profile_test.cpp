@@ -0,0 +1,125 @@
+#define SDS_USE_PROFILER
+#include "gtest/gtest.h"
+
+#include "sds/profile.h"
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+std::string write_trace()
+{
+    std::FILE* out = std::tmpfile();
+    EXPECT_NE(out, nullptr);
+    sds::profile_write_chrome_trace(out);
+
+    std::rewind(out);
+    std::string text;
+    for (int c = std::fgetc(out); c != EOF; c = std::fgetc(out)) { text += static_cast<char>(c); }
+    std::fclose(out);
+    return text;
+}
+
+size_t count_of(std::string const& text, std::string const& what)
+{
+    size_t n = 0;
+    for (size_t i = text.find(what); i != std::string::npos; i = text.find(what, i + 1)) { ++n; }
+    return n;
+}
+
+void profiled_function() { SDS_PROFILE_FUNCTION(); }
+} // namespace
+
+TEST(Profile_Test, chrome_trace)
+{
+    write_trace(); // drain zones of earlier tests
+
+    {
+        SDS_PROFILE_SCOPE("outer");
+        for (int i = 0; i < 3; ++i) { SDS_PROFILE_SCOPE("inner \"quoted\""); }
+        profiled_function();
+    }
+
+    std::thread worker([] {
+        SDS_PROFILE_THREAD_NAME("worker");
+        SDS_PROFILE_SCOPE("on_worker");
+    });
+    worker.join();
+
+    std::string const trace = write_trace();
+    EXPECT_EQ(trace.find("{\"traceEvents\":["), 0U);
+    EXPECT_EQ(count_of(trace, "\"ph\":\"X\""), 6U);
+    EXPECT_EQ(count_of(trace, "\"name\":\"outer\""), 1U);
+    EXPECT_EQ(count_of(trace, "\"name\":\"inner \\\"quoted\\\"\""), 3U);
+    EXPECT_EQ(count_of(trace, "\"name\":\"profiled_function\""), 1U);
+    EXPECT_EQ(count_of(trace, "\"name\":\"on_worker\""), 1U);
+    EXPECT_NE(trace.find("\"args\":{\"name\":\"worker\"}"), std::string::npos);
+    EXPECT_NE(trace.find("\"dropped_zones\":"), std::string::npos);
+
+    // Zones are only written once
+    EXPECT_EQ(count_of(write_trace(), "\"ph\":\"X\""), 0U);
+}
+
+TEST(Profile_Test, overflow_drops_oldest)
+{
+    write_trace();
+    sds::u64 const dropped = sds::profile_dropped_count();
+
+    constexpr sds::u32 extra = 10;
+    for (sds::u32 i = 0; i < sds::profile_buffer_capacity + extra; ++i) {
+        SDS_PROFILE_SCOPE("zone");
+    }
+
+    std::FILE* out = std::tmpfile();
+    ASSERT_NE(out, nullptr);
+    EXPECT_EQ(sds::profile_write_chrome_trace(out), sds::profile_buffer_capacity);
+    std::fclose(out);
+    EXPECT_EQ(sds::profile_dropped_count() - dropped, extra);
+}
+
+TEST(Profile_Test, concurrent_write)
+{
+    write_trace();
+
+    constexpr int thread_count = 4;
+    constexpr int zones_per_thread = 100000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < zones_per_thread; ++i) { SDS_PROFILE_SCOPE("busy"); }
+        });
+    }
+
+    // Drain while the threads record. Every zone is written or dropped exactly once.
+    sds::u64 const dropped = sds::profile_dropped_count();
+    sds::u64 written = 0;
+    std::FILE* out = std::tmpfile();
+    ASSERT_NE(out, nullptr);
+    for (int i = 0; i < 20; ++i) { written += sds::profile_write_chrome_trace(out); }
+    for (std::thread& t : threads) { t.join(); }
+    written += sds::profile_write_chrome_trace(out);
+    std::fclose(out);
+
+    EXPECT_EQ(written + sds::profile_dropped_count() - dropped,
+              static_cast<sds::u64>(thread_count) * zones_per_thread);
+}
+
+TEST(Profile_Test, exited_threads)
+{
+    write_trace();
+
+    // Zones and names outlive their threads, whose buffers are reused
+    for (int i = 0; i < 20; ++i) {
+        std::thread([] {
+            SDS_PROFILE_THREAD_NAME("short_lived");
+            SDS_PROFILE_SCOPE("exited");
+        }).join();
+    }
+
+    std::string const trace = write_trace();
+    EXPECT_EQ(count_of(trace, "\"name\":\"exited\""), 20U);
+    EXPECT_EQ(count_of(trace, "\"args\":{\"name\":\"short_lived\"}"), 20U);
+    EXPECT_EQ(count_of(write_trace(), "\"ph\":\"X\""), 0U);
+}
@@ -0,0 +1,93 @@
+#include "gtest/gtest.h"
+
+#include "sds/allocator/region_allocator.h"
+#include "sds/array/dynamic_array.h"
+#include "sds/bitarray.h"
+#include <cstring>
+
+TEST(Region_Allocator_Test, allocate)
+{
+    constexpr size_t bytes = 8 * 1024 * 1024 + 100;
+    for (sds::Page_Size const pages :
+         {sds::Page_Size::normal, sds::Page_Size::transparent_huge, sds::Page_Size::huge}) {
+        SCOPED_TRACE(sds::to_string(pages));
+        sds::Region_Options options;
+        options.pages = pages;
+        sds::Region_Info info;
+        unsigned char* const p =
+            static_cast<unsigned char*>(sds::region_allocate(bytes, options, &info));
+        ASSERT_NE(p, nullptr);
+
+        // Huge pages may not be available here; what was granted never exceeds what was asked
+        EXPECT_LE(static_cast<sds::u32>(info.pages), static_cast<sds::u32>(pages));
+        EXPECT_FALSE(info.numa_bound);
+        size_t const alignment = pages == sds::Page_Size::normal ? 4096 : sds::huge_page_size;
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % alignment, 0U);
+
+        EXPECT_EQ(p[0], 0);
+        EXPECT_EQ(p[bytes / 2], 0);
+        EXPECT_EQ(p[bytes - 1], 0);
+        std::memset(p, 0xab, bytes);
+        EXPECT_EQ(p[bytes - 1], 0xab);
+        sds::region_deallocate(p, bytes, options);
+    }
+}
+
+TEST(Region_Allocator_Test, numa)
+{
+    EXPECT_GE(sds::numa_node_count(), 1);
+
+    constexpr size_t bytes = 4 * sds::huge_page_size;
+    sds::Region_Options options;
+    options.numa_node = 0;
+    char* const p = static_cast<char*>(sds::region_allocate(bytes, options));
+    std::memset(p, 1, bytes);
+    // -1 where the kernel has no NUMA support
+    sds::s32 const node = sds::numa_node_of(p);
+    EXPECT_TRUE(node == 0 || node == -1);
+    sds::region_deallocate(p, bytes, options);
+
+    // Nodes that don't exist are skipped, not an error
+    options.numa_node = 4000;
+    sds::Region_Info info;
+    void* const q = sds::region_allocate(bytes, options, &info);
+    EXPECT_FALSE(info.numa_bound);
+    sds::region_deallocate(q, bytes, options);
+}
+
+TEST(Region_Allocator_Test, allocator)
+{
+    sds::Region_Options options;
+    options.min_bytes = 64 * 1024;
+    sds::Region_Allocator<sds::u64> const a(options);
+    sds::Region_Allocator<char> const b(a);
+    EXPECT_EQ(b.options(), options);
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a, sds::Region_Allocator<sds::u64>());
+
+    // Large buffers are regions, small ones come from the heap
+    sds::Dynamic_Array<sds::u64, sds::Region_Allocator<sds::u64>> big(a);
+    big.resize(1 << 20, 7);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(big.data()) % sds::huge_page_size, 0U);
+    EXPECT_EQ(big[(1 << 20) - 1], 7U);
+
+    sds::Dynamic_Array<sds::u64, sds::Region_Allocator<sds::u64>> small(a);
+    for (sds::u64 i = 0; i < 100; ++i) { small.push_back(i); }
+    EXPECT_EQ(small[99], 99U);
+
+    auto const copy = big;
+    EXPECT_EQ(copy.get_allocator(), a);
+    EXPECT_EQ(copy[12345], 7U);
+}
+
+TEST(Region_Allocator_Test, make_region_unique)
+{
+    sds::Region_Options options;
+    options.pages = sds::Page_Size::normal;
+    auto bits = sds::make_region_unique<sds::Bitarray<(1 << 24)>>(options);
+    EXPECT_TRUE(bits->none());
+    bits->set(12345678);
+    EXPECT_TRUE(bits->test(12345678));
+    EXPECT_EQ(bits->count(), 1);
+    EXPECT_EQ(bits.get_deleter().options, options);
+}
@@ -3,6 +3,7 @@
 #include "sds/s_list.h"
 
 #include "sds/array/carray.h"
+#include <memory_resource>
 #include <vector>
 
 TEST(S_List_Test, constructor)
@@ -573,3 +574,37 @@ TEST(S_List_Test, non_pod_element)
         EXPECT_EQ(*it1, *it2) << "on loop " << i;
     }
 }
+
+TEST(S_List_Test, allocator)
+{
+    using Alloc = std::pmr::polymorphic_allocator<int>;
+    std::pmr::monotonic_buffer_resource arena1;
+    std::pmr::monotonic_buffer_resource arena2;
+
+    sds::S_List<int, Alloc> l1{{1, 2, 3}, Alloc(&arena1)};
+    EXPECT_EQ(l1.get_allocator().resource(), &arena1);
+    l1.push_front(0);
+    l1.push_back(4);
+
+    // Copies don't propagate polymorphic allocators
+    sds::S_List<int, Alloc> l2(l1);
+    EXPECT_EQ(l2.get_allocator().resource(), std::pmr::get_default_resource());
+
+    // Moving between resources copies the elements
+    sds::S_List<int, Alloc> l3{Alloc(&arena2)};
+    l3 = std::move(l1);
+    EXPECT_EQ(l3.get_allocator().resource(), &arena2);
+    EXPECT_TRUE(l1.empty());
+    EXPECT_EQ(l3.size(), 5U);
+
+    sds::S_List<int, Alloc> l4(std::move(l3));
+    EXPECT_EQ(l4.get_allocator().resource(), &arena2);
+    EXPECT_TRUE(l3.empty());
+
+    int n = 0;
+    for (int v : l4) { EXPECT_EQ(v, n++); }
+    EXPECT_EQ(n, 5);
+    n = 0;
+    for (int v : l2) { EXPECT_EQ(v, n++); }
+    EXPECT_EQ(n, 5);
+}
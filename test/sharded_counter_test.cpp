@@ -0,0 +1,107 @@
+#include "gtest/gtest.h"
+
+#include "sds/sharded_counter.h"
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr int thread_count = 8;
+constexpr int per_thread = 10000;
+
+template <typename F>
+void run_threads(F f)
+{
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; ++t) { threads.emplace_back(f, t); }
+    for (std::thread& t : threads) { t.join(); }
+}
+} // namespace
+
+TEST(Sharded_Counter_Test, counter)
+{
+    for (sds::Shard_Policy const policy : {sds::Shard_Policy::thread, sds::Shard_Policy::cpu}) {
+        SCOPED_TRACE(sds::to_string(policy));
+        sds::Sharded_Counter c(policy);
+        EXPECT_EQ(c.policy(), policy);
+        EXPECT_EQ(c.value(), 0);
+
+        run_threads([&c](int) {
+            for (int i = 0; i < per_thread; ++i) { c.add(); }
+            c.add(5);
+            c.sub(5);
+        });
+        EXPECT_EQ(c.value(), thread_count * per_thread);
+
+        // Take returns the count since the last take
+        EXPECT_EQ(c.take(), thread_count * per_thread);
+        EXPECT_EQ(c.value(), 0);
+        c.sub(3);
+        EXPECT_EQ(c.take(), -3);
+        c.add(10);
+        c.reset();
+        EXPECT_EQ(c.value(), 0);
+    }
+}
+
+TEST(Sharded_Counter_Test, max)
+{
+    sds::Sharded_Max m;
+    EXPECT_EQ(m.value(), sds::Sharded_Max::empty);
+
+    run_threads([&m](int t) {
+        for (int i = 0; i < per_thread; ++i) { m.record(t * per_thread + i - 1000); }
+    });
+    EXPECT_EQ(m.value(), thread_count * per_thread - 1001);
+
+    EXPECT_EQ(m.take(), thread_count * per_thread - 1001);
+    EXPECT_EQ(m.value(), sds::Sharded_Max::empty);
+    m.record(-7);
+    EXPECT_EQ(m.value(), -7);
+}
+
+TEST(Sharded_Counter_Test, histogram)
+{
+    using sds::Histogram_Snapshot;
+    EXPECT_EQ(sds::Sharded_Histogram::bucket_of(0), 0);
+    EXPECT_EQ(sds::Sharded_Histogram::bucket_of(1), 1);
+    EXPECT_EQ(sds::Sharded_Histogram::bucket_of(7), 3);
+    EXPECT_EQ(sds::Sharded_Histogram::bucket_of(8), 4);
+    EXPECT_EQ(sds::Sharded_Histogram::bucket_of(~sds::u64{0}), 64);
+    for (sds::s32 i = 1; i < sds::histogram_buckets; ++i) {
+        EXPECT_EQ(sds::Sharded_Histogram::bucket_of(Histogram_Snapshot::bucket_min(i)), i);
+        EXPECT_EQ(sds::Sharded_Histogram::bucket_of(Histogram_Snapshot::bucket_max(i)), i);
+    }
+
+    sds::Sharded_Histogram h(sds::Shard_Policy::cpu);
+    EXPECT_EQ(h.snapshot().percentile(0.5), 0U);
+
+    // Values 1..100 from every thread
+    run_threads([&h](int) {
+        for (sds::u64 v = 1; v <= 100; ++v) { h.record(v); }
+    });
+    Histogram_Snapshot const s = h.snapshot();
+    EXPECT_EQ(s.count, thread_count * 100U);
+    EXPECT_EQ(s.sum, thread_count * 5050U);
+    EXPECT_DOUBLE_EQ(s.mean(), 50.5);
+    EXPECT_EQ(s.buckets[1], thread_count * 1U);  // 1
+    EXPECT_EQ(s.buckets[7], thread_count * 37U); // 64..100
+
+    // Upper bounds of the buckets holding the quantiles
+    EXPECT_EQ(s.percentile(0.0), 1U);
+    EXPECT_EQ(s.percentile(0.5), 63U);
+    EXPECT_EQ(s.percentile(0.99), 127U);
+    EXPECT_EQ(s.percentile(1.0), 127U);
+
+    // The rank rounds up: 9 of 10 values at or below 1 isn't 91%
+    sds::Sharded_Histogram small;
+    for (int i = 0; i < 9; ++i) { small.record(1); }
+    small.record(1000);
+    EXPECT_EQ(small.snapshot().percentile(0.9), 1U);
+    EXPECT_EQ(small.snapshot().percentile(0.91), 1023U);
+
+    Histogram_Snapshot const taken = h.take();
+    EXPECT_EQ(taken.count, s.count);
+    EXPECT_EQ(h.snapshot().count, 0U);
+    EXPECT_EQ(h.snapshot().sum, 0U);
+}
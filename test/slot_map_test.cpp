@@ -0,0 +1,111 @@
+#include "gtest/gtest.h"
+
+#include "sds/slot_map.h"
+#include <algorithm>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+TEST(Slot_Map, basics)
+{
+    sds::Slot_Map<std::string> m;
+    EXPECT_TRUE(m.empty());
+    EXPECT_FALSE(m.contains(sds::Slot_Handle()));
+    EXPECT_FALSE(sds::Slot_Handle().is_valid());
+
+    sds::Slot_Handle const a = m.insert("alpha");
+    sds::Slot_Handle const b = m.emplace(3, 'b');
+    EXPECT_TRUE(a.is_valid());
+    EXPECT_NE(a, b);
+    EXPECT_EQ(m.size(), 2u);
+    EXPECT_EQ(m[a], "alpha");
+    EXPECT_EQ(*m.find(b), "bbb");
+    EXPECT_EQ(m.at(b), "bbb");
+
+    EXPECT_TRUE(m.erase(a));
+    EXPECT_FALSE(m.erase(a));
+    EXPECT_FALSE(m.contains(a));
+    EXPECT_EQ(m.find(a), nullptr);
+    EXPECT_THROW(static_cast<void>(m.at(a)), std::out_of_range);
+    EXPECT_EQ(m[b], "bbb");
+
+    // The freed slot is reused with a new generation, so the old handle stays stale
+    sds::Slot_Handle const c = m.insert("gamma");
+    EXPECT_EQ(c.index(), a.index());
+    EXPECT_NE(c.generation(), a.generation());
+    EXPECT_FALSE(m.contains(a));
+    EXPECT_EQ(m[c], "gamma");
+    EXPECT_EQ(m.slot_count(), 2u);
+
+    // Handles from beyond the slot array are stale too
+    EXPECT_FALSE(m.contains(sds::Slot_Handle(100, 1)));
+
+    m.clear();
+    EXPECT_TRUE(m.empty());
+    EXPECT_FALSE(m.contains(b));
+    EXPECT_FALSE(m.contains(c));
+    sds::Slot_Handle const d = m.insert("delta");
+    EXPECT_EQ(m.size(), 1u);
+    EXPECT_EQ(m[d], "delta");
+}
+
+TEST(Slot_Map, dense_iteration)
+{
+    sds::Slot_Map<int> m;
+    std::vector<sds::Slot_Handle> handles;
+    for (int i = 0; i < 10; ++i) { handles.push_back(m.insert(i)); }
+    m.erase(handles[0]);
+    m.erase(handles[5]);
+
+    // Values stay packed and every dense position maps back to its handle
+    EXPECT_EQ(static_cast<size_t>(m.end() - m.begin()), m.size());
+    std::vector<int> values(m.begin(), m.end());
+    std::sort(values.begin(), values.end());
+    EXPECT_EQ(values, (std::vector<int>{1, 2, 3, 4, 6, 7, 8, 9}));
+    for (size_t i = 0; i < m.size(); ++i) { EXPECT_EQ(m[m.handle_at(i)], m.data()[i]); }
+
+    for (int& v : m) { v *= 10; }
+    EXPECT_EQ(m[handles[9]], 90);
+}
+
+TEST(Slot_Map, matches_unordered_map)
+{
+    sds::Slot_Map<sds::u64> m;
+    std::unordered_map<sds::u64, sds::u64> ref; // handle bits -> value
+    std::vector<sds::Slot_Handle> live;
+    std::vector<sds::Slot_Handle> dead;
+    std::mt19937_64 rng(3);
+
+    for (int step = 0; step < 20000; ++step) {
+        if (live.empty() || rng() % 3 != 0) {
+            sds::u64 const v = rng();
+            sds::Slot_Handle const h = m.insert(v);
+            ASSERT_TRUE(ref.emplace(h.bits(), v).second);
+            live.push_back(h);
+        } else {
+            size_t const i = rng() % live.size();
+            sds::Slot_Handle const h = live[i];
+            ASSERT_TRUE(m.erase(h));
+            ref.erase(h.bits());
+            live[i] = live.back();
+            live.pop_back();
+            dead.push_back(h);
+        }
+    }
+
+    ASSERT_EQ(m.size(), ref.size());
+    for (sds::Slot_Handle const h : live) { ASSERT_EQ(m[h], ref.at(h.bits())); }
+    for (sds::Slot_Handle const h : dead) { ASSERT_FALSE(m.contains(h)); }
+    EXPECT_LE(m.slot_count(), m.size() + dead.size());
+}
+
+TEST(Slot_Map, allocator)
+{
+    std::pmr::monotonic_buffer_resource arena;
+    sds::Slot_Map<int, std::pmr::polymorphic_allocator<int>> m{
+        std::pmr::polymorphic_allocator<int>(&arena)};
+    sds::Slot_Handle const h = m.insert(7);
+    EXPECT_EQ(m[h], 7);
+}
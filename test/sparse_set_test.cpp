@@ -0,0 +1,105 @@
+#include "gtest/gtest.h"
+
+#include "sds/sparse_set.h"
+#include <algorithm>
+#include <memory_resource>
+#include <random>
+#include <set>
+#include <vector>
+
+TEST(Sparse_Set, basics)
+{
+    sds::Sparse_Set<> s;
+    EXPECT_TRUE(s.empty());
+    EXPECT_FALSE(s.contains(0));
+    EXPECT_EQ(s.page_count(), 0u);
+
+    EXPECT_TRUE(s.insert(5));
+    EXPECT_FALSE(s.insert(5));
+    EXPECT_TRUE(s.insert(0));
+    EXPECT_TRUE(s.insert(4095));
+    EXPECT_EQ(s.size(), 3u);
+    EXPECT_EQ(s.page_count(), 1u);
+    EXPECT_TRUE(s.contains(5));
+    EXPECT_FALSE(s.contains(6));
+    EXPECT_EQ(s.index_of(0), 1u);
+    EXPECT_EQ(s.index_of(6), s.size());
+
+    // Only the pages that hold ids are allocated
+    EXPECT_TRUE(s.insert(3'000'000'000U));
+    EXPECT_EQ(s.page_count(), 2u);
+    EXPECT_TRUE(s.contains(3'000'000'000U));
+    EXPECT_FALSE(s.contains(3'000'000'001U));
+    EXPECT_FALSE(s.contains(2'999'999'999U));
+
+    EXPECT_TRUE(s.erase(5));
+    EXPECT_FALSE(s.erase(5));
+    EXPECT_FALSE(s.contains(5));
+    EXPECT_EQ(s.size(), 3u);
+
+    std::vector<sds::u32> members(s.begin(), s.end());
+    std::sort(members.begin(), members.end());
+    EXPECT_EQ(members, (std::vector<sds::u32>{0, 4095, 3'000'000'000U}));
+
+    s.clear();
+    EXPECT_TRUE(s.empty());
+    EXPECT_FALSE(s.contains(0));
+    EXPECT_EQ(s.page_count(), 2u);
+}
+
+TEST(Sparse_Set, matches_std_set)
+{
+    sds::Sparse_Set<sds::u32, 256> s;
+    std::set<sds::u32> ref;
+    std::mt19937 rng(5);
+    for (int step = 0; step < 20000; ++step) {
+        sds::u32 const id = static_cast<sds::u32>(rng() % 5000);
+        if (rng() % 3 == 0) {
+            ASSERT_EQ(s.erase(id), ref.erase(id) == 1);
+        } else {
+            ASSERT_EQ(s.insert(id), ref.insert(id).second);
+        }
+    }
+    ASSERT_EQ(s.size(), ref.size());
+    for (sds::u32 id = 0; id < 5000; ++id) { ASSERT_EQ(s.contains(id), ref.count(id) == 1); }
+    for (size_t i = 0; i < s.size(); ++i) { ASSERT_EQ(s.index_of(s.data()[i]), i); }
+
+    sds::Sparse_Set<sds::u32, 256> copy(s);
+    EXPECT_EQ(copy, s);
+    copy.erase(*copy.begin());
+    EXPECT_NE(copy, s);
+    copy = s;
+    EXPECT_EQ(copy, s);
+
+    sds::Sparse_Set<sds::u32, 256> moved(std::move(copy));
+    EXPECT_EQ(moved, s);
+    copy = std::move(moved);
+    EXPECT_EQ(copy, s);
+}
+
+TEST(Sparse_Set, intersection)
+{
+    sds::Sparse_Set<> a;
+    sds::Sparse_Set<> b;
+    for (sds::u32 i = 0; i < 1000; ++i) { a.insert(i * 2); }
+    for (sds::u32 i = 0; i < 100; ++i) { b.insert(i * 3); }
+
+    sds::Sparse_Set<> const ab = intersection(a, b);
+    sds::Sparse_Set<> const ba = intersection(b, a);
+    EXPECT_EQ(ab, ba);
+    EXPECT_EQ(ab.size(), 50u); // multiples of 6 below 300
+    for (sds::u32 const id : ab) { EXPECT_EQ(id % 6, 0u); }
+}
+
+TEST(Sparse_Set, allocator)
+{
+    std::pmr::monotonic_buffer_resource arena;
+    using Set = sds::Sparse_Set<sds::u32, 64, std::pmr::polymorphic_allocator<sds::u32>>;
+    Set s{std::pmr::polymorphic_allocator<sds::u32>(&arena)};
+    for (sds::u32 i = 0; i < 1000; i += 7) { s.insert(i); }
+
+    Set other;
+    other = std::move(s); // different resource: copies
+    EXPECT_TRUE(other.contains(700));
+    EXPECT_EQ(other.size(), 143u);
+}
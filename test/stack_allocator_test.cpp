@@ -0,0 +1,148 @@
+#include "gtest/gtest.h"
+
+#include "sds/allocator/stack_allocator.h"
+#include "sds/array/dynamic_array.h"
+#include "sds/s_list.h"
+#include <cstring>
+#include <thread>
+
+TEST(Stack_Allocator_Test, arena)
+{
+    sds::Stack_Arena arena(1024);
+    EXPECT_EQ(arena.used(), 0U);
+    EXPECT_EQ(arena.reserved(), 0U);
+
+    sds::Stack_Marker const start = arena.mark();
+    void* const a = arena.allocate(10, 1);
+    void* const b = arena.allocate(24, 64);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % 64, 0U);
+    EXPECT_GE(static_cast<char*>(b), static_cast<char*>(a) + 10);
+    EXPECT_GE(arena.used(), 34U);
+
+    // Only the top allocation is released individually
+    arena.deallocate(a, 10);
+    arena.deallocate(b, 24);
+    EXPECT_EQ(arena.allocate(24, 64), b);
+
+    // Rewinding hands out the same memory again
+    sds::Stack_Marker const m = arena.mark();
+    void* const c = arena.allocate(100);
+    arena.rewind(m);
+    EXPECT_EQ(arena.allocate(100), c);
+
+    arena.rewind(start);
+    EXPECT_EQ(arena.used(), 0U);
+    EXPECT_EQ(arena.allocate(10, 1), a);
+}
+
+TEST(Stack_Allocator_Test, grow)
+{
+    sds::Stack_Arena arena(1024);
+    sds::Stack_Marker const start = arena.mark();
+
+    // Spans several blocks, including one larger than the block size
+    for (int i = 0; i < 20; ++i) { std::memset(arena.allocate(200), i, 200); }
+    std::memset(arena.allocate(5000), 0, 5000);
+    size_t const reserved = arena.reserved();
+    EXPECT_GE(reserved, 20 * 200U + 5000U);
+
+    // Blocks are reused after a rewind
+    for (int round = 0; round < 10; ++round) {
+        arena.rewind(start);
+        for (int i = 0; i < 20; ++i) { std::memset(arena.allocate(200), i, 200); }
+        std::memset(arena.allocate(5000), 0, 5000);
+    }
+    EXPECT_EQ(arena.reserved(), reserved);
+
+    // Freeing the top allocation of an earlier block is left to the rewind
+    arena.rewind(start);
+    void* const first = arena.allocate(1000);
+    void* const second = arena.allocate(1000);
+    arena.deallocate(second, 1000);
+    arena.deallocate(first, 1000);
+    EXPECT_NE(arena.allocate(1000), first);
+    arena.rewind(start);
+    EXPECT_EQ(arena.allocate(1000), first);
+}
+
+TEST(Stack_Allocator_Test, scope)
+{
+    sds::Stack_Arena& arena = sds::thread_stack_arena();
+    size_t const used = arena.used();
+    {
+        sds::Stack_Scope const scope;
+        EXPECT_EQ(&scope.arena(), &arena);
+
+        sds::Dynamic_Array<int, sds::Stack_Allocator<int>> v;
+        v.reserve(1000);
+        for (int i = 0; i < 1000; ++i) { v.push_back(i); }
+        EXPECT_EQ(v[999], 999);
+        EXPECT_EQ(&v.get_allocator().arena(), &arena);
+
+        sds::S_List<double, sds::Stack_Allocator<double>> l;
+        for (int i = 0; i < 100; ++i) { l.push_back(i); }
+        EXPECT_EQ(l.size(), 100);
+        EXPECT_GT(arena.used(), used + 1000 * sizeof(int));
+
+        {
+            sds::Stack_Scope const nested;
+            void* const p = arena.allocate(64);
+            std::memset(p, 1, 64);
+        }
+    }
+    EXPECT_EQ(arena.used(), used);
+
+    // Each thread has its own arena
+    sds::Stack_Arena* other = nullptr;
+    std::thread([&other] { other = &sds::thread_stack_arena(); }).join();
+    EXPECT_NE(other, &arena);
+}
+
+TEST(Stack_Allocator_Test, allocator)
+{
+    sds::Stack_Arena arena;
+    sds::Stack_Allocator<int> const a(arena);
+    sds::Stack_Allocator<double> const b(a);
+    EXPECT_EQ(&b.arena(), &arena);
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a, sds::Stack_Allocator<int>());
+
+    sds::Dynamic_Array<double, sds::Stack_Allocator<double>> v(b);
+    v.resize(3, 1.5);
+    auto const copy = v;
+    EXPECT_EQ(copy.get_allocator(), b);
+}
+
+TEST(Stack_Allocator_Test, canaries)
+{
+    for (bool const canaries : {false, true}) {
+        sds::Stack_Arena arena(1024, canaries);
+        EXPECT_EQ(arena.canaries(), canaries);
+        sds::Stack_Marker const m = arena.mark();
+        unsigned char* const p = static_cast<unsigned char*>(arena.allocate(16));
+        std::memset(p, 0, 16);
+
+        // Only the top allocation is released individually, in either mode
+        void* const q = arena.allocate(32);
+        arena.deallocate(p, 16);
+        EXPECT_EQ(arena.allocate(8), static_cast<char*>(q) + 32 + (canaries ? 32 : 0));
+        arena.rewind(m);
+        EXPECT_EQ(arena.used(), 0U);
+
+        // Released memory is filled when canaries are on
+        for (int i = 0; i < 16; ++i) { EXPECT_EQ(p[i], canaries ? 0xdd : 0); }
+    }
+}
+
+TEST(Stack_Allocator_Test, canary_overrun)
+{
+    // Checked with canaries on, however the library was built
+    EXPECT_DEATH(
+        {
+            sds::Stack_Arena arena(1024, true);
+            sds::Stack_Marker const m = arena.mark();
+            std::memset(arena.allocate(16), 0, 17);
+            arena.rewind(m);
+        },
+        "written past its end");
+}
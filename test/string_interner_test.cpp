@@ -0,0 +1,89 @@
+#include "gtest/gtest.h"
+
+#include "sds/string_interner.h"
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(String_Interner, intern)
+{
+    sds::String_Interner pool;
+    EXPECT_EQ(pool.size(), 0u);
+    EXPECT_FALSE(pool.find("missing").is_valid());
+
+    sds::Interned_String const a = pool.intern("alpha");
+    sds::Interned_String const b = pool.intern("beta");
+    EXPECT_TRUE(a.is_valid());
+    EXPECT_NE(a, b);
+    EXPECT_EQ(pool.size(), 2u);
+
+    // Same contents from a different buffer give the same handle
+    std::string const copy("alpha");
+    EXPECT_EQ(pool.intern(sds::String_View(copy.data(), copy.size())), a);
+    EXPECT_EQ(pool.find("alpha"), a);
+    EXPECT_EQ(pool.size(), 2u);
+
+    EXPECT_EQ(pool.view(a), "alpha");
+    EXPECT_STREQ(pool.c_str(b), "beta");
+    EXPECT_EQ(pool.string_bytes(), 11u);
+
+    sds::Interned_String const empty = pool.intern("");
+    EXPECT_TRUE(empty.is_valid());
+    EXPECT_EQ(pool.intern(sds::String_View()), empty);
+    EXPECT_TRUE(pool.view(empty).empty());
+
+    // Not null-terminated input
+    sds::String_View const prefix("alphabet", 5);
+    EXPECT_EQ(pool.intern(prefix), a);
+}
+
+TEST(String_Interner, many)
+{
+    sds::String_Interner pool;
+    std::vector<sds::Interned_String> handles;
+    for (int i = 0; i < 5000; ++i) {
+        std::string const s = "identifier_" + std::to_string(i);
+        handles.push_back(pool.intern(sds::String_View(s.data(), s.size())));
+    }
+    EXPECT_EQ(pool.size(), 5000u);
+
+    // Views stay valid as the pool grows
+    for (int i = 0; i < 5000; ++i) {
+        std::string const s = "identifier_" + std::to_string(i);
+        sds::String_View const v(s.data(), s.size());
+        ASSERT_EQ(pool.view(handles[static_cast<size_t>(i)]), v);
+        ASSERT_EQ(pool.find(v), handles[static_cast<size_t>(i)]);
+    }
+}
+
+TEST(String_Interner, concurrent)
+{
+    sds::String_Interner pool;
+    constexpr int num_threads = 8;
+    constexpr int num_keys = 2000;
+
+    std::vector<std::vector<sds::Interned_String>> results(num_threads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&pool, &results, t] {
+            // Every thread interns the same keys in a different order
+            for (int i = 0; i < num_keys; ++i) {
+                int const k = (i * (2 * t + 1)) % num_keys;
+                std::string const s = "key" + std::to_string(k);
+                results[static_cast<size_t>(t)].push_back(
+                    pool.intern(sds::String_View(s.data(), s.size())));
+            }
+        });
+    }
+    for (std::thread& th : threads) { th.join(); }
+
+    EXPECT_EQ(pool.size(), static_cast<sds::u32>(num_keys));
+    for (int t = 0; t < num_threads; ++t) {
+        for (int i = 0; i < num_keys; ++i) {
+            int const k = (i * (2 * t + 1)) % num_keys;
+            std::string const s = "key" + std::to_string(k);
+            ASSERT_EQ(pool.view(results[static_cast<size_t>(t)][static_cast<size_t>(i)]),
+                      sds::String_View(s.data(), s.size()));
+        }
+    }
+}
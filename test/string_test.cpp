@@ -1,9 +1,214 @@
 #include "gtest/gtest.h"
 
 #include "sds/string.h"
+#include <memory_resource>
+#include <string>
+#include <vector>
 
 TEST(String, byte_size) {
     EXPECT_EQ(sds::byte_size("hello"), 6);
     EXPECT_EQ(sds::byte_size(""), 1);
     EXPECT_EQ(sds::byte_size("hello world"), 12);
 }
+
+TEST(String, str_size) {
+    EXPECT_EQ(sds::str_size(static_cast<char const*>(nullptr)), 0);
+    EXPECT_EQ(sds::str_size(""), 0);
+    EXPECT_EQ(sds::str_size("hello"), 5);
+    EXPECT_EQ(sds::str_size(L"hello"), 5);
+
+    // Every start alignment and length around the block sizes
+    std::vector<char> buf(256, 'x');
+    for (int start = 0; start < 64; ++start) {
+        for (int len : {0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100}) {
+            buf[start + len] = '\0';
+            EXPECT_EQ(sds::str_size(buf.data() + start), len) << start << " " << len;
+            buf[start + len] = 'x';
+        }
+    }
+}
+
+TEST(String, is_ascii) {
+    EXPECT_TRUE(sds::is_ascii('a'));
+    EXPECT_TRUE(sds::is_ascii('\0'));
+    EXPECT_TRUE(sds::is_ascii(127));
+    EXPECT_FALSE(sds::is_ascii(static_cast<char>(0x80)));
+    EXPECT_FALSE(sds::is_ascii(static_cast<char>(0xFF)));
+}
+
+TEST(String, ascii_cmp) {
+    EXPECT_TRUE(sds::ascii_cmp("hello", "hello"));
+    EXPECT_TRUE(sds::ascii_cmp("hello world", "hello"));
+    EXPECT_FALSE(sds::ascii_cmp("hell", "hello"));
+    EXPECT_FALSE(sds::ascii_cmp("hellO", "hello"));
+
+    EXPECT_TRUE(sds::ascii_cmp("hello", "help", 3));
+    EXPECT_FALSE(sds::ascii_cmp("hello", "help", 4));
+    EXPECT_FALSE(sds::ascii_cmp("he", "he", 3));
+
+    // Mismatch and terminator positions within and across blocks
+    std::string const a(100, 'k');
+    for (int len : {1, 15, 16, 17, 32, 33, 64, 99, 100}) {
+        std::string b = a;
+        EXPECT_TRUE(sds::ascii_cmp(a.c_str(), b.c_str(), len)) << len;
+
+        b[len - 1] = 'j';
+        EXPECT_FALSE(sds::ascii_cmp(a.c_str(), b.c_str(), len)) << len;
+
+        std::string const shorter = a.substr(0, len - 1);
+        EXPECT_FALSE(sds::ascii_cmp(a.c_str(), shorter.c_str(), len)) << len;
+        EXPECT_FALSE(sds::ascii_cmp(shorter.c_str(), a.c_str(), len)) << len;
+    }
+}
+
+TEST(String, sso)
+{
+    EXPECT_EQ(sizeof(sds::String), 3 * sizeof(void*));
+    EXPECT_EQ(sds::String::inline_capacity(), 3 * sizeof(void*) - 1);
+
+    sds::String empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_TRUE(empty.is_inline());
+    EXPECT_STREQ(empty.c_str(), "");
+
+    // Largest inline string: the size byte doubles as the null-terminator
+    std::string const full(sds::String::inline_capacity(), 'x');
+    sds::String s(full.c_str());
+    EXPECT_TRUE(s.is_inline());
+    EXPECT_EQ(s.size(), full.size());
+    EXPECT_STREQ(s.c_str(), full.c_str());
+
+    s.push_back('y');
+    EXPECT_FALSE(s.is_inline());
+    EXPECT_EQ(s.size(), full.size() + 1);
+    EXPECT_EQ(s, (full + "y").c_str());
+
+    s.pop_back();
+    s.shrink_to_fit();
+    EXPECT_TRUE(s.is_inline());
+    EXPECT_EQ(s, full.c_str());
+}
+
+TEST(String, growth)
+{
+    sds::String s;
+    std::string expected;
+    for (int i = 0; i < 1000; ++i) {
+        char const c = static_cast<char>('a' + i % 26);
+        s += c;
+        expected += c;
+        ASSERT_EQ(s.size(), expected.size());
+        ASSERT_EQ(s.c_str()[s.size()], '\0');
+    }
+    EXPECT_EQ(s, expected.c_str());
+    EXPECT_GE(s.capacity(), s.size());
+
+    // 1.5x growth
+    sds::String g(std::string(100, 'g').c_str());
+    g.shrink_to_fit();
+    EXPECT_EQ(g.capacity(), 100u);
+    g.push_back('h');
+    EXPECT_EQ(g.capacity(), 150u);
+
+    // Exact reserve
+    sds::String r;
+    r.reserve(64);
+    EXPECT_EQ(r.capacity(), 64u);
+    r.reserve(10);
+    EXPECT_EQ(r.capacity(), 64u);
+}
+
+TEST(String, modifiers)
+{
+    sds::String s("hello");
+    s.append(" world");
+    EXPECT_EQ(s, "hello world");
+    s += sds::String_View("!!", 1);
+    EXPECT_EQ(s, "hello world!");
+
+    s.resize(5);
+    EXPECT_EQ(s, "hello");
+    s.resize(8, '.');
+    EXPECT_EQ(s, "hello...");
+    s.append(2, '?');
+    EXPECT_EQ(s, "hello...??");
+
+    s.clear();
+    EXPECT_TRUE(s.empty());
+    EXPECT_STREQ(s.c_str(), "");
+
+    // Self-append across a reallocation
+    sds::String a(std::string(20, 'a').c_str());
+    a.append(a.data(), a.size());
+    EXPECT_EQ(a, std::string(40, 'a').c_str());
+    a.append(a);
+    EXPECT_EQ(a, std::string(80, 'a').c_str());
+
+    a = "short";
+    EXPECT_EQ(a, "short");
+    a.assign(a.substr(1, 3));
+    EXPECT_EQ(a, "hor");
+}
+
+TEST(String, copy_move_swap)
+{
+    sds::String const small("abc");
+    sds::String const large(std::string(50, 'z').c_str());
+
+    sds::String c1(small);
+    sds::String c2(large);
+    EXPECT_EQ(c1, small);
+    EXPECT_EQ(c2, large);
+    EXPECT_NE(c2.data(), large.data());
+
+    sds::String m(sds::move(c2));
+    EXPECT_EQ(m, large);
+    EXPECT_TRUE(c2.empty());
+    EXPECT_TRUE(c2.is_inline());
+
+    c1 = m;
+    EXPECT_EQ(c1, large);
+    c1 = small;
+    EXPECT_EQ(c1, small);
+    m = sds::move(c1);
+    EXPECT_EQ(m, small);
+
+    sds::String x("x");
+    sds::String y(large);
+    swap(x, y);
+    EXPECT_EQ(x, large);
+    EXPECT_EQ(y, "x");
+}
+
+TEST(String, substr_view)
+{
+    sds::String const s("the quick brown fox");
+    sds::String_View const v = s.substr(4, 5);
+    EXPECT_EQ(v, "quick");
+    EXPECT_EQ(v.data(), s.data() + 4); // no copy
+    EXPECT_EQ(s.substr(16), "fox");
+    EXPECT_EQ(s.substr(16, 100), "fox");
+    EXPECT_TRUE(s.substr(s.size()).empty());
+
+    EXPECT_LT(sds::String("abc"), sds::String("abd"));
+    EXPECT_LT(sds::String("ab"), "abc");
+    EXPECT_EQ(sds::String("abc").compare("abc"), 0);
+}
+
+TEST(String, allocator)
+{
+    // Arena allocation through a stateful allocator
+    std::byte buf[1024];
+    std::pmr::monotonic_buffer_resource arena(buf, sizeof(buf), std::pmr::null_memory_resource());
+    using Pmr_String = sds::Basic_String<std::pmr::polymorphic_allocator<char>>;
+
+    Pmr_String s(std::string(100, 'p').c_str(), &arena);
+    EXPECT_GE(reinterpret_cast<std::byte const*>(s.data()), buf);
+    EXPECT_LT(reinterpret_cast<std::byte const*>(s.data()), buf + sizeof(buf));
+    EXPECT_EQ(s.get_allocator().resource(), &arena);
+
+    Pmr_String t(s);
+    EXPECT_EQ(t, s);
+    t.append("tail");
+    EXPECT_EQ(t.size(), 104u);
+}
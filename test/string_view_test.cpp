@@ -0,0 +1,161 @@
+#include "gtest/gtest.h"
+
+#include "sds/string.h"
+#include "sds/string_view.h"
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+TEST(String_View, basics)
+{
+    constexpr sds::String_View empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.size(), 0u);
+
+    constexpr sds::String_View cv("hello");
+    static_assert(cv.size() == 5);
+    static_assert(cv[1] == 'e');
+
+    sds::String_View v("hello world");
+    EXPECT_EQ(v.size(), 11u);
+    EXPECT_EQ(v.front(), 'h');
+    EXPECT_EQ(v.back(), 'd');
+    EXPECT_EQ(v.substr(6), "world");
+    EXPECT_EQ(v.substr(0, 5), "hello");
+
+    v.remove_prefix(6);
+    EXPECT_EQ(v, "world");
+    v.remove_suffix(2);
+    EXPECT_EQ(v, "wor");
+
+    EXPECT_LT(sds::String_View("abc"), sds::String_View("abd"));
+    EXPECT_LT(sds::String_View("ab"), sds::String_View("abc"));
+    EXPECT_EQ(sds::String_View("abc").compare("abc"), 0);
+    EXPECT_EQ(std::string_view(sds::String_View("abc")), "abc");
+}
+
+TEST(String_View, starts_ends_with)
+{
+    constexpr sds::String_View v("key=value");
+    static_assert(v.starts_with("key"));
+    static_assert(v.ends_with("value"));
+
+    EXPECT_TRUE(v.starts_with('k'));
+    EXPECT_TRUE(v.ends_with('e'));
+    EXPECT_TRUE(v.starts_with(""));
+    EXPECT_FALSE(v.starts_with("value"));
+    EXPECT_FALSE(v.ends_with("key"));
+    EXPECT_FALSE(sds::String_View("k").starts_with("key"));
+    EXPECT_FALSE(sds::String_View().starts_with('k'));
+}
+
+TEST(String_View, find)
+{
+    constexpr sds::String_View v("the quick brown fox jumps over the lazy dog");
+    static_assert(v.find('q') == 4);
+    static_assert(v.find("the", 1) == 31);
+    static_assert(v.find_first_of("xyz") == 18);
+
+    EXPECT_EQ(v.find('q'), 4u);
+    EXPECT_EQ(v.find('t', 1), 31u);
+    EXPECT_EQ(v.find('!'), sds::String_View::npos);
+    EXPECT_EQ(v.find('t', v.size()), sds::String_View::npos);
+
+    EXPECT_EQ(v.find("the"), 0u);
+    EXPECT_EQ(v.find("the", 1), 31u);
+    EXPECT_EQ(v.find("dog"), v.size() - 3);
+    EXPECT_EQ(v.find("cat"), sds::String_View::npos);
+    EXPECT_EQ(v.find(""), 0u);
+    EXPECT_EQ(v.find("", v.size()), v.size());
+    EXPECT_EQ(v.find("", 5), 5u);
+    EXPECT_EQ(v.find("", v.size() + 1), sds::String_View::npos);
+
+    // An empty view has no data to point into
+    constexpr sds::String_View empty;
+    static_assert(empty.find("") == 0);
+    EXPECT_EQ(empty.find(""), 0u);
+    EXPECT_EQ(empty.find(sds::String_View()), 0u);
+    EXPECT_EQ(empty.find("a"), sds::String_View::npos);
+    EXPECT_TRUE(empty.contains(""));
+
+    EXPECT_EQ(v.find_first_of("xyz"), 18u);
+    EXPECT_EQ(v.find_first_of("!?"), sds::String_View::npos);
+    EXPECT_EQ(v.find_first_of(""), sds::String_View::npos);
+
+    EXPECT_TRUE(v.contains("lazy"));
+    EXPECT_FALSE(v.contains('!'));
+}
+
+TEST(String_View, find_matches_std)
+{
+    // Cover every block size, tail length and match position of the SIMD kernels
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> letter('a', 'h');
+    std::uniform_int_distribution<int> any_byte(0, 255);
+
+    for (size_t len = 0; len <= 300; ++len) {
+        std::string s(len, '\0');
+        for (char& c : s) { c = static_cast<char>(letter(rng)); }
+        // Some high bytes to exercise the upper half of the byte set tables
+        if (len > 4) { s[len / 2] = static_cast<char>(any_byte(rng) | 0x80); }
+
+        std::string_view const ref(s);
+        sds::String_View const v(s.data(), s.size());
+
+        for (char c : {'a', 'e', 'h', 'z'}) {
+            for (size_t pos : {size_t{0}, size_t{1}, len / 3}) {
+                ASSERT_EQ(v.find(c, pos), ref.find(c, pos)) << len << " " << c << " " << pos;
+            }
+        }
+
+        for (char const* set : {"xyz", "hz", "gh", "\x80\xff", "abcdefgh\xc0"}) {
+            ASSERT_EQ(v.find_first_of(set), ref.find_first_of(set)) << len << " " << set;
+        }
+        std::string const high_set = std::string(1, s.empty() ? 'x' : s[len / 2]) + "z";
+        ASSERT_EQ(v.find_first_of(high_set.c_str()), ref.find_first_of(high_set)) << len;
+
+        for (char const* needle : {"ab", "abc", "hhh", "zz", "abcdefghabcdefghabcdefghabcdefghx"}) {
+            ASSERT_EQ(v.find(needle), ref.find(needle)) << len << " " << needle;
+        }
+        if (len >= 8) {
+            std::string const tail(s.end() - 8, s.end());
+            ASSERT_EQ(v.find(tail.c_str()), ref.find(tail)) << len;
+        }
+    }
+}
+
+TEST(String_View, split)
+{
+    auto collect = [](sds::String_Split split) {
+        std::vector<std::string> out;
+        for (sds::String_View t : split) { out.emplace_back(t.data(), t.size()); }
+        return out;
+    };
+
+    using V = std::vector<std::string>;
+    EXPECT_EQ(collect(sds::String_View("a,b,c").split(',')), (V{"a", "b", "c"}));
+    EXPECT_EQ(collect(sds::String_View("a,,b,").split(',')), (V{"a", "", "b", ""}));
+    EXPECT_EQ(collect(sds::String_View("abc").split(',')), (V{"abc"}));
+    EXPECT_EQ(collect(sds::String_View("").split(',')), (V{""}));
+    EXPECT_EQ(collect(sds::String_View("a::b:c::").split("::")), (V{"a", "b:c", ""}));
+    EXPECT_EQ(collect(sds::String_View("k=v; x\ty").split_any_of("=; \t")),
+              (V{"k", "v", "", "x", "y"}));
+
+    // Tokens are views into the source
+    sds::String const line("alpha beta");
+    auto it = sds::String_View(line).split(' ').begin();
+    EXPECT_EQ(it->data(), line.data());
+    ++it;
+    EXPECT_EQ(it->data(), line.data() + 6);
+}
+
+TEST(String_View, ascii_eq)
+{
+    sds::String const s("content-length");
+    EXPECT_TRUE(sds::ascii_eq(s, "content-length"));
+    EXPECT_FALSE(sds::ascii_eq(s, "content"));
+    EXPECT_FALSE(sds::ascii_eq(s.substr(0, 7), "content-length"));
+    EXPECT_TRUE(sds::ascii_eq(s.substr(0, 7), "content"));
+    EXPECT_TRUE(sds::ascii_eq(sds::String_View(), ""));
+}
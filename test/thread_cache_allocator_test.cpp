@@ -0,0 +1,122 @@
+#include "gtest/gtest.h"
+
+#include "sds/allocator/thread_cache_allocator.h"
+#include "sds/array/dynamic_array.h"
+#include "sds/s_list.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+struct alignas(64) Over_Aligned {
+    char c = 0;
+};
+} // namespace
+
+TEST(Thread_Cache_Allocator_Test, allocate)
+{
+    std::vector<std::pair<void*, size_t>> blocks;
+    for (size_t bytes : {size_t{0}, size_t{1}, size_t{16}, size_t{17}, size_t{129}, size_t{1000},
+                         sds::thread_cache_max_size, sds::thread_cache_max_size + 1,
+                         size_t{1} << 20}) {
+        for (int i = 0; i < 100; ++i) {
+            void* const p = sds::thread_cache_allocate(bytes);
+            ASSERT_NE(p, nullptr);
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % alignof(std::max_align_t), 0U);
+            std::memset(p, 0xab, bytes);
+            blocks.emplace_back(p, bytes);
+        }
+    }
+
+    // Blocks don't overlap
+    std::vector<std::pair<char*, char*>> ranges;
+    for (auto const& [p, bytes] : blocks) {
+        ranges.emplace_back(static_cast<char*>(p), static_cast<char*>(p) + bytes);
+    }
+    std::sort(ranges.begin(), ranges.end());
+    for (size_t i = 1; i < ranges.size(); ++i) { EXPECT_LE(ranges[i - 1].second, ranges[i].first); }
+
+    for (auto const& [p, bytes] : blocks) { sds::thread_cache_deallocate(p, bytes); }
+    sds::thread_cache_deallocate(nullptr, 16);
+
+    // Freed blocks are reused
+    void* const p = sds::thread_cache_allocate(1000);
+    bool reused = false;
+    for (auto const& b : blocks) { reused |= b.first == p; }
+    EXPECT_TRUE(reused);
+    sds::thread_cache_deallocate(p, 1000);
+}
+
+TEST(Thread_Cache_Allocator_Test, containers)
+{
+    sds::Dynamic_Array<int, sds::Thread_Cache_Allocator<int>> v;
+    for (int i = 0; i < 10'000; ++i) { v.push_back(i); }
+    EXPECT_EQ(v[9'999], 9'999);
+    auto const copy = v;
+    EXPECT_EQ(copy, v);
+
+    sds::S_List<std::pair<int, double>, sds::Thread_Cache_Allocator<std::pair<int, double>>> l;
+    for (int i = 0; i < 1000; ++i) { l.push_back({i, 0.5}); }
+    int sum = 0;
+    for (auto const& e : l) { sum += e.first; }
+    EXPECT_EQ(sum, 999 * 1000 / 2);
+
+    sds::Dynamic_Array<Over_Aligned, sds::Thread_Cache_Allocator<Over_Aligned>> aligned(3);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(aligned.data()) % 64, 0U);
+}
+
+/* Blocks are passed between threads through shared slots, so most are freed by a thread other
+ * than the one that allocated them. */
+TEST(Thread_Cache_Allocator_Test, cross_thread_churn)
+{
+    constexpr int thread_count = 8;
+    constexpr int rounds = 20'000;
+    constexpr size_t slot_count = 256;
+
+    auto churn = [&] {
+        std::vector<std::atomic<void*>> slots(slot_count);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < thread_count; ++t) {
+            threads.emplace_back([&, t] {
+                std::mt19937 rng(static_cast<unsigned>(t));
+                for (int i = 0; i < rounds; ++i) {
+                    // Blocks carry their size, and a marker at the end to catch overlaps
+                    size_t const bytes = sizeof(size_t) + 1 + rng() % 2000;
+                    char* const p = static_cast<char*>(sds::thread_cache_allocate(bytes));
+                    std::memcpy(p, &bytes, sizeof(bytes));
+                    p[bytes - 1] = static_cast<char>(bytes);
+
+                    void* const old = slots[rng() % slot_count].exchange(p);
+                    if (old) {
+                        size_t old_bytes = 0;
+                        std::memcpy(&old_bytes, old, sizeof(old_bytes));
+                        EXPECT_EQ(static_cast<char*>(old)[old_bytes - 1],
+                                  static_cast<char>(old_bytes));
+                        sds::thread_cache_deallocate(old, old_bytes);
+                    }
+                }
+            });
+        }
+        for (std::thread& t : threads) { t.join(); }
+        for (std::atomic<void*>& slot : slots) {
+            if (void* const p = slot.load()) {
+                size_t bytes = 0;
+                std::memcpy(&bytes, p, sizeof(bytes));
+                sds::thread_cache_deallocate(p, bytes);
+            }
+        }
+    };
+
+    churn();
+    size_t const reserved = sds::thread_cache_stats().reserved_bytes;
+
+    // Memory freed by other threads and by exited threads is reused, not leaked
+    for (int i = 0; i < 5; ++i) { churn(); }
+    sds::Thread_Cache_Stats const s = sds::thread_cache_stats();
+    EXPECT_LE(s.reserved_bytes, 2 * reserved);
+    EXPECT_LE(s.pooled_bytes, s.reserved_bytes);
+}
@@ -0,0 +1,136 @@
+#include "gtest/gtest.h"
+
+#include "sds/allocator/tracking_allocator.h"
+#include "sds/array/dynamic_array.h"
+#include "sds/bit.h"
+#include "sds/s_list.h"
+#include "sds/string.h"
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+template <typename T>
+using Tracked = sds::Tracking_Allocator<T>;
+} // namespace
+
+TEST(Tracking_Allocator_Test, dynamic_array)
+{
+    sds::Memory_Tag tag("dynamic_array");
+    {
+        sds::Dynamic_Array<int, Tracked<int>> v{Tracked<int>(tag)};
+        v.reserve(100'000);
+
+        sds::Memory_Stats s = tag.stats();
+        EXPECT_EQ(s.live_bytes, static_cast<sds::s64>(100'000 * sizeof(int)));
+        EXPECT_EQ(s.allocations, 1U);
+        EXPECT_EQ(s.deallocations, 0U);
+        EXPECT_EQ(s.size_histogram[sds::log2(sds::u64{100'000 * sizeof(int)})], 1U);
+
+        // Copies are accounted to the same tag
+        auto const copy = v;
+        EXPECT_EQ(&copy.get_allocator().tag(), &tag);
+    }
+
+    sds::Memory_Stats const s = tag.stats();
+    EXPECT_EQ(s.live_bytes, 0);
+    EXPECT_GE(s.peak_bytes, static_cast<sds::s64>(100'000 * sizeof(int)));
+    EXPECT_LE(s.peak_bytes, static_cast<sds::s64>(2 * 100'000 * sizeof(int)));
+    EXPECT_EQ(s.allocations, s.deallocations);
+}
+
+TEST(Tracking_Allocator_Test, s_list_and_string)
+{
+    sds::Memory_Tag list_tag("s_list");
+    sds::Memory_Tag string_tag("string");
+    {
+        sds::S_List<int, Tracked<int>> l{Tracked<int>(list_tag)};
+        for (int i = 0; i < 10; ++i) { l.push_back(i); }
+        EXPECT_EQ(list_tag.stats().allocations, 10U);
+        EXPECT_GT(list_tag.stats().live_bytes, static_cast<sds::s64>(10 * sizeof(int)));
+        l.pop_front();
+        EXPECT_EQ(list_tag.stats().deallocations, 1U);
+
+        sds::Basic_String<Tracked<char>> str(200, 'x', Tracked<char>(string_tag));
+        EXPECT_GE(string_tag.stats().live_bytes, 200);
+    }
+    EXPECT_EQ(list_tag.stats().live_bytes, 0);
+    EXPECT_EQ(string_tag.stats().live_bytes, 0);
+}
+
+TEST(Tracking_Allocator_Test, wraps_allocator)
+{
+    using Alloc = sds::Tracking_Allocator<int, std::pmr::polymorphic_allocator<int>>;
+    sds::Memory_Tag tag("pmr");
+    std::pmr::monotonic_buffer_resource arena;
+
+    sds::Dynamic_Array<int, Alloc> v{Alloc(tag, &arena)};
+    v.push_back(1);
+    EXPECT_EQ(v.get_allocator().base().resource(), &arena);
+    EXPECT_EQ(tag.stats().allocations, 1U);
+
+    // Different tags or resources compare unequal
+    sds::Memory_Tag other("other");
+    EXPECT_EQ(Alloc(tag, &arena), Alloc(tag, &arena));
+    EXPECT_NE(Alloc(tag, &arena), Alloc(other, &arena));
+    EXPECT_NE(Alloc(tag, &arena), Alloc(tag));
+
+    // Default constructed allocators report to the untagged account
+    sds::Tracking_Allocator<int> def;
+    EXPECT_EQ(&def.tag(), &sds::Memory_Tag::untagged());
+}
+
+TEST(Tracking_Allocator_Test, threads)
+{
+    sds::Memory_Tag tag("threads");
+    constexpr int thread_count = 8;
+    constexpr int rounds = 2000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&tag] {
+            Tracked<char> alloc(tag);
+            std::vector<char*> held;
+            for (int i = 0; i < rounds; ++i) {
+                held.push_back(alloc.allocate(1024));
+                if (held.size() > 100) {
+                    alloc.deallocate(held.front(), 1024);
+                    held.erase(held.begin());
+                }
+            }
+            for (char* p : held) { alloc.deallocate(p, 1024); }
+        });
+    }
+    for (std::thread& t : threads) { t.join(); }
+
+    sds::Memory_Stats const s = tag.stats();
+    EXPECT_EQ(s.live_bytes, 0);
+    EXPECT_EQ(s.allocations, static_cast<sds::u64>(thread_count * rounds));
+    EXPECT_EQ(s.deallocations, s.allocations);
+    EXPECT_EQ(s.size_histogram[10], s.allocations);
+    // Each thread peaked at 101 KiB. The peak may be understated by one batch per shard.
+    EXPECT_LE(s.peak_bytes, thread_count * 101 * 1024);
+    EXPECT_GE(s.peak_bytes, 101 * 1024 - sds::Memory_Tag::peak_batch_bytes);
+}
+
+TEST(Tracking_Allocator_Test, for_each_memory_tag)
+{
+    sds::Memory_Tag tag("enumerated");
+    bool found = false;
+    bool found_untagged = false;
+    (void)sds::Memory_Tag::untagged();
+    sds::for_each_memory_tag([&](sds::Memory_Tag const& t) {
+        found |= &t == &tag;
+        found_untagged |= std::string(t.name()) == "untagged";
+    });
+    EXPECT_TRUE(found);
+    EXPECT_TRUE(found_untagged);
+
+    {
+        sds::Memory_Tag temporary("temporary");
+    }
+    sds::for_each_memory_tag(
+        [&](sds::Memory_Tag const& t) { EXPECT_NE(std::string(t.name()), "temporary"); });
+}